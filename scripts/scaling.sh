@@ -0,0 +1,41 @@
+#!/bin/bash
+##
+# @section DESCRIPTION
+# Strong scaling report of the OpenMP-parallel solver.
+# Runs a config with 1, 2, 4, ... up to N threads and prints the time spent
+# in the time loop together with speedup and parallel efficiency.
+#
+# Usage (from the project root, after building with scons):
+#   ./scripts/scaling.sh [CONFIG_FILE_NAME.json] [MAX_THREADS]
+##
+l_config=${1:-dam_break_2d.json}
+l_maxThreads=${2:-$(nproc)}
+
+l_threads=()
+for (( l_nt=1; l_nt<l_maxThreads; l_nt*=2 )); do
+  l_threads+=(${l_nt})
+done
+l_threads+=(${l_maxThreads})
+
+echo "strong scaling of ${l_config} (output disabled)"
+printf "%8s %12s %10s %12s\n" "threads" "time [s]" "speedup" "efficiency"
+
+l_base=""
+for l_nt in "${l_threads[@]}"; do
+  # the timer prints "Took: <seconds>s" in the line following the "Simulation" label
+  l_time=$(OMP_NUM_THREADS=${l_nt} OMP_PROC_BIND=close OMP_PLACES=cores \
+           ./build/tsunami_lab ${l_config} -t -nio \
+           | grep -A1 "^Simulation$" | sed -n 's/^Took: \(.*\)s$/\1/p')
+
+  if [ -z "${l_time}" ]; then
+    echo "run with ${l_nt} threads failed"
+    exit 1
+  fi
+
+  if [ -z "${l_base}" ]; then
+    l_base=${l_time}
+  fi
+
+  awk -v nt=${l_nt} -v t=${l_time} -v b=${l_base} \
+      'BEGIN { printf "%8d %12.4f %10.2f %11.1f%%\n", nt, t, b / t, 100 * b / (t * nt) }'
+done
@@ -0,0 +1,312 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Entry-point for micro-benchmarks of the solver kernels.
+ **/
+#include <omp.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "constants.h"
+#include "kernels/Kernels.h"
+#include "patches/1d/WavePropagation1d.h"
+#include "patches/2d/WavePropagation2d.h"
+#include "setups/DamBreak2d/DamBreak2d.h"
+#include "solvers/FWave.h"
+
+/**
+ * Times the x- and y-sweep of the 2d patch separately on a dam break.
+ *
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ * @param i_nSteps number of timed time steps.
+ **/
+static void benchmarkSweeps(tsunami_lab::t_idx i_nx,
+                            tsunami_lab::t_idx i_ny,
+                            tsunami_lab::t_idx i_nSteps) {
+    typedef std::chrono::high_resolution_clock t_clock;
+
+    tsunami_lab::setups::DamBreak2d l_setup(10, 5, i_nx, i_ny, i_ny / 4);
+    tsunami_lab::patches::WavePropagation2d l_waveProp(i_nx, i_ny);
+
+    for (tsunami_lab::t_idx l_ceY = 0; l_ceY < i_ny; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 0; l_ceX < i_nx; l_ceX++) {
+            tsunami_lab::t_real l_x = l_ceX + 0.5;
+            tsunami_lab::t_real l_y = l_ceY + 0.5;
+
+            l_waveProp.setHeight(l_ceX, l_ceY, l_setup.getHeight(l_x, l_y));
+            l_waveProp.setBathymetry(l_ceX, l_ceY, l_setup.getBathymetry(l_x, l_y));
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    tsunami_lab::t_real l_scaling = 0.01;
+
+    // warm-up step
+    l_waveProp.setGhostCells(l_boundary);
+    l_waveProp.timeStep(l_scaling, l_scaling);
+
+    std::chrono::duration<double> l_durationX(0);
+    std::chrono::duration<double> l_durationY(0);
+
+    for (tsunami_lab::t_idx l_st = 0; l_st < i_nSteps; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+
+        t_clock::time_point l_start = t_clock::now();
+        l_waveProp.sweepX(l_scaling);
+        t_clock::time_point l_mid = t_clock::now();
+        l_waveProp.sweepY(l_scaling);
+        t_clock::time_point l_end = t_clock::now();
+
+        l_durationX += l_mid - l_start;
+        l_durationY += l_end - l_mid;
+    }
+
+    // edges solved per sweep
+    double l_nEdgesX = double(i_nx + 1) * (i_ny + 2) * i_nSteps;
+    double l_nEdgesY = double(i_nx) * (i_ny + 1) * i_nSteps;
+
+    std::cout << "sweeps of the 2d patch, " << i_nx << " x " << i_ny << " cells, "
+              << i_nSteps << " steps, " << omp_get_max_threads() << " threads" << std::endl;
+    std::cout << "  x-sweep: " << l_durationX.count() / l_nEdgesX * 1E9 << " ns per edge" << std::endl;
+    std::cout << "  y-sweep: " << l_durationY.count() / l_nEdgesY * 1E9 << " ns per edge" << std::endl;
+}
+
+/**
+ * Times the batched F-wave net-updates with and without precomputed cell terms on a row of wet cells and prints the
+ * operations per edge of both kernels.
+ *
+ * @param i_nEdges number of edges of the row.
+ * @param i_nRepetitions number of timed solves of the row.
+ **/
+static void benchmarkEdgeKernels(tsunami_lab::t_idx i_nEdges,
+                                 tsunami_lab::t_idx i_nRepetitions) {
+    typedef std::chrono::high_resolution_clock t_clock;
+    using tsunami_lab::solvers::FWave;
+    using tsunami_lab::t_real;
+
+    tsunami_lab::t_idx l_nCells = i_nEdges + 1;
+    std::vector<t_real> l_h(l_nCells), l_hu(l_nCells), l_b(l_nCells);
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++) {
+        l_h[l_ce] = 10 + 5 * t_real(l_ce % 17) / 17;
+        l_hu[l_ce] = t_real(l_ce % 5) - 2;
+        l_b[l_ce] = -10 - t_real(l_ce % 3);
+    }
+
+    std::vector<t_real> l_u(l_nCells), l_sqrtH(l_nCells), l_flux(l_nCells);
+    std::vector<t_real> l_netUpdates[2][4];
+    for (unsigned short l_ke = 0; l_ke < 2; l_ke++) {
+        for (unsigned short l_qu = 0; l_qu < 4; l_qu++) l_netUpdates[l_ke][l_qu].resize(i_nEdges);
+    }
+
+    t_real l_waveSpeed[2] = {0, 0};
+    std::chrono::duration<double> l_duration[2];
+
+    t_clock::time_point l_start = t_clock::now();
+    for (tsunami_lab::t_idx l_re = 0; l_re < i_nRepetitions; l_re++) {
+        l_waveSpeed[0] += FWave::netUpdatesBatch(i_nEdges,
+                                                 l_h.data(),
+                                                 l_h.data() + 1,
+                                                 l_hu.data(),
+                                                 l_hu.data() + 1,
+                                                 l_b.data(),
+                                                 l_b.data() + 1,
+                                                 l_netUpdates[0][0].data(),
+                                                 l_netUpdates[0][1].data(),
+                                                 l_netUpdates[0][2].data(),
+                                                 l_netUpdates[0][3].data());
+    }
+    l_duration[0] = t_clock::now() - l_start;
+
+    // the terms are computed in every repetition, as a sweep does for every row
+    l_start = t_clock::now();
+    for (tsunami_lab::t_idx l_re = 0; l_re < i_nRepetitions; l_re++) {
+        FWave::cellTerms(l_nCells, l_h.data(), l_hu.data(), l_u.data(), l_sqrtH.data(), l_flux.data());
+        l_waveSpeed[1] += FWave::netUpdatesBatch(i_nEdges,
+                                                 l_h.data(),
+                                                 l_h.data() + 1,
+                                                 l_hu.data(),
+                                                 l_hu.data() + 1,
+                                                 l_b.data(),
+                                                 l_b.data() + 1,
+                                                 l_u.data(),
+                                                 l_u.data() + 1,
+                                                 l_sqrtH.data(),
+                                                 l_sqrtH.data() + 1,
+                                                 l_flux.data(),
+                                                 l_flux.data() + 1,
+                                                 l_netUpdates[1][0].data(),
+                                                 l_netUpdates[1][1].data(),
+                                                 l_netUpdates[1][2].data(),
+                                                 l_netUpdates[1][3].data());
+    }
+    l_duration[1] = t_clock::now() - l_start;
+
+    bool l_identical = l_waveSpeed[0] == l_waveSpeed[1];
+    for (unsigned short l_qu = 0; l_qu < 4; l_qu++) l_identical = l_identical && l_netUpdates[0][l_qu] == l_netUpdates[1][l_qu];
+
+    // operations per wet edge as written in the kernels: additions and subtractions, multiplications, divisions and
+    // square roots; the cell terms cost one addition, four multiplications, one division and one square root per
+    // cell, i.e., per edge of a sweep
+    unsigned short l_ops[2][4] = {{23, 23, 4, 3},
+                                  {21 + 1, 15 + 4, 2 + 1, 1 + 1}};
+    char const *l_names[2] = {"net-updates         ", "cell terms + updates"};
+
+    double l_nEdgesAll = double(i_nEdges) * i_nRepetitions;
+    std::cout << "F-wave edge kernels, " << i_nEdges << " edges, " << i_nRepetitions << " repetitions" << std::endl;
+    for (unsigned short l_ke = 0; l_ke < 2; l_ke++) {
+        std::cout << "  " << l_names[l_ke] << ": "
+                  << l_ops[l_ke][0] + l_ops[l_ke][1] << " add/mul, "
+                  << l_ops[l_ke][2] << " div, "
+                  << l_ops[l_ke][3] << " sqrt, "
+                  << l_duration[l_ke].count() / l_nEdgesAll * 1E9 << " ns per edge" << std::endl;
+    }
+    std::cout << "  results " << (l_identical ? "identical" : "DIFFER") << std::endl;
+}
+
+/**
+ * Times complete time steps of the 1d and the 2d patch on a dam break for every solver and prints the cell updates
+ * per second. The 1d patch holds as many cells as the 2d patch.
+ *
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ * @param i_nSteps number of timed time steps.
+ **/
+static void benchmarkSolvers(tsunami_lab::t_idx i_nx,
+                             tsunami_lab::t_idx i_ny,
+                             tsunami_lab::t_idx i_nSteps) {
+    typedef std::chrono::high_resolution_clock t_clock;
+
+    tsunami_lab::setups::DamBreak2d l_setup(10, 5, i_nx, i_ny, i_ny / 4);
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    tsunami_lab::t_real l_scaling = 0.01;
+
+    tsunami_lab::e_solver l_solvers[2] = {tsunami_lab::FWAVE, tsunami_lab::ROE};
+    char const *l_names[2] = {"F-wave", "Roe   "};
+
+    double l_nCellUpdates = double(i_nx) * i_ny * i_nSteps;
+    std::cout << "time steps of the patches, " << i_nx * i_ny << " cells, "
+              << i_nSteps << " steps, " << omp_get_max_threads() << " threads" << std::endl;
+
+    for (unsigned short l_so = 0; l_so < 2; l_so++) {
+        tsunami_lab::patches::WavePropagation2d l_waveProp2d(i_nx, i_ny, 0, false, l_solvers[l_so]);
+        tsunami_lab::patches::WavePropagation1d l_waveProp1d(i_nx * i_ny, l_solvers[l_so]);
+        tsunami_lab::patches::WavePropagation *l_waveProps[2] = {&l_waveProp1d, &l_waveProp2d};
+
+        for (tsunami_lab::t_idx l_ceY = 0; l_ceY < i_ny; l_ceY++) {
+            for (tsunami_lab::t_idx l_ceX = 0; l_ceX < i_nx; l_ceX++) {
+                tsunami_lab::t_real l_x = l_ceX + 0.5;
+                tsunami_lab::t_real l_y = l_ceY + 0.5;
+
+                l_waveProp2d.setHeight(l_ceX, l_ceY, l_setup.getHeight(l_x, l_y));
+                l_waveProp2d.setBathymetry(l_ceX, l_ceY, l_setup.getBathymetry(l_x, l_y));
+
+                // the rows of the 2d patch are placed one after another
+                l_waveProp1d.setHeight(l_ceY * i_nx + l_ceX, 0, l_setup.getHeight(l_x, l_y));
+                l_waveProp1d.setBathymetry(l_ceY * i_nx + l_ceX, 0, l_setup.getBathymetry(l_x, l_y));
+            }
+        }
+
+        double l_nsPerCell[2];
+        for (unsigned short l_di = 0; l_di < 2; l_di++) {
+            // warm-up step
+            l_waveProps[l_di]->setGhostCells(l_boundary);
+            l_waveProps[l_di]->timeStep(l_scaling, l_scaling);
+
+            t_clock::time_point l_start = t_clock::now();
+            for (tsunami_lab::t_idx l_st = 0; l_st < i_nSteps; l_st++) {
+                l_waveProps[l_di]->setGhostCells(l_boundary);
+                l_waveProps[l_di]->timeStep(l_scaling, l_scaling);
+            }
+            std::chrono::duration<double> l_duration = t_clock::now() - l_start;
+            l_nsPerCell[l_di] = l_duration.count() / l_nCellUpdates * 1E9;
+        }
+
+        std::cout << "  " << l_names[l_so] << ": 1d " << l_nsPerCell[0] << " ns, 2d " << l_nsPerCell[1]
+                  << " ns per cell update; 2d " << 1E3 / l_nsPerCell[1] << " million cell updates per second" << std::endl;
+    }
+}
+
+/**
+ * Times the time steps of the 2d patch with the kernels of every available instruction set level on a dam break.
+ *
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ * @param i_nSteps number of timed time steps.
+ **/
+static void benchmarkIsas(tsunami_lab::t_idx i_nx,
+                          tsunami_lab::t_idx i_ny,
+                          tsunami_lab::t_idx i_nSteps) {
+    typedef std::chrono::high_resolution_clock t_clock;
+
+    tsunami_lab::setups::DamBreak2d l_setup(10, 5, i_nx, i_ny, i_ny / 4);
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    tsunami_lab::t_real l_scaling = 0.01;
+
+    double l_nCellUpdates = double(i_nx) * i_ny * i_nSteps;
+    std::cout << "time steps of the 2d patch per kernel ISA, " << i_nx * i_ny << " cells, "
+              << i_nSteps << " steps, " << omp_get_max_threads() << " threads" << std::endl;
+
+    for (tsunami_lab::t_idx l_is = 0; l_is < tsunami_lab::kernels::c_nIsas; l_is++) {
+        tsunami_lab::kernels::e_isa l_isa = static_cast<tsunami_lab::kernels::e_isa>(l_is);
+        if (!tsunami_lab::kernels::isAvailable(l_isa)) continue;
+
+        tsunami_lab::patches::WavePropagation2d l_waveProp(i_nx,
+                                                           i_ny,
+                                                           0,
+                                                           false,
+                                                           tsunami_lab::FWAVE,
+                                                           &tsunami_lab::kernels::getKernels(l_isa));
+        for (tsunami_lab::t_idx l_ceY = 0; l_ceY < i_ny; l_ceY++) {
+            for (tsunami_lab::t_idx l_ceX = 0; l_ceX < i_nx; l_ceX++) {
+                l_waveProp.setHeight(l_ceX, l_ceY, l_setup.getHeight(l_ceX + 0.5, l_ceY + 0.5));
+                l_waveProp.setBathymetry(l_ceX, l_ceY, l_setup.getBathymetry(l_ceX + 0.5, l_ceY + 0.5));
+            }
+        }
+
+        // warm-up step
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(l_scaling, l_scaling);
+
+        t_clock::time_point l_start = t_clock::now();
+        for (tsunami_lab::t_idx l_st = 0; l_st < i_nSteps; l_st++) {
+            l_waveProp.setGhostCells(l_boundary);
+            l_waveProp.timeStep(l_scaling, l_scaling);
+        }
+        std::chrono::duration<double> l_duration = t_clock::now() - l_start;
+        double l_nsPerCell = l_duration.count() / l_nCellUpdates * 1E9;
+
+        std::cout << "  " << tsunami_lab::kernels::getIsaName(l_isa) << ": " << l_nsPerCell << " ns per cell update; "
+                  << 1E3 / l_nsPerCell << " million cell updates per second" << std::endl;
+    }
+}
+
+int main(int i_argc, char *i_argv[]) {
+    tsunami_lab::t_idx l_nx = 4000;
+    tsunami_lab::t_idx l_ny = 2000;
+    tsunami_lab::t_idx l_nSteps = 10;
+
+    if (i_argc != 1 && i_argc != 4) {
+        std::cerr << "invalid number of program parameter" << std::endl;
+        std::cerr << "  ./build/benchmarks [NX NY STEPS]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (i_argc == 4) {
+        l_nx = std::stoul(i_argv[1]);
+        l_ny = std::stoul(i_argv[2]);
+        l_nSteps = std::stoul(i_argv[3]);
+    }
+
+    benchmarkSweeps(l_nx, l_ny, l_nSteps);
+    benchmarkEdgeKernels(l_nx, l_ny * l_nSteps);
+    benchmarkSolvers(l_nx, l_ny, l_nSteps);
+    benchmarkIsas(l_nx, l_ny, l_nSteps);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Configuration that holds all information for the adaptive mesh refinement.
+ **/
+#ifndef TSUNAMI_LAB_AMR_CONFIG_H
+#define TSUNAMI_LAB_AMR_CONFIG_H
+
+#include "../constants.h"
+
+namespace tsunami_lab {
+    namespace configs {
+        class AmrConfig;
+    }
+}  // namespace tsunami_lab
+
+class tsunami_lab::configs::AmrConfig {
+   private:
+    //! number of fine cells per coarse cell in each direction; 1 disables the refinement.
+    t_idx m_ratio = 1;
+
+    //! number of coarse cells per block in each direction.
+    t_idx m_blockSize = 32;
+
+    //! water depth below which wet cells are refined.
+    t_real m_depthThreshold = 200;
+
+    //! gradient of the surface elevation which triggers the refinement; 0 refines all shallow blocks.
+    t_real m_gradientThreshold = 0;
+
+    //! number of time steps between two regrids.
+    t_idx m_regridInterval = 10;
+
+   public:
+    /**
+     * Constructs an adaptive mesh refinement configuration object.
+     *
+     * @param i_ratio number of fine cells per coarse cell in each direction; 1 disables the refinement.
+     * @param i_blockSize number of coarse cells per block in each direction.
+     * @param i_depthThreshold water depth below which wet cells are refined.
+     * @param i_gradientThreshold gradient of the surface elevation which triggers the refinement; 0 refines all shallow blocks.
+     * @param i_regridInterval number of time steps between two regrids.
+     */
+    AmrConfig(t_idx i_ratio = 1,
+              t_idx i_blockSize = 32,
+              t_real i_depthThreshold = 200,
+              t_real i_gradientThreshold = 0,
+              t_idx i_regridInterval = 10) {
+        m_ratio = i_ratio;
+        m_blockSize = i_blockSize;
+        m_depthThreshold = i_depthThreshold;
+        m_gradientThreshold = i_gradientThreshold;
+        m_regridInterval = i_regridInterval;
+    }
+
+    /**
+     * @brief Gets if the adaptive mesh refinement is used.
+     *
+     * @return true if the refinement ratio is larger than 1.
+     */
+    bool useRefinement() {
+        return m_ratio > 1;
+    }
+
+    /**
+     * @brief Gets the refinement ratio.
+     *
+     * @return number of fine cells per coarse cell in each direction.
+     */
+    t_idx getRatio() {
+        return m_ratio;
+    }
+
+    /**
+     * @brief Gets the block size.
+     *
+     * @return number of coarse cells per block in each direction.
+     */
+    t_idx getBlockSize() {
+        return m_blockSize;
+    }
+
+    /**
+     * @brief Gets the depth threshold.
+     *
+     * @return water depth below which wet cells are refined.
+     */
+    t_real getDepthThreshold() {
+        return m_depthThreshold;
+    }
+
+    /**
+     * @brief Gets the gradient threshold.
+     *
+     * @return gradient of the surface elevation which triggers the refinement.
+     */
+    t_real getGradientThreshold() {
+        return m_gradientThreshold;
+    }
+
+    /**
+     * @brief Gets the regrid interval.
+     *
+     * @return number of time steps between two regrids.
+     */
+    t_idx getRegridInterval() {
+        return m_regridInterval;
+    }
+};
+
+#endif
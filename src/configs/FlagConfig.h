@@ -23,6 +23,8 @@ class tsunami_lab::configs::FlagConfig {
     bool m_useCheckPoint = false;
     bool m_useTiming = false;
     bool m_useIO = true;
+    bool m_useTrace = false;
+    std::string m_kernelIsa = "auto";
 
    public:
     /**
@@ -75,6 +77,42 @@ class tsunami_lab::configs::FlagConfig {
     void setUseIO(bool i_value) {
         m_useIO = i_value;
     }
+
+    /**
+     * @brief Gets the useTrace flag.
+     *
+     * @return wether a timeline of the time steps' phases should be written.
+     */
+    bool useTrace() {
+        return m_useTrace;
+    }
+
+    /**
+     * @brief Set the useTrace flag.
+     *
+     * @param i_value value of the useTrace flag.
+     */
+    void setUseTrace(bool i_value) {
+        m_useTrace = i_value;
+    }
+
+    /**
+     * @brief Gets the instruction set level of the kernels.
+     *
+     * @return name of the level; "auto" selects the highest one supported by the CPU.
+     */
+    std::string getKernelIsa() {
+        return m_kernelIsa;
+    }
+
+    /**
+     * @brief Set the instruction set level of the kernels.
+     *
+     * @param i_value name of the level, i.e., auto, sse2, avx2 or avx512.
+     */
+    void setKernelIsa(std::string i_value) {
+        m_kernelIsa = i_value;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Configuration that holds all information for the output of 2d simulations.
+ **/
+#ifndef TSUNAMI_LAB_OUTPUT_CONFIG_H
+#define TSUNAMI_LAB_OUTPUT_CONFIG_H
+
+#include "../constants.h"
+
+namespace tsunami_lab {
+    namespace configs {
+        class OutputConfig;
+
+        //! compression filter of the output fields
+        enum e_compression { NO_COMPRESSION,
+                             DEFLATE,
+                             ZSTD };
+    }
+}  // namespace tsunami_lab
+
+class tsunami_lab::configs::OutputConfig {
+   private:
+    //! number of frame buffers handed to the output thread; 0 writes the frames in the time loop.
+    t_idx m_bufferCount = 2;
+
+    //! drop frames while all buffers are in use instead of waiting for the output thread.
+    bool m_dropFrames = false;
+
+    //! write a NetCDF-4/HDF5 file instead of a classic one.
+    bool m_useNetCdf4 = false;
+
+    //! number of coarse cells per chunk in x-direction; 0 uses the entire row.
+    t_idx m_chunkX = 0;
+
+    //! number of coarse cells per chunk in y-direction; 0 uses all rows.
+    t_idx m_chunkY = 0;
+
+    //! compression filter of the output fields, requires NetCDF-4.
+    e_compression m_compression = NO_COMPRESSION;
+
+    //! level of the compression filter.
+    int m_compressionLevel = 4;
+
+    //! reorder the bytes of the values before the compression.
+    bool m_shuffle = true;
+
+    //! absolute error bound of the output fields; 0 writes them lossless.
+    t_real m_errorBound = 0;
+
+    //! maximum number of forked processes writing checkpoints at the same time; 0 passes them to the output thread.
+    t_idx m_snapshotWriters = 0;
+
+   public:
+    /**
+     * Constructs an output configuration object.
+     *
+     * @param i_bufferCount number of frame buffers handed to the output thread; 0 writes the frames in the time loop.
+     * @param i_dropFrames drop frames while all buffers are in use instead of waiting for the output thread.
+     * @param i_useNetCdf4 write a NetCDF-4/HDF5 file instead of a classic one.
+     * @param i_chunkX number of coarse cells per chunk in x-direction; 0 uses the entire row.
+     * @param i_chunkY number of coarse cells per chunk in y-direction; 0 uses all rows.
+     * @param i_compression compression filter of the output fields, requires NetCDF-4.
+     * @param i_compressionLevel level of the compression filter.
+     * @param i_shuffle reorder the bytes of the values before the compression.
+     * @param i_errorBound absolute error bound of the output fields; 0 writes them lossless.
+     * @param i_snapshotWriters maximum number of forked processes writing checkpoints at the same time; 0 passes them
+     *                          to the output thread.
+     */
+    OutputConfig(t_idx i_bufferCount = 2,
+                 bool i_dropFrames = false,
+                 bool i_useNetCdf4 = false,
+                 t_idx i_chunkX = 0,
+                 t_idx i_chunkY = 0,
+                 e_compression i_compression = NO_COMPRESSION,
+                 int i_compressionLevel = 4,
+                 bool i_shuffle = true,
+                 t_real i_errorBound = 0,
+                 t_idx i_snapshotWriters = 0) {
+        m_bufferCount = i_bufferCount;
+        m_dropFrames = i_dropFrames;
+        m_useNetCdf4 = i_useNetCdf4;
+        m_chunkX = i_chunkX;
+        m_chunkY = i_chunkY;
+        m_compression = i_compression;
+        m_compressionLevel = i_compressionLevel;
+        m_shuffle = i_shuffle;
+        m_errorBound = i_errorBound;
+        m_snapshotWriters = i_snapshotWriters;
+    }
+
+    /**
+     * @brief Gets the number of frame buffers.
+     *
+     * @return number of frame buffers; 0 if the frames are written in the time loop.
+     */
+    t_idx getBufferCount() {
+        return m_bufferCount;
+    }
+
+    /**
+     * @brief Gets if frames are dropped while all buffers are in use.
+     *
+     * @return true if frames are dropped, false if the time loop waits for the output thread.
+     */
+    bool dropFrames() {
+        return m_dropFrames;
+    }
+
+    /**
+     * @brief Gets if a NetCDF-4/HDF5 file is written.
+     *
+     * @return true for NetCDF-4, false for the classic format.
+     */
+    bool useNetCdf4() {
+        return m_useNetCdf4;
+    }
+
+    /**
+     * @brief Gets the number of coarse cells per chunk in x-direction.
+     *
+     * @return cells per chunk; 0 if a chunk spans the entire row.
+     */
+    t_idx getChunkX() {
+        return m_chunkX;
+    }
+
+    /**
+     * @brief Gets the number of coarse cells per chunk in y-direction.
+     *
+     * @return cells per chunk; 0 if a chunk spans all rows.
+     */
+    t_idx getChunkY() {
+        return m_chunkY;
+    }
+
+    /**
+     * @brief Gets the compression filter.
+     *
+     * @return compression filter of the output fields.
+     */
+    e_compression getCompression() {
+        return m_compression;
+    }
+
+    /**
+     * @brief Gets the level of the compression filter.
+     *
+     * @return compression level.
+     */
+    int getCompressionLevel() {
+        return m_compressionLevel;
+    }
+
+    /**
+     * @brief Sets the compression filter and its level.
+     *
+     * @param i_compression compression filter of the output fields.
+     * @param i_compressionLevel level of the compression filter.
+     */
+    void setCompression(e_compression i_compression,
+                        int i_compressionLevel) {
+        m_compression = i_compression;
+        m_compressionLevel = i_compressionLevel;
+    }
+
+    /**
+     * @brief Gets if the bytes are shuffled before the compression.
+     *
+     * @return true if the shuffle filter is used.
+     */
+    bool useShuffle() {
+        return m_shuffle;
+    }
+
+    /**
+     * @brief Gets the absolute error bound of the output fields.
+     *
+     * @return error bound; 0 if the fields are written lossless.
+     */
+    t_real getErrorBound() {
+        return m_errorBound;
+    }
+
+    /**
+     * @brief Gets the maximum number of forked processes writing checkpoints at the same time.
+     *
+     * @return number of processes; 0 if the checkpoints are passed to the output thread.
+     */
+    t_idx getSnapshotWriters() {
+        return m_snapshotWriters;
+    }
+};
+
+#endif
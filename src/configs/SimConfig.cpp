@@ -23,7 +23,14 @@ tsunami_lab::configs::SimConfig::SimConfig(tsunami_lab::t_idx i_dimension,
 														 tsunami_lab::t_idx i_currentFrame,
 														 tsunami_lab::t_idx i_coarseFactor,
                                            e_boundary i_boundaryCondition[4],
-                                           bool i_isRoeSolver) {
+                                           bool i_isRoeSolver,
+                                           tsunami_lab::t_idx i_tileRows,
+                                           tsunami_lab::t_real i_cflNumber,
+                                           tsunami_lab::t_real i_frameTime,
+                                           bool i_useActiveTiles,
+                                           tsunami_lab::configs::AmrConfig i_amrConfig,
+                                           tsunami_lab::configs::OutputConfig i_outputConfig,
+                                           tsunami_lab::parallel::e_affinity i_threadAffinity) {
     m_dimension = i_dimension;
 	 m_configName = i_configName;
 	 m_flagConfig = i_flagConfig;
@@ -40,6 +47,13 @@ tsunami_lab::configs::SimConfig::SimConfig(tsunami_lab::t_idx i_dimension,
         m_boundaryCondition[l_i] = i_boundaryCondition[l_i];
     }
     m_isRoeSolver = i_isRoeSolver;
+    m_tileRows = i_tileRows;
+    m_cflNumber = i_cflNumber;
+    m_frameTime = i_frameTime;
+    m_useActiveTiles = i_useActiveTiles;
+    m_amrConfig = i_amrConfig;
+    m_outputConfig = i_outputConfig;
+    m_threadAffinity = i_threadAffinity;
 }
 
 tsunami_lab::configs::SimConfig::~SimConfig() {}
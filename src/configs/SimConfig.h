@@ -11,7 +11,10 @@
 #include <string>
 
 #include "../constants.h"
+#include "../parallel/Affinity.h"
+#include "AmrConfig.h"
 #include "FlagConfig.h"
+#include "OutputConfig.h"
 
 namespace tsunami_lab {
     namespace configs {
@@ -63,6 +66,27 @@ class tsunami_lab::configs::SimConfig {
     //! boolean that shows if the Roe Solver is to be used.
     bool m_isRoeSolver = false;
 
+    //! number of rows per band of the fused 2d sweeps; 0 disables the fused mode.
+    tsunami_lab::t_idx m_tileRows = 0;
+
+    //! CFL number which scales the largest stable time step.
+    tsunami_lab::t_real m_cflNumber = tsunami_lab::t_real(0.5);
+
+    //! simulation time between two output frames; 0 uses 25 initial time steps.
+    tsunami_lab::t_real m_frameTime = tsunami_lab::t_real(0);
+
+    //! boolean that shows if tiles of still or dry water are skipped in 2d simulations.
+    bool m_useActiveTiles = false;
+
+    //! adaptive mesh refinement of 2d simulations.
+    tsunami_lab::configs::AmrConfig m_amrConfig;
+
+    //! output of 2d simulations.
+    tsunami_lab::configs::OutputConfig m_outputConfig;
+
+    //! preset of the cores the threads are pinned to.
+    tsunami_lab::parallel::e_affinity m_threadAffinity = tsunami_lab::parallel::AFFINITY_NONE;
+
    public:
     /**
      * Default constructor;
@@ -86,6 +110,13 @@ class tsunami_lab::configs::SimConfig {
      * @param i_coarseFactor factor of the coarse output.
      * @param i_boundaryCondition list that determines the chosen boundary conditions.
      * @param i_isRoeSolver boolean that shows if the roe solver is to be used (false -> f-wave solver).
+     * @param i_tileRows number of rows per band of the fused 2d sweeps; 0 disables the fused mode.
+     * @param i_cflNumber CFL number which scales the largest stable time step.
+     * @param i_frameTime simulation time between two output frames; 0 uses 25 initial time steps.
+     * @param i_useActiveTiles boolean that shows if tiles of still or dry water are skipped in 2d simulations.
+     * @param i_amrConfig adaptive mesh refinement of 2d simulations.
+     * @param i_outputConfig output of 2d simulations.
+     * @param i_threadAffinity preset of the cores the threads are pinned to.
      */
     SimConfig(tsunami_lab::t_idx i_dimension,
               std::string i_configName,
@@ -100,7 +131,14 @@ class tsunami_lab::configs::SimConfig {
               tsunami_lab::t_idx i_currentFrame,
               tsunami_lab::t_idx i_coarseFactor,
               e_boundary i_boundaryCondition[4],
-              bool i_isRoeSolver);
+              bool i_isRoeSolver,
+              tsunami_lab::t_idx i_tileRows = 0,
+              tsunami_lab::t_real i_cflNumber = 0.5,
+              tsunami_lab::t_real i_frameTime = 0,
+              bool i_useActiveTiles = false,
+              tsunami_lab::configs::AmrConfig i_amrConfig = tsunami_lab::configs::AmrConfig(),
+              tsunami_lab::configs::OutputConfig i_outputConfig = tsunami_lab::configs::OutputConfig(),
+              tsunami_lab::parallel::e_affinity i_threadAffinity = tsunami_lab::parallel::AFFINITY_NONE);
     /**
      * @brief Destructor which frees all allocated memory.
      **/
@@ -232,6 +270,69 @@ class tsunami_lab::configs::SimConfig {
     t_idx getCheckPointCount() {
         return m_checkPointCount;
     }
+
+    /**
+     * @brief Gets the number of rows per band of the fused 2d sweeps.
+     *
+     * @return rows per band; 0 if the fused mode is disabled.
+     */
+    tsunami_lab::t_idx getTileRows() {
+        return m_tileRows;
+    }
+
+    /**
+     * @brief Gets the CFL number.
+     *
+     * @return CFL number.
+     */
+    tsunami_lab::t_real getCflNumber() {
+        return m_cflNumber;
+    }
+
+    /**
+     * @brief Gets the simulation time between two output frames.
+     *
+     * @return time between two frames; 0 if 25 initial time steps are used.
+     */
+    tsunami_lab::t_real getFrameTime() {
+        return m_frameTime;
+    }
+
+    /**
+     * @brief Gets if tiles of still or dry water are skipped in 2d simulations.
+     *
+     * @return true if the activity of tiles is tracked.
+     */
+    bool useActiveTiles() {
+        return m_useActiveTiles;
+    }
+
+    /**
+     * @brief Gets the adaptive mesh refinement configuration.
+     *
+     * @return adaptive mesh refinement of 2d simulations.
+     */
+    tsunami_lab::configs::AmrConfig getAmrConfig() {
+        return m_amrConfig;
+    }
+
+    /**
+     * @brief Gets the output configuration.
+     *
+     * @return output of 2d simulations.
+     */
+    tsunami_lab::configs::OutputConfig getOutputConfig() {
+        return m_outputConfig;
+    }
+
+    /**
+     * @brief Gets the preset of the cores the threads are pinned to.
+     *
+     * @return thread affinity.
+     */
+    tsunami_lab::parallel::e_affinity getThreadAffinity() {
+        return m_threadAffinity;
+    }
 };
 
 #endif
\ No newline at end of file
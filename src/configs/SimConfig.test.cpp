@@ -53,4 +53,5 @@ TEST_CASE("Test the SimConfig data-structure.", "[SimConfig]") {
         REQUIRE(l_boundaryCondition[l_i] == l_boundaryCondition_ptr[l_i]);
     }
     REQUIRE(l_isRoeSolver == l_config.isRoeSolver());
+    REQUIRE(l_config.getThreadAffinity() == tsunami_lab::parallel::AFFINITY_NONE);
 }
\ No newline at end of file
@@ -20,6 +20,10 @@ namespace tsunami_lab {
     //! boundary condition type enum
     enum e_boundary { OUTFLOW,
                       REFLECTING };
+
+    //! Riemann solver type enum
+    enum e_solver { FWAVE,
+                    ROE };
 }  // namespace tsunami_lab
 
 #endif
\ No newline at end of file
@@ -0,0 +1,216 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Output stage which hands the frames of the time loop to a dedicated output thread.
+ **/
+#include "AsyncWriter.h"
+
+#include <omp.h>
+
+#include <chrono>
+
+#include "../../parallel/Affinity.h"
+
+namespace {
+    //! seconds since the given point in time
+    double secondsSince(std::chrono::steady_clock::time_point i_start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - i_start).count();
+    }
+}  // namespace
+
+tsunami_lab::io::AsyncWriter::AsyncWriter(NetCDF *i_writer,
+                                          t_idx i_nx,
+                                          t_idx i_ny,
+                                          t_idx i_stride,
+                                          t_real const *i_b,
+                                          t_idx i_nFrames,
+                                          bool i_dropFrames) : m_head(0), m_tail(0), m_finished(false), m_nErrors(0) {
+    m_writer = i_writer;
+    m_nx = i_nx;
+    m_ny = i_ny;
+    m_stride = i_stride;
+    m_size = i_stride * (i_ny + 2);
+    m_nFrames = i_nFrames;
+    m_dropFrames = i_dropFrames;
+
+    // the time loop keeps updating the ghost cells of the patch's bathymetry
+    m_b = new t_real[m_size];
+    for (t_idx l_i = 0; l_i < m_size; l_i++) {
+        m_b[l_i] = i_b[l_i];
+    }
+
+    if (m_nFrames == 0) return;
+
+    m_frames = new Frame[m_nFrames];
+    for (t_idx l_fr = 0; l_fr < m_nFrames; l_fr++) {
+        m_frames[l_fr].h = new t_real[m_size];
+        m_frames[l_fr].hu = new t_real[m_size];
+        m_frames[l_fr].hv = new t_real[m_size];
+    }
+
+    m_thread = std::thread(&AsyncWriter::run, this);
+}
+
+tsunami_lab::io::AsyncWriter::~AsyncWriter() {
+    finish();
+    delete[] m_b;
+
+    if (m_frames != nullptr) {
+        for (t_idx l_fr = 0; l_fr < m_nFrames; l_fr++) {
+            delete[] m_frames[l_fr].h;
+            delete[] m_frames[l_fr].hu;
+            delete[] m_frames[l_fr].hv;
+        }
+        delete[] m_frames;
+    }
+}
+
+tsunami_lab::io::AsyncWriter::Frame *tsunami_lab::io::AsyncWriter::acquire(bool i_mayDrop) {
+    t_idx l_tail = m_tail.load(std::memory_order_relaxed);
+
+    if (l_tail - m_head.load(std::memory_order_acquire) >= m_nFrames) {
+        if (i_mayDrop) return nullptr;
+
+        // wait for the output thread to release the oldest entry
+        std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+        while (l_tail - m_head.load(std::memory_order_acquire) >= m_nFrames) {
+            std::this_thread::yield();
+        }
+        m_stallTime += secondsSince(l_start);
+    }
+
+    return &m_frames[l_tail % m_nFrames];
+}
+
+void tsunami_lab::io::AsyncWriter::run() {
+    // the coarsening of the writer must not compete with the threads of the time loop
+    omp_set_num_threads(1);
+
+    // the thread inherited the core of the pinned master thread of the time loop
+    parallel::Affinity::unpinThread();
+
+    while (true) {
+        t_idx l_head = m_head.load(std::memory_order_relaxed);
+
+        if (l_head == m_tail.load(std::memory_order_acquire)) {
+            // entries filled before the time loop finished are visible once the flag is
+            if (m_finished.load(std::memory_order_acquire)) {
+                if (l_head == m_tail.load(std::memory_order_acquire)) break;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+
+        Frame &l_frame = m_frames[l_head % m_nFrames];
+        std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+        int l_err = 0;
+        if (l_frame.isCheckPoint) {
+            l_err = BinaryCheckPoint::write(l_frame.checkPointPath,
+                                            m_nx,
+                                            m_ny,
+                                            m_stride,
+                                            l_frame.frame,
+                                            l_frame.simTime,
+                                            l_frame.endTime,
+                                            l_frame.h,
+                                            l_frame.hu,
+                                            l_frame.hv,
+                                            m_b);
+        } else {
+            l_err = m_writer->store(l_frame.simTime, l_frame.frame, l_frame.h, l_frame.hu, l_frame.hv);
+        }
+        if (l_err != 0) m_nErrors++;
+        m_writeTime += secondsSince(l_start);
+
+        // hand the entry back to the time loop
+        m_head.store(l_head + 1, std::memory_order_release);
+    }
+}
+
+void tsunami_lab::io::AsyncWriter::copy(Frame *o_frame,
+                                        t_real const *i_h,
+                                        t_real const *i_hu,
+                                        t_real const *i_hv) {
+    std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+
+    t_real *l_h = o_frame->h;
+    t_real *l_hu = o_frame->hu;
+    t_real *l_hv = o_frame->hv;
+#pragma omp parallel for schedule(static)
+    for (t_idx l_i = 0; l_i < m_size; l_i++) {
+        l_h[l_i] = i_h[l_i];
+        l_hu[l_i] = i_hu[l_i];
+        l_hv[l_i] = i_hv[l_i];
+    }
+
+    m_copyTime += secondsSince(l_start);
+}
+
+bool tsunami_lab::io::AsyncWriter::store(t_real i_simTime,
+                                         t_idx i_frame,
+                                         t_real const *i_h,
+                                         t_real const *i_hu,
+                                         t_real const *i_hv) {
+    if (m_nFrames == 0) {
+        // the time loop waits for the writer
+        std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+        if (m_writer->store(i_simTime, i_frame, i_h, i_hu, i_hv) != 0) m_nErrors++;
+        m_stallTime += secondsSince(l_start);
+        m_nStored++;
+        return true;
+    }
+
+    Frame *l_frame = acquire(m_dropFrames);
+    if (l_frame == nullptr) {
+        m_nDropped++;
+        return false;
+    }
+
+    l_frame->isCheckPoint = false;
+    l_frame->simTime = i_simTime;
+    l_frame->frame = i_frame;
+    copy(l_frame, i_h, i_hu, i_hv);
+
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_nStored++;
+
+    return true;
+}
+
+void tsunami_lab::io::AsyncWriter::checkPoint(t_idx i_currentFrame,
+                                              std::string i_checkPointPath,
+                                              t_real i_simTime,
+                                              t_real i_endTime,
+                                              t_real const *i_h,
+                                              t_real const *i_hu,
+                                              t_real const *i_hv) {
+    if (m_nFrames == 0) {
+        std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+        if (BinaryCheckPoint::write(i_checkPointPath, m_nx, m_ny, m_stride, i_currentFrame, i_simTime, i_endTime, i_h, i_hu, i_hv, m_b) != 0) m_nErrors++;
+        m_stallTime += secondsSince(l_start);
+        return;
+    }
+
+    Frame *l_frame = acquire(false);
+    l_frame->isCheckPoint = true;
+    l_frame->frame = i_currentFrame;
+    l_frame->checkPointPath = i_checkPointPath;
+    l_frame->simTime = i_simTime;
+    l_frame->endTime = i_endTime;
+    copy(l_frame, i_h, i_hu, i_hv);
+
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+tsunami_lab::t_idx tsunami_lab::io::AsyncWriter::finish() {
+    if (m_thread.joinable()) {
+        std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+        m_finished.store(true, std::memory_order_release);
+        m_thread.join();
+        m_stallTime += secondsSince(l_start);
+    }
+
+    return m_nErrors.load();
+}
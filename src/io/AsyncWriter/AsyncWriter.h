@@ -0,0 +1,239 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Output stage which hands the frames of the time loop to a dedicated output thread.
+ **/
+#ifndef TSUNAMI_LAB_IO_ASYNC_WRITER
+#define TSUNAMI_LAB_IO_ASYNC_WRITER
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "../../constants.h"
+#include "../BinaryCheckPoint/BinaryCheckPoint.h"
+#include "../NetCDF/NetCDF.h"
+
+namespace tsunami_lab {
+    namespace io {
+        class AsyncWriter;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * The time loop copies a frame into one of the preallocated buffers of a ring and continues; the output thread
+ * coarsens and writes the frames in order. The ring has a single producer and a single consumer, such that the
+ * positions of both ends are the only shared state.
+ *
+ * Without buffers, all calls are passed to the writer in the calling thread.
+ **/
+class tsunami_lab::io::AsyncWriter {
+   private:
+    //! entry of the ring
+    struct Frame {
+        //! true if the entry requests a checkpoint instead of holding a frame
+        bool isCheckPoint;
+        //! simulation time of the frame or checkpoint
+        t_real simTime;
+        //! id of the frame or of the next frame after the checkpoint
+        t_idx frame;
+        //! simulation time at which the simulation ends, checkpoints only
+        t_real endTime;
+        //! path of the checkpoint file
+        std::string checkPointPath;
+        //! water heights, momenta in x- and y-direction of the cells
+        t_real *h, *hu, *hv;
+    };
+
+    //! writer which is only used by the output thread
+    NetCDF *m_writer;
+
+    //! number of inner cells in x- and y-direction and stride of the rows of a frame
+    t_idx m_nx, m_ny, m_stride;
+
+    //! number of values per quantity of a frame
+    t_idx m_size;
+
+    //! bathymetry of the cells, written to the checkpoints
+    t_real *m_b = nullptr;
+
+    //! number of entries in the ring
+    t_idx m_nFrames;
+
+    //! drop frames while the ring is full
+    bool m_dropFrames;
+
+    //! entries of the ring
+    Frame *m_frames = nullptr;
+
+    //! number of entries taken by the output thread
+    std::atomic<t_idx> m_head;
+
+    //! number of entries filled by the time loop
+    std::atomic<t_idx> m_tail;
+
+    //! set once no further entries follow
+    std::atomic<bool> m_finished;
+
+    //! output thread
+    std::thread m_thread;
+
+    //! number of frames handed over
+    t_idx m_nStored = 0;
+
+    //! number of frames dropped since the ring was full
+    t_idx m_nDropped = 0;
+
+    //! time the time loop waited for a free entry in seconds
+    double m_stallTime = 0;
+
+    //! time the time loop spent copying frames in seconds
+    double m_copyTime = 0;
+
+    //! time the output thread spent in the writer in seconds
+    double m_writeTime = 0;
+
+    //! number of failed calls of the writer
+    std::atomic<t_idx> m_nErrors;
+
+    /**
+     * @brief Gets the next free entry of the ring.
+     *
+     * @param i_mayDrop return nullptr instead of waiting if the ring is full.
+     * @return free entry; nullptr if the ring is full and i_mayDrop is set.
+     */
+    Frame *acquire(bool i_mayDrop);
+
+    /**
+     * @brief Copies the cells into an entry of the ring.
+     *
+     * @param o_frame entry of the ring.
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells.
+     */
+    void copy(Frame *o_frame,
+              t_real const *i_h,
+              t_real const *i_hu,
+              t_real const *i_hv);
+
+    /**
+     * @brief Writes the entries of the ring until the time loop is finished.
+     */
+    void run();
+
+   public:
+    /**
+     * Constructs the output stage and starts the output thread.
+     *
+     * @param i_writer writer of the frames; it must not be used elsewhere until finish returns.
+     * @param i_nx number of inner cells in x-direction.
+     * @param i_ny number of inner cells in y-direction.
+     * @param i_stride stride of the rows of a frame; a frame holds i_stride * (i_ny + 2) values per quantity.
+     * @param i_b bathymetry of the cells, which is copied for the checkpoints.
+     * @param i_nFrames number of frame buffers; 0 writes the frames in the calling thread.
+     * @param i_dropFrames drop frames while all buffers are in use instead of waiting.
+     */
+    AsyncWriter(NetCDF *i_writer,
+                t_idx i_nx,
+                t_idx i_ny,
+                t_idx i_stride,
+                t_real const *i_b,
+                t_idx i_nFrames,
+                bool i_dropFrames);
+
+    /**
+     * Destructor which finishes the output thread and frees the buffers.
+     */
+    ~AsyncWriter();
+
+    /**
+     * @brief Hands a frame over to the output thread.
+     *
+     * @param i_simTime amount of time passed.
+     * @param i_frame counter for iterations done.
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells.
+     * @return true if the frame was handed over, false if it was dropped.
+     */
+    bool store(t_real i_simTime,
+               t_idx i_frame,
+               t_real const *i_h,
+               t_real const *i_hu,
+               t_real const *i_hv);
+
+    /**
+     * @brief Requests a checkpoint once all frames handed over before are written; never dropped.
+     *
+     * @param i_currentFrame id of the next frame to be written.
+     * @param i_checkPointPath path to the written checkpoint file.
+     * @param i_simTime time passed since simulation begin.
+     * @param i_endTime maximum time to be simulated.
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells.
+     */
+    void checkPoint(t_idx i_currentFrame,
+                    std::string i_checkPointPath,
+                    t_real i_simTime,
+                    t_real i_endTime,
+                    t_real const *i_h,
+                    t_real const *i_hu,
+                    t_real const *i_hv);
+
+    /**
+     * @brief Waits until all entries are written and stops the output thread.
+     *
+     * @return number of failed calls of the writer.
+     */
+    t_idx finish();
+
+    /**
+     * @brief Gets the number of frames handed over.
+     *
+     * @return number of frames handed over.
+     */
+    t_idx getNumberOfStoredFrames() {
+        return m_nStored;
+    }
+
+    /**
+     * @brief Gets the number of dropped frames.
+     *
+     * @return number of frames dropped since all buffers were in use.
+     */
+    t_idx getNumberOfDroppedFrames() {
+        return m_nDropped;
+    }
+
+    /**
+     * @brief Gets the time the time loop waited for the output thread.
+     *
+     * @return waiting time in seconds.
+     */
+    double getStallTime() {
+        return m_stallTime;
+    }
+
+    /**
+     * @brief Gets the time the time loop spent copying frames.
+     *
+     * @return copy time in seconds.
+     */
+    double getCopyTime() {
+        return m_copyTime;
+    }
+
+    /**
+     * @brief Gets the time spent in the writer; only valid after finish.
+     *
+     * @return write time in seconds.
+     */
+    double getWriteTime() {
+        return m_writeTime;
+    }
+};
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the output stage with a dedicated output thread.
+ **/
+#include "AsyncWriter.h"
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Fills the inner cells of a 3 x 2 frame with values derived from the frame.
+ *
+ * @param i_frame id of the frame.
+ * @param o_h water heights.
+ * @param o_hu momenta in x-direction.
+ **/
+static void fillFrame(tsunami_lab::t_idx i_frame,
+                      std::vector<tsunami_lab::t_real> &o_h,
+                      std::vector<tsunami_lab::t_real> &o_hu) {
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 2; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 3; l_ix++) {
+            o_h[(l_iy + 1) * 5 + l_ix + 1] = 10 * i_frame + 3 * l_iy + l_ix;
+            o_hu[(l_iy + 1) * 5 + l_ix + 1] = -tsunami_lab::t_real(i_frame);
+        }
+    }
+}
+
+/**
+ * Checks the frames of an output file.
+ *
+ * @param i_path path of the output file.
+ * @param i_nWritten expected number of written frames, i.e., the length of the time dimension.
+ * @param i_lastFrame id of the last written frame.
+ **/
+static void checkFrames(char const *i_path,
+                        tsunami_lab::t_idx i_nWritten,
+                        tsunami_lab::t_idx i_lastFrame) {
+    int l_ncId, l_dimIdTime, l_varIdTime, l_varIdHeight, l_varIdMomentumX;
+    REQUIRE(nc_open(i_path, NC_NOWRITE, &l_ncId) == NC_NOERR);
+    REQUIRE(nc_inq_dimid(l_ncId, "time", &l_dimIdTime) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "time", &l_varIdTime) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "height", &l_varIdHeight) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "momentum_x", &l_varIdMomentumX) == NC_NOERR);
+
+    std::size_t l_timeLength;
+    REQUIRE(nc_inq_dimlen(l_ncId, l_dimIdTime, &l_timeLength) == NC_NOERR);
+    REQUIRE(l_timeLength == i_nWritten);
+
+    std::vector<float> l_time(i_nWritten);
+    std::vector<float> l_height(i_nWritten * 6);
+    std::vector<float> l_momentumX(i_nWritten * 6);
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdTime, l_time.data()) == NC_NOERR);
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdHeight, l_height.data()) == NC_NOERR);
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdMomentumX, l_momentumX.data()) == NC_NOERR);
+    REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+    // dropped frames leave no records; the time of a frame is its id
+    for (tsunami_lab::t_idx l_re = 0; l_re < i_nWritten; l_re++) {
+        if (l_re > 0) REQUIRE(l_time[l_re] > l_time[l_re - 1]);
+        tsunami_lab::t_real l_fr = l_time[l_re];
+
+        for (tsunami_lab::t_idx l_ce = 0; l_ce < 6; l_ce++) {
+            REQUIRE(l_height[l_re * 6 + l_ce] == 10 * l_fr + l_ce);
+            REQUIRE(l_momentumX[l_re * 6 + l_ce] == -l_fr);
+        }
+    }
+    REQUIRE(l_time[i_nWritten - 1] == i_lastFrame);
+}
+
+TEST_CASE("Test the output thread writing all frames and a checkpoint in order.", "[AsyncWriter]") {
+    /*
+     * Test case:
+     *   40 frames of 3 x 2 cells are written without buffers and through rings of 1 and 2 buffers; a checkpoint is
+     *   requested after frame 24. The time loop reuses a single array for all frames, as the patches do.
+     *
+     *   Every frame is written with its own values and the checkpoint holds the state of frame 24.
+     */
+    std::vector<tsunami_lab::t_real> l_b(20, -20);
+    std::vector<tsunami_lab::t_real> l_h(20, 0);
+    std::vector<tsunami_lab::t_real> l_hu(20, 0);
+
+    for (tsunami_lab::t_idx l_nBuffers : {0, 1, 2}) {
+        tsunami_lab::io::NetCDF l_writer(1, 3, 2, 5, 1, l_b.data(), "async_writer_test.nc");
+        tsunami_lab::io::AsyncWriter l_async(&l_writer, 3, 2, 5, l_b.data(), l_nBuffers, false);
+
+        for (tsunami_lab::t_idx l_fr = 0; l_fr < 40; l_fr++) {
+            fillFrame(l_fr, l_h, l_hu);
+            REQUIRE(l_async.store(l_fr, l_fr, l_h.data(), l_hu.data(), l_h.data()));
+
+            if (l_fr == 24) l_async.checkPoint(l_fr + 1, "async_writer_test_checkpoint.bin", l_fr, 40, l_h.data(), l_hu.data(), l_h.data());
+        }
+        REQUIRE(l_async.finish() == 0);
+        REQUIRE(l_async.getNumberOfStoredFrames() == 40);
+        REQUIRE(l_async.getNumberOfDroppedFrames() == 0);
+        REQUIRE(l_writer.write() == NC_NOERR);
+
+        checkFrames("async_writer_test.nc", 40, 39);
+
+        tsunami_lab::io::BinaryCheckPoint l_checkPoint;
+        REQUIRE(l_checkPoint.map("async_writer_test_checkpoint.bin", 3, 2) == 0);
+        REQUIRE(l_checkPoint.getFrame() == 25);
+        REQUIRE(l_checkPoint.getSimTime() == 24);
+        for (tsunami_lab::t_idx l_iy = 0; l_iy < 2; l_iy++) {
+            for (tsunami_lab::t_idx l_ix = 0; l_ix < 3; l_ix++) {
+                tsunami_lab::t_idx l_ce = (l_iy + 1) * 5 + l_ix + 1;
+                REQUIRE(l_checkPoint.getHeight()[l_ce] == 240 + 3 * l_iy + l_ix);
+                REQUIRE(l_checkPoint.getMomentumX()[l_ce] == -24);
+                REQUIRE(l_checkPoint.getBathymetry()[l_ce] == -20);
+            }
+        }
+    }
+
+    std::remove("async_writer_test.nc");
+    std::remove("async_writer_test_checkpoint.bin");
+}
+
+TEST_CASE("Test the output thread dropping frames while its buffer is in use.", "[AsyncWriter]") {
+    /*
+     * Test case:
+     *   200 frames pass a ring of a single buffer which drops frames instead of waiting.
+     *
+     *   Stored and dropped frames add up, the stored frames are written to consecutive records and every written frame
+     *   holds its own values.
+     */
+    std::vector<tsunami_lab::t_real> l_b(20, -20);
+    std::vector<tsunami_lab::t_real> l_h(20, 0);
+    std::vector<tsunami_lab::t_real> l_hu(20, 0);
+
+    tsunami_lab::io::NetCDF l_writer(1, 3, 2, 5, 1, l_b.data(), "async_writer_drop_test.nc");
+    tsunami_lab::io::AsyncWriter l_async(&l_writer, 3, 2, 5, l_b.data(), 1, true);
+
+    tsunami_lab::t_idx l_lastStored = 0;
+    for (tsunami_lab::t_idx l_fr = 0; l_fr < 200; l_fr++) {
+        fillFrame(l_fr, l_h, l_hu);
+        if (l_async.store(l_fr, l_fr, l_h.data(), l_hu.data(), l_h.data())) l_lastStored = l_fr;
+    }
+    REQUIRE(l_async.finish() == 0);
+    REQUIRE(l_async.getNumberOfStoredFrames() + l_async.getNumberOfDroppedFrames() == 200);
+    REQUIRE(l_async.getStallTime() >= 0);
+    REQUIRE(l_writer.write() == NC_NOERR);
+
+    checkFrames("async_writer_drop_test.nc", l_async.getNumberOfStoredFrames(), l_lastStored);
+
+    std::remove("async_writer_drop_test.nc");
+}
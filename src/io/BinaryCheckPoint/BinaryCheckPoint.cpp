@@ -0,0 +1,225 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Raw binary checkpoints of the state of a 2d patch which are restored through a memory mapping.
+ **/
+#include "BinaryCheckPoint.h"
+
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+constexpr char tsunami_lab::io::BinaryCheckPoint::c_magic[8];
+constexpr std::uint32_t tsunami_lab::io::BinaryCheckPoint::c_version;
+
+namespace {
+    //! finalizer of splitmix64, which spreads every input bit over the whole word
+    inline std::uint64_t mix(std::uint64_t i_word) {
+        i_word = (i_word ^ (i_word >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        i_word = (i_word ^ (i_word >> 27)) * 0x94d049bb133111ebULL;
+        return i_word ^ (i_word >> 31);
+    }
+
+    //! sums up the mixed words in [i_first, i_last) of an array at the given offset of the file
+    std::uint64_t sumWords(unsigned char const *i_data,
+                           tsunami_lab::t_idx i_first,
+                           tsunami_lab::t_idx i_last,
+                           tsunami_lab::t_idx i_offset) {
+        std::uint64_t l_sum = 0;
+        for (tsunami_lab::t_idx l_wo = i_first; l_wo < i_last; l_wo++) {
+            std::uint64_t l_word;
+            std::memcpy(&l_word, i_data + 8 * l_wo, 8);
+            l_sum += mix(l_word ^ mix(i_offset + 8 * l_wo));
+        }
+        return l_sum;
+    }
+
+    //! rounds the size up to a multiple of the alignment
+    inline tsunami_lab::t_idx alignUp(tsunami_lab::t_idx i_size,
+                                      tsunami_lab::t_idx i_alignment) {
+        return (i_size + i_alignment - 1) / i_alignment * i_alignment;
+    }
+
+    //! writes all bytes at the given offset of the file, continuing after partial writes
+    bool writeAll(int i_fd,
+                  void const *i_data,
+                  tsunami_lab::t_idx i_bytes,
+                  tsunami_lab::t_idx i_offset) {
+        char const *l_data = static_cast<char const *>(i_data);
+        while (i_bytes > 0) {
+            ssize_t l_written = pwrite(i_fd, l_data, i_bytes, i_offset);
+            if (l_written <= 0) return false;
+            l_data += l_written;
+            i_bytes -= l_written;
+            i_offset += l_written;
+        }
+        return true;
+    }
+}  // namespace
+
+tsunami_lab::io::BinaryCheckPoint::~BinaryCheckPoint() {
+    if (m_data != nullptr) munmap(m_data, m_size);
+}
+
+std::uint64_t tsunami_lab::io::BinaryCheckPoint::checksum(void const *i_data,
+                                                          t_idx i_bytes,
+                                                          t_idx i_offset,
+                                                          bool i_parallel) {
+    unsigned char const *l_data = static_cast<unsigned char const *>(i_data);
+    t_idx l_nWords = i_bytes / 8;
+    std::uint64_t l_sum = 0;
+
+    if (i_parallel) {
+#pragma omp parallel reduction(+ : l_sum)
+        {
+            t_idx l_nThreads = omp_get_num_threads();
+            t_idx l_thread = omp_get_thread_num();
+            l_sum += sumWords(l_data, l_nWords * l_thread / l_nThreads, l_nWords * (l_thread + 1) / l_nThreads, i_offset);
+        }
+    } else {
+        l_sum = sumWords(l_data, 0, l_nWords, i_offset);
+    }
+
+    // the last bytes are padded with zeros to a word
+    if (i_bytes % 8 != 0) {
+        std::uint64_t l_word = 0;
+        std::memcpy(&l_word, l_data + 8 * l_nWords, i_bytes % 8);
+        l_sum += mix(l_word ^ mix(i_offset + 8 * l_nWords));
+    }
+
+    return l_sum;
+}
+
+int tsunami_lab::io::BinaryCheckPoint::write(std::string i_path,
+                                             t_idx i_nx,
+                                             t_idx i_ny,
+                                             t_idx i_stride,
+                                             t_idx i_frame,
+                                             t_real i_simTime,
+                                             t_real i_endTime,
+                                             t_real const *i_h,
+                                             t_real const *i_hu,
+                                             t_real const *i_hv,
+                                             t_real const *i_b,
+                                             bool i_parallel) {
+    t_idx l_pageSize = sysconf(_SC_PAGESIZE);
+    t_idx l_valueBytes = i_stride * (i_ny + 2) * sizeof(t_real);
+
+    Header l_header = {};
+    std::memcpy(l_header.magic, c_magic, sizeof(c_magic));
+    l_header.version = c_version;
+    l_header.realSize = sizeof(t_real);
+    l_header.nx = i_nx;
+    l_header.ny = i_ny;
+    l_header.stride = i_stride;
+    l_header.frame = i_frame;
+    l_header.simTime = i_simTime;
+    l_header.endTime = i_endTime;
+    l_header.dataOffset = alignUp(sizeof(Header), l_pageSize);
+    l_header.arrayBytes = alignUp(l_valueBytes, l_pageSize);
+
+    t_real const *l_arrays[4] = {i_h, i_hu, i_hv, i_b};
+    for (t_idx l_ar = 0; l_ar < 4; l_ar++) {
+        l_header.checksum += checksum(l_arrays[l_ar], l_valueBytes, l_header.dataOffset + l_ar * l_header.arrayBytes, i_parallel);
+    }
+
+    // concurrent writers of the same checkpoint, e.g., snapshot processes, use temporary files of their own
+    std::string l_tmpPath = i_path + "." + std::to_string(getpid()) + ".tmp";
+    int l_fd = open(l_tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (l_fd < 0) {
+        std::cerr << "Could not create file: " << l_tmpPath << std::endl;
+        return 1;
+    }
+
+    // the gaps up to the page boundaries stay holes which read as zeros
+    bool l_ok = writeAll(l_fd, &l_header, sizeof(Header), 0);
+    for (t_idx l_ar = 0; l_ar < 4 && l_ok; l_ar++) {
+        l_ok = writeAll(l_fd, l_arrays[l_ar], l_valueBytes, l_header.dataOffset + l_ar * l_header.arrayBytes);
+    }
+    l_ok = l_ok && ftruncate(l_fd, l_header.dataOffset + 4 * l_header.arrayBytes) == 0;
+    l_ok = l_ok && fsync(l_fd) == 0;
+    l_ok = (close(l_fd) == 0) && l_ok;
+    if (!l_ok || std::rename(l_tmpPath.c_str(), i_path.c_str()) != 0) {
+        std::cerr << "Could not write checkpoint: " << i_path << std::endl;
+        std::remove(l_tmpPath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
+
+int tsunami_lab::io::BinaryCheckPoint::map(std::string i_path,
+                                           t_idx i_nx,
+                                           t_idx i_ny) {
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    int l_fd = open(i_path.c_str(), O_RDONLY);
+    if (l_fd < 0) {
+        std::cerr << "Could not open file: " << i_path << std::endl;
+        return 1;
+    }
+
+    struct stat l_stat;
+    if (fstat(l_fd, &l_stat) != 0 || t_idx(l_stat.st_size) < sizeof(Header)) {
+        std::cerr << "The checkpoint " << i_path << " is truncated." << std::endl;
+        close(l_fd);
+        return 1;
+    }
+
+    m_size = l_stat.st_size;
+    void *l_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, l_fd, 0);
+    close(l_fd);
+    if (l_data == MAP_FAILED) {
+        std::cerr << "Could not map file: " << i_path << std::endl;
+        return 1;
+    }
+    m_data = l_data;
+    madvise(m_data, m_size, MADV_SEQUENTIAL);
+    madvise(m_data, m_size, MADV_WILLNEED);
+
+    std::memcpy(&m_header, m_data, sizeof(Header));
+    t_idx l_valueBytes = m_header.stride * (m_header.ny + 2) * sizeof(t_real);
+    char const *l_error = nullptr;
+    if (std::memcmp(m_header.magic, c_magic, sizeof(c_magic)) != 0) {
+        l_error = "is no checkpoint";
+    } else if (m_header.version != c_version || m_header.realSize != sizeof(t_real)) {
+        l_error = "was written by another version";
+    } else if (m_header.nx != i_nx || m_header.ny != i_ny || m_header.stride < i_nx + 2) {
+        l_error = "does not match the grid";
+    } else if (m_header.dataOffset < sizeof(Header) || m_header.arrayBytes < l_valueBytes ||
+               m_size < m_header.dataOffset + 4 * m_header.arrayBytes) {
+        l_error = "is truncated";
+    } else {
+        std::uint64_t l_checksum = 0;
+        for (t_idx l_ar = 0; l_ar < 4; l_ar++) {
+            l_checksum += checksum(getArray(l_ar), l_valueBytes, m_header.dataOffset + l_ar * m_header.arrayBytes);
+        }
+        if (l_checksum != m_header.checksum) l_error = "is corrupted";
+    }
+
+    if (l_error != nullptr) {
+        std::cerr << "The checkpoint " << i_path << " " << l_error << "." << std::endl;
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_header = Header();
+        return 1;
+    }
+
+    return 0;
+}
+
+tsunami_lab::t_real const *tsunami_lab::io::BinaryCheckPoint::getArray(t_idx i_array) const {
+    if (m_data == nullptr) return nullptr;
+
+    return reinterpret_cast<t_real const *>(static_cast<char const *>(m_data) + m_header.dataOffset + i_array * m_header.arrayBytes);
+}
@@ -0,0 +1,247 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Raw binary checkpoints of the state of a 2d patch which are restored through a memory mapping.
+ **/
+#ifndef TSUNAMI_LAB_IO_BINARY_CHECK_POINT
+#define TSUNAMI_LAB_IO_BINARY_CHECK_POINT
+
+#include <cstdint>
+#include <string>
+
+#include "../../constants.h"
+
+namespace tsunami_lab {
+    namespace io {
+        class BinaryCheckPoint;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * A checkpoint consists of a header followed by the water heights, the momenta in x- and y-direction and the
+ * bathymetry. Every array holds all cells including the ghost cells in the layout of the patch, i.e., rows of stride
+ * values, and starts at a page boundary. Writing and restoring a checkpoint thus is a plain copy of the arrays.
+ *
+ * An object maps a checkpoint file read-only; the arrays are valid while it exists.
+ **/
+class tsunami_lab::io::BinaryCheckPoint {
+   public:
+    //! first bytes of every checkpoint
+    static constexpr char c_magic[8] = {'T', 'S', 'U', 'N', 'A', 'M', 'I', 'C'};
+
+    //! version of the layout; files of other versions are rejected
+    static constexpr std::uint32_t c_version = 1;
+
+    //! header at the beginning of the file
+    struct Header {
+        //! magic bytes c_magic
+        char magic[8];
+        //! version of the layout
+        std::uint32_t version;
+        //! size of a value in bytes
+        std::uint32_t realSize;
+        //! number of inner cells in x-direction
+        std::uint64_t nx;
+        //! number of inner cells in y-direction
+        std::uint64_t ny;
+        //! stride of the rows
+        std::uint64_t stride;
+        //! id of the next frame to be written
+        std::uint64_t frame;
+        //! time passed since simulation begin
+        double simTime;
+        //! maximum time to be simulated
+        double endTime;
+        //! offset of the first array from the beginning of the file in bytes
+        std::uint64_t dataOffset;
+        //! distance between two arrays in bytes
+        std::uint64_t arrayBytes;
+        //! checksum of the four arrays
+        std::uint64_t checksum;
+    };
+
+   private:
+    //! mapped file, nullptr if no file is mapped
+    void *m_data = nullptr;
+
+    //! size of the mapping in bytes
+    t_idx m_size = 0;
+
+    //! header of the mapped file
+    Header m_header = {};
+
+    /**
+     * @brief Gets the array with the given id of the mapped file.
+     *
+     * @param i_array id of the array: 0 water heights, 1 and 2 momenta in x- and y-direction, 3 bathymetry.
+     * @return first value of the array.
+     */
+    t_real const *getArray(t_idx i_array) const;
+
+   public:
+    /**
+     * Constructor which maps no file.
+     **/
+    BinaryCheckPoint() = default;
+
+    BinaryCheckPoint(BinaryCheckPoint const &) = delete;
+    BinaryCheckPoint &operator=(BinaryCheckPoint const &) = delete;
+
+    /**
+     * Destructor which unmaps the file.
+     **/
+    ~BinaryCheckPoint();
+
+    /**
+     * @brief Computes the checksum of an array; the contributions of the values are mixed with their position and
+     * summed up, such that the threads may sum up their parts of the array in any order.
+     *
+     * @param i_data first byte of the array.
+     * @param i_bytes size of the array in bytes.
+     * @param i_offset offset of the array in the file in bytes.
+     * @param i_parallel use the threads of OpenMP; a forked process must not.
+     * @return checksum.
+     */
+    static std::uint64_t checksum(void const *i_data,
+                                  t_idx i_bytes,
+                                  t_idx i_offset,
+                                  bool i_parallel = true);
+
+    /**
+     * @brief Writes the state of a patch to a checkpoint file.
+     *
+     * The file is written under a temporary name, synced and renamed afterwards, such that an interrupted write keeps
+     * the previous checkpoint.
+     *
+     * @param i_path path of the checkpoint file.
+     * @param i_nx number of inner cells in x-direction.
+     * @param i_ny number of inner cells in y-direction.
+     * @param i_stride stride of the rows; the arrays hold i_stride * (i_ny + 2) values.
+     * @param i_frame id of the next frame to be written.
+     * @param i_simTime time passed since simulation begin.
+     * @param i_endTime maximum time to be simulated.
+     * @param i_h water heights of the cells.
+     * @param i_hu momenta in x-direction of the cells.
+     * @param i_hv momenta in y-direction of the cells.
+     * @param i_b bathymetry of the cells.
+     * @param i_parallel use the threads of OpenMP; a forked process must not.
+     * @return 0 on success, 1 otherwise.
+     */
+    static int write(std::string i_path,
+                     t_idx i_nx,
+                     t_idx i_ny,
+                     t_idx i_stride,
+                     t_idx i_frame,
+                     t_real i_simTime,
+                     t_real i_endTime,
+                     t_real const *i_h,
+                     t_real const *i_hu,
+                     t_real const *i_hv,
+                     t_real const *i_b,
+                     bool i_parallel = true);
+
+    /**
+     * @brief Maps a checkpoint file and validates its header, its size and its checksum.
+     *
+     * @param i_path path of the checkpoint file.
+     * @param i_nx expected number of inner cells in x-direction.
+     * @param i_ny expected number of inner cells in y-direction.
+     * @return 0 on success, 1 otherwise.
+     */
+    int map(std::string i_path,
+            t_idx i_nx,
+            t_idx i_ny);
+
+    /**
+     * @brief Gets the number of inner cells in x-direction.
+     *
+     * @return number of cells.
+     */
+    t_idx getNx() const {
+        return m_header.nx;
+    }
+
+    /**
+     * @brief Gets the number of inner cells in y-direction.
+     *
+     * @return number of cells.
+     */
+    t_idx getNy() const {
+        return m_header.ny;
+    }
+
+    /**
+     * @brief Gets the stride of the rows of the arrays.
+     *
+     * @return stride.
+     */
+    t_idx getStride() const {
+        return m_header.stride;
+    }
+
+    /**
+     * @brief Gets the id of the next frame to be written.
+     *
+     * @return id of the frame.
+     */
+    t_idx getFrame() const {
+        return m_header.frame;
+    }
+
+    /**
+     * @brief Gets the time passed since simulation begin.
+     *
+     * @return simulation time.
+     */
+    t_real getSimTime() const {
+        return m_header.simTime;
+    }
+
+    /**
+     * @brief Gets the maximum time to be simulated.
+     *
+     * @return end time.
+     */
+    t_real getEndTime() const {
+        return m_header.endTime;
+    }
+
+    /**
+     * @brief Gets the water heights of all cells including the ghost cells.
+     *
+     * @return water heights.
+     */
+    t_real const *getHeight() const {
+        return getArray(0);
+    }
+
+    /**
+     * @brief Gets the momenta in x-direction of all cells including the ghost cells.
+     *
+     * @return momenta in x-direction.
+     */
+    t_real const *getMomentumX() const {
+        return getArray(1);
+    }
+
+    /**
+     * @brief Gets the momenta in y-direction of all cells including the ghost cells.
+     *
+     * @return momenta in y-direction.
+     */
+    t_real const *getMomentumY() const {
+        return getArray(2);
+    }
+
+    /**
+     * @brief Gets the bathymetry of all cells including the ghost cells.
+     *
+     * @return bathymetry.
+     */
+    t_real const *getBathymetry() const {
+        return getArray(3);
+    }
+};
+
+#endif
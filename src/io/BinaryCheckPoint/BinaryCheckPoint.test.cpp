@@ -0,0 +1,108 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the raw binary checkpoints.
+ **/
+#include "BinaryCheckPoint.h"
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+TEST_CASE("Test writing and mapping a raw binary checkpoint.", "[BinaryCheckPoint]") {
+    /*
+     * Test case:
+     *   A checkpoint of 7 x 5 cells with rows of 10 values is written and mapped again.
+     *
+     *   The header holds the grid, the frame and the times; every array starts at a page boundary and matches the
+     *   written one including the ghost cells.
+     */
+    tsunami_lab::t_idx l_nx = 7;
+    tsunami_lab::t_idx l_ny = 5;
+    tsunami_lab::t_idx l_stride = 10;
+    tsunami_lab::t_idx l_size = l_stride * (l_ny + 2);
+    std::vector<tsunami_lab::t_real> l_h(l_size), l_hu(l_size), l_hv(l_size), l_b(l_size);
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_size; l_ce++) {
+        l_h[l_ce] = l_ce;
+        l_hu[l_ce] = -tsunami_lab::t_real(0.5) * l_ce;
+        l_hv[l_ce] = tsunami_lab::t_real(0.25) * l_ce;
+        l_b[l_ce] = -100 + tsunami_lab::t_real(l_ce);
+    }
+
+    REQUIRE(tsunami_lab::io::BinaryCheckPoint::write("binary_checkpoint_test.bin", l_nx, l_ny, l_stride, 12, 3.5, 10, l_h.data(), l_hu.data(), l_hv.data(), l_b.data()) == 0);
+
+    tsunami_lab::io::BinaryCheckPoint l_checkPoint;
+    REQUIRE(l_checkPoint.map("binary_checkpoint_test.bin", l_nx, l_ny) == 0);
+    REQUIRE(l_checkPoint.getNx() == l_nx);
+    REQUIRE(l_checkPoint.getNy() == l_ny);
+    REQUIRE(l_checkPoint.getStride() == l_stride);
+    REQUIRE(l_checkPoint.getFrame() == 12);
+    REQUIRE(l_checkPoint.getSimTime() == 3.5);
+    REQUIRE(l_checkPoint.getEndTime() == 10);
+
+    tsunami_lab::t_idx l_pageSize = sysconf(_SC_PAGESIZE);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(l_checkPoint.getHeight()) % l_pageSize == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(l_checkPoint.getMomentumX()) % l_pageSize == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(l_checkPoint.getMomentumY()) % l_pageSize == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(l_checkPoint.getBathymetry()) % l_pageSize == 0);
+
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_size; l_ce++) {
+        REQUIRE(l_checkPoint.getHeight()[l_ce] == l_h[l_ce]);
+        REQUIRE(l_checkPoint.getMomentumX()[l_ce] == l_hu[l_ce]);
+        REQUIRE(l_checkPoint.getMomentumY()[l_ce] == l_hv[l_ce]);
+        REQUIRE(l_checkPoint.getBathymetry()[l_ce] == l_b[l_ce]);
+    }
+
+    // a rewritten checkpoint replaces the previous one
+    l_h[l_stride + 1] = 42;
+    REQUIRE(tsunami_lab::io::BinaryCheckPoint::write("binary_checkpoint_test.bin", l_nx, l_ny, l_stride, 13, 4, 10, l_h.data(), l_hu.data(), l_hv.data(), l_b.data()) == 0);
+    REQUIRE(l_checkPoint.map("binary_checkpoint_test.bin", l_nx, l_ny) == 0);
+    REQUIRE(l_checkPoint.getFrame() == 13);
+    REQUIRE(l_checkPoint.getHeight()[l_stride + 1] == 42);
+
+    std::remove("binary_checkpoint_test.bin");
+}
+
+TEST_CASE("Test rejecting invalid raw binary checkpoints.", "[BinaryCheckPoint]") {
+    /*
+     * Test case:
+     *   A checkpoint of 3 x 2 cells is mapped for another grid, with a flipped byte in the heights and truncated.
+     *
+     *   Every mapping fails and leaves no arrays behind.
+     */
+    std::vector<tsunami_lab::t_real> l_data(20, 1);
+    REQUIRE(tsunami_lab::io::BinaryCheckPoint::write("binary_checkpoint_invalid_test.bin", 3, 2, 5, 1, 0, 1, l_data.data(), l_data.data(), l_data.data(), l_data.data()) == 0);
+
+    tsunami_lab::io::BinaryCheckPoint l_checkPoint;
+    REQUIRE(l_checkPoint.map("binary_checkpoint_missing_test.bin", 3, 2) != 0);
+    REQUIRE(l_checkPoint.map("binary_checkpoint_invalid_test.bin", 4, 2) != 0);
+    REQUIRE(l_checkPoint.getHeight() == nullptr);
+    REQUIRE(l_checkPoint.map("binary_checkpoint_invalid_test.bin", 3, 2) == 0);
+
+    std::ifstream l_in("binary_checkpoint_invalid_test.bin", std::ios::binary);
+    std::vector<char> l_file((std::istreambuf_iterator<char>(l_in)), std::istreambuf_iterator<char>());
+    l_in.close();
+    tsunami_lab::t_idx l_pageSize = sysconf(_SC_PAGESIZE);
+    REQUIRE(l_file.size() == 5 * l_pageSize);
+
+    // the first height is stored at the first page boundary
+    std::vector<char> l_corrupted = l_file;
+    l_corrupted[l_pageSize] ^= 0x10;
+    std::ofstream l_out("binary_checkpoint_invalid_test.bin", std::ios::binary | std::ios::trunc);
+    l_out.write(l_corrupted.data(), l_corrupted.size());
+    l_out.close();
+    REQUIRE(l_checkPoint.map("binary_checkpoint_invalid_test.bin", 3, 2) != 0);
+    REQUIRE(l_checkPoint.getHeight() == nullptr);
+
+    l_out.open("binary_checkpoint_invalid_test.bin", std::ios::binary | std::ios::trunc);
+    l_out.write(l_file.data(), 4 * l_pageSize);
+    l_out.close();
+    REQUIRE(l_checkPoint.map("binary_checkpoint_invalid_test.bin", 3, 2) != 0);
+
+    std::remove("binary_checkpoint_invalid_test.bin");
+}
@@ -13,8 +13,10 @@
 #include <random>
 #include <string>
 
+#include "../../io/BinaryCheckPoint/BinaryCheckPoint.h"
 #include "../../io/Csv/Csv.h"
 #include "../../io/NetCDF/NetCDF.h"
+#include "../../patches/2d/WavePropagation2d.h"
 
 // include setup classes
 #include "../../setups/ArtificialTsunami2d/ArtificialTsunami2d.h"
@@ -177,6 +179,219 @@ tsunami_lab::t_idx tsunami_lab::io::ConfigLoader::loadConfig(std::string i_confi
         l_coarseFactor = 1;
     }
 
+    // rows per band of the fused 2d sweeps
+    tsunami_lab::t_idx l_tileRows;
+    if (l_configFile.contains("tileRows")) {
+        if (l_configFile.at("tileRows").is_string()) {
+            std::string l_tileRowsName = l_configFile.at("tileRows");
+            if (l_tileRowsName.compare("auto") != 0) {
+                std::cout << "tileRows has to be a number or \"auto\"" << std::endl;
+                return EXIT_FAILURE;
+            }
+            l_tileRows = tsunami_lab::patches::WavePropagation2d::getL2TileRows(l_nx);
+        } else {
+            // read signed, such that negative values don't wrap around to huge bands
+            int l_tileRowsValue = l_configFile.at("tileRows");
+            if (l_tileRowsValue < 0) {
+                std::cout << "tileRows can't be negative" << std::endl;
+                return EXIT_FAILURE;
+            }
+            l_tileRows = l_tileRowsValue;
+        }
+    } else {
+        std::cout << "tileRows takes on default value" << std::endl;
+        l_tileRows = 0;
+    }
+
+    // skipping of tiles with still or dry water in 2d simulations
+    bool l_useActiveTiles;
+    if (l_configFile.contains("activeTiles")) {
+        l_useActiveTiles = l_configFile.at("activeTiles");
+
+        if (l_useActiveTiles && l_tileRows != 0) {
+            std::cout << "activeTiles can't be combined with the fused mode (tileRows)" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "activeTiles takes on default value" << std::endl;
+        l_useActiveTiles = false;
+    }
+
+    // cores the threads are pinned to
+    tsunami_lab::parallel::e_affinity l_threadAffinity = tsunami_lab::parallel::AFFINITY_NONE;
+    if (l_configFile.contains("threadAffinity")) {
+        std::string l_threadAffinityName = l_configFile.at("threadAffinity");
+
+        if (l_threadAffinityName.compare("close") == 0) {
+            l_threadAffinity = tsunami_lab::parallel::AFFINITY_CLOSE;
+        } else if (l_threadAffinityName.compare("spread") == 0) {
+            l_threadAffinity = tsunami_lab::parallel::AFFINITY_SPREAD;
+        } else if (l_threadAffinityName.compare("none") != 0) {
+            std::cout << "threadAffinity has to be none, close or spread" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // adaptive mesh refinement of 2d simulations
+    tsunami_lab::t_idx l_refinementRatio = 1;
+    tsunami_lab::t_idx l_refinementBlockSize = 32;
+    tsunami_lab::t_real l_refinementDepth = 200;
+    tsunami_lab::t_real l_refinementGradient = 0;
+    tsunami_lab::t_idx l_regridInterval = 10;
+    if (l_configFile.contains("refinementRatio")) {
+        l_refinementRatio = l_configFile.at("refinementRatio");
+
+        if (l_refinementRatio < 1) {
+            std::cout << "refinementRatio can't be smaller than 1" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (l_refinementRatio > 1 && (l_useActiveTiles || l_tileRows != 0)) {
+            std::cout << "refinementRatio can't be combined with activeTiles or tileRows" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "refinementRatio takes on default value" << std::endl;
+    }
+    if (l_configFile.contains("refinementBlockSize")) l_refinementBlockSize = l_configFile.at("refinementBlockSize");
+    if (l_configFile.contains("refinementDepth")) l_refinementDepth = l_configFile.at("refinementDepth");
+    if (l_configFile.contains("refinementGradient")) l_refinementGradient = l_configFile.at("refinementGradient");
+    if (l_configFile.contains("regridInterval")) l_regridInterval = l_configFile.at("regridInterval");
+
+    if (l_refinementBlockSize < 1 || l_regridInterval < 1) {
+        std::cout << "refinementBlockSize and regridInterval have to be positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+    tsunami_lab::configs::AmrConfig l_amrConfig(l_refinementRatio,
+                                                l_refinementBlockSize,
+                                                l_refinementDepth,
+                                                l_refinementGradient,
+                                                l_regridInterval);
+
+    // CFL number of the adaptive time step
+    tsunami_lab::t_real l_cflNumber;
+    if (l_configFile.contains("cfl")) {
+        l_cflNumber = l_configFile.at("cfl");
+
+        if (l_cflNumber <= 0 || l_cflNumber > 1) {
+            std::cout << "cfl has to be in (0, 1]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "cfl takes on default value" << std::endl;
+        l_cflNumber = 0.5;
+    }
+
+    // simulation time between two output frames
+    tsunami_lab::t_real l_frameTime;
+    if (l_configFile.contains("frameTime")) {
+        l_frameTime = l_configFile.at("frameTime");
+
+        if (l_frameTime <= 0) {
+            std::cout << "frameTime has to be positive" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "frameTime takes on default value" << std::endl;
+        l_frameTime = 0;
+    }
+
+    // frame buffers of the output thread
+    int l_outputBuffers = 2;
+    if (l_configFile.contains("outputBuffers")) {
+        l_outputBuffers = l_configFile.at("outputBuffers");
+
+        if (l_outputBuffers < 0) {
+            std::cout << "outputBuffers can't be negative" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "outputBuffers takes on default value" << std::endl;
+    }
+    bool l_dropFrames = false;
+    if (l_configFile.contains("dropFrames")) l_dropFrames = l_configFile.at("dropFrames");
+
+    // format, chunks and compression of the output file
+    bool l_useNetCdf4 = false;
+    if (l_configFile.contains("outputFormat")) {
+        std::string l_outputFormat = l_configFile.at("outputFormat");
+
+        if (l_outputFormat.compare("netcdf4") == 0) {
+            l_useNetCdf4 = true;
+        } else if (l_outputFormat.compare("classic") != 0) {
+            std::cout << "outputFormat has to be classic or netcdf4" << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::cout << "outputFormat takes on default value" << std::endl;
+    }
+    int l_chunkX = 0;
+    int l_chunkY = 0;
+    if (l_configFile.contains("chunkX")) l_chunkX = l_configFile.at("chunkX");
+    if (l_configFile.contains("chunkY")) l_chunkY = l_configFile.at("chunkY");
+    if (l_chunkX < 0 || l_chunkY < 0) {
+        std::cout << "chunkX and chunkY can't be negative" << std::endl;
+        return EXIT_FAILURE;
+    }
+    tsunami_lab::configs::e_compression l_compression = tsunami_lab::configs::NO_COMPRESSION;
+    if (l_configFile.contains("compression")) {
+        std::string l_compressionName = l_configFile.at("compression");
+
+        if (l_compressionName.compare("deflate") == 0) {
+            l_compression = tsunami_lab::configs::DEFLATE;
+        } else if (l_compressionName.compare("zstd") == 0) {
+            l_compression = tsunami_lab::configs::ZSTD;
+        } else if (l_compressionName.compare("none") != 0) {
+            std::cout << "compression has to be none, deflate or zstd" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (!l_useNetCdf4 && (l_compression != tsunami_lab::configs::NO_COMPRESSION || l_chunkX != 0 || l_chunkY != 0)) {
+        std::cout << "compression and chunks require the netcdf4 outputFormat" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int l_compressionLevel = 4;
+    if (l_configFile.contains("compressionLevel")) {
+        l_compressionLevel = l_configFile.at("compressionLevel");
+
+        if (l_compressionLevel < 1 || (l_compression == tsunami_lab::configs::DEFLATE && l_compressionLevel > 9)) {
+            std::cout << "compressionLevel has to be in [1, 9] for deflate and positive for zstd" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    bool l_shuffle = true;
+    if (l_configFile.contains("shuffle")) l_shuffle = l_configFile.at("shuffle");
+    tsunami_lab::t_real l_errorBound = 0;
+    if (l_configFile.contains("outputErrorBound")) {
+        l_errorBound = l_configFile.at("outputErrorBound");
+
+        if (l_errorBound < 0) {
+            std::cout << "outputErrorBound can't be negative" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // forked processes which write the checkpoints from a copy-on-write snapshot
+    int l_snapshotWriters = 0;
+    if (l_configFile.contains("checkPointSnapshots")) {
+        l_snapshotWriters = l_configFile.at("checkPointSnapshots");
+
+        if (l_snapshotWriters < 0) {
+            std::cout << "checkPointSnapshots can't be negative" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    tsunami_lab::configs::OutputConfig l_outputConfig(l_outputBuffers,
+                                                      l_dropFrames,
+                                                      l_useNetCdf4,
+                                                      l_chunkX,
+                                                      l_chunkY,
+                                                      l_compression,
+                                                      l_compressionLevel,
+                                                      l_shuffle,
+                                                      l_errorBound,
+                                                      l_snapshotWriters);
+
     // set bathymetry and displacements file names
     std::string l_bathymetryFileName, l_displacementsFileName;
     if (l_configFile.contains("bathymetryFileName")) {
@@ -205,37 +420,22 @@ tsunami_lab::t_idx tsunami_lab::io::ConfigLoader::loadConfig(std::string i_confi
 
     // check if checkpoint exists
     std::string l_configName = i_configName.substr(0, i_configName.find_last_of("."));
-    std::string l_checkPointPath = "out/" + l_configName + "_checkpoint.nc";
+    std::string l_checkPointPath = "out/" + l_configName + "_checkpoint.bin";
     std::ifstream f(l_checkPointPath.c_str());
     t_idx l_startFrame = 0;
     if (i_flagConfig.useCheckPoint() && f.good()) {
-        std::cout << "Reading out/" + l_configName + "_checkpoint.nc" << std::endl;
-        t_real *l_height;
-        t_real *l_momentumX;
-        t_real *l_momentumY;
-        t_real *l_bathymetry;
-        t_real *l_time;
-        t_real l_endSimTime;
-        tsunami_lab::io::NetCDF::readCheckpoint(l_checkPointPath,
-                                                l_height,
-                                                l_momentumX,
-                                                l_momentumY,
-                                                l_bathymetry,
-                                                l_time,
-                                                &l_startFrame,
-                                                &l_endSimTime,
-                                                &l_startSimTime);
+        std::cout << "Reading " + l_checkPointPath << std::endl;
+        tsunami_lab::io::BinaryCheckPoint *l_checkPoint = new tsunami_lab::io::BinaryCheckPoint();
+        if (l_checkPoint->map(l_checkPointPath, l_nx, l_ny) != 0) {
+            delete l_checkPoint;
+            return EXIT_FAILURE;
+        }
+        l_startFrame = l_checkPoint->getFrame();
+        l_startSimTime = l_checkPoint->getSimTime();
 
         o_setup = new tsunami_lab::setups::CheckPoint(l_xLen,
                                                       l_yLen,
-                                                      l_nx,
-                                                      l_ny,
-                                                      l_startFrame,
-                                                      l_height,
-                                                      l_momentumX,
-                                                      l_momentumY,
-                                                      l_bathymetry,
-                                                      l_time);
+                                                      l_checkPoint);
     } else if (l_setupName.compare("DamBreak") == 0) {
         if (l_dimension == 1) {
             o_setup = new tsunami_lab::setups::DamBreak1d(10, 5, 5);
@@ -413,7 +613,14 @@ tsunami_lab::t_idx tsunami_lab::io::ConfigLoader::loadConfig(std::string i_confi
                                                   l_startFrame,
                                                   l_coarseFactor,
                                                   l_boundaryCond,
-                                                  l_useRoeSolver);
+                                                  l_useRoeSolver,
+                                                  l_tileRows,
+                                                  l_cflNumber,
+                                                  l_frameTime,
+                                                  l_useActiveTiles,
+                                                  l_amrConfig,
+                                                  l_outputConfig,
+                                                  l_threadAffinity);
 
     return 0;
 }
\ No newline at end of file
@@ -9,10 +9,23 @@
 
 #include "NetCDF.h"
 
+#include <netcdf_filter.h>
 #include <omp.h>
+#include <sys/stat.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <vector>
+
+#include "../../kernels/Kernels.h"
+
+// id of the zstandard filter registered with HDF5, defined by recent versions of netcdf_filter.h
+#ifndef H5Z_FILTER_ZSTD
+#define H5Z_FILTER_ZSTD 32015
+#endif
 
 int tsunami_lab::io::NetCDF::read(std::string i_nameBathymetry,
                                   std::string i_nameDisplacements,
@@ -177,22 +190,14 @@ int tsunami_lab::io::NetCDF::read(std::string i_nameBathymetry,
     return 0;
 }
 
-int tsunami_lab::io::NetCDF::init(t_idx i_currentFrame, bool i_isCeckPoint) {
-    int l_nc_err = 0;
-
+int tsunami_lab::io::NetCDF::init(int i_ncId) {
     // define dimensions
-    if (i_isCeckPoint) {
-        l_nc_err = nc_def_dim(m_ncId, "x", m_nx, &m_dimXId);
-        l_nc_err += nc_def_dim(m_ncId, "y", m_ny, &m_dimYId);
-    } else {
-        l_nc_err = nc_def_dim(m_ncId, "x", m_nxCoarse, &m_dimXId);
-        l_nc_err += nc_def_dim(m_ncId, "y", m_nyCoarse, &m_dimYId);
-    }
-
-    l_nc_err += nc_def_dim(m_ncId, "time", i_currentFrame, &m_dimTimeId);
-    l_nc_err += nc_def_dim(m_ncId, "simTime", 1, &m_dimSimTimeId);
-    l_nc_err += nc_def_dim(m_ncId, "endTime", 1, &m_dimEndTimeId);
-    l_nc_err += nc_def_dim(m_ncId, "frame", 1, &m_dimFrameId);
+    int l_nc_err = nc_def_dim(i_ncId, "x", m_nxCoarse, &m_dimXId);
+    l_nc_err += nc_def_dim(i_ncId, "y", m_nyCoarse, &m_dimYId);
+    l_nc_err += nc_def_dim(i_ncId, "time", NC_UNLIMITED, &m_dimTimeId);
+    l_nc_err += nc_def_dim(i_ncId, "simTime", 1, &m_dimSimTimeId);
+    l_nc_err += nc_def_dim(i_ncId, "endTime", 1, &m_dimEndTimeId);
+    l_nc_err += nc_def_dim(i_ncId, "frame", 1, &m_dimFrameId);
 
     if (l_nc_err != NC_NOERR) {
         std::cerr << "NCError: Define dimensions." << std::endl;
@@ -200,38 +205,53 @@ int tsunami_lab::io::NetCDF::init(t_idx i_currentFrame, bool i_isCeckPoint) {
     }
 
     // define variables
-    l_nc_err = nc_def_var(m_ncId, "x", NC_FLOAT, 1, &m_dimXId, &m_varXId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varXId, "units", 6, "meters");
-    l_nc_err += nc_put_att_text(m_ncId, m_varXId, "axis", 1, "X");
+    l_nc_err = nc_def_var(i_ncId, "x", NC_FLOAT, 1, &m_dimXId, &m_varXId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varXId, "units", 6, "meters");
+    l_nc_err += nc_put_att_text(i_ncId, m_varXId, "axis", 1, "X");
 
-    l_nc_err += nc_def_var(m_ncId, "y", NC_FLOAT, 1, &m_dimYId, &m_varYId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varYId, "units", 6, "meters");
-    l_nc_err += nc_put_att_text(m_ncId, m_varXId, "axis", 1, "Y");
+    l_nc_err += nc_def_var(i_ncId, "y", NC_FLOAT, 1, &m_dimYId, &m_varYId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varYId, "units", 6, "meters");
+    l_nc_err += nc_put_att_text(i_ncId, m_varXId, "axis", 1, "Y");
 
-    l_nc_err += nc_def_var(m_ncId, "time", NC_FLOAT, 1, &m_dimTimeId, &m_varTimeId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varTimeId, "units", 7, "seconds");
+    l_nc_err += nc_def_var(i_ncId, "time", NC_FLOAT, 1, &m_dimTimeId, &m_varTimeId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varTimeId, "units", 7, "seconds");
 
     int l_dimBathymetryIds[2] = {m_dimYId, m_dimXId};
-    l_nc_err += nc_def_var(m_ncId, "bathymetry", NC_FLOAT, 2, l_dimBathymetryIds, &m_varBathymetryId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varBathymetryId, "units", 6, "meters");
+    l_nc_err += nc_def_var(i_ncId, "bathymetry", NC_FLOAT, 2, l_dimBathymetryIds, &m_varBathymetryId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varBathymetryId, "units", 6, "meters");
 
     int l_dimHeightIds[3] = {m_dimTimeId, m_dimYId, m_dimXId};
-    l_nc_err += nc_def_var(m_ncId, "height", NC_FLOAT, 3, l_dimHeightIds, &m_varHeightId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varHeightId, "units", 6, "meters");
+    l_nc_err += nc_def_var(i_ncId, "height", NC_FLOAT, 3, l_dimHeightIds, &m_varHeightId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varHeightId, "units", 6, "meters");
 
     int l_dimMomentumXIds[3] = {m_dimTimeId, m_dimYId, m_dimXId};
-    l_nc_err += nc_def_var(m_ncId, "momentum_x", NC_FLOAT, 3, l_dimMomentumXIds, &m_varMomentumXId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varMomentumXId, "units", 11, "meters*kg/s");
+    l_nc_err += nc_def_var(i_ncId, "momentum_x", NC_FLOAT, 3, l_dimMomentumXIds, &m_varMomentumXId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varMomentumXId, "units", 11, "meters*kg/s");
 
     int l_dimMomentumYIds[3] = {m_dimTimeId, m_dimYId, m_dimXId};
-    l_nc_err += nc_def_var(m_ncId, "momentum_y", NC_FLOAT, 3, l_dimMomentumYIds, &m_varMomentumYId);
-    l_nc_err += nc_put_att_text(m_ncId, m_varMomentumYId, "units", 11, "meters*kg/s");
+    l_nc_err += nc_def_var(i_ncId, "momentum_y", NC_FLOAT, 3, l_dimMomentumYIds, &m_varMomentumYId);
+    l_nc_err += nc_put_att_text(i_ncId, m_varMomentumYId, "units", 11, "meters*kg/s");
 
-    l_nc_err += nc_def_var(m_ncId, "simTime", NC_FLOAT, 1, &m_dimSimTimeId, &m_varSimTimeId);
-    l_nc_err += nc_def_var(m_ncId, "endTime", NC_FLOAT, 1, &m_dimEndTimeId, &m_varEndTimeId);
-    l_nc_err += nc_def_var(m_ncId, "frame", NC_FLOAT, 1, &m_dimFrameId, &m_varFrameId);
+    // the lossy fields document their precision
+    t_real l_errorBound = m_outputConfig.getErrorBound();
+    if (l_errorBound > 0) {
+        l_nc_err += nc_put_att_float(i_ncId, m_varHeightId, "quantization_error", NC_FLOAT, 1, &l_errorBound);
+        l_nc_err += nc_put_att_float(i_ncId, m_varMomentumXId, "quantization_error", NC_FLOAT, 1, &l_errorBound);
+        l_nc_err += nc_put_att_float(i_ncId, m_varMomentumYId, "quantization_error", NC_FLOAT, 1, &l_errorBound);
+    }
 
-    l_nc_err += nc_enddef(m_ncId);
+    if (m_outputConfig.useNetCdf4()) {
+        l_nc_err += defineStorage(i_ncId, m_varBathymetryId, false);
+        l_nc_err += defineStorage(i_ncId, m_varHeightId, true);
+        l_nc_err += defineStorage(i_ncId, m_varMomentumXId, true);
+        l_nc_err += defineStorage(i_ncId, m_varMomentumYId, true);
+    }
+
+    l_nc_err += nc_def_var(i_ncId, "simTime", NC_FLOAT, 1, &m_dimSimTimeId, &m_varSimTimeId);
+    l_nc_err += nc_def_var(i_ncId, "endTime", NC_FLOAT, 1, &m_dimEndTimeId, &m_varEndTimeId);
+    l_nc_err += nc_def_var(i_ncId, "frame", NC_FLOAT, 1, &m_dimFrameId, &m_varFrameId);
+
+    l_nc_err += nc_enddef(i_ncId);
     if (l_nc_err != NC_NOERR) {
         std::cerr << "NCError: Define variables." << std::endl;
         return 1;
@@ -240,267 +260,315 @@ int tsunami_lab::io::NetCDF::init(t_idx i_currentFrame, bool i_isCeckPoint) {
     return NC_NOERR;
 }
 
-int tsunami_lab::io::NetCDF::store(t_real i_simTime,
-                                   t_idx i_frame,
-                                   t_real const *i_h,
-                                   t_real const *i_hu,
-                                   t_real const *i_hv) {
-    m_time[i_frame] = i_simTime;
+int tsunami_lab::io::NetCDF::defineStorage(int i_ncId, int i_varId, bool i_hasTime) {
+    // chunks span the entire frame unless configured otherwise; the library requires at least one cell per chunk
+    t_idx l_chunkX = m_outputConfig.getChunkX() == 0 ? m_nxCoarse : std::min(m_outputConfig.getChunkX(), m_nxCoarse);
+    t_idx l_chunkY = m_outputConfig.getChunkY() == 0 ? m_nyCoarse : std::min(m_outputConfig.getChunkY(), m_nyCoarse);
+    std::size_t l_chunks[3] = {1, std::max<t_idx>(l_chunkY, 1), std::max<t_idx>(l_chunkX, 1)};
 
-    for (t_idx l_iy = 0; l_iy < m_ny; l_iy++) {
-        for (t_idx l_ix = 0; l_ix < m_nx; l_ix++) {
-            t_real l_h = i_h[(l_iy + 1) * m_stride + (l_ix + 1)];
-            // t_real l_b = m_dataB[l_iy * m_nx + l_ix];
-            m_height[l_ix + l_iy * m_nx + m_nxy * i_frame] = l_h;
-            m_momentumX[l_ix + l_iy * m_nx + m_nxy * i_frame] = i_hu[(l_iy + 1) * m_stride + (l_ix + 1)];
-            m_momentumY[l_ix + l_iy * m_nx + m_nxy * i_frame] = i_hv[(l_iy + 1) * m_stride + (l_ix + 1)];
-        }
+    int l_nc_err = nc_def_var_chunking(i_ncId, i_varId, NC_CHUNKED, i_hasTime ? l_chunks : l_chunks + 1);
+
+    int l_shuffle = m_outputConfig.useShuffle() ? 1 : 0;
+    if (m_outputConfig.getCompression() == tsunami_lab::configs::DEFLATE) {
+        l_nc_err += nc_def_var_deflate(i_ncId, i_varId, l_shuffle, 1, m_outputConfig.getCompressionLevel());
+    } else if (m_outputConfig.getCompression() == tsunami_lab::configs::ZSTD) {
+        // the shuffle filter runs before zstandard, since HDF5 applies the filters in the order of their definition
+        unsigned int l_level = m_outputConfig.getCompressionLevel();
+        if (l_shuffle) l_nc_err += nc_def_var_deflate(i_ncId, i_varId, l_shuffle, 0, 0);
+        l_nc_err += nc_def_var_filter(i_ncId, i_varId, H5Z_FILTER_ZSTD, 1, &l_level);
     }
 
-    return 0;
+    if (l_nc_err != NC_NOERR) {
+        std::cerr << "NCError: Define chunks and compression." << std::endl;
+        return 1;
+    }
+
+    return NC_NOERR;
 }
 
-int tsunami_lab::io::NetCDF::write(t_idx i_currentFrame,
-                                   std::string i_checkPointPath = "",
-                                   t_real i_simTime = -1,
-                                   t_real i_endTime = -1) {
-    int l_nc_err = 0;
-
-    // create netCDF file
-    std::string l_outFileName;
-    if (i_checkPointPath.compare("") != 0) {
-        l_outFileName = i_checkPointPath;
-    } else {
-        l_outFileName = m_outFileName;
-    }
-    std::cout << l_outFileName << std::endl;
-    l_nc_err += nc_create((l_outFileName).c_str(), NC_CLOBBER, &m_ncId);
+int tsunami_lab::io::NetCDF::create() {
+    std::cout << m_outFileName << std::endl;
+    int l_mode = m_outputConfig.useNetCdf4() ? NC_CLOBBER | NC_NETCDF4 : NC_CLOBBER;
+    int l_nc_err = nc_create(m_outFileName.c_str(), l_mode, &m_ncId);
     if (l_nc_err != NC_NOERR) {
         std::cerr << "NCError: Create file." << std::endl;
+        m_ncId = -1;
         return 1;
     }
 
-    // define dims and vars
-    init(i_currentFrame, (i_checkPointPath.compare("") != 0));
+    // the zstandard filter is an optional plugin of HDF5
+    if (m_outputConfig.getCompression() == tsunami_lab::configs::ZSTD && nc_inq_filter_avail(m_ncId, H5Z_FILTER_ZSTD) != NC_NOERR) {
+        std::cout << "zstd filter is not available, falling back to deflate" << std::endl;
+        m_outputConfig.setCompression(tsunami_lab::configs::DEFLATE, std::min(m_outputConfig.getCompressionLevel(), 9));
+    }
 
-    // write data
-    if (i_checkPointPath.compare("") != 0) {
-        l_nc_err = nc_put_var_float(m_ncId, m_varXId, m_dataX);
-        l_nc_err += nc_put_var_float(m_ncId, m_varYId, m_dataY);
-        l_nc_err += nc_put_var_float(m_ncId, m_varBathymetryId, m_dataB);
-        l_nc_err += nc_put_var_float(m_ncId, m_varTimeId, m_time);
-        l_nc_err += nc_put_var_float(m_ncId, m_varHeightId, m_height);
-        l_nc_err += nc_put_var_float(m_ncId, m_varMomentumXId, m_momentumX);
-        l_nc_err += nc_put_var_float(m_ncId, m_varMomentumYId, m_momentumY);
-    } else {
-        // coarse output
-        t_real *l_dataX = new tsunami_lab::t_real[m_nxCoarse];
-#pragma omp parallel for schedule(static, 16)
-        for (t_idx l_idx = 0; l_idx < m_nxCoarse; l_idx++) {
-            t_idx l_ix = m_coarseFactor - 1 + (l_idx * m_coarseFactor);
-            l_dataX[l_idx] = m_dataX[l_ix];
-        }
-        l_nc_err = nc_put_var_float(m_ncId, m_varXId, l_dataX);
-        delete[] l_dataX;
+    // frames are appended along the unlimited time dimension
+    if (init(m_ncId) != NC_NOERR) {
+        nc_close(m_ncId);
+        m_ncId = -1;
+        return 1;
+    }
 
-        t_real *l_dataY = new tsunami_lab::t_real[m_nyCoarse];
+    // coarse coordinates
+    t_real *l_dataX = new tsunami_lab::t_real[m_nxCoarse];
 #pragma omp parallel for schedule(static, 16)
-        for (t_idx l_idx = 0; l_idx < m_nyCoarse; l_idx++) {
-            t_idx l_iy = m_coarseFactor - 1 + (l_idx * m_coarseFactor);
-            l_dataY[l_idx] = m_dataY[l_iy];
-        }
-        l_nc_err += nc_put_var_float(m_ncId, m_varYId, l_dataY);
-        delete[] l_dataY;
-
-        t_real *l_dataB = new tsunami_lab::t_real[m_nxyCoarse];
-#pragma omp parallel for schedule(static, 8)
-        for (t_idx l_idx = 0; l_idx < m_nxyCoarse; l_idx++) {
-            t_idx l_ix = m_coarseFactor * (l_idx % m_nxCoarse) + m_coarseFactor - 1;
-            t_idx l_iy = m_coarseFactor * (t_idx)std::floor(l_idx / m_nxCoarse) + m_coarseFactor - 1;
-            // average over neighbors
-            l_dataB[l_idx] = m_dataB[l_iy * m_nx + l_ix];
-            t_idx l_neighborCount = 1;
-            if (m_coarseFactor != 1) {
-                for (int l_offsetY = -(m_coarseFactor - 1); l_offsetY < (int)m_coarseFactor; l_offsetY++) {
-                    for (int l_offsetX = -(m_coarseFactor - 1); l_offsetX < (int)m_coarseFactor; l_offsetX++) {
-                        int l_idxX = l_ix + l_offsetX;
-                        int l_idxY = l_iy + l_offsetY;
-                        if (tsunami_lab::io::NetCDF::isInBounds(l_idxX, l_idxY)) {
-                            l_dataB[l_idx] += m_dataB[l_idxY * m_nx + l_idxX];
-                            l_neighborCount++;
-                        }
-                    }
-                }
-            }
-            l_dataB[l_idx] /= l_neighborCount;
-        }
-        l_nc_err += nc_put_var_float(m_ncId, m_varBathymetryId, l_dataB);
-        delete[] l_dataB;
+    for (t_idx l_idx = 0; l_idx < m_nxCoarse; l_idx++) {
+        t_idx l_ix = m_coarseFactor - 1 + (l_idx * m_coarseFactor);
+        l_dataX[l_idx] = m_dataX[l_ix];
+    }
+    l_nc_err = nc_put_var_float(m_ncId, m_varXId, l_dataX);
+    delete[] l_dataX;
 
-        t_real *l_height = new tsunami_lab::t_real[m_nxyCoarse * m_frameCount];
-        t_real *l_momentumX = new tsunami_lab::t_real[m_nxyCoarse * m_frameCount];
-        t_real *l_momentumY = new tsunami_lab::t_real[m_nxyCoarse * m_frameCount];
+    t_real *l_dataY = new tsunami_lab::t_real[m_nyCoarse];
 #pragma omp parallel for schedule(static, 16)
-        for (t_idx l_idx = 0; l_idx < m_nxyCoarse * m_frameCount; l_idx++) {
-            // average over neighbors
-            t_idx l_frame = std::floor(l_idx / m_nxyCoarse);
-            t_idx l_ix = m_coarseFactor * (l_idx % m_nxCoarse) + m_coarseFactor - 1;
-            t_idx l_iy = m_coarseFactor * (t_idx)std::floor((l_idx % m_nxyCoarse) / m_nxCoarse) + m_coarseFactor - 1;
-            t_idx l_framedIdx = (l_iy * m_nx + l_ix) + m_nxy * l_frame;
-            l_height[l_idx] = m_height[l_framedIdx];
-            l_momentumX[l_idx] = m_momentumX[l_framedIdx];
-            l_momentumY[l_idx] = m_momentumY[l_framedIdx];
-            t_idx l_neighborCount = 1;
-            if (m_coarseFactor != 1) {
-                for (int l_offsetY = -(m_coarseFactor - 1); l_offsetY < (int)m_coarseFactor; l_offsetY++) {
-                    for (int l_offsetX = -(m_coarseFactor - 1); l_offsetX < (int)m_coarseFactor; l_offsetX++) {
-                        int l_idxX = l_ix + l_offsetX;
-                        int l_idxY = l_iy + l_offsetY;
-                        if (tsunami_lab::io::NetCDF::isInBounds(l_idxX, l_idxY)) {
-                            t_idx l_framedIdxOffset = (l_idxY * m_nx + l_idxX) + m_nxy * l_frame;
-                            l_height[l_idx] += m_height[l_framedIdxOffset];
-                            l_momentumX[l_idx] += m_momentumX[l_framedIdxOffset];
-                            l_momentumY[l_idx] += m_momentumY[l_framedIdxOffset];
-                            l_neighborCount++;
-                        }
-                    }
-                }
-            }
-            l_height[l_idx] /= l_neighborCount;
-            l_momentumX[l_idx] /= l_neighborCount;
-            l_momentumY[l_idx] /= l_neighborCount;
-        }
-        l_nc_err += nc_put_var_float(m_ncId, m_varHeightId, l_height);
-        l_nc_err += nc_put_var_float(m_ncId, m_varMomentumXId, l_momentumX);
-        l_nc_err += nc_put_var_float(m_ncId, m_varMomentumYId, l_momentumY);
-        delete[] l_height;
-        delete[] l_momentumX;
-        delete[] l_momentumY;
+    for (t_idx l_idx = 0; l_idx < m_nyCoarse; l_idx++) {
+        t_idx l_iy = m_coarseFactor - 1 + (l_idx * m_coarseFactor);
+        l_dataY[l_idx] = m_dataY[l_iy];
     }
+    l_nc_err += nc_put_var_float(m_ncId, m_varYId, l_dataY);
+    delete[] l_dataY;
 
-    l_nc_err += nc_put_var_float(m_ncId, m_varTimeId, m_time);
+    // the coarse frame buffer holds the bathymetry until the first frame arrives
+    coarsen(m_dataB, m_nx, m_heightCoarse);
+    l_nc_err += nc_put_var_float(m_ncId, m_varBathymetryId, m_heightCoarse);
 
-    l_nc_err += nc_put_var_float(m_ncId, m_varSimTimeId, &i_simTime);
-    l_nc_err += nc_put_var_float(m_ncId, m_varEndTimeId, &i_endTime);
-    unsigned long long l_currentFrame = i_currentFrame;
-    l_nc_err += nc_put_var_ulonglong(m_ncId, m_varFrameId, &l_currentFrame);
+    l_nc_err += nc_sync(m_ncId);
+    m_rawBytes += (m_nxCoarse + m_nyCoarse + m_nxyCoarse) * sizeof(float);
     if (l_nc_err != NC_NOERR) {
-        std::cerr << "NCError: Put variables." << std::endl;
+        std::cerr << "NCError: Put coordinates and bathymetry." << std::endl;
         return 1;
     }
 
-    l_nc_err = nc_close(m_ncId);
+    return NC_NOERR;
+}
+
+int tsunami_lab::io::NetCDF::open(t_real i_startTime) {
+    int l_nc_err = nc_open(m_outFileName.c_str(), NC_WRITE, &m_ncId);
     if (l_nc_err != NC_NOERR) {
-        std::cerr << "NCError: Close file." << std::endl;
+        m_ncId = -1;
         return 1;
     }
 
+    l_nc_err = nc_inq_dimid(m_ncId, "x", &m_dimXId);
+    l_nc_err += nc_inq_dimid(m_ncId, "y", &m_dimYId);
+    l_nc_err += nc_inq_dimid(m_ncId, "time", &m_dimTimeId);
+    std::size_t l_nxCoarse = 0, l_nyCoarse = 0;
+    l_nc_err += nc_inq_dimlen(m_ncId, m_dimXId, &l_nxCoarse);
+    l_nc_err += nc_inq_dimlen(m_ncId, m_dimYId, &l_nyCoarse);
+
+    l_nc_err += nc_inq_varid(m_ncId, "time", &m_varTimeId);
+    l_nc_err += nc_inq_varid(m_ncId, "height", &m_varHeightId);
+    l_nc_err += nc_inq_varid(m_ncId, "momentum_x", &m_varMomentumXId);
+    l_nc_err += nc_inq_varid(m_ncId, "momentum_y", &m_varMomentumYId);
+    l_nc_err += nc_inq_varid(m_ncId, "simTime", &m_varSimTimeId);
+    l_nc_err += nc_inq_varid(m_ncId, "endTime", &m_varEndTimeId);
+    l_nc_err += nc_inq_varid(m_ncId, "frame", &m_varFrameId);
+
+    // the output of the earlier run has to match the coarse grid of this one
+    if (l_nc_err != NC_NOERR || l_nxCoarse != m_nxCoarse || l_nyCoarse != m_nyCoarse) {
+        nc_close(m_ncId);
+        m_ncId = -1;
+        return 1;
+    }
+
+    // frames after the start time are overwritten, since they were written after the checkpoint
+    std::size_t l_nRecords = 0;
+    l_nc_err = nc_inq_dimlen(m_ncId, m_dimTimeId, &l_nRecords);
+    std::vector<float> l_times(l_nRecords);
+    if (l_nc_err == NC_NOERR && l_nRecords > 0) l_nc_err = nc_get_var_float(m_ncId, m_varTimeId, l_times.data());
+    if (l_nc_err != NC_NOERR) {
+        nc_close(m_ncId);
+        m_ncId = -1;
+        return 1;
+    }
+    m_framesWritten = 0;
+    while (m_framesWritten < l_nRecords && l_times[m_framesWritten] <= i_startTime) m_framesWritten++;
+
     return NC_NOERR;
 }
 
-int tsunami_lab::io::NetCDF::write() {
-    return write(m_frameCount);
-}
+void tsunami_lab::io::NetCDF::coarsen(t_real const *i_data,
+                                      t_idx i_stride,
+                                      t_real *o_coarse) {
+    if (m_coarseFactor == 1) {
+#pragma omp parallel for schedule(static)
+        for (t_idx l_iy = 0; l_iy < m_ny; l_iy++) {
+            for (t_idx l_ix = 0; l_ix < m_nx; l_ix++) {
+                o_coarse[l_iy * m_nx + l_ix] = i_data[l_iy * i_stride + l_ix];
+            }
+        }
+        return;
+    }
+
+    if (m_nxyCoarse == 0) return;
+
+    // coarse cell c averages the cells f * c to f * c + 2f - 2 in each direction (clipped to the domain) and
+    // counts the cell f * c + f - 1 twice
+    t_idx l_window = 2 * m_coarseFactor - 1;
+    t_idx l_nxUsed = std::min(m_nx, m_coarseFactor * (m_nxCoarse - 1) + l_window);
+    kernels::t_addRow l_addRow = kernels::getKernels().addRow;
+
+#pragma omp parallel
+    {
+        // sums over the rows of the window and their prefix sums along x; doubles keep the differences exact
+        std::vector<double> l_colSum(l_nxUsed);
+        std::vector<double> l_prefix(l_nxUsed + 1);
+
+#pragma omp for schedule(static)
+        for (t_idx l_cy = 0; l_cy < m_nyCoarse; l_cy++) {
+            t_idx l_yFirst = m_coarseFactor * l_cy;
+            t_idx l_yLast = std::min(l_yFirst + l_window, m_ny) - 1;
+
+            for (t_idx l_ix = 0; l_ix < l_nxUsed; l_ix++) {
+                l_colSum[l_ix] = 0;
+            }
+            for (t_idx l_iy = l_yFirst; l_iy <= l_yLast; l_iy++) {
+                l_addRow(l_nxUsed, i_data + l_iy * i_stride, l_colSum.data());
+            }
+
+            l_prefix[0] = 0;
+            for (t_idx l_ix = 0; l_ix < l_nxUsed; l_ix++) {
+                l_prefix[l_ix + 1] = l_prefix[l_ix] + l_colSum[l_ix];
+            }
+
+            // every coarse cell is the difference of two prefix sums
+            t_idx l_yCenter = l_yFirst + m_coarseFactor - 1;
+            for (t_idx l_cx = 0; l_cx < m_nxCoarse; l_cx++) {
+                t_idx l_xFirst = m_coarseFactor * l_cx;
+                t_idx l_xLast = std::min(l_xFirst + l_window, m_nx) - 1;
+                t_idx l_xCenter = l_xFirst + m_coarseFactor - 1;
+
+                double l_sum = l_prefix[l_xLast + 1] - l_prefix[l_xFirst] + i_data[l_yCenter * i_stride + l_xCenter];
+                t_idx l_count = (l_xLast - l_xFirst + 1) * (l_yLast - l_yFirst + 1) + 1;
 
-bool tsunami_lab::io::NetCDF::isInBounds(int i_x, int i_y) {
-    if (i_x < 0 || i_x >= (int)m_nx) {
-        return false;
+                o_coarse[l_cy * m_nxCoarse + l_cx] = l_sum / l_count;
+            }
+        }
     }
-    if (i_y < 0 || i_y >= (int)m_ny) {
-        return false;
+}
+
+void tsunami_lab::io::NetCDF::quantize(t_real *io_data,
+                                       t_idx i_size,
+                                       t_real i_errorBound) {
+    // largest power of two not above the bound
+    int l_boundExp = std::floor(std::log2(i_errorBound));
+
+#pragma omp parallel for schedule(static)
+    for (t_idx l_i = 0; l_i < i_size; l_i++) {
+        float l_value = io_data[l_i];
+        if (std::abs(l_value) <= i_errorBound) {
+            io_data[l_i] = 0;
+            continue;
+        }
+
+        std::uint32_t l_bits;
+        std::memcpy(&l_bits, &l_value, sizeof(float));
+        int l_biasedExp = (l_bits >> 23) & 0xff;
+        if (l_biasedExp == 0xff) continue;
+
+        // rounding to the kept bits changes the value by at most half of their last place, i.e. 2^(e - kept - 1)
+        int l_kept = std::max(l_biasedExp - 127 - 1 - l_boundExp, 0);
+        if (l_kept >= 23) continue;
+
+        int l_dropped = 23 - l_kept;
+        l_bits += std::uint32_t(1) << (l_dropped - 1);
+        l_bits &= ~((std::uint32_t(1) << l_dropped) - 1);
+        std::memcpy(&l_value, &l_bits, sizeof(float));
+        io_data[l_i] = l_value;
     }
-    return true;
 }
 
-int tsunami_lab::io::NetCDF::readCheckpoint(std::string i_checkPoinPath,
-                                            t_real *&o_height,
-                                            t_real *&o_momentumX,
-                                            t_real *&o_momentumY,
-                                            t_real *&o_bathymetry,
-                                            t_real *&o_time,
-                                            t_idx *o_currentFrame,
-                                            t_real *o_endSimTime,
-                                            t_real *o_startSimTime) {
-    int l_ncID;
-    // open checkpoint file
-    int l_nc_err = nc_open(i_checkPoinPath.c_str(), 0, &l_ncID);
-    if (l_nc_err != NC_NOERR) {
-        std::cerr << "Could not open file: " << i_checkPoinPath << std::endl;
+int tsunami_lab::io::NetCDF::store(t_real i_simTime,
+                                   t_idx i_frame,
+                                   t_real const *i_h,
+                                   t_real const *i_hu,
+                                   t_real const *i_hv) {
+    if (m_ncId < 0) {
+        std::cerr << "NCError: Output file is not open." << std::endl;
         return 1;
     }
 
-    // get dimensions
-    std::size_t l_xDim, l_yDim, l_timeDim;
-    std::size_t l_simTimeDim, l_endTimeDim, l_frameDim;
+    // coarse frame starting at the first inner cell
+    coarsen(i_h + m_stride + 1, m_stride, m_heightCoarse);
+    coarsen(i_hu + m_stride + 1, m_stride, m_momentumXCoarse);
+    coarsen(i_hv + m_stride + 1, m_stride, m_momentumYCoarse);
+
+    if (m_outputConfig.getErrorBound() > 0) {
+        quantize(m_heightCoarse, m_nxyCoarse, m_outputConfig.getErrorBound());
+        quantize(m_momentumXCoarse, m_nxyCoarse, m_outputConfig.getErrorBound());
+        quantize(m_momentumYCoarse, m_nxyCoarse, m_outputConfig.getErrorBound());
+    }
 
-    l_nc_err = nc_inq_dimlen(l_ncID, 0, &l_xDim);
-    l_nc_err += nc_inq_dimlen(l_ncID, 1, &l_yDim);
-    l_nc_err += nc_inq_dimlen(l_ncID, 2, &l_timeDim);
+    // append the frame as the next record of the time dimension; dropped frames leave no gaps
+    std::size_t l_startTime[1] = {m_framesWritten};
+    std::size_t l_countTime[1] = {1};
+    std::size_t l_start[3] = {m_framesWritten, 0, 0};
+    std::size_t l_count[3] = {1, m_nyCoarse, m_nxCoarse};
 
-    l_nc_err += nc_inq_dimlen(l_ncID, 3, &l_simTimeDim);
-    l_nc_err += nc_inq_dimlen(l_ncID, 4, &l_endTimeDim);
-    l_nc_err += nc_inq_dimlen(l_ncID, 5, &l_frameDim);
+    std::chrono::steady_clock::time_point l_writeStart = std::chrono::steady_clock::now();
+    int l_nc_err = nc_put_vara_float(m_ncId, m_varTimeId, l_startTime, l_countTime, &i_simTime);
+    l_nc_err += nc_put_vara_float(m_ncId, m_varHeightId, l_start, l_count, m_heightCoarse);
+    l_nc_err += nc_put_vara_float(m_ncId, m_varMomentumXId, l_start, l_count, m_momentumXCoarse);
+    l_nc_err += nc_put_vara_float(m_ncId, m_varMomentumYId, l_start, l_count, m_momentumYCoarse);
+
+    // a crashed run keeps all frames written so far
+    l_nc_err += nc_sync(m_ncId);
     if (l_nc_err != NC_NOERR) {
-        std::cerr << "NCError: Load Dimensions." << std::endl;
+        std::cerr << "NCError: Append frame " << i_frame << "." << std::endl;
         return 1;
     }
+    double l_writeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_writeStart).count();
+    m_writeTime += l_writeTime;
+    m_maxFrameWriteTime = std::max(m_maxFrameWriteTime, l_writeTime);
+    m_rawBytes += (3 * m_nxyCoarse + 1) * sizeof(float);
+    m_framesWritten++;
 
-    std::cout << "timedim: " << l_timeDim << std::endl;
-    std::cout << l_xDim << " | " << l_yDim << " | " << l_timeDim << std::endl;
+    return NC_NOERR;
+}
 
-    o_time = new tsunami_lab::t_real[l_timeDim];
-    o_height = new tsunami_lab::t_real[l_xDim * l_yDim * l_timeDim];
-    o_momentumX = new tsunami_lab::t_real[l_xDim * l_yDim * l_timeDim];
-    o_momentumY = new tsunami_lab::t_real[l_xDim * l_yDim * l_timeDim];
-    o_bathymetry = new tsunami_lab::t_real[l_xDim * l_yDim];
+int tsunami_lab::io::NetCDF::write() {
+    if (m_ncId < 0) {
+        std::cerr << "NCError: Output file is not open." << std::endl;
+        return 1;
+    }
 
-    // get variable ids
-    int l_varIDtime, l_varIDheight, l_varIDmomentumX, l_varIDmomentumY, l_varIDbathymetry;
-    int l_varIDsimTime, l_varIDendTime, l_varIDframe;
-
-    l_nc_err += nc_inq_varid(l_ncID, "time", &l_varIDtime);
-    l_nc_err += nc_inq_varid(l_ncID, "height", &l_varIDheight);
-    l_nc_err += nc_inq_varid(l_ncID, "momentum_x", &l_varIDmomentumX);
-    l_nc_err += nc_inq_varid(l_ncID, "momentum_y", &l_varIDmomentumY);
-    l_nc_err += nc_inq_varid(l_ncID, "bathymetry", &l_varIDbathymetry);
-
-    l_nc_err += nc_inq_varid(l_ncID, "simTime", &l_varIDsimTime);
-    l_nc_err += nc_inq_varid(l_ncID, "endTime", &l_varIDendTime);
-    l_nc_err += nc_inq_varid(l_ncID, "frame", &l_varIDframe);
+    t_real l_simTime = -1;
+    t_real l_endTime = -1;
+    int l_nc_err = nc_put_var_float(m_ncId, m_varSimTimeId, &l_simTime);
+    l_nc_err += nc_put_var_float(m_ncId, m_varEndTimeId, &l_endTime);
+    unsigned long long l_currentFrame = m_framesWritten;
+    l_nc_err += nc_put_var_ulonglong(m_ncId, m_varFrameId, &l_currentFrame);
     if (l_nc_err != NC_NOERR) {
-        std::cerr << "NCError: Load Variable IDs" << std::endl;
+        std::cerr << "NCError: Put variables." << std::endl;
         return 1;
     }
 
-    l_nc_err = nc_get_var_float(l_ncID, l_varIDtime, o_time);
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDheight, o_height);
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDmomentumX, o_momentumX);
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDmomentumY, o_momentumY);
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDbathymetry, o_bathymetry);
-
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDsimTime, o_startSimTime);
-    l_nc_err += nc_get_var_float(l_ncID, l_varIDendTime, o_endSimTime);
-    unsigned long long l_currentFrame;
-    l_nc_err += nc_get_var_ulonglong(l_ncID, l_varIDframe, &l_currentFrame);
-    *o_currentFrame = (t_idx)l_currentFrame;
+    l_nc_err = nc_close(m_ncId);
+    m_ncId = -1;
     if (l_nc_err != NC_NOERR) {
-        std::cerr << "NCError: Load Data" << std::endl;
+        std::cerr << "NCError: Close file." << std::endl;
         return 1;
     }
 
-    return 0;
+    return NC_NOERR;
 }
 
-tsunami_lab::io::NetCDF::NetCDF(t_real i_endTime,
-                                t_real i_dt,
-                                t_idx i_timeStepsPerFrame,
-                                t_real i_dxy,
+tsunami_lab::t_idx tsunami_lab::io::NetCDF::getFileSize() {
+    struct stat l_stat;
+    if (stat(m_outFileName.c_str(), &l_stat) != 0) return 0;
+
+    return l_stat.st_size;
+}
+
+tsunami_lab::io::NetCDF::NetCDF(t_real i_dxy,
                                 t_idx i_nx,
                                 t_idx i_ny,
                                 t_idx i_stride,
                                 t_idx i_coarseFactor,
                                 t_real const *i_b,
-                                std::string i_outFileName) {
+                                std::string i_outFileName,
+                                t_real i_startTime,
+                                tsunami_lab::configs::OutputConfig i_outputConfig) : m_outputConfig(i_outputConfig) {
     m_dxy = i_dxy;
     m_nx = i_nx;
     m_ny = i_ny;
@@ -514,14 +582,14 @@ tsunami_lab::io::NetCDF::NetCDF(t_real i_endTime,
     m_nxyCoarse = m_nxCoarse * m_nyCoarse;
     m_stride = i_stride;
     m_outFileName = i_outFileName;
+    m_framesWritten = 0;
+    m_rawBytes = 0;
+    m_writeTime = 0;
+    m_maxFrameWriteTime = 0;
 
-    m_frameCount = ceil((i_endTime / i_dt) / i_timeStepsPerFrame);
-    m_dataSize = m_nxy * m_frameCount;
-
-    m_time = new t_real[m_frameCount];
-    m_height = new t_real[m_dataSize];
-    m_momentumX = new t_real[m_dataSize];
-    m_momentumY = new t_real[m_dataSize];
+    m_heightCoarse = new t_real[m_nxyCoarse];
+    m_momentumXCoarse = new t_real[m_nxyCoarse];
+    m_momentumYCoarse = new t_real[m_nxyCoarse];
 
     m_dataX = new t_real[m_nx];
     m_dataY = new t_real[m_ny];
@@ -538,14 +606,22 @@ tsunami_lab::io::NetCDF::NetCDF(t_real i_endTime,
             m_dataB[l_ix + l_iy * m_nx] = i_b[(l_iy + 1) * m_stride + (l_ix + 1)];
         }
     }
+
+    // a restarted run continues the output of the earlier one
+    if (i_startTime > 0) {
+        if (open(i_startTime) == NC_NOERR) return;
+        std::cerr << "NCError: Could not append to " << m_outFileName << ", creating it." << std::endl;
+    }
+    create();
 }
 
 tsunami_lab::io::NetCDF::~NetCDF() {
-    delete[] m_time;
+    // finish the output file of an interrupted run
+    if (m_ncId >= 0) nc_close(m_ncId);
 
-    delete[] m_height;
-    delete[] m_momentumX;
-    delete[] m_momentumY;
+    delete[] m_heightCoarse;
+    delete[] m_momentumXCoarse;
+    delete[] m_momentumYCoarse;
 
     delete[] m_dataX;
     delete[] m_dataY;
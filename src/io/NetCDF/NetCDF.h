@@ -16,6 +16,7 @@
 #include <cstring>
 #include <string>
 
+#include "../../configs/OutputConfig.h"
 #include "../../constants.h"
 
 namespace tsunami_lab {
@@ -28,42 +29,110 @@ class tsunami_lab::io::NetCDF {
    private:
     std::string m_outFileName;
 
-    t_real *m_time;
-    t_real *m_height, *m_momentumX, *m_momentumY;
+    //! full-resolution coordinates and bathymetry
     t_real *m_dataX, *m_dataY, *m_dataB;
 
+    //! coarse version of the current frame which is appended to the output file
+    t_real *m_heightCoarse, *m_momentumXCoarse, *m_momentumYCoarse;
+
     t_real m_dxy;
     t_idx m_nx, m_ny, m_nxCoarse, m_nyCoarse, m_nxy, m_nxyCoarse, m_stride;
-    t_idx m_frameCount, m_dataSize, m_coarseFactor;
+    t_idx m_coarseFactor;
+
+    //! number of frames in the output file
+    t_idx m_framesWritten;
 
     int m_varXId, m_varYId, m_varTimeId, m_varBathymetryId, m_varHeightId, m_varMomentumXId, m_varMomentumYId, m_varSimTimeId, m_varEndTimeId, m_varFrameId;
     int m_dimXId, m_dimYId, m_dimTimeId, m_dimSimTimeId, m_dimEndTimeId, m_dimFrameId;
+
+    //! id of the output file, -1 if it is not open
     int m_ncId;
 
-    int init(t_idx i_currentFrame, bool i_isCheckPoint);
+    //! format, chunks and compression of the output file
+    tsunami_lab::configs::OutputConfig m_outputConfig;
+
+    //! uncompressed size of the values written to the output file in bytes
+    double m_rawBytes;
+
+    //! time spent passing frames to the library, including the sync, in seconds
+    double m_writeTime, m_maxFrameWriteTime;
+
+    /**
+     * @brief Defines the chunks and compression filters of a variable of the output file.
+     *
+     * A chunk holds one frame at most, such that appending a frame only touches its own chunks.
+     *
+     * @param i_ncId id of the file.
+     * @param i_varId id of the variable.
+     * @param i_hasTime true if the first dimension of the variable is the time dimension.
+     */
+    int defineStorage(int i_ncId, int i_varId, bool i_hasTime);
+
+    /**
+     * @brief Defines the dimensions and variables of the output file with an unlimited time dimension.
+     *
+     * @param i_ncId id of the file.
+     */
+    int init(int i_ncId);
+
+    /**
+     * @brief Creates the output file and writes the coordinates and the coarse bathymetry.
+     */
+    int create();
 
-    bool isInBounds(int i_x, int i_y);
+    /**
+     * @brief Opens the output file of an earlier run to append the frames after the given time.
+     *
+     * @param i_startTime simulation time of the restart; the records of later frames are overwritten.
+     */
+    int open(t_real i_startTime);
+
+    /**
+     * @brief Averages the cells of one frame over the neighbors of each coarse cell.
+     *
+     * A box filter on the sums of the window rows costs O(1) per coarse cell for any coarse factor.
+     *
+     * @param i_data first inner cell of the frame.
+     * @param i_stride stride of the rows of the frame.
+     * @param o_coarse coarse cells.
+     */
+    void coarsen(t_real const *i_data,
+                 t_idx i_stride,
+                 t_real *o_coarse);
 
    public:
     /**
-     * @brief constructor/deconstructor.
+     * @brief Constructor which creates the output file with an unlimited time dimension.
+     *
+     * A run restarted from a checkpoint appends to the output file of the earlier run instead; if that file can't be
+     * opened, a new one is created.
      *
+     * @param i_dxy size of a cell.
+     * @param i_nx number of cells in x-direction.
+     * @param i_ny number of cells in y-direction.
+     * @param i_stride stride of the rows of the stored arrays.
+     * @param i_coarseFactor number of cells in each direction which are combined into one output cell.
+     * @param i_b bathymetry of the cells.
+     * @param i_outFileName path of the output file.
+     * @param i_startTime simulation time of a restarted run, which keeps the frames up to it; 0 creates a new file.
+     * @param i_outputConfig format, chunks and compression of the output file.
      */
-    NetCDF(t_real i_endTime,
-           t_real i_dt,
-           t_idx i_timeStepsPerFrame,
-           t_real i_dxy,
+    NetCDF(t_real i_dxy,
            t_idx i_nx,
            t_idx i_ny,
            t_idx i_stride,
            t_idx i_coarseFactor,
            t_real const *i_b,
-           std::string i_outFileName);
+           std::string i_outFileName,
+           t_real i_startTime = 0,
+           tsunami_lab::configs::OutputConfig i_outputConfig = tsunami_lab::configs::OutputConfig());
 
     ~NetCDF();
 
     /**
-     * @brief appends data for given timestep.
+     * @brief appends data for given timestep to the output file.
+     *
+     * The frames are written to consecutive records, such that frames which were never stored leave no gaps.
      *
      * @param i_simTime amount of time passed.
      * @param i_frame counter for iterations done.
@@ -78,46 +147,66 @@ class tsunami_lab::io::NetCDF {
               t_real const *i_hv);
 
     /**
-     * @brief Depending on if the checkpoint path is set write a solution file or
-     * a checkpoint file.
+     * @brief finishes the output file when the simulation is finished.
+     */
+    int write();
+
+    /**
+     * @brief Rounds the mantissas of values such that each value changes by at most the error bound.
+     *
+     * A value of magnitude in [2^e, 2^(e+1)) keeps e - 1 - floor(log2(bound)) mantissa bits, the others become zero
+     * and compress well. Values with a magnitude up to the bound become zero.
      *
-     * @param i_currentFrame number holding the current frame id for the writer.
-     * @param i_checkPointPath path to the written checkpoint file.
-     * @param i_simTime time passed since simulation begin.
-     * @param i_endTime maximum time to be simulated.
+     * @param io_data values to be rounded.
+     * @param i_size number of values.
+     * @param i_errorBound absolute error bound; has to be positive.
      */
-    int write(t_idx i_currentFrame,
-              std::string i_checkPointPath,
-              t_real i_simTime,
-              t_real i_endTime);
+    static void quantize(t_real *io_data,
+                         t_idx i_size,
+                         t_real i_errorBound);
 
     /**
-     * @brief standard writer when the simulation is finished and output is generated.
+     * @brief Gets the size of the output file.
+     *
+     * @return size of the output file in bytes; 0 if it does not exist.
      */
-    int write();
+    t_idx getFileSize();
 
     /**
-     * @brief Reads a checkpoint file.
-     *
-     * @param i_checkPointPath path to the checkpoint file to be read.
-     * @param o_height array of height values to be read.
-     * @param o_momentumX array of momentum values in x-direction to be read.
-     * @param o_momentumY array of momentum values in y-direction to be read.
-     * @param o_bathymetry array of bathymetry values of each cell to be read.
-     * @param o_time array of timestamps that already passed to be read.
-     * @param o_currentFrame current Frame in the writer.
-     * @param o_endSimTime maximum time to be simulated.
-     * @param o_startSimTime time passed since simulation begin.
+     * @brief Gets the uncompressed size of the values written to the output file.
+     *
+     * @return raw size in bytes.
      */
-    static int readCheckpoint(std::string i_checkPointPath,
-                              t_real *&o_height,
-                              t_real *&o_momentumX,
-                              t_real *&o_momentumY,
-                              t_real *&o_bathymetry,
-                              t_real *&o_time,
-                              t_idx *o_currentFrame,
-                              t_real *o_endSimTime,
-                              t_real *o_startSimTime);
+    double getRawBytes() {
+        return m_rawBytes;
+    }
+
+    /**
+     * @brief Gets the time spent passing frames to the library.
+     *
+     * @return write time in seconds.
+     */
+    double getWriteTime() {
+        return m_writeTime;
+    }
+
+    /**
+     * @brief Gets the longest time spent passing a single frame to the library.
+     *
+     * @return write time in seconds.
+     */
+    double getMaxFrameWriteTime() {
+        return m_maxFrameWriteTime;
+    }
+
+    /**
+     * @brief Gets the number of frames in the output file.
+     *
+     * @return number of frames.
+     */
+    t_idx getFramesWritten() {
+        return m_framesWritten;
+    }
 
     /**
      * Reads the bathymetry and displacement data from the respective file.
@@ -7,11 +7,16 @@
  * @section DESCRIPTION
  * Unit tests for reading and writing NetCDF files.
  **/
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "../../constants.h"
 #define private public
@@ -31,7 +36,7 @@ TEST_CASE("Test the NetCDF writer.", "[NetCDFWrite]") {
     tsunami_lab::t_real hu2[16] = {-1, -1, -1, -1, -1, 4, 3, -1, -1, 2, 1, -1, -1, -1, -1, -1};
     tsunami_lab::t_real hv2[16] = {-1, -1, -1, -1, -1, 4, 3, -1, -1, 2, 1, -1, -1, -1, -1, -1};
 
-    tsunami_lab::io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(1.0, 0.02, 25, 1, 2, 2, 4, 1, b, "writer_test.nc");
+    tsunami_lab::io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(1, 2, 2, 4, 1, b, "writer_test.nc");
 
     REQUIRE(l_writer->store(0.5, 0, h1, hu1, hv1) == NC_NOERR);
     REQUIRE(l_writer->store(1.0, 1, h2, hu2, hv2) == NC_NOERR);
@@ -92,6 +97,365 @@ TEST_CASE("Test the NetCDF writer.", "[NetCDFWrite]") {
     delete l_writer;
 }
 
+TEST_CASE("Test the NetCDF writer appending the frames.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   A writer of 2 x 2 cells stores three frames.
+     *
+     *   Every frame is readable from the output file as soon as it is stored and the time dimension grows with it.
+     */
+    tsunami_lab::t_real b[16] = {-1, -1, -1, -1,
+                                 -1, 1, 2, -1,
+                                 -1, 3, 4, -1,
+                                 -1, -1, -1, -1};
+    tsunami_lab::t_real h[16] = {-1, -1, -1, -1,
+                                 -1, 5, 6, -1,
+                                 -1, 7, 8, -1,
+                                 -1, -1, -1, -1};
+
+    tsunami_lab::io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(1, 2, 2, 4, 1, b, "writer_append_test.nc");
+
+    for (tsunami_lab::t_idx l_frame = 0; l_frame < 3; l_frame++) {
+        REQUIRE(l_writer->store(0.5 * l_frame, l_frame, h, b, h) == NC_NOERR);
+
+        int l_ncId, l_dimIdTime, l_varIdTime, l_varIdHeight;
+        REQUIRE(nc_open("writer_append_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+        REQUIRE(nc_inq_dimid(l_ncId, "time", &l_dimIdTime) == NC_NOERR);
+        REQUIRE(nc_inq_varid(l_ncId, "time", &l_varIdTime) == NC_NOERR);
+        REQUIRE(nc_inq_varid(l_ncId, "height", &l_varIdHeight) == NC_NOERR);
+
+        std::size_t l_timeLength;
+        REQUIRE(nc_inq_dimlen(l_ncId, l_dimIdTime, &l_timeLength) == NC_NOERR);
+        REQUIRE(l_timeLength == l_frame + 1);
+
+        float l_time;
+        std::size_t l_startTime[1] = {l_frame};
+        std::size_t l_countTime[1] = {1};
+        REQUIRE(nc_get_vara_float(l_ncId, l_varIdTime, l_startTime, l_countTime, &l_time) == NC_NOERR);
+        REQUIRE(l_time == Approx(0.5 * l_frame));
+
+        float l_height[4];
+        std::size_t l_start[3] = {l_frame, 0, 0};
+        std::size_t l_count[3] = {1, 2, 2};
+        REQUIRE(nc_get_vara_float(l_ncId, l_varIdHeight, l_start, l_count, l_height) == NC_NOERR);
+        REQUIRE(l_height[0] == 5);
+        REQUIRE(l_height[1] == 6);
+        REQUIRE(l_height[2] == 7);
+        REQUIRE(l_height[3] == 8);
+
+        REQUIRE(nc_close(l_ncId) == NC_NOERR);
+    }
+
+    REQUIRE(l_writer->write() == NC_NOERR);
+    delete l_writer;
+
+    int l_ncId, l_varIdFrame;
+    REQUIRE(nc_open("writer_append_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "frame", &l_varIdFrame) == NC_NOERR);
+    unsigned long long l_frameCount;
+    REQUIRE(nc_get_var_ulonglong(l_ncId, l_varIdFrame, &l_frameCount) == NC_NOERR);
+    REQUIRE(l_frameCount == 3);
+    REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+    std::remove("writer_append_test.nc");
+}
+
+TEST_CASE("Test the NetCDF writer appending to the output of an earlier run.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   A first run writes frames 0 to 4 of 2 x 2 cells at the times 0 to 4; a run restarted from a checkpoint at
+     *   time 2 writes the frames 3 to 5 with other heights into the same file.
+     *
+     *   The file holds the frames 0 to 2 of the first run followed by the frames of the restarted run.
+     */
+    tsunami_lab::t_real b[16] = {-1, -1, -1, -1,
+                                 -1, 1, 2, -1,
+                                 -1, 3, 4, -1,
+                                 -1, -1, -1, -1};
+    tsunami_lab::t_real h1[16] = {0, 0, 0, 0,
+                                  0, 1, 1, 0,
+                                  0, 1, 1, 0,
+                                  0, 0, 0, 0};
+    tsunami_lab::t_real h2[16] = {0, 0, 0, 0,
+                                  0, 2, 2, 0,
+                                  0, 2, 2, 0,
+                                  0, 0, 0, 0};
+
+    tsunami_lab::io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(1, 2, 2, 4, 1, b, "writer_restart_test.nc");
+    for (tsunami_lab::t_idx l_frame = 0; l_frame < 5; l_frame++) {
+        REQUIRE(l_writer->store(l_frame, l_frame, h1, h1, h1) == NC_NOERR);
+    }
+    delete l_writer;
+
+    l_writer = new tsunami_lab::io::NetCDF(1, 2, 2, 4, 1, b, "writer_restart_test.nc", 2);
+    for (tsunami_lab::t_idx l_frame = 3; l_frame < 6; l_frame++) {
+        REQUIRE(l_writer->store(l_frame, l_frame, h2, h2, h2) == NC_NOERR);
+    }
+    REQUIRE(l_writer->write() == NC_NOERR);
+    delete l_writer;
+
+    int l_ncId, l_dimIdTime, l_varIdTime, l_varIdHeight, l_varIdBathymetry;
+    REQUIRE(nc_open("writer_restart_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+    REQUIRE(nc_inq_dimid(l_ncId, "time", &l_dimIdTime) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "time", &l_varIdTime) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "height", &l_varIdHeight) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "bathymetry", &l_varIdBathymetry) == NC_NOERR);
+
+    std::size_t l_timeLength;
+    REQUIRE(nc_inq_dimlen(l_ncId, l_dimIdTime, &l_timeLength) == NC_NOERR);
+    REQUIRE(l_timeLength == 6);
+
+    float l_time[6];
+    float l_height[24];
+    float l_bathymetry[4];
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdTime, l_time) == NC_NOERR);
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdHeight, l_height) == NC_NOERR);
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdBathymetry, l_bathymetry) == NC_NOERR);
+    REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+    for (tsunami_lab::t_idx l_frame = 0; l_frame < 6; l_frame++) {
+        REQUIRE(l_time[l_frame] == l_frame);
+        for (tsunami_lab::t_idx l_ce = 0; l_ce < 4; l_ce++) {
+            REQUIRE(l_height[l_frame * 4 + l_ce] == (l_frame < 3 ? 1 : 2));
+        }
+    }
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < 4; l_ce++) {
+        REQUIRE(l_bathymetry[l_ce] == l_ce + 1);
+    }
+
+    std::remove("writer_restart_test.nc");
+}
+
+TEST_CASE("Test the coarse output of the NetCDF writer.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   Frames of 11 x 8 cells with varying heights are coarsened by the factors 2, 3 and 4.
+     *
+     *   Every coarse cell averages the cells f * c to f * c + 2f - 2 in each direction, clipped to the domain, and
+     *   counts the cell f * c + f - 1 twice.
+     */
+    tsunami_lab::t_idx l_nx = 11;
+    tsunami_lab::t_idx l_ny = 8;
+    tsunami_lab::t_idx l_stride = l_nx + 2;
+    std::vector<tsunami_lab::t_real> l_b(l_stride * (l_ny + 2), -1);
+    std::vector<tsunami_lab::t_real> l_h(l_stride * (l_ny + 2), -1);
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < l_ny; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < l_nx; l_ix++) {
+            l_h[(l_iy + 1) * l_stride + l_ix + 1] = (l_ix * 7 + l_iy * 13) % 10 + tsunami_lab::t_real(0.25) * l_ix;
+        }
+    }
+
+    for (tsunami_lab::t_idx l_factor = 2; l_factor < 5; l_factor++) {
+        tsunami_lab::io::NetCDF l_writer(1, l_nx, l_ny, l_stride, l_factor, l_b.data(), "writer_coarse_test.nc");
+        REQUIRE(l_writer.store(0, 0, l_h.data(), l_h.data(), l_h.data()) == NC_NOERR);
+
+        tsunami_lab::t_idx l_nxCoarse = l_nx / l_factor;
+        tsunami_lab::t_idx l_nyCoarse = l_ny / l_factor;
+        for (tsunami_lab::t_idx l_cy = 0; l_cy < l_nyCoarse; l_cy++) {
+            for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nxCoarse; l_cx++) {
+                tsunami_lab::t_idx l_centerX = l_factor * l_cx + l_factor - 1;
+                tsunami_lab::t_idx l_centerY = l_factor * l_cy + l_factor - 1;
+
+                double l_sum = l_h[(l_centerY + 1) * l_stride + l_centerX + 1];
+                tsunami_lab::t_idx l_count = 1;
+                for (tsunami_lab::t_idx l_iy = l_factor * l_cy; l_iy < std::min(l_factor * l_cy + 2 * l_factor - 1, l_ny); l_iy++) {
+                    for (tsunami_lab::t_idx l_ix = l_factor * l_cx; l_ix < std::min(l_factor * l_cx + 2 * l_factor - 1, l_nx); l_ix++) {
+                        l_sum += l_h[(l_iy + 1) * l_stride + l_ix + 1];
+                        l_count++;
+                    }
+                }
+
+                REQUIRE(l_writer.m_heightCoarse[l_cy * l_nxCoarse + l_cx] == Approx(l_sum / l_count));
+            }
+        }
+        REQUIRE(l_writer.write() == NC_NOERR);
+    }
+
+    std::remove("writer_coarse_test.nc");
+}
+
+TEST_CASE("Test the chunked and compressed NetCDF-4 output.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   Two frames of 6 x 4 cells are written to a NetCDF-4 file with chunks of 4 cells in x-direction and all rows
+     *   in y-direction, compressed by deflate at level 5. A second file asks for zstd and an error bound of 1e-3.
+     *
+     *   Chunks hold a single frame, the filters are set and the frames are read back unchanged. Without the zstd
+     *   plugin the writer falls back to deflate and keeps the other settings.
+     */
+    tsunami_lab::t_idx l_stride = 8;
+    std::vector<tsunami_lab::t_real> l_b(l_stride * 6, -1);
+    std::vector<tsunami_lab::t_real> l_h(l_stride * 6, -1);
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 4; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 6; l_ix++) {
+            l_h[(l_iy + 1) * l_stride + l_ix + 1] = l_iy * 6 + l_ix;
+        }
+    }
+
+    tsunami_lab::configs::OutputConfig l_deflateConfig(0, false, true, 4, 0, tsunami_lab::configs::DEFLATE, 5, true);
+    tsunami_lab::io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(1, 6, 4, l_stride, 1, l_b.data(), "writer_netcdf4_test.nc", 0, l_deflateConfig);
+    REQUIRE(l_writer->store(0, 0, l_h.data(), l_h.data(), l_h.data()) == NC_NOERR);
+    REQUIRE(l_writer->store(0.5, 1, l_h.data(), l_h.data(), l_h.data()) == NC_NOERR);
+    REQUIRE(l_writer->write() == NC_NOERR);
+
+    // coordinates, bathymetry and two frames of time, height and momenta
+    REQUIRE(l_writer->getRawBytes() == (6 + 4 + 24 + 2 * (3 * 24 + 1)) * sizeof(float));
+    REQUIRE(l_writer->getFileSize() > 0);
+    REQUIRE(l_writer->getMaxFrameWriteTime() <= l_writer->getWriteTime());
+    delete l_writer;
+
+    int l_ncId, l_varIdHeight, l_varIdBathymetry;
+    REQUIRE(nc_open("writer_netcdf4_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "height", &l_varIdHeight) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "bathymetry", &l_varIdBathymetry) == NC_NOERR);
+
+    int l_storage;
+    std::size_t l_chunks[3];
+    REQUIRE(nc_inq_var_chunking(l_ncId, l_varIdHeight, &l_storage, l_chunks) == NC_NOERR);
+    REQUIRE(l_storage == NC_CHUNKED);
+    REQUIRE(l_chunks[0] == 1);
+    REQUIRE(l_chunks[1] == 4);
+    REQUIRE(l_chunks[2] == 4);
+    REQUIRE(nc_inq_var_chunking(l_ncId, l_varIdBathymetry, &l_storage, l_chunks) == NC_NOERR);
+    REQUIRE(l_chunks[0] == 4);
+    REQUIRE(l_chunks[1] == 4);
+
+    int l_shuffle, l_deflate, l_level;
+    REQUIRE(nc_inq_var_deflate(l_ncId, l_varIdHeight, &l_shuffle, &l_deflate, &l_level) == NC_NOERR);
+    REQUIRE(l_shuffle == 1);
+    REQUIRE(l_deflate == 1);
+    REQUIRE(l_level == 5);
+
+    float l_height[48];
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdHeight, l_height) == NC_NOERR);
+    for (tsunami_lab::t_idx l_i = 0; l_i < 48; l_i++) {
+        REQUIRE(l_height[l_i] == l_i % 24);
+    }
+    REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+    tsunami_lab::configs::OutputConfig l_zstdConfig(0, false, true, 0, 0, tsunami_lab::configs::ZSTD, 12, false, 1E-3, 2);
+    l_writer = new tsunami_lab::io::NetCDF(1, 6, 4, l_stride, 1, l_b.data(), "writer_netcdf4_test.nc", 0, l_zstdConfig);
+    // 32015 is the id of the zstd filter of HDF5
+    bool l_hasZstd = nc_inq_filter_avail(l_writer->m_ncId, 32015) == NC_NOERR;
+    REQUIRE(l_writer->m_outputConfig.getErrorBound() == Approx(1E-3));
+    REQUIRE(l_writer->m_outputConfig.getSnapshotWriters() == 2);
+    REQUIRE(l_writer->m_outputConfig.useShuffle() == false);
+    REQUIRE(l_writer->store(0, 0, l_h.data(), l_h.data(), l_h.data()) == NC_NOERR);
+    REQUIRE(l_writer->write() == NC_NOERR);
+    delete l_writer;
+
+    REQUIRE(nc_open("writer_netcdf4_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+    REQUIRE(nc_inq_varid(l_ncId, "height", &l_varIdHeight) == NC_NOERR);
+    REQUIRE(nc_inq_var_chunking(l_ncId, l_varIdHeight, &l_storage, l_chunks) == NC_NOERR);
+    REQUIRE(l_chunks[1] == 4);
+    REQUIRE(l_chunks[2] == 6);
+    REQUIRE(nc_inq_var_deflate(l_ncId, l_varIdHeight, &l_shuffle, &l_deflate, &l_level) == NC_NOERR);
+    if (!l_hasZstd) {
+        REQUIRE(l_deflate == 1);
+        REQUIRE(l_level == 9);
+    } else {
+        REQUIRE(l_deflate == 0);
+    }
+    REQUIRE(nc_get_var_float(l_ncId, l_varIdHeight, l_height) == NC_NOERR);
+    for (tsunami_lab::t_idx l_i = 0; l_i < 24; l_i++) {
+        REQUIRE(l_height[l_i] == l_i);
+    }
+    REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+    std::remove("writer_netcdf4_test.nc");
+}
+
+TEST_CASE("Test the quantization of the output fields.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   Values of both signs with magnitudes from 1e-5 to 1e4 are quantized with the error bounds 1e-3, 0.01 and 0.5.
+     *
+     *   Every value changes by at most the error bound and 1000.123 keeps 18 mantissa bits for the bound 1e-3.
+     */
+    std::vector<tsunami_lab::t_real> l_values;
+    for (tsunami_lab::t_idx l_i = 0; l_i < 2000; l_i++) {
+        tsunami_lab::t_real l_magnitude = std::pow(10.0, -5 + 9.0 * l_i / 2000);
+        l_values.push_back(l_i % 2 == 0 ? l_magnitude : -l_magnitude);
+    }
+
+    for (tsunami_lab::t_real l_errorBound : {tsunami_lab::t_real(1e-3), tsunami_lab::t_real(0.01), tsunami_lab::t_real(0.5)}) {
+        std::vector<tsunami_lab::t_real> l_quantized = l_values;
+        tsunami_lab::io::NetCDF::quantize(l_quantized.data(), l_quantized.size(), l_errorBound);
+
+        for (tsunami_lab::t_idx l_i = 0; l_i < l_values.size(); l_i++) {
+            REQUIRE(std::abs(l_quantized[l_i] - l_values[l_i]) <= l_errorBound);
+        }
+    }
+
+    tsunami_lab::t_real l_value = 1000.123;
+    tsunami_lab::io::NetCDF::quantize(&l_value, 1, 1e-3);
+    std::uint32_t l_bits;
+    std::memcpy(&l_bits, &l_value, sizeof(float));
+    REQUIRE((l_bits & 31) == 0);
+    REQUIRE(l_value != 1000);
+    REQUIRE(std::abs(l_value - tsunami_lab::t_real(1000.123)) <= 1e-3);
+}
+
+TEST_CASE("Test the NetCDF writer with an error bound against the lossless output.", "[NetCDFWrite]") {
+    /*
+     * Test case:
+     *   Frames of 9 x 6 cells with heights around 4000 and small momenta are written lossless and with the error
+     *   bound 1e-3 for the full output and the coarse factor 2.
+     *
+     *   Each value of the bounded output differs by at most 1e-3 from the lossless output, which documents its bound.
+     */
+    tsunami_lab::t_idx l_nx = 9;
+    tsunami_lab::t_idx l_ny = 6;
+    tsunami_lab::t_idx l_stride = l_nx + 2;
+    std::vector<tsunami_lab::t_real> l_b(l_stride * (l_ny + 2), -4000);
+    std::vector<tsunami_lab::t_real> l_h(l_stride * (l_ny + 2), 0);
+    std::vector<tsunami_lab::t_real> l_hu(l_stride * (l_ny + 2), 0);
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < l_ny; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < l_nx; l_ix++) {
+            l_h[(l_iy + 1) * l_stride + l_ix + 1] = 4000 + std::sin(tsunami_lab::t_real(l_ix * l_ny + l_iy));
+            l_hu[(l_iy + 1) * l_stride + l_ix + 1] = tsunami_lab::t_real(1e-4) * l_ix - tsunami_lab::t_real(0.37) * l_iy;
+        }
+    }
+
+    tsunami_lab::configs::OutputConfig l_boundedConfig(0, false, false, 0, 0, tsunami_lab::configs::NO_COMPRESSION, 4, true, 1e-3);
+    for (tsunami_lab::t_idx l_factor = 1; l_factor < 3; l_factor++) {
+        tsunami_lab::io::NetCDF *l_lossless = new tsunami_lab::io::NetCDF(1, l_nx, l_ny, l_stride, l_factor, l_b.data(), "writer_lossless_test.nc");
+        tsunami_lab::io::NetCDF *l_bounded = new tsunami_lab::io::NetCDF(1, l_nx, l_ny, l_stride, l_factor, l_b.data(), "writer_bounded_test.nc", 0, l_boundedConfig);
+        REQUIRE(l_lossless->store(0, 0, l_h.data(), l_hu.data(), l_hu.data()) == NC_NOERR);
+        REQUIRE(l_bounded->store(0, 0, l_h.data(), l_hu.data(), l_hu.data()) == NC_NOERR);
+        REQUIRE(l_lossless->write() == NC_NOERR);
+        REQUIRE(l_bounded->write() == NC_NOERR);
+        delete l_lossless;
+        delete l_bounded;
+
+        tsunami_lab::t_idx l_size = (l_nx / l_factor) * (l_ny / l_factor);
+        for (char const *l_name : {"height", "momentum_x", "momentum_y"}) {
+            std::vector<float> l_exact(l_size);
+            std::vector<float> l_rounded(l_size);
+            int l_ncId, l_varId;
+            REQUIRE(nc_open("writer_lossless_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+            REQUIRE(nc_inq_varid(l_ncId, l_name, &l_varId) == NC_NOERR);
+            REQUIRE(nc_get_var_float(l_ncId, l_varId, l_exact.data()) == NC_NOERR);
+            REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+            REQUIRE(nc_open("writer_bounded_test.nc", NC_NOWRITE, &l_ncId) == NC_NOERR);
+            REQUIRE(nc_inq_varid(l_ncId, l_name, &l_varId) == NC_NOERR);
+            REQUIRE(nc_get_var_float(l_ncId, l_varId, l_rounded.data()) == NC_NOERR);
+            float l_errorBound;
+            REQUIRE(nc_get_att_float(l_ncId, l_varId, "quantization_error", &l_errorBound) == NC_NOERR);
+            REQUIRE(l_errorBound == tsunami_lab::t_real(1e-3));
+            REQUIRE(nc_close(l_ncId) == NC_NOERR);
+
+            for (tsunami_lab::t_idx l_i = 0; l_i < l_size; l_i++) {
+                REQUIRE(std::abs(l_rounded[l_i] - l_exact[l_i]) <= l_errorBound);
+            }
+        }
+    }
+
+    std::remove("writer_lossless_test.nc");
+    std::remove("writer_bounded_test.nc");
+}
+
 TEST_CASE("Test the NetCDF read.", "[NetCDFRead]") {
     std::string l_bathymetryName = "dummy_bathymetry.nc";
     std::string l_displacementsName = "dummy_disp.nc";
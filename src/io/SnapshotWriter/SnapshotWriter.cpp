@@ -0,0 +1,143 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Checkpoints written by forked processes from a copy-on-write snapshot of the simulation.
+ **/
+#include "SnapshotWriter.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+
+#include "../../parallel/Affinity.h"
+#include "../BinaryCheckPoint/BinaryCheckPoint.h"
+
+namespace {
+    //! seconds since the given point in time
+    double secondsSince(std::chrono::steady_clock::time_point i_start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - i_start).count();
+    }
+}  // namespace
+
+tsunami_lab::io::SnapshotWriter::SnapshotWriter(t_idx i_nx,
+                                                t_idx i_ny,
+                                                t_idx i_stride,
+                                                t_idx i_maxWriters) {
+    m_nx = i_nx;
+    m_ny = i_ny;
+    m_stride = i_stride;
+    m_maxWriters = std::max(i_maxWriters, t_idx(1));
+}
+
+tsunami_lab::io::SnapshotWriter::~SnapshotWriter() {
+    finish();
+}
+
+void tsunami_lab::io::SnapshotWriter::check(pid_t i_pid,
+                                            int i_status) {
+    if (WIFEXITED(i_status) && WEXITSTATUS(i_status) == 0) return;
+
+    m_nFailed++;
+    if (WIFSIGNALED(i_status)) {
+        std::cerr << "checkpoint writer " << i_pid << " was killed by signal " << WTERMSIG(i_status) << std::endl;
+    } else {
+        std::cerr << "checkpoint writer " << i_pid << " failed with exit status " << WEXITSTATUS(i_status) << std::endl;
+    }
+}
+
+void tsunami_lab::io::SnapshotWriter::reap(bool i_wait) {
+    for (std::deque<pid_t>::iterator l_it = m_writers.begin(); l_it != m_writers.end();) {
+        int l_status;
+        pid_t l_pid = waitpid(*l_it, &l_status, WNOHANG);
+        if (l_pid == 0) {
+            l_it++;
+            continue;
+        }
+
+        // a child which can't be waited for is lost
+        if (l_pid < 0) {
+            m_nFailed++;
+            std::cerr << "checkpoint writer " << *l_it << " is lost" << std::endl;
+        } else {
+            check(l_pid, l_status);
+        }
+        l_it = m_writers.erase(l_it);
+        i_wait = false;
+    }
+
+    if (!i_wait || m_writers.empty()) return;
+
+    pid_t l_oldest = m_writers.front();
+    m_writers.pop_front();
+    int l_status;
+    pid_t l_pid;
+    do {
+        l_pid = waitpid(l_oldest, &l_status, 0);
+    } while (l_pid < 0 && errno == EINTR);
+
+    if (l_pid < 0) {
+        m_nFailed++;
+        std::cerr << "checkpoint writer " << l_oldest << " is lost" << std::endl;
+    } else {
+        check(l_pid, l_status);
+    }
+}
+
+void tsunami_lab::io::SnapshotWriter::checkPoint(std::string i_checkPointPath,
+                                                 t_idx i_currentFrame,
+                                                 t_real i_simTime,
+                                                 t_real i_endTime,
+                                                 t_real const *i_h,
+                                                 t_real const *i_hu,
+                                                 t_real const *i_hv,
+                                                 t_real const *i_b) {
+    std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+
+    reap(false);
+    while (m_writers.size() >= m_maxWriters) reap(true);
+
+    m_nSnapshots++;
+    pid_t l_pid = fork();
+    if (l_pid == 0) {
+        // the child holds only the forking thread, such that it must not use OpenMP or return to the caller
+        // and which runs on the core of the pinned forking thread without restoring the inherited mask
+        parallel::Affinity::unpinThread();
+        int l_err = BinaryCheckPoint::write(i_checkPointPath,
+                                            m_nx,
+                                            m_ny,
+                                            m_stride,
+                                            i_currentFrame,
+                                            i_simTime,
+                                            i_endTime,
+                                            i_h,
+                                            i_hu,
+                                            i_hv,
+                                            i_b,
+                                            false);
+        _exit(l_err == 0 ? 0 : 1);
+    }
+
+    if (l_pid > 0) {
+        m_writers.push_back(l_pid);
+    } else {
+        std::cerr << "could not fork a checkpoint writer, writing in the time loop" << std::endl;
+        if (BinaryCheckPoint::write(i_checkPointPath, m_nx, m_ny, m_stride, i_currentFrame, i_simTime, i_endTime, i_h, i_hu, i_hv, i_b) != 0) {
+            m_nFailed++;
+        }
+    }
+
+    m_stallTime += secondsSince(l_start);
+}
+
+tsunami_lab::t_idx tsunami_lab::io::SnapshotWriter::finish() {
+    std::chrono::steady_clock::time_point l_start = std::chrono::steady_clock::now();
+    while (!m_writers.empty()) reap(true);
+    m_stallTime += secondsSince(l_start);
+
+    return m_nFailed;
+}
@@ -0,0 +1,143 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Checkpoints written by forked processes from a copy-on-write snapshot of the simulation.
+ **/
+#ifndef TSUNAMI_LAB_IO_SNAPSHOT_WRITER
+#define TSUNAMI_LAB_IO_SNAPSHOT_WRITER
+
+#include <sys/types.h>
+
+#include <deque>
+#include <string>
+
+#include "../../constants.h"
+
+namespace tsunami_lab {
+    namespace io {
+        class SnapshotWriter;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * A checkpoint forks the process; the child writes the state of the patch as it was at the fork and exits, while the
+ * parent continues with the time loop at once. The pages of the patch are shared until the parent modifies them,
+ * such that a checkpoint costs the fork and one page fault per modified page instead of a copy of the state.
+ *
+ * At most a given number of children write at the same time; further checkpoints wait for the oldest one. The exit
+ * status of every child is checked.
+ **/
+class tsunami_lab::io::SnapshotWriter {
+   private:
+    //! number of inner cells in x- and y-direction and stride of the rows of the patch
+    t_idx m_nx, m_ny, m_stride;
+
+    //! maximum number of children writing at the same time
+    t_idx m_maxWriters;
+
+    //! ids of the running children, oldest first
+    std::deque<pid_t> m_writers;
+
+    //! number of started checkpoints
+    t_idx m_nSnapshots = 0;
+
+    //! number of checkpoints which could not be written
+    t_idx m_nFailed = 0;
+
+    //! time the time loop spent forking and waiting for children in seconds
+    double m_stallTime = 0;
+
+    /**
+     * @brief Collects the children which have exited.
+     *
+     * @param i_wait wait for the oldest child if none has exited.
+     */
+    void reap(bool i_wait);
+
+    /**
+     * @brief Checks the exit status of a child.
+     *
+     * @param i_pid id of the child.
+     * @param i_status status returned by waitpid.
+     */
+    void check(pid_t i_pid,
+               int i_status);
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param i_nx number of inner cells in x-direction.
+     * @param i_ny number of inner cells in y-direction.
+     * @param i_stride stride of the rows of the patch.
+     * @param i_maxWriters maximum number of children writing at the same time; at least one.
+     */
+    SnapshotWriter(t_idx i_nx,
+                   t_idx i_ny,
+                   t_idx i_stride,
+                   t_idx i_maxWriters);
+
+    /**
+     * Destructor which waits for the running children.
+     */
+    ~SnapshotWriter();
+
+    /**
+     * @brief Starts a child which writes a checkpoint of the given state; waits while the maximum number of children
+     * is running. If the process can't be forked, the checkpoint is written in the calling thread.
+     *
+     * @param i_checkPointPath path to the written checkpoint file.
+     * @param i_currentFrame id of the next frame to be written.
+     * @param i_simTime time passed since simulation begin.
+     * @param i_endTime maximum time to be simulated.
+     * @param i_h water height of the cells.
+     * @param i_hu momentum in x-direction of the cells.
+     * @param i_hv momentum in y-direction of the cells.
+     * @param i_b bathymetry of the cells.
+     */
+    void checkPoint(std::string i_checkPointPath,
+                    t_idx i_currentFrame,
+                    t_real i_simTime,
+                    t_real i_endTime,
+                    t_real const *i_h,
+                    t_real const *i_hu,
+                    t_real const *i_hv,
+                    t_real const *i_b);
+
+    /**
+     * @brief Waits for all running children.
+     *
+     * @return number of checkpoints which could not be written.
+     */
+    t_idx finish();
+
+    /**
+     * @brief Gets the number of started checkpoints.
+     *
+     * @return number of checkpoints.
+     */
+    t_idx getNumberOfSnapshots() {
+        return m_nSnapshots;
+    }
+
+    /**
+     * @brief Gets the number of running children.
+     *
+     * @return number of children.
+     */
+    t_idx getNumberOfWriters() {
+        return m_writers.size();
+    }
+
+    /**
+     * @brief Gets the time the time loop spent forking and waiting for children.
+     *
+     * @return stall time in seconds.
+     */
+    double getStallTime() {
+        return m_stallTime;
+    }
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the checkpoints written by forked processes.
+ **/
+#include "SnapshotWriter.h"
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../BinaryCheckPoint/BinaryCheckPoint.h"
+
+TEST_CASE("Test the checkpoints written from copy-on-write snapshots.", "[SnapshotWriter]") {
+    /*
+     * Test case:
+     *   Four checkpoints of 3 x 2 cells with rows of 5 values are requested with at most two writers; the heights are
+     *   overwritten right after every request.
+     *
+     *   Never more than two writers run and every checkpoint holds the state at its request.
+     */
+    std::vector<tsunami_lab::t_real> l_b(20, -5);
+    std::vector<tsunami_lab::t_real> l_h(20, 0);
+    std::vector<tsunami_lab::t_real> l_hu(20, 1);
+
+    tsunami_lab::io::SnapshotWriter l_snapshots(3, 2, 5, 2);
+    for (tsunami_lab::t_idx l_cp = 0; l_cp < 4; l_cp++) {
+        for (tsunami_lab::t_idx l_ce = 0; l_ce < 20; l_ce++) l_h[l_ce] = 10 * l_cp + l_ce;
+
+        std::string l_path = "snapshot_writer_test_" + std::to_string(l_cp) + ".bin";
+        l_snapshots.checkPoint(l_path, l_cp + 1, l_cp, 10, l_h.data(), l_hu.data(), l_h.data(), l_b.data());
+        REQUIRE(l_snapshots.getNumberOfWriters() <= 2);
+
+        for (tsunami_lab::t_idx l_ce = 0; l_ce < 20; l_ce++) l_h[l_ce] = -1;
+    }
+    REQUIRE(l_snapshots.finish() == 0);
+    REQUIRE(l_snapshots.getNumberOfWriters() == 0);
+    REQUIRE(l_snapshots.getNumberOfSnapshots() == 4);
+
+    for (tsunami_lab::t_idx l_cp = 0; l_cp < 4; l_cp++) {
+        std::string l_path = "snapshot_writer_test_" + std::to_string(l_cp) + ".bin";
+        tsunami_lab::io::BinaryCheckPoint l_checkPoint;
+        REQUIRE(l_checkPoint.map(l_path, 3, 2) == 0);
+        REQUIRE(l_checkPoint.getFrame() == l_cp + 1);
+        REQUIRE(l_checkPoint.getSimTime() == l_cp);
+        for (tsunami_lab::t_idx l_ce = 0; l_ce < 20; l_ce++) {
+            REQUIRE(l_checkPoint.getHeight()[l_ce] == 10 * l_cp + l_ce);
+            REQUIRE(l_checkPoint.getMomentumX()[l_ce] == 1);
+            REQUIRE(l_checkPoint.getBathymetry()[l_ce] == -5);
+        }
+        std::remove(l_path.c_str());
+    }
+}
+
+TEST_CASE("Test the exit status of a failed snapshot writer.", "[SnapshotWriter]") {
+    /*
+     * Test case:
+     *   A checkpoint is requested in a directory which does not exist.
+     *
+     *   The writer exits with an error, which is reported by finish.
+     */
+    std::vector<tsunami_lab::t_real> l_data(20, 0);
+
+    tsunami_lab::io::SnapshotWriter l_snapshots(3, 2, 5, 1);
+    l_snapshots.checkPoint("snapshot_writer_missing_dir/checkpoint.bin", 1, 0, 10, l_data.data(), l_data.data(), l_data.data(), l_data.data());
+    REQUIRE(l_snapshots.finish() == 1);
+}
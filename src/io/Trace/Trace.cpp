@@ -0,0 +1,71 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Timeline of the phases executed by the threads, written in the trace event format of Chrome and Perfetto.
+ **/
+#include "Trace.h"
+
+#include <iomanip>
+
+tsunami_lab::io::Trace::Trace(int i_nThreads,
+                              int i_process,
+                              t_idx i_maxEvents) {
+    m_start = std::chrono::steady_clock::now();
+    m_process = i_process;
+    m_maxEvents = i_maxEvents;
+    m_events.resize(i_nThreads);
+}
+
+double tsunami_lab::io::Trace::now() {
+    std::chrono::duration<double> l_elapsed = std::chrono::steady_clock::now() - m_start;
+    return l_elapsed.count();
+}
+
+void tsunami_lab::io::Trace::record(int i_thread,
+                                    char const *i_name,
+                                    double i_start,
+                                    double i_end) {
+    if (i_thread < 0 || i_thread >= int(m_events.size())) return;
+    if (m_events[i_thread].size() >= m_maxEvents) return;
+
+    m_events[i_thread].push_back({i_name, i_start, i_end});
+}
+
+tsunami_lab::t_idx tsunami_lab::io::Trace::getNumberOfEvents() {
+    t_idx l_nEvents = 0;
+    for (std::vector<Event> const &l_events : m_events) {
+        l_nEvents += l_events.size();
+    }
+
+    return l_nEvents;
+}
+
+void tsunami_lab::io::Trace::write(std::ostream &io_stream) {
+    // microseconds with nanosecond resolution, independent of the length of the run
+    std::ios_base::fmtflags l_flags = io_stream.flags();
+    std::streamsize l_precision = io_stream.precision();
+    io_stream << std::fixed << std::setprecision(3);
+
+    io_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool l_first = true;
+    for (t_idx l_th = 0; l_th < m_events.size(); l_th++) {
+        for (Event const &l_event : m_events[l_th]) {
+            if (!l_first) io_stream << ",";
+            l_first = false;
+
+            // complete events with timestamps and durations in microseconds
+            io_stream << "\n{\"name\":\"" << l_event.name << "\",\"ph\":\"X\""
+                      << ",\"pid\":" << m_process
+                      << ",\"tid\":" << l_th
+                      << ",\"ts\":" << l_event.start * 1E6
+                      << ",\"dur\":" << (l_event.end - l_event.start) * 1E6 << "}";
+        }
+    }
+
+    io_stream << "\n]}" << std::endl;
+
+    io_stream.flags(l_flags);
+    io_stream.precision(l_precision);
+}
@@ -0,0 +1,98 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Timeline of the phases executed by the threads, written in the trace event format of Chrome and Perfetto.
+ **/
+#ifndef TSUNAMI_LAB_IO_TRACE
+#define TSUNAMI_LAB_IO_TRACE
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "../../constants.h"
+
+namespace tsunami_lab {
+    namespace io {
+        class Trace;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * Every thread records its events into a buffer of its own, such that recording needs no synchronization.
+ * Events beyond the capacity of a buffer are dropped.
+ **/
+class tsunami_lab::io::Trace {
+   private:
+    //! phase executed by a thread
+    struct Event {
+        //! name of the phase; has to outlive the trace
+        char const *name;
+        //! start in seconds since the construction of the trace
+        double start;
+        //! end in seconds since the construction of the trace
+        double end;
+    };
+
+    //! point in time of the construction
+    std::chrono::steady_clock::time_point m_start;
+
+    //! id of the process, e.g., the MPI rank
+    int m_process = 0;
+
+    //! maximum number of events per thread
+    t_idx m_maxEvents = 0;
+
+    //! events of every thread
+    std::vector<std::vector<Event>> m_events;
+
+   public:
+    /**
+     * Constructs an empty trace.
+     *
+     * @param i_nThreads number of threads which record events.
+     * @param i_process id of the process, e.g., the MPI rank.
+     * @param i_maxEvents maximum number of events per thread.
+     **/
+    Trace(int i_nThreads,
+          int i_process = 0,
+          t_idx i_maxEvents = 100000);
+
+    /**
+     * Gets the current time.
+     *
+     * @return seconds since the construction of the trace.
+     **/
+    double now();
+
+    /**
+     * Records an event of a thread. Threads outside the traced ones and events of full buffers are dropped.
+     *
+     * @param i_thread id of the thread.
+     * @param i_name name of the phase; has to outlive the trace.
+     * @param i_start start of the phase as returned by now().
+     * @param i_end end of the phase as returned by now().
+     **/
+    void record(int i_thread,
+                char const *i_name,
+                double i_start,
+                double i_end);
+
+    /**
+     * Gets the number of recorded events of all threads.
+     *
+     * @return number of events.
+     **/
+    t_idx getNumberOfEvents();
+
+    /**
+     * Writes the events as JSON in the trace event format, which can be opened by chrome://tracing or
+     * https://ui.perfetto.dev.
+     *
+     * @param io_stream stream to which the trace is written.
+     **/
+    void write(std::ostream &io_stream);
+};
+
+#endif
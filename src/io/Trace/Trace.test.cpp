@@ -0,0 +1,37 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the timeline trace.
+ **/
+#include "Trace.h"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+
+TEST_CASE("Test the recording and writing of a timeline trace.", "[Trace]") {
+    tsunami_lab::io::Trace l_trace(2, 3, 2);
+
+    double l_start = l_trace.now();
+    REQUIRE(l_start >= 0);
+
+    l_trace.record(0, "ghost cells", 0.5, 0.75);
+    l_trace.record(1, "interior x-sweep", 0.5, 1.5);
+    l_trace.record(1, "boundary x-sweep", 1.5, 2);
+
+    // unknown threads and full buffers are dropped
+    l_trace.record(2, "ghost cells", 0, 1);
+    l_trace.record(1, "interior y-sweep", 2, 3);
+
+    REQUIRE(l_trace.getNumberOfEvents() == 3);
+
+    std::stringstream l_stream;
+    l_trace.write(l_stream);
+    std::string l_json = l_stream.str();
+
+    REQUIRE(l_json.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(l_json.find("{\"name\":\"ghost cells\",\"ph\":\"X\",\"pid\":3,\"tid\":0,\"ts\":500000.000,\"dur\":250000.000}") != std::string::npos);
+    REQUIRE(l_json.find("{\"name\":\"interior x-sweep\",\"ph\":\"X\",\"pid\":3,\"tid\":1,\"ts\":500000.000,\"dur\":1000000.000}") != std::string::npos);
+    REQUIRE(l_json.find("\"boundary x-sweep\"") != std::string::npos);
+    REQUIRE(l_json.find("\"interior y-sweep\"") == std::string::npos);
+}
@@ -0,0 +1,102 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Selection of the kernels' instruction set level at startup.
+ **/
+#include "Kernels.h"
+
+namespace {
+    //! names of the instruction set levels, indexed by e_isa
+    char const *const c_isaNames[tsunami_lab::kernels::c_nIsas] = {"sse2", "avx2", "avx512"};
+
+    /**
+     * Checks if the CPU supports an instruction set level.
+     *
+     * @param i_isa instruction set level.
+     * @return true if supported.
+     **/
+    bool isSupported(tsunami_lab::kernels::e_isa i_isa) {
+#if defined(__x86_64__) || defined(__i386__)
+        if (i_isa == tsunami_lab::kernels::AVX2) {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }
+        if (i_isa == tsunami_lab::kernels::AVX512) {
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                   __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+                   __builtin_cpu_supports("fma");
+        }
+#endif
+        return i_isa == tsunami_lab::kernels::SSE2;
+    }
+
+    /**
+     * Gets the kernels of an instruction set level, if they are built.
+     *
+     * @param i_isa instruction set level.
+     * @return kernels; nullptr if the level is not built.
+     **/
+    tsunami_lab::kernels::Kernels const *getBuiltKernels(tsunami_lab::kernels::e_isa i_isa) {
+#ifdef TSUNAMI_LAB_KERNELS_AVX2
+        if (i_isa == tsunami_lab::kernels::AVX2) return tsunami_lab::kernels::avx2::getKernels();
+#endif
+#ifdef TSUNAMI_LAB_KERNELS_AVX512
+        if (i_isa == tsunami_lab::kernels::AVX512) return tsunami_lab::kernels::avx512::getKernels();
+#endif
+        if (i_isa == tsunami_lab::kernels::SSE2) return tsunami_lab::kernels::sse2::getKernels();
+        return nullptr;
+    }
+
+    /**
+     * Gets the selected instruction set level, which is the highest available one until selectIsa is called.
+     *
+     * @return selected instruction set level.
+     **/
+    tsunami_lab::kernels::e_isa &getSelectedIsa() {
+        static tsunami_lab::kernels::e_isa l_isa = tsunami_lab::kernels::getBestIsa();
+        return l_isa;
+    }
+}  // namespace
+
+char const *tsunami_lab::kernels::getIsaName(e_isa i_isa) {
+    return c_isaNames[i_isa];
+}
+
+bool tsunami_lab::kernels::isAvailable(e_isa i_isa) {
+    return getBuiltKernels(i_isa) != nullptr && isSupported(i_isa);
+}
+
+tsunami_lab::kernels::e_isa tsunami_lab::kernels::getBestIsa() {
+    if (isAvailable(AVX512)) return AVX512;
+    if (isAvailable(AVX2)) return AVX2;
+    return SSE2;
+}
+
+bool tsunami_lab::kernels::selectIsa(std::string const &i_name) {
+    if (i_name == "auto") {
+        getSelectedIsa() = getBestIsa();
+        return true;
+    }
+
+    for (t_idx l_is = 0; l_is < c_nIsas; l_is++) {
+        e_isa l_isa = static_cast<e_isa>(l_is);
+        if (i_name == c_isaNames[l_is] && isAvailable(l_isa)) {
+            getSelectedIsa() = l_isa;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+tsunami_lab::kernels::e_isa tsunami_lab::kernels::getActiveIsa() {
+    return getSelectedIsa();
+}
+
+tsunami_lab::kernels::Kernels const &tsunami_lab::kernels::getKernels() {
+    return *getBuiltKernels(getSelectedIsa());
+}
+
+tsunami_lab::kernels::Kernels const &tsunami_lab::kernels::getKernels(e_isa i_isa) {
+    return *getBuiltKernels(i_isa);
+}
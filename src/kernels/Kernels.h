@@ -0,0 +1,214 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Hot kernels which are built once per instruction set level and selected at startup.
+ **/
+#ifndef TSUNAMI_LAB_KERNELS_KERNELS
+#define TSUNAMI_LAB_KERNELS_KERNELS
+
+#include <string>
+
+#include "../constants.h"
+
+/**
+ * The sweeps of the 2d patch, which hold the batched net-updates of the solvers, the ghost-cell copies and the row
+ * sums of the coarse output are compiled once for every instruction set level: SSE2, which every x86-64 CPU has,
+ * AVX2 and AVX-512. At startup the highest level supported by the CPU is selected, unless it is overridden.
+ * All levels are compiled without contracting multiplications and additions, such that they give identical results.
+ *
+ * The selection has to happen before the patches are constructed, since these keep the kernels of their construction.
+ **/
+namespace tsunami_lab {
+    namespace kernels {
+        //! number of edges which are solved at once; also the width of the blocks of columns of the y-sweep
+        static t_idx constexpr c_chunkSize = 128;
+
+        //! alignment in bytes of the rows' first inner cells in the layout of the 2d patch; blocks of columns whose rows
+        //! are aligned this way are swept with aligned loads and stores
+        static t_idx constexpr c_alignment = 64;
+
+        //! instruction set levels of the kernel builds
+        enum e_isa { SSE2,
+                     AVX2,
+                     AVX512 };
+
+        //! number of instruction set levels
+        static t_idx constexpr c_nIsas = 3;
+
+        /**
+         * Updates one row of cells in the x-sweep; see WavePropagation2d::sweepRow.
+         *
+         * @param i_nCells number of cells in the row including both ghost cells.
+         * @param i_scaling scaling of the time step (dt / dx).
+         * @param i_h water heights of the row before the sweep.
+         * @param i_hu momenta in x-direction of the row before the sweep.
+         * @param i_b bathymetries of the row.
+         * @param o_h will be set to the water heights of the inner cells after the sweep.
+         * @param o_hu will be set to the momenta in x-direction of the inner cells after the sweep.
+         * @return maximum absolute wave speed of the row's edges.
+         **/
+        typedef t_real (*t_sweepRow)(t_idx i_nCells,
+                                     t_real i_scaling,
+                                     t_real const *i_h,
+                                     t_real const *i_hu,
+                                     t_real const *i_b,
+                                     t_real *o_h,
+                                     t_real *o_hu);
+
+        /**
+         * Updates a block of up to c_chunkSize neighboring columns in the y-sweep; see WavePropagation2d::sweepColumns.
+         *
+         * @param i_nRows number of rows of the block including the two input-only rows.
+         * @param i_nCols number of columns of the block.
+         * @param i_stride stride of the rows.
+         * @param i_scaling scaling of the time step (dt / dy).
+         * @param i_h water heights of the block before the sweep.
+         * @param i_hv momenta in y-direction of the block before the sweep.
+         * @param i_b bathymetries of the block.
+         * @param o_h will be set to the water heights of the inner rows after the sweep.
+         * @param o_hv will be set to the momenta in y-direction of the inner rows after the sweep.
+         * @return maximum absolute wave speed of the block's edges.
+         **/
+        typedef t_real (*t_sweepColumns)(t_idx i_nRows,
+                                         t_idx i_nCols,
+                                         t_idx i_stride,
+                                         t_real i_scaling,
+                                         t_real const *i_h,
+                                         t_real const *i_hv,
+                                         t_real const *i_b,
+                                         t_real *o_h,
+                                         t_real *o_hv);
+
+        /**
+         * Copies the outer cells of a patch into the ghost cells of the given sides; the corners are left unchanged.
+         *
+         * @param i_nx number of inner cells in x-direction.
+         * @param i_ny number of inner cells in y-direction.
+         * @param i_stride stride of the rows, which include the ghost cells.
+         * @param i_axis sides which are set. 0: x-Axis (-1, 1: left, right); 1: y-Axis (-1, 1: bottom, top).
+         * @param io_data quantity of the cells including the ghost cells.
+         **/
+        typedef void (*t_copyGhostCellsOutflow)(t_idx i_nx,
+                                                t_idx i_ny,
+                                                t_idx i_stride,
+                                                short const i_axis[2],
+                                                t_real *io_data);
+
+        /**
+         * Sets the ghost cells of the given sides to a value; the corners are left unchanged.
+         *
+         * @param i_nx number of inner cells in x-direction.
+         * @param i_ny number of inner cells in y-direction.
+         * @param i_stride stride of the rows, which include the ghost cells.
+         * @param i_axis sides which are set. 0: x-Axis (-1, 1: left, right); 1: y-Axis (-1, 1: bottom, top).
+         * @param i_value value of the ghost cells.
+         * @param io_data quantity of the cells including the ghost cells.
+         **/
+        typedef void (*t_copyGhostCellsReflecting)(t_idx i_nx,
+                                                   t_idx i_ny,
+                                                   t_idx i_stride,
+                                                   short const i_axis[2],
+                                                   t_real i_value,
+                                                   t_real *io_data);
+
+        /**
+         * Adds a row of cells to the column sums of the coarse output.
+         *
+         * @param i_nCells number of cells of the row.
+         * @param i_row cells of the row.
+         * @param io_sums column sums to which the cells are added.
+         **/
+        typedef void (*t_addRow)(t_idx i_nCells,
+                                 t_real const *i_row,
+                                 double *io_sums);
+
+        //! kernels of one instruction set level
+        struct Kernels {
+            //! x-sweep of a row for every solver; indexed by e_solver
+            t_sweepRow sweepRow[2];
+
+            //! y-sweep of a block of columns for every solver; indexed by e_solver
+            t_sweepColumns sweepColumns[2];
+
+            //! outflow boundary of a quantity
+            t_copyGhostCellsOutflow copyGhostCellsOutflow;
+
+            //! reflecting boundary of a quantity
+            t_copyGhostCellsReflecting copyGhostCellsReflecting;
+
+            //! column sums of the coarse output
+            t_addRow addRow;
+        };
+
+        namespace sse2 {
+            //! kernels built for SSE2
+            Kernels const *getKernels();
+        }  // namespace sse2
+
+        namespace avx2 {
+            //! kernels built for AVX2 and FMA
+            Kernels const *getKernels();
+        }  // namespace avx2
+
+        namespace avx512 {
+            //! kernels built for AVX-512 (F, VL, BW, DQ)
+            Kernels const *getKernels();
+        }  // namespace avx512
+
+        /**
+         * Gets the name of an instruction set level, as accepted by selectIsa.
+         *
+         * @param i_isa instruction set level.
+         * @return name.
+         **/
+        char const *getIsaName(e_isa i_isa);
+
+        /**
+         * Checks if the kernels of an instruction set level are built and supported by the CPU.
+         *
+         * @param i_isa instruction set level.
+         * @return true if the kernels can be used.
+         **/
+        bool isAvailable(e_isa i_isa);
+
+        /**
+         * Gets the highest available instruction set level.
+         *
+         * @return instruction set level.
+         **/
+        e_isa getBestIsa();
+
+        /**
+         * Selects the kernels which are used by the patches constructed afterwards.
+         *
+         * @param i_name name of the instruction set level; "auto" selects the highest available one.
+         * @return true if the level is known and available; otherwise the selection is unchanged.
+         **/
+        bool selectIsa(std::string const &i_name);
+
+        /**
+         * Gets the instruction set level of the selected kernels.
+         *
+         * @return instruction set level; the highest available one if none was selected.
+         **/
+        e_isa getActiveIsa();
+
+        /**
+         * Gets the selected kernels.
+         *
+         * @return kernels.
+         **/
+        Kernels const &getKernels();
+
+        /**
+         * Gets the kernels of an instruction set level.
+         *
+         * @param i_isa instruction set level, which has to be available.
+         * @return kernels.
+         **/
+        Kernels const &getKernels(e_isa i_isa);
+    }  // namespace kernels
+}  // namespace tsunami_lab
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the kernels built per instruction set level.
+ **/
+#include "Kernels.h"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+#include "../patches/2d/Layout2d.h"
+#include "../patches/2d/WavePropagation2d.h"
+
+/**
+ * Initializes a patch with smoothly varying heights, momenta and bathymetries.
+ *
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ * @param i_dry true if some cells are dry.
+ * @param io_waveProp patch which is initialized.
+ **/
+static void setVaryingState(tsunami_lab::t_idx i_nx,
+                            tsunami_lab::t_idx i_ny,
+                            bool i_dry,
+                            tsunami_lab::patches::WavePropagation2d &io_waveProp) {
+    for (tsunami_lab::t_idx l_ceY = 0; l_ceY < i_ny; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 0; l_ceX < i_nx; l_ceX++) {
+            tsunami_lab::t_real l_h = 5 + std::sin(0.1 * l_ceX) + 0.03 * l_ceY;
+            if (i_dry && (l_ceX + 3 * l_ceY) % 37 == 0) l_h = 0;
+
+            io_waveProp.setHeight(l_ceX, l_ceY, l_h);
+            io_waveProp.setMomentumX(l_ceX, l_ceY, l_h * std::cos(0.05 * l_ceX));
+            io_waveProp.setMomentumY(l_ceX, l_ceY, l_h * std::sin(0.7 * l_ceY + 0.01 * l_ceX));
+            io_waveProp.setBathymetry(l_ceX, l_ceY, -5 - 0.01 * l_ceX);
+        }
+    }
+}
+
+TEST_CASE("Test the selection of the kernels' instruction set level.", "[Kernels]") {
+    /*
+     * Test case:
+     *   SSE2 is always available and auto selects the highest available level; unknown names are rejected and keep
+     *   the selection.
+     */
+    REQUIRE(tsunami_lab::kernels::isAvailable(tsunami_lab::kernels::SSE2));
+    REQUIRE(std::string(tsunami_lab::kernels::getIsaName(tsunami_lab::kernels::AVX512)) == "avx512");
+
+    REQUIRE(tsunami_lab::kernels::selectIsa("sse2"));
+    REQUIRE(tsunami_lab::kernels::getActiveIsa() == tsunami_lab::kernels::SSE2);
+    REQUIRE(&tsunami_lab::kernels::getKernels() == &tsunami_lab::kernels::getKernels(tsunami_lab::kernels::SSE2));
+
+    REQUIRE_FALSE(tsunami_lab::kernels::selectIsa("avx1024"));
+    REQUIRE_FALSE(tsunami_lab::kernels::selectIsa("AVX2"));
+    REQUIRE(tsunami_lab::kernels::getActiveIsa() == tsunami_lab::kernels::SSE2);
+
+    REQUIRE(tsunami_lab::kernels::selectIsa("auto"));
+    REQUIRE(tsunami_lab::kernels::getActiveIsa() == tsunami_lab::kernels::getBestIsa());
+    REQUIRE(tsunami_lab::kernels::isAvailable(tsunami_lab::kernels::getActiveIsa()));
+}
+
+TEST_CASE("Test the ghost-cell copies and the row sums of all instruction set levels against SSE2.", "[Kernels]") {
+    /*
+     * Test case:
+     *   Given a patch of 150 x 5 inner cells and a row of 300 cells.
+     *
+     *   Every available level has to set the same ghost cells and sums as SSE2.
+     */
+    tsunami_lab::t_idx l_nx = 150;
+    tsunami_lab::t_idx l_ny = 5;
+    tsunami_lab::t_idx l_stride = l_nx + 2;
+    tsunami_lab::kernels::Kernels const &l_ref = tsunami_lab::kernels::getKernels(tsunami_lab::kernels::SSE2);
+    short l_axis[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+
+    std::vector<tsunami_lab::t_real> l_row(300);
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_row.size(); l_ce++) l_row[l_ce] = std::sin(0.3 * l_ce);
+
+    for (tsunami_lab::t_idx l_is = 0; l_is < tsunami_lab::kernels::c_nIsas; l_is++) {
+        tsunami_lab::kernels::e_isa l_isa = static_cast<tsunami_lab::kernels::e_isa>(l_is);
+        if (!tsunami_lab::kernels::isAvailable(l_isa)) continue;
+        tsunami_lab::kernels::Kernels const &l_kernels = tsunami_lab::kernels::getKernels(l_isa);
+
+        for (tsunami_lab::t_idx l_si = 0; l_si < 4; l_si++) {
+            std::vector<tsunami_lab::t_real> l_dataRef(l_stride * (l_ny + 2));
+            for (tsunami_lab::t_idx l_ce = 0; l_ce < l_dataRef.size(); l_ce++) l_dataRef[l_ce] = l_ce;
+            std::vector<tsunami_lab::t_real> l_data = l_dataRef;
+
+            l_ref.copyGhostCellsOutflow(l_nx, l_ny, l_stride, l_axis[l_si], l_dataRef.data());
+            l_kernels.copyGhostCellsOutflow(l_nx, l_ny, l_stride, l_axis[l_si], l_data.data());
+            REQUIRE(l_data == l_dataRef);
+
+            l_ref.copyGhostCellsReflecting(l_nx, l_ny, l_stride, l_axis[l_si], -1, l_dataRef.data());
+            l_kernels.copyGhostCellsReflecting(l_nx, l_ny, l_stride, l_axis[l_si], -1, l_data.data());
+            REQUIRE(l_data == l_dataRef);
+        }
+
+        std::vector<double> l_sumsRef(l_row.size(), 0.5);
+        std::vector<double> l_sums = l_sumsRef;
+        for (unsigned short l_it = 0; l_it < 3; l_it++) {
+            l_ref.addRow(l_row.size(), l_row.data(), l_sumsRef.data());
+            l_kernels.addRow(l_row.size(), l_row.data(), l_sums.data());
+        }
+        REQUIRE(l_sums == l_sumsRef);
+    }
+}
+
+TEST_CASE("Test the y-sweep of aligned blocks against unaligned ones.", "[Kernels]") {
+    /*
+     * Test case:
+     *   Given a block of 128 columns and 12 rows, once in the padded rows of the 2d layout, whose first inner cells are
+     *   aligned, and once in rows of 131 values, which are not aligned.
+     *
+     *   Both have to give bit for bit the same results for every available level and solver.
+     */
+    tsunami_lab::t_idx l_nx = 150;
+    tsunami_lab::t_idx l_nRows = 12;
+    tsunami_lab::t_idx l_nCols = 128;
+    tsunami_lab::t_idx l_strideUnaligned = 131;
+    tsunami_lab::patches::Layout2d l_layout(l_nx, l_nRows - 2);
+    tsunami_lab::t_idx l_stride = l_layout.getStride();
+
+    tsunami_lab::t_real *l_aligned[5];
+    std::vector<tsunami_lab::t_real> l_unaligned[5];
+    for (unsigned short l_ar = 0; l_ar < 5; l_ar++) {
+        l_aligned[l_ar] = l_layout.allocate(l_nRows);
+        l_unaligned[l_ar].resize(l_strideUnaligned * l_nRows + 1);
+    }
+
+    for (tsunami_lab::t_idx l_is = 0; l_is < tsunami_lab::kernels::c_nIsas; l_is++) {
+        tsunami_lab::kernels::e_isa l_isa = static_cast<tsunami_lab::kernels::e_isa>(l_is);
+        if (!tsunami_lab::kernels::isAvailable(l_isa)) continue;
+        tsunami_lab::kernels::Kernels const &l_kernels = tsunami_lab::kernels::getKernels(l_isa);
+
+        for (unsigned short l_so = 0; l_so < 2; l_so++) {
+            // h, hv and b of the block; the outputs are zero
+            for (tsunami_lab::t_idx l_ro = 0; l_ro < l_nRows; l_ro++) {
+                for (tsunami_lab::t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                    tsunami_lab::t_real l_values[5] = {tsunami_lab::t_real(5 + std::sin(0.1 * l_co + 0.3 * l_ro)),
+                                                       tsunami_lab::t_real(std::cos(0.05 * l_co) - 0.1 * l_ro),
+                                                       tsunami_lab::t_real(-5 - 0.01 * l_co),
+                                                       0,
+                                                       0};
+                    for (unsigned short l_ar = 0; l_ar < 5; l_ar++) {
+                        l_aligned[l_ar][l_layout.getIndex(1 + l_co, l_ro)] = l_values[l_ar];
+                        l_unaligned[l_ar][1 + l_ro * l_strideUnaligned + l_co] = l_values[l_ar];
+                    }
+                }
+            }
+
+            tsunami_lab::t_idx l_first = l_layout.getIndex(1, 0);
+            tsunami_lab::t_real l_waveSpeed = l_kernels.sweepColumns[l_so](l_nRows,
+                                                                          l_nCols,
+                                                                          l_stride,
+                                                                          0.01,
+                                                                          l_aligned[0] + l_first,
+                                                                          l_aligned[1] + l_first,
+                                                                          l_aligned[2] + l_first,
+                                                                          l_aligned[3] + l_first,
+                                                                          l_aligned[4] + l_first);
+            tsunami_lab::t_real l_waveSpeedUnaligned = l_kernels.sweepColumns[l_so](l_nRows,
+                                                                                   l_nCols,
+                                                                                   l_strideUnaligned,
+                                                                                   0.01,
+                                                                                   l_unaligned[0].data() + 1,
+                                                                                   l_unaligned[1].data() + 1,
+                                                                                   l_unaligned[2].data() + 1,
+                                                                                   l_unaligned[3].data() + 1,
+                                                                                   l_unaligned[4].data() + 1);
+            REQUIRE(l_waveSpeed > 0);
+            REQUIRE(l_waveSpeed == l_waveSpeedUnaligned);
+
+            for (tsunami_lab::t_idx l_ro = 1; l_ro < l_nRows - 1; l_ro++) {
+                for (tsunami_lab::t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                    REQUIRE(l_aligned[3][l_layout.getIndex(1 + l_co, l_ro)] == l_unaligned[3][1 + l_ro * l_strideUnaligned + l_co]);
+                    REQUIRE(l_aligned[4][l_layout.getIndex(1 + l_co, l_ro)] == l_unaligned[4][1 + l_ro * l_strideUnaligned + l_co]);
+                }
+            }
+        }
+    }
+
+    for (unsigned short l_ar = 0; l_ar < 5; l_ar++) tsunami_lab::patches::Layout2d::free(l_aligned[l_ar]);
+}
+
+TEST_CASE("Test the 2d sweeps of all instruction set levels against SSE2.", "[Kernels]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 300 x 140 cells, i.e., several chunks in x-direction and tiles in y-direction.
+     *   The F-wave solver runs on dry cells and reflecting boundaries, the Roe solver on wet cells and outflow
+     *   boundaries.
+     *
+     *   After several time steps every available level has to give bit for bit the same results as SSE2.
+     */
+    tsunami_lab::t_idx l_nx = 300;
+    tsunami_lab::t_idx l_ny = 140;
+    tsunami_lab::e_solver l_solvers[2] = {tsunami_lab::FWAVE, tsunami_lab::ROE};
+
+    for (tsunami_lab::t_idx l_is = 1; l_is < tsunami_lab::kernels::c_nIsas; l_is++) {
+        tsunami_lab::kernels::e_isa l_isa = static_cast<tsunami_lab::kernels::e_isa>(l_is);
+        if (!tsunami_lab::kernels::isAvailable(l_isa)) continue;
+
+        for (unsigned short l_so = 0; l_so < 2; l_so++) {
+            bool l_fWave = l_solvers[l_so] == tsunami_lab::FWAVE;
+            tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx,
+                                                               l_ny,
+                                                               0,
+                                                               false,
+                                                               l_solvers[l_so],
+                                                               &tsunami_lab::kernels::getKernels(tsunami_lab::kernels::SSE2));
+            tsunami_lab::patches::WavePropagation2d l_wavePropIsa(l_nx,
+                                                                  l_ny,
+                                                                  0,
+                                                                  false,
+                                                                  l_solvers[l_so],
+                                                                  &tsunami_lab::kernels::getKernels(l_isa));
+            setVaryingState(l_nx, l_ny, l_fWave, l_waveProp);
+            setVaryingState(l_nx, l_ny, l_fWave, l_wavePropIsa);
+
+            tsunami_lab::e_boundary l_bound = l_fWave ? tsunami_lab::REFLECTING : tsunami_lab::OUTFLOW;
+            tsunami_lab::e_boundary l_boundary[4] = {l_bound, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, l_bound};
+
+            for (int l_st = 0; l_st < 5; l_st++) {
+                l_waveProp.setGhostCells(l_boundary);
+                l_waveProp.timeStep(0.01, 0.02);
+
+                l_wavePropIsa.setGhostCells(l_boundary);
+                l_wavePropIsa.timeStep(0.01, 0.02);
+
+                REQUIRE(l_waveProp.getMaxWaveSpeed() > 0);
+                REQUIRE(l_waveProp.getMaxWaveSpeed() == l_wavePropIsa.getMaxWaveSpeed());
+            }
+
+            tsunami_lab::t_idx l_nCells = l_waveProp.getStride() * (l_ny + 2);
+            for (tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++) {
+                REQUIRE(l_waveProp.getHeight()[l_ce] == l_wavePropIsa.getHeight()[l_ce]);
+                REQUIRE(l_waveProp.getMomentumX()[l_ce] == l_wavePropIsa.getMomentumX()[l_ce]);
+                REQUIRE(l_waveProp.getMomentumY()[l_ce] == l_wavePropIsa.getMomentumY()[l_ce]);
+            }
+        }
+    }
+}
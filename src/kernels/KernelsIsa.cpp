@@ -0,0 +1,299 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Hot kernels of one instruction set level; compiled once per level.
+ **/
+#include <algorithm>
+#include <cstdint>
+
+#include "../solvers/FWave.h"
+#include "../solvers/Roe.h"
+#include "Kernels.h"
+
+// the build defines the level of this object, e.g., avx2; the kernels are declared in the namespace of that name
+#ifndef TSUNAMI_LAB_KERNELS_ISA
+#define TSUNAMI_LAB_KERNELS_ISA sse2
+#endif
+
+/*
+ * Everything but getKernels has internal linkage and every callee is flattened into the kernels. Thus no inline
+ * function of the solvers is emitted with this level's instructions under a name the linker could pick for another
+ * object file, which would execute them on CPUs without the level.
+ */
+namespace {
+    using tsunami_lab::t_idx;
+    using tsunami_lab::t_real;
+    using tsunami_lab::kernels::c_alignment;
+    using tsunami_lab::kernels::c_chunkSize;
+
+    /**
+     * Passes a pointer on, which the compiler may assume to be aligned to c_alignment if the block is aligned.
+     *
+     * @param i_ptr pointer.
+     * @return pointer.
+     **/
+    template <bool t_aligned, typename t_type>
+    inline t_type *assumeAligned(t_type *i_ptr) {
+        return t_aligned ? static_cast<t_type *>(__builtin_assume_aligned(i_ptr, c_alignment)) : i_ptr;
+    }
+
+    /**
+     * Checks if a pointer is aligned to c_alignment.
+     *
+     * @param i_ptr pointer.
+     * @return true if aligned.
+     **/
+    inline bool isAligned(void const *i_ptr) {
+        return reinterpret_cast<std::uintptr_t>(i_ptr) % c_alignment == 0;
+    }
+
+    template <typename t_solver>
+    __attribute__((flatten)) t_real sweepRow(t_idx i_nCells,
+                                             t_real i_scaling,
+                                             t_real const *i_h,
+                                             t_real const *i_hu,
+                                             t_real const *i_b,
+                                             t_real *o_h,
+                                             t_real *o_hu) {
+        // net-updates of the edges in the current chunk; entry 0 of the right-going updates
+        // carries the update of the last edge of the previous chunk
+        t_real l_netUpdatesL[2][c_chunkSize];
+        t_real l_netUpdatesR[2][c_chunkSize + 1];
+        t_real l_waveSpeedMax = 0;
+
+        // velocities, roots of the heights and fluxes of the cells of the current chunk; entry 0 carries the terms of
+        // the last cell of the previous chunk
+        t_real l_terms[3][c_chunkSize + 1];
+
+        t_idx l_nEdges = i_nCells - 1;
+        for (t_idx l_ed0 = 0; l_ed0 < l_nEdges; l_ed0 += c_chunkSize) {
+            t_idx l_nChunk = std::min(c_chunkSize, l_nEdges - l_ed0);
+
+            // compute the terms of every cell in the chunk once
+            t_idx l_first = (l_ed0 == 0) ? 0 : 1;
+            t_solver::cellTerms(l_nChunk + 1 - l_first,
+                                i_h + l_ed0 + l_first,
+                                i_hu + l_ed0 + l_first,
+                                l_terms[0] + l_first,
+                                l_terms[1] + l_first,
+                                l_terms[2] + l_first);
+
+            // compute the net-updates of every edge in the chunk once
+            t_real l_waveSpeed = t_solver::netUpdatesBatch(l_nChunk,
+                                                           i_h + l_ed0,
+                                                           i_h + l_ed0 + 1,
+                                                           i_hu + l_ed0,
+                                                           i_hu + l_ed0 + 1,
+                                                           i_b + l_ed0,
+                                                           i_b + l_ed0 + 1,
+                                                           l_terms[0],
+                                                           l_terms[0] + 1,
+                                                           l_terms[1],
+                                                           l_terms[1] + 1,
+                                                           l_terms[2],
+                                                           l_terms[2] + 1,
+                                                           l_netUpdatesL[0],
+                                                           l_netUpdatesL[1],
+                                                           l_netUpdatesR[0] + 1,
+                                                           l_netUpdatesR[1] + 1);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+
+            // gather: every inner cell receives the update of its left edge first and then the one of its right edge
+            for (t_idx l_ed = (l_ed0 == 0) ? 1 : 0; l_ed < l_nChunk; l_ed++) {
+                t_idx l_ce = l_ed0 + l_ed;
+
+                o_h[l_ce] = i_h[l_ce] - i_scaling * l_netUpdatesR[0][l_ed];
+                o_h[l_ce] -= i_scaling * l_netUpdatesL[0][l_ed];
+
+                o_hu[l_ce] = i_hu[l_ce] - i_scaling * l_netUpdatesR[1][l_ed];
+                o_hu[l_ce] -= i_scaling * l_netUpdatesL[1][l_ed];
+            }
+
+            l_netUpdatesR[0][0] = l_netUpdatesR[0][l_nChunk];
+            l_netUpdatesR[1][0] = l_netUpdatesR[1][l_nChunk];
+            for (unsigned short l_te = 0; l_te < 3; l_te++) l_terms[l_te][0] = l_terms[l_te][l_nChunk];
+        }
+
+        return l_waveSpeedMax;
+    }
+
+    template <typename t_solver, bool t_aligned>
+    __attribute__((flatten)) t_real sweepColumnsBlock(t_idx i_nRows,
+                                                      t_idx i_nCols,
+                                                      t_idx i_stride,
+                                                      t_real i_scaling,
+                                                      t_real const *i_h,
+                                                      t_real const *i_hv,
+                                                      t_real const *i_b,
+                                                      t_real *o_h,
+                                                      t_real *o_hv) {
+        // net-updates of the current row of edges; the upward-going updates alternate between two rows,
+        // such that the ones of the edges below the current cells are still available
+        alignas(c_alignment) t_real l_netUpdatesL[2][c_chunkSize];
+        alignas(c_alignment) t_real l_netUpdatesR[2][2][c_chunkSize];
+        t_real l_waveSpeedMax = 0;
+
+        // velocities, roots of the heights and fluxes of the cells, which alternate between two rows like the updates
+        alignas(c_alignment) t_real l_terms[2][3][c_chunkSize];
+        t_solver::cellTerms(i_nCols,
+                            assumeAligned<t_aligned>(i_h),
+                            assumeAligned<t_aligned>(i_hv),
+                            l_terms[0][0],
+                            l_terms[0][1],
+                            l_terms[0][2]);
+
+        for (t_idx l_ed = 0; l_ed < i_nRows - 1; l_ed++) {
+            t_idx l_idxL = l_ed * i_stride;
+            t_idx l_idxR = l_idxL + i_stride;
+            unsigned short l_cur = l_ed % 2;
+
+            // rows l_ed and l_ed + 1 of the block
+            t_real const *l_hL = assumeAligned<t_aligned>(i_h + l_idxL);
+            t_real const *l_hR = assumeAligned<t_aligned>(i_h + l_idxR);
+            t_real const *l_hvL = assumeAligned<t_aligned>(i_hv + l_idxL);
+            t_real const *l_hvR = assumeAligned<t_aligned>(i_hv + l_idxR);
+            t_real const *l_bL = assumeAligned<t_aligned>(i_b + l_idxL);
+            t_real const *l_bR = assumeAligned<t_aligned>(i_b + l_idxR);
+
+            // compute the terms of the cells of row l_ed + 1 once
+            t_real(*l_termsL)[c_chunkSize] = l_terms[l_cur];
+            t_real(*l_termsR)[c_chunkSize] = l_terms[1 - l_cur];
+            t_solver::cellTerms(i_nCols, l_hR, l_hvR, l_termsR[0], l_termsR[1], l_termsR[2]);
+
+            // compute the net-updates of the edges between rows l_ed and l_ed + 1
+            t_real l_waveSpeed = t_solver::netUpdatesBatch(i_nCols,
+                                                           l_hL,
+                                                           l_hR,
+                                                           l_hvL,
+                                                           l_hvR,
+                                                           l_bL,
+                                                           l_bR,
+                                                           l_termsL[0],
+                                                           l_termsR[0],
+                                                           l_termsL[1],
+                                                           l_termsR[1],
+                                                           l_termsL[2],
+                                                           l_termsR[2],
+                                                           l_netUpdatesL[0],
+                                                           l_netUpdatesL[1],
+                                                           l_netUpdatesR[l_cur][0],
+                                                           l_netUpdatesR[l_cur][1]);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+
+            // row l_ed has all its net-updates now: first the one of the edge below, then the one of the edge above
+            if (l_ed > 0) {
+                t_real const *l_netUpdatesBelowH = l_netUpdatesR[1 - l_cur][0];
+                t_real const *l_netUpdatesBelowHv = l_netUpdatesR[1 - l_cur][1];
+                t_real *l_hOut = assumeAligned<t_aligned>(o_h + l_idxL);
+                t_real *l_hvOut = assumeAligned<t_aligned>(o_hv + l_idxL);
+
+                for (t_idx l_co = 0; l_co < i_nCols; l_co++) {
+                    l_hOut[l_co] = l_hL[l_co] - i_scaling * l_netUpdatesBelowH[l_co];
+                    l_hOut[l_co] -= i_scaling * l_netUpdatesL[0][l_co];
+
+                    l_hvOut[l_co] = l_hvL[l_co] - i_scaling * l_netUpdatesBelowHv[l_co];
+                    l_hvOut[l_co] -= i_scaling * l_netUpdatesL[1][l_co];
+                }
+            }
+        }
+
+        return l_waveSpeedMax;
+    }
+
+    template <typename t_solver>
+    t_real sweepColumns(t_idx i_nRows,
+                        t_idx i_nCols,
+                        t_idx i_stride,
+                        t_real i_scaling,
+                        t_real const *i_h,
+                        t_real const *i_hv,
+                        t_real const *i_b,
+                        t_real *o_h,
+                        t_real *o_hv) {
+        // blocks which start at the aligned first inner cells of padded rows are swept with aligned loads and stores
+        bool l_aligned = isAligned(i_h) && isAligned(i_hv) && isAligned(i_b) && isAligned(o_h) && isAligned(o_hv) &&
+                         (i_stride * sizeof(t_real)) % c_alignment == 0;
+
+        if (l_aligned) {
+            return sweepColumnsBlock<t_solver, true>(i_nRows, i_nCols, i_stride, i_scaling, i_h, i_hv, i_b, o_h, o_hv);
+        }
+        return sweepColumnsBlock<t_solver, false>(i_nRows, i_nCols, i_stride, i_scaling, i_h, i_hv, i_b, o_h, o_hv);
+    }
+
+    void copyGhostCellsOutflow(t_idx i_nx,
+                               t_idx i_ny,
+                               t_idx i_stride,
+                               short const i_axis[2],
+                               t_real *io_data) {
+        t_idx l_xMax = i_nx + 1;
+        t_idx l_yMax = i_ny + 1;
+
+        if (i_axis[0] == 1) {
+            for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
+                io_data[l_iy * i_stride + l_xMax] = io_data[l_iy * i_stride + l_xMax - 1];
+            }
+        } else if (i_axis[0] == -1) {
+            for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
+                io_data[l_iy * i_stride] = io_data[l_iy * i_stride + 1];
+            }
+        }
+
+        // the rows are contiguous and copied as vectors
+        if (i_axis[1] != 0) {
+            t_real *l_ghost = io_data + ((i_axis[1] == 1) ? l_yMax * i_stride : 0);
+            t_real const *l_inner = io_data + ((i_axis[1] == 1) ? (l_yMax - 1) * i_stride : i_stride);
+#pragma omp simd
+            for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
+                l_ghost[l_ix] = l_inner[l_ix];
+            }
+        }
+    }
+
+    void copyGhostCellsReflecting(t_idx i_nx,
+                                  t_idx i_ny,
+                                  t_idx i_stride,
+                                  short const i_axis[2],
+                                  t_real i_value,
+                                  t_real *io_data) {
+        t_idx l_xMax = i_nx + 1;
+        t_idx l_yMax = i_ny + 1;
+
+        if (i_axis[0] == 1) {
+            for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
+                io_data[l_iy * i_stride + l_xMax] = i_value;
+            }
+        } else if (i_axis[0] == -1) {
+            for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
+                io_data[l_iy * i_stride] = i_value;
+            }
+        }
+
+        if (i_axis[1] != 0) {
+            t_real *l_ghost = io_data + ((i_axis[1] == 1) ? l_yMax * i_stride : 0);
+#pragma omp simd
+            for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
+                l_ghost[l_ix] = i_value;
+            }
+        }
+    }
+
+    void addRow(t_idx i_nCells,
+                t_real const *i_row,
+                double *io_sums) {
+#pragma omp simd
+        for (t_idx l_ce = 0; l_ce < i_nCells; l_ce++) {
+            io_sums[l_ce] += i_row[l_ce];
+        }
+    }
+}  // namespace
+
+tsunami_lab::kernels::Kernels const *tsunami_lab::kernels::TSUNAMI_LAB_KERNELS_ISA::getKernels() {
+    static Kernels const l_kernels = {{sweepRow<solvers::FWave>, sweepRow<solvers::Roe>},
+                                      {sweepColumns<solvers::FWave>, sweepColumns<solvers::Roe>},
+                                      copyGhostCellsOutflow,
+                                      copyGhostCellsReflecting,
+                                      addRow};
+
+    return &l_kernels;
+}
@@ -10,13 +10,36 @@
 #include <iostream>
 #include <limits>
 
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
 #include "configs/FlagConfig.h"
 #include "configs/SimConfig.h"
 #include "io/Json/ConfigLoader.h"
+#include "kernels/Kernels.h"
 #include "simulator/Simulator.h"
 #include "timer.h"
 
 int main(int i_argc, char *i_argv[]) {
+#ifdef USE_MPI
+    // the master thread of the OpenMP team exchanges the halos
+    int l_threadSupport = 0;
+    MPI_Init_thread(&i_argc, &i_argv, MPI_THREAD_FUNNELED, &l_threadSupport);
+
+    // only rank 0 reports
+    int l_rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &l_rank);
+    if (l_rank != 0) std::cout.setstate(std::ios_base::failbit);
+
+    // the overlapped time step calls MPI from within a parallel region; all processes get the same level
+    if (l_threadSupport < MPI_THREAD_FUNNELED) {
+        if (l_rank == 0) std::cerr << "the MPI library does not support MPI_THREAD_FUNNELED" << std::endl;
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+#endif
+
     std::cout << "####################################" << std::endl;
     std::cout << "### Tsunami Lab                  ###" << std::endl;
     std::cout << "###                              ###" << std::endl;
@@ -26,6 +49,9 @@ int main(int i_argc, char *i_argv[]) {
     if (i_argc < 2) {
         std::cerr << "invalid number of program parameter" << std::endl;
         std::cerr << "  ./build/tsunami_lab CONFIG_FILE_NAME.json" << std::endl;
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
         return EXIT_FAILURE;
     }
 
@@ -42,10 +68,29 @@ int main(int i_argc, char *i_argv[]) {
                 l_flagConfig.setUseTiming(true);
             } else if (std::string(i_argv[l_arguments]).compare("-nio") == 0) {
 					l_flagConfig.setUseIO(false);
-				}
+            } else if (std::string(i_argv[l_arguments]).compare("-trace") == 0) {
+                l_flagConfig.setUseTrace(true);
+            } else if (std::string(i_argv[l_arguments]).compare("--kernel-isa") == 0 && l_arguments + 1 < i_argc) {
+                l_flagConfig.setKernelIsa(i_argv[++l_arguments]);
+            }
         }
     }
 
+    // the kernels are selected before any patch is constructed
+    if (!tsunami_lab::kernels::selectIsa(l_flagConfig.getKernelIsa())) {
+        std::cerr << "kernel ISA " << l_flagConfig.getKernelIsa() << " is unknown or not supported, available:";
+        for (tsunami_lab::t_idx l_is = 0; l_is < tsunami_lab::kernels::c_nIsas; l_is++) {
+            tsunami_lab::kernels::e_isa l_isa = static_cast<tsunami_lab::kernels::e_isa>(l_is);
+            if (tsunami_lab::kernels::isAvailable(l_isa)) std::cerr << " " << tsunami_lab::kernels::getIsaName(l_isa);
+        }
+        std::cerr << std::endl;
+        delete l_timer;
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return EXIT_FAILURE;
+    }
+
     tsunami_lab::setups::Setup *l_setups = nullptr;
     tsunami_lab::t_real l_hStar = -1;
     tsunami_lab::configs::SimConfig l_simConfig = tsunami_lab::configs::SimConfig();
@@ -63,14 +108,29 @@ int main(int i_argc, char *i_argv[]) {
         std::cout << "failed to read: " << l_configName << std::endl;
         delete l_setups;
         delete l_timer;
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
         return EXIT_FAILURE;
     }
 
     // start simulation from config
+#ifdef USE_MPI
+    // 2d simulations are distributed over all processes, 1d simulations run on rank 0
+    if (l_simConfig.getDimension() == 2) {
+        tsunami_lab::simulator::runSimulationMpi(l_setups, l_simConfig);
+    } else if (l_rank == 0) {
+        tsunami_lab::simulator::runSimulation(l_setups, l_hStar, l_simConfig);
+    }
+#else
     tsunami_lab::simulator::runSimulation(l_setups, l_hStar, l_simConfig);
+#endif
 
     delete l_setups;
     delete l_timer;
     std::cout << "finished, exiting" << std::endl;
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
     return EXIT_SUCCESS;
 }
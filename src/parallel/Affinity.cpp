@@ -0,0 +1,191 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Pinning of the OpenMP threads to cores and placement of pages on NUMA nodes.
+ **/
+#include "Affinity.h"
+
+#include <omp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace {
+    /**
+     * Reads an id of the topology of a hardware thread from sysfs.
+     *
+     * @param i_cpu id of the hardware thread.
+     * @param i_name name of the id, e.g., core_id.
+     * @param i_default value if the id is not available.
+     * @return id.
+     **/
+    int readTopology(int i_cpu,
+                     char const *i_name,
+                     int i_default) {
+        std::ifstream l_file("/sys/devices/system/cpu/cpu" + std::to_string(i_cpu) + "/topology/" + i_name);
+        int l_id = i_default;
+        if (!(l_file >> l_id)) return i_default;
+        return l_id;
+    }
+
+    /**
+     * Gets the affinity mask the process inherited; derived once, since the mask of the calling thread shrinks when
+     * it is pinned.
+     *
+     * @param o_set will be set to the mask.
+     * @return true if the mask is available.
+     **/
+    bool getInheritedMask(cpu_set_t &o_set) {
+        static cpu_set_t l_set;
+        static bool const l_valid = []() {
+            CPU_ZERO(&l_set);
+            return sched_getaffinity(0, sizeof(l_set), &l_set) == 0;
+        }();
+
+        o_set = l_set;
+        return l_valid;
+    }
+}  // namespace
+
+char const *tsunami_lab::parallel::Affinity::getName(e_affinity i_affinity) {
+    if (i_affinity == AFFINITY_CLOSE) return "close";
+    if (i_affinity == AFFINITY_SPREAD) return "spread";
+    return "none";
+}
+
+bool tsunami_lab::parallel::Affinity::isSetByEnvironment() {
+    return std::getenv("OMP_PROC_BIND") != nullptr || std::getenv("OMP_PLACES") != nullptr;
+}
+
+std::vector<std::vector<int> > tsunami_lab::parallel::Affinity::getCores() {
+    static std::vector<std::vector<int> > const l_cores = []() {
+        std::vector<std::vector<int> > l_cores;
+
+        cpu_set_t l_set;
+        if (!getInheritedMask(l_set)) return l_cores;
+
+        // hardware threads grouped by socket and core; without topology every hardware thread is a core
+        std::map<std::pair<int, int>, std::vector<int> > l_groups;
+        for (int l_cpu = 0; l_cpu < CPU_SETSIZE; l_cpu++) {
+            if (!CPU_ISSET(l_cpu, &l_set)) continue;
+            int l_socket = readTopology(l_cpu, "physical_package_id", 0);
+            int l_core = readTopology(l_cpu, "core_id", l_cpu);
+            l_groups[std::make_pair(l_socket, l_core)].push_back(l_cpu);
+        }
+
+        for (std::map<std::pair<int, int>, std::vector<int> >::const_iterator l_it = l_groups.begin(); l_it != l_groups.end(); l_it++) {
+            l_cores.push_back(l_it->second);
+        }
+        return l_cores;
+    }();
+
+    return l_cores;
+}
+
+tsunami_lab::t_idx tsunami_lab::parallel::Affinity::getCore(e_affinity i_affinity,
+                                                            t_idx i_thread,
+                                                            t_idx i_nThreads,
+                                                            t_idx i_nCores) {
+    if (i_affinity == AFFINITY_SPREAD && i_nThreads <= i_nCores) {
+        return i_thread * i_nCores / i_nThreads;
+    }
+    return i_thread % i_nCores;
+}
+
+void tsunami_lab::parallel::Affinity::getPartition(t_idx i_partition,
+                                                   t_idx i_nPartitions,
+                                                   t_idx i_nCores,
+                                                   t_idx &o_first,
+                                                   t_idx &o_nCores) {
+    if (i_nCores == 0) {
+        o_first = 0;
+        o_nCores = 0;
+        return;
+    }
+
+    if (i_nPartitions > i_nCores) {
+        o_first = i_partition % i_nCores;
+        o_nCores = 1;
+        return;
+    }
+
+    o_first = i_partition * i_nCores / i_nPartitions;
+    o_nCores = (i_partition + 1) * i_nCores / i_nPartitions - o_first;
+}
+
+tsunami_lab::t_idx tsunami_lab::parallel::Affinity::pinThreads(e_affinity i_affinity,
+                                                               t_idx i_partition,
+                                                               t_idx i_nPartitions) {
+    if (i_affinity == AFFINITY_NONE || isSetByEnvironment()) return 0;
+
+    std::vector<std::vector<int> > l_cores = getCores();
+    if (l_cores.empty()) return 0;
+
+    t_idx l_first = 0;
+    t_idx l_nCores = 0;
+    getPartition(i_partition, i_nPartitions, l_cores.size(), l_first, l_nCores);
+
+    // the runtime keeps its threads, such that the team of every later parallel region runs on the same cores
+    t_idx l_nPinned = 0;
+#pragma omp parallel reduction(+ : l_nPinned)
+    {
+        t_idx l_core = l_first + getCore(i_affinity, omp_get_thread_num(), omp_get_num_threads(), l_nCores);
+
+        cpu_set_t l_set;
+        CPU_ZERO(&l_set);
+        for (std::size_t l_hw = 0; l_hw < l_cores[l_core].size(); l_hw++) CPU_SET(l_cores[l_core][l_hw], &l_set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(l_set), &l_set) == 0) l_nPinned++;
+    }
+
+    return l_nPinned;
+}
+
+bool tsunami_lab::parallel::Affinity::unpinThread() {
+    cpu_set_t l_set;
+    if (!getInheritedMask(l_set)) return false;
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(l_set), &l_set) == 0;
+}
+
+bool tsunami_lab::parallel::Affinity::countPagesPerNode(void const *i_data,
+                                                        t_idx i_bytes,
+                                                        std::vector<t_idx> &io_pages) {
+    if (i_bytes == 0) return true;
+
+    std::uintptr_t l_pageSize = sysconf(_SC_PAGESIZE);
+    std::uintptr_t l_first = reinterpret_cast<std::uintptr_t>(i_data) / l_pageSize * l_pageSize;
+    std::uintptr_t l_end = reinterpret_cast<std::uintptr_t>(i_data) + i_bytes;
+
+    // without target nodes move_pages only reports the node of every page, or a negative error if it is not mapped
+    t_idx const l_nBatch = 4096;
+    std::vector<void *> l_pages(l_nBatch);
+    std::vector<int> l_status(l_nBatch);
+
+    for (std::uintptr_t l_page0 = l_first; l_page0 < l_end; l_page0 += l_nBatch * l_pageSize) {
+        t_idx l_nPages = std::min<std::uintptr_t>(l_nBatch, (l_end - l_page0 + l_pageSize - 1) / l_pageSize);
+        for (t_idx l_pa = 0; l_pa < l_nPages; l_pa++) {
+            l_pages[l_pa] = reinterpret_cast<void *>(l_page0 + l_pa * l_pageSize);
+        }
+
+        if (syscall(SYS_move_pages, 0, l_nPages, l_pages.data(), nullptr, l_status.data(), 0) != 0) return false;
+
+        for (t_idx l_pa = 0; l_pa < l_nPages; l_pa++) {
+            if (l_status[l_pa] < 0) continue;
+            t_idx l_node = l_status[l_pa];
+            if (io_pages.size() <= l_node) io_pages.resize(l_node + 1, 0);
+            io_pages[l_node]++;
+        }
+    }
+
+    return true;
+}
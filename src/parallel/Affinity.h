@@ -0,0 +1,124 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Pinning of the OpenMP threads to cores and placement of pages on NUMA nodes.
+ **/
+#ifndef TSUNAMI_LAB_PARALLEL_AFFINITY
+#define TSUNAMI_LAB_PARALLEL_AFFINITY
+
+#include <vector>
+
+#include "../constants.h"
+
+namespace tsunami_lab {
+    namespace parallel {
+        class Affinity;
+
+        //! presets of the thread affinity, named after the proc_bind policies of OpenMP on the places "cores"
+        enum e_affinity { AFFINITY_NONE,
+                          AFFINITY_CLOSE,
+                          AFFINITY_SPREAD };
+    }  // namespace parallel
+}  // namespace tsunami_lab
+
+/**
+ * The places are the cores the process may run on, i.e., of the affinity mask the process inherited, ordered by socket
+ * and core, each with all of its hardware threads. Processes which share the mask, e.g., the MPI ranks of a node
+ * without binding, split the cores into contiguous partitions. "close" binds thread i to core i of the partition, such
+ * that the first socket is filled first; "spread" distributes the threads evenly over all cores of the partition.
+ * More threads than cores wrap around.
+ *
+ * The threads are pinned once before the patches are constructed: the patches zero their arrays in parallel with the
+ * partition of their sweeps, such that every page is placed on the NUMA node of the thread which updates it.
+ * Threads and processes created by a pinned thread inherit its core; helpers, e.g., output threads, restore the
+ * inherited mask through unpinThread. An affinity set through OMP_PROC_BIND or OMP_PLACES is left to the OpenMP
+ * runtime.
+ **/
+class tsunami_lab::parallel::Affinity {
+   public:
+    /**
+     * Gets the name of a preset.
+     *
+     * @param i_affinity preset.
+     * @return name, i.e., none, close or spread.
+     **/
+    static char const *getName(e_affinity i_affinity);
+
+    /**
+     * Checks if the affinity is set through the environment of the OpenMP runtime.
+     *
+     * @return true if OMP_PROC_BIND or OMP_PLACES is set.
+     **/
+    static bool isSetByEnvironment();
+
+    /**
+     * Gets the cores the process may run on, i.e., of the mask it inherited before any thread was pinned.
+     *
+     * @return ids of the hardware threads of every core, ordered by socket and core.
+     **/
+    static std::vector<std::vector<int> > getCores();
+
+    /**
+     * Gets the contiguous cores of a partition; partitions without cores, i.e., with more partitions than cores,
+     * share single cores.
+     *
+     * @param i_partition id of the partition.
+     * @param i_nPartitions number of partitions.
+     * @param i_nCores number of cores.
+     * @param o_first will be set to the id of the first core of the partition.
+     * @param o_nCores will be set to the number of cores of the partition; at least 1 if there are cores.
+     **/
+    static void getPartition(t_idx i_partition,
+                             t_idx i_nPartitions,
+                             t_idx i_nCores,
+                             t_idx &o_first,
+                             t_idx &o_nCores);
+
+    /**
+     * Gets the core of a thread.
+     *
+     * @param i_affinity preset; not AFFINITY_NONE.
+     * @param i_thread id of the thread.
+     * @param i_nThreads number of threads.
+     * @param i_nCores number of cores.
+     * @return id of the core.
+     **/
+    static t_idx getCore(e_affinity i_affinity,
+                         t_idx i_thread,
+                         t_idx i_nThreads,
+                         t_idx i_nCores);
+
+    /**
+     * Pins the threads of the OpenMP team to the cores of a preset within a partition of the cores.
+     *
+     * @param i_affinity preset.
+     * @param i_partition id of the partition of this process, e.g., the rank among the processes of a node.
+     * @param i_nPartitions number of partitions, e.g., the number of processes of a node which share the cores.
+     * @return number of pinned threads; 0 if the preset is none, the environment sets the affinity or pinning failed.
+     **/
+    static t_idx pinThreads(e_affinity i_affinity,
+                            t_idx i_partition = 0,
+                            t_idx i_nPartitions = 1);
+
+    /**
+     * Restores the mask the process inherited for the calling thread, e.g., a helper created by a pinned thread.
+     *
+     * @return true if the mask was restored.
+     **/
+    static bool unpinThread();
+
+    /**
+     * Counts the pages of an array per NUMA node; pages which were not touched yet are not counted.
+     *
+     * @param i_data array.
+     * @param i_bytes size of the array in bytes.
+     * @param io_pages pages per node, to which the pages of the array are added; grown as needed.
+     * @return true if the nodes could be queried from the kernel.
+     **/
+    static bool countPagesPerNode(void const *i_data,
+                                  t_idx i_bytes,
+                                  std::vector<t_idx> &io_pages);
+};
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the thread affinity and the placement of pages.
+ **/
+#include "Affinity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test the cores of the thread affinity presets.", "[Affinity]") {
+    REQUIRE(std::string(tsunami_lab::parallel::Affinity::getName(tsunami_lab::parallel::AFFINITY_NONE)) == "none");
+    REQUIRE(std::string(tsunami_lab::parallel::Affinity::getName(tsunami_lab::parallel::AFFINITY_CLOSE)) == "close");
+    REQUIRE(std::string(tsunami_lab::parallel::Affinity::getName(tsunami_lab::parallel::AFFINITY_SPREAD)) == "spread");
+
+    // close fills the cores one after another
+    for (tsunami_lab::t_idx l_th = 0; l_th < 4; l_th++) {
+        REQUIRE(tsunami_lab::parallel::Affinity::getCore(tsunami_lab::parallel::AFFINITY_CLOSE, l_th, 4, 16) == l_th);
+    }
+
+    // spread distributes the threads evenly, e.g., two per socket of 8 cores
+    tsunami_lab::t_idx l_spread[4] = {0, 4, 8, 12};
+    for (tsunami_lab::t_idx l_th = 0; l_th < 4; l_th++) {
+        REQUIRE(tsunami_lab::parallel::Affinity::getCore(tsunami_lab::parallel::AFFINITY_SPREAD, l_th, 4, 16) == l_spread[l_th]);
+    }
+    REQUIRE(tsunami_lab::parallel::Affinity::getCore(tsunami_lab::parallel::AFFINITY_SPREAD, 2, 3, 16) == 10);
+
+    // more threads than cores wrap around
+    REQUIRE(tsunami_lab::parallel::Affinity::getCore(tsunami_lab::parallel::AFFINITY_CLOSE, 5, 8, 4) == 1);
+    REQUIRE(tsunami_lab::parallel::Affinity::getCore(tsunami_lab::parallel::AFFINITY_SPREAD, 6, 8, 4) == 2);
+
+    // every hardware thread the process may run on belongs to exactly one core
+    std::vector<std::vector<int> > l_cores = tsunami_lab::parallel::Affinity::getCores();
+    REQUIRE(l_cores.size() > 0);
+    std::set<int> l_hwThreads;
+    for (tsunami_lab::t_idx l_co = 0; l_co < l_cores.size(); l_co++) {
+        REQUIRE(l_cores[l_co].size() > 0);
+        for (tsunami_lab::t_idx l_hw = 0; l_hw < l_cores[l_co].size(); l_hw++) {
+            REQUIRE(l_hwThreads.insert(l_cores[l_co][l_hw]).second);
+        }
+    }
+
+    // without a preset no thread is pinned
+    REQUIRE(tsunami_lab::parallel::Affinity::pinThreads(tsunami_lab::parallel::AFFINITY_NONE) == 0);
+}
+
+TEST_CASE("Test the partitions of the cores and restoring the inherited mask.", "[Affinity]") {
+    /*
+     * Test case:
+     *   16 cores are split into 3 partitions, which are contiguous and cover every core once; 3 cores are shared by 5
+     *   partitions.
+     *
+     *   A thread pinned to a single core gets all cores of the process back.
+     */
+    tsunami_lab::t_idx l_first = 0;
+    tsunami_lab::t_idx l_nCores = 0;
+    tsunami_lab::t_idx l_firstRef[3] = {0, 5, 10};
+    tsunami_lab::t_idx l_nCoresRef[3] = {5, 5, 6};
+    for (tsunami_lab::t_idx l_pa = 0; l_pa < 3; l_pa++) {
+        tsunami_lab::parallel::Affinity::getPartition(l_pa, 3, 16, l_first, l_nCores);
+        REQUIRE(l_first == l_firstRef[l_pa]);
+        REQUIRE(l_nCores == l_nCoresRef[l_pa]);
+    }
+
+    tsunami_lab::parallel::Affinity::getPartition(4, 5, 3, l_first, l_nCores);
+    REQUIRE(l_first == 1);
+    REQUIRE(l_nCores == 1);
+
+    std::vector<std::vector<int> > l_cores = tsunami_lab::parallel::Affinity::getCores();
+    tsunami_lab::t_idx l_nHwThreads = 0;
+    for (tsunami_lab::t_idx l_co = 0; l_co < l_cores.size(); l_co++) l_nHwThreads += l_cores[l_co].size();
+
+    // pinning and restoring run in a separate thread, which leaves the mask of the test runner unchanged
+    int l_nPinned = -1;
+    int l_nRestored = -1;
+    std::thread l_thread([&]() {
+        cpu_set_t l_set;
+        CPU_ZERO(&l_set);
+        CPU_SET(l_cores.back().front(), &l_set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(l_set), &l_set) != 0) return;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(l_set), &l_set) == 0) l_nPinned = CPU_COUNT(&l_set);
+
+        if (!tsunami_lab::parallel::Affinity::unpinThread()) return;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(l_set), &l_set) == 0) l_nRestored = CPU_COUNT(&l_set);
+    });
+    l_thread.join();
+
+    REQUIRE(l_nPinned == 1);
+    REQUIRE(l_nRestored == int(l_nHwThreads));
+}
+
+TEST_CASE("Test counting the pages of an array per NUMA node.", "[Affinity]") {
+    /*
+     * Test case:
+     *   An array of 64 pages, which starts in the middle of a page, is touched.
+     *
+     *   If the kernel reports the nodes, all 65 pages the array covers are counted once.
+     */
+    tsunami_lab::t_idx l_pageSize = sysconf(_SC_PAGESIZE);
+    std::vector<char> l_data(66 * l_pageSize, 1);
+    tsunami_lab::t_idx l_offset = l_pageSize - reinterpret_cast<std::uintptr_t>(l_data.data()) % l_pageSize;
+    char const *l_array = l_data.data() + l_offset + l_pageSize / 2;
+
+    std::vector<tsunami_lab::t_idx> l_pages;
+    if (!tsunami_lab::parallel::Affinity::countPagesPerNode(l_array, 64 * l_pageSize, l_pages)) {
+        WARN("the NUMA nodes of pages can't be queried");
+        return;
+    }
+
+    tsunami_lab::t_idx l_nPages = 0;
+    for (tsunami_lab::t_idx l_no = 0; l_no < l_pages.size(); l_no++) l_nPages += l_pages[l_no];
+    REQUIRE(l_nPages == 65);
+
+    // the counts are accumulated
+    REQUIRE(tsunami_lab::parallel::Affinity::countPagesPerNode(l_array, l_pageSize / 2, l_pages));
+    l_nPages = 0;
+    for (tsunami_lab::t_idx l_no = 0; l_no < l_pages.size(); l_no++) l_nPages += l_pages[l_no];
+    REQUIRE(l_nPages == 66);
+}
@@ -0,0 +1,66 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Cartesian decomposition of a two-dimensional grid into the subdomains of the processes.
+ **/
+#include "Decomposition.h"
+
+tsunami_lab::parallel::Decomposition::Decomposition(t_idx i_nCellsX,
+                                                    t_idx i_nCellsY,
+                                                    t_idx i_nRanks,
+                                                    t_idx i_rank) {
+    m_nCells[0] = i_nCellsX;
+    m_nCells[1] = i_nCellsY;
+
+    getProcessGrid(i_nCellsX, i_nCellsY, i_nRanks, m_nProcs);
+
+    m_coords[0] = i_rank % m_nProcs[0];
+    m_coords[1] = i_rank / m_nProcs[0];
+
+    // balanced split: the subdomains differ by at most one cell
+    for (unsigned short l_di = 0; l_di < 2; l_di++) {
+        t_idx l_end = (m_coords[l_di] + 1) * m_nCells[l_di] / m_nProcs[l_di];
+        m_first[l_di] = m_coords[l_di] * m_nCells[l_di] / m_nProcs[l_di];
+        m_nLocal[l_di] = l_end - m_first[l_di];
+    }
+}
+
+void tsunami_lab::parallel::Decomposition::getProcessGrid(t_idx i_nCellsX,
+                                                          t_idx i_nCellsY,
+                                                          t_idx i_nRanks,
+                                                          t_idx o_nProcs[2]) {
+    o_nProcs[0] = i_nRanks;
+    o_nProcs[1] = 1;
+
+    t_idx l_cutMin = 0;
+    bool l_fitsMin = false;
+    bool l_found = false;
+
+    for (t_idx l_px = 1; l_px <= i_nRanks; l_px++) {
+        if (i_nRanks % l_px != 0) continue;
+        t_idx l_py = i_nRanks / l_px;
+
+        // length of all cuts between the subdomains in cells
+        t_idx l_cut = (l_px - 1) * i_nCellsY + (l_py - 1) * i_nCellsX;
+        bool l_fits = l_px <= i_nCellsX && l_py <= i_nCellsY;
+
+        if (!l_found || (l_fits && !l_fitsMin) || (l_fits == l_fitsMin && l_cut < l_cutMin)) {
+            o_nProcs[0] = l_px;
+            o_nProcs[1] = l_py;
+            l_cutMin = l_cut;
+            l_fitsMin = l_fits;
+            l_found = true;
+        }
+    }
+}
+
+long tsunami_lab::parallel::Decomposition::getNeighbor(int i_dx,
+                                                       int i_dy) {
+    long l_px = long(m_coords[0]) + i_dx;
+    long l_py = long(m_coords[1]) + i_dy;
+
+    if (l_px < 0 || l_py < 0 || l_px >= long(m_nProcs[0]) || l_py >= long(m_nProcs[1])) return -1;
+
+    return long(getRank(l_px, l_py));
+}
@@ -0,0 +1,146 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Cartesian decomposition of a two-dimensional grid into the subdomains of the processes.
+ **/
+#ifndef TSUNAMI_LAB_PARALLEL_DECOMPOSITION
+#define TSUNAMI_LAB_PARALLEL_DECOMPOSITION
+
+#include "../constants.h"
+
+namespace tsunami_lab {
+    namespace parallel {
+        class Decomposition;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * The processes are arranged in a grid of px x py processes, which is chosen such that the cut between the
+ * subdomains is as short as possible. Rank r sits at position (r % px, r / px) of the process grid.
+ * The cells are distributed as evenly as possible, i.e., the sizes of the subdomains differ by at most one cell in
+ * each direction.
+ **/
+class tsunami_lab::parallel::Decomposition {
+   private:
+    //! number of cells of the entire domain in x- and y-direction
+    t_idx m_nCells[2] = {0, 0};
+
+    //! number of processes in x- and y-direction
+    t_idx m_nProcs[2] = {1, 1};
+
+    //! position of the process in the process grid
+    t_idx m_coords[2] = {0, 0};
+
+    //! first cell of the subdomain in x- and y-direction
+    t_idx m_first[2] = {0, 0};
+
+    //! number of cells of the subdomain in x- and y-direction
+    t_idx m_nLocal[2] = {0, 0};
+
+   public:
+    /**
+     * Constructs the decomposition as seen by one process.
+     *
+     * @param i_nCellsX number of cells of the entire domain in x-direction.
+     * @param i_nCellsY number of cells of the entire domain in y-direction.
+     * @param i_nRanks number of processes.
+     * @param i_rank rank of the process.
+     **/
+    Decomposition(t_idx i_nCellsX,
+                  t_idx i_nCellsY,
+                  t_idx i_nRanks,
+                  t_idx i_rank);
+
+    /**
+     * Chooses the process grid with the shortest cut between the subdomains. Every subdomain keeps at least one cell
+     * in each direction if possible.
+     *
+     * @param i_nCellsX number of cells of the entire domain in x-direction.
+     * @param i_nCellsY number of cells of the entire domain in y-direction.
+     * @param i_nRanks number of processes.
+     * @param o_nProcs will be set to the number of processes in x- and y-direction.
+     **/
+    static void getProcessGrid(t_idx i_nCellsX,
+                               t_idx i_nCellsY,
+                               t_idx i_nRanks,
+                               t_idx o_nProcs[2]);
+
+    /**
+     * Gets the rank of a neighboring process.
+     *
+     * @param i_dx offset in the process grid in x-direction (-1, 0 or 1).
+     * @param i_dy offset in the process grid in y-direction (-1, 0 or 1).
+     * @return rank of the neighbor; -1 if the subdomain touches the boundary of the domain on that side.
+     **/
+    long getNeighbor(int i_dx,
+                     int i_dy);
+
+    /**
+     * Gets the rank of the process at a position of the process grid.
+     *
+     * @param i_px position in x-direction.
+     * @param i_py position in y-direction.
+     * @return rank.
+     **/
+    t_idx getRank(t_idx i_px,
+                  t_idx i_py) {
+        return i_py * m_nProcs[0] + i_px;
+    }
+
+    /**
+     * Gets the number of processes in x-direction.
+     *
+     * @return number of processes.
+     **/
+    t_idx getProcsX() {
+        return m_nProcs[0];
+    }
+
+    /**
+     * Gets the number of processes in y-direction.
+     *
+     * @return number of processes.
+     **/
+    t_idx getProcsY() {
+        return m_nProcs[1];
+    }
+
+    /**
+     * Gets the first cell of the subdomain in x-direction.
+     *
+     * @return id of the cell in the entire domain.
+     **/
+    t_idx getFirstX() {
+        return m_first[0];
+    }
+
+    /**
+     * Gets the first cell of the subdomain in y-direction.
+     *
+     * @return id of the cell in the entire domain.
+     **/
+    t_idx getFirstY() {
+        return m_first[1];
+    }
+
+    /**
+     * Gets the number of cells of the subdomain in x-direction.
+     *
+     * @return number of cells.
+     **/
+    t_idx getCellsX() {
+        return m_nLocal[0];
+    }
+
+    /**
+     * Gets the number of cells of the subdomain in y-direction.
+     *
+     * @return number of cells.
+     **/
+    t_idx getCellsY() {
+        return m_nLocal[1];
+    }
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the Cartesian domain decomposition.
+ **/
+#include "Decomposition.h"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test the choice of the process grid.", "[Decomposition]") {
+    tsunami_lab::t_idx l_nProcs[2] = {0, 0};
+
+    // a single process owns the entire domain
+    tsunami_lab::parallel::Decomposition::getProcessGrid(100, 100, 1, l_nProcs);
+    REQUIRE(l_nProcs[0] == 1);
+    REQUIRE(l_nProcs[1] == 1);
+
+    // square domains are cut in both directions
+    tsunami_lab::parallel::Decomposition::getProcessGrid(100, 100, 4, l_nProcs);
+    REQUIRE(l_nProcs[0] == 2);
+    REQUIRE(l_nProcs[1] == 2);
+
+    // wide domains are cut more often in x-direction
+    tsunami_lab::parallel::Decomposition::getProcessGrid(1000, 500, 8, l_nProcs);
+    REQUIRE(l_nProcs[0] == 4);
+    REQUIRE(l_nProcs[1] == 2);
+
+    // prime numbers of processes cut the longer side
+    tsunami_lab::parallel::Decomposition::getProcessGrid(50, 300, 3, l_nProcs);
+    REQUIRE(l_nProcs[0] == 1);
+    REQUIRE(l_nProcs[1] == 3);
+
+    // every subdomain keeps at least one cell
+    tsunami_lab::parallel::Decomposition::getProcessGrid(1000, 1, 4, l_nProcs);
+    REQUIRE(l_nProcs[0] == 4);
+    REQUIRE(l_nProcs[1] == 1);
+}
+
+TEST_CASE("Test the subdomains of the Cartesian decomposition.", "[Decomposition]") {
+    /*
+     * Test case:
+     *   37 x 23 cells are split among 6 processes in a 3 x 2 process grid.
+     *   The subdomains have 12, 12 and 13 cells in x-direction and 11 and 12 cells in y-direction.
+     */
+    tsunami_lab::t_idx l_covered[37 * 23] = {0};
+
+    for (tsunami_lab::t_idx l_rank = 0; l_rank < 6; l_rank++) {
+        tsunami_lab::parallel::Decomposition l_decomp(37, 23, 6, l_rank);
+        REQUIRE(l_decomp.getProcsX() == 3);
+        REQUIRE(l_decomp.getProcsY() == 2);
+
+        REQUIRE(l_decomp.getCellsX() >= 12);
+        REQUIRE(l_decomp.getCellsX() <= 13);
+        REQUIRE(l_decomp.getCellsY() >= 11);
+        REQUIRE(l_decomp.getCellsY() <= 12);
+
+        for (tsunami_lab::t_idx l_iy = 0; l_iy < l_decomp.getCellsY(); l_iy++) {
+            for (tsunami_lab::t_idx l_ix = 0; l_ix < l_decomp.getCellsX(); l_ix++) {
+                l_covered[(l_decomp.getFirstY() + l_iy) * 37 + l_decomp.getFirstX() + l_ix]++;
+            }
+        }
+    }
+
+    // every cell is owned by exactly one process
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < 37 * 23; l_ce++) {
+        REQUIRE(l_covered[l_ce] == 1);
+    }
+
+    // neighbors of the process in the middle of the lower row
+    tsunami_lab::parallel::Decomposition l_decomp(37, 23, 6, 1);
+    REQUIRE(l_decomp.getFirstX() == 12);
+    REQUIRE(l_decomp.getFirstY() == 0);
+    REQUIRE(l_decomp.getNeighbor(1, 0) == 2);
+    REQUIRE(l_decomp.getNeighbor(-1, 0) == 0);
+    REQUIRE(l_decomp.getNeighbor(0, 1) == 4);
+    REQUIRE(l_decomp.getNeighbor(0, -1) == -1);
+    REQUIRE(l_decomp.getNeighbor(1, 1) == 5);
+    REQUIRE(l_decomp.getNeighbor(-1, -1) == -1);
+}
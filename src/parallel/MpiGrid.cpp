@@ -0,0 +1,249 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Communication of the subdomains of a Cartesian decomposition through MPI.
+ **/
+#include "MpiGrid.h"
+
+//! MPI datatype matching t_real
+static MPI_Datatype const c_mpiReal = (sizeof(tsunami_lab::t_real) == sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT;
+
+tsunami_lab::parallel::MpiGrid::MpiGrid(t_idx i_nCellsX,
+                                        t_idx i_nCellsY,
+                                        MPI_Comm i_comm) {
+    m_comm = i_comm;
+    MPI_Comm_rank(m_comm, &m_rank);
+    MPI_Comm_size(m_comm, &m_nRanks);
+
+    m_nCells[0] = i_nCellsX;
+    m_nCells[1] = i_nCellsY;
+
+    m_decomp = new Decomposition(i_nCellsX, i_nCellsY, m_nRanks, m_rank);
+
+    int l_offsets[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    for (unsigned short l_si = 0; l_si < 4; l_si++) {
+        long l_neighbor = m_decomp->getNeighbor(l_offsets[l_si][0], l_offsets[l_si][1]);
+        m_neighbors[l_si] = (l_neighbor < 0) ? MPI_PROC_NULL : int(l_neighbor);
+
+        // columns hold the inner rows, rows hold all columns including the ghost cells; the buffers fit the water
+        // heights and momenta of the time steps, the bathymetries use a third of them
+        m_nSideCells[l_si] = (l_si % 2 == 0) ? m_decomp->getCellsY() : m_decomp->getCellsX() + 2;
+        m_send[l_si].resize(3 * m_nSideCells[l_si]);
+        m_recv[l_si].resize(3 * m_nSideCells[l_si]);
+    }
+
+    m_gatherLocal.resize(m_decomp->getCellsX() * m_decomp->getCellsY());
+    if (m_rank == 0) m_gatherGlobal.resize(i_nCellsX * i_nCellsY);
+}
+
+tsunami_lab::parallel::MpiGrid::~MpiGrid() {
+    delete m_decomp;
+}
+
+void tsunami_lab::parallel::MpiGrid::exchangeSides(patches::WavePropagation2d &io_patch,
+                                                   unsigned short i_side,
+                                                   e_boundary const *i_boundary,
+                                                   bool i_bathymetry) {
+    t_idx l_nx = m_decomp->getCellsX();
+    t_idx l_ny = m_decomp->getCellsY();
+
+    t_real const *l_data[4] = {io_patch.getHeight(),
+                               io_patch.getMomentumX(),
+                               io_patch.getMomentumY(),
+                               io_patch.getBathymetry()};
+
+    // the messages hold the quantities first to first + nQuantities - 1 of every cell
+    unsigned short l_first = i_bathymetry ? 3 : 0;
+    unsigned short l_nQuantities = i_bathymetry ? 1 : 3;
+
+    MPI_Request l_requests[4];
+    int l_nRequests = 0;
+
+    unsigned short l_sides[2] = {i_side, (unsigned short)(i_side + 2)};
+
+    // position of the i-th cell of the inner (0) or ghost (1) line of a side including the ghost cells
+    auto l_cell = [&](unsigned short i_si, t_idx i_ce, unsigned short i_ghost, t_idx o_xy[2]) {
+        if (i_si % 2 == 0) {
+            o_xy[0] = (i_si == 0) ? l_nx + i_ghost : 1 - i_ghost;
+            o_xy[1] = i_ce + 1;
+        } else {
+            o_xy[0] = i_ce;
+            o_xy[1] = (i_si == 1) ? l_ny + i_ghost : 1 - i_ghost;
+        }
+    };
+
+    for (unsigned short l_si : l_sides) {
+        if (m_neighbors[l_si] == MPI_PROC_NULL) continue;
+
+        int l_count = int(l_nQuantities * m_nSideCells[l_si]);
+        // the neighbor sends the data of its opposite side
+        MPI_Irecv(m_recv[l_si].data(), l_count, c_mpiReal, m_neighbors[l_si], (l_si + 2) % 4, m_comm, &l_requests[l_nRequests++]);
+    }
+
+    for (unsigned short l_si : l_sides) {
+        if (m_neighbors[l_si] == MPI_PROC_NULL) continue;
+
+        for (t_idx l_ce = 0; l_ce < m_nSideCells[l_si]; l_ce++) {
+            t_idx l_xy[2];
+            l_cell(l_si, l_ce, 0, l_xy);
+            t_idx l_idx = io_patch.getIndex(l_xy[0], l_xy[1]);
+
+            for (unsigned short l_qu = 0; l_qu < l_nQuantities; l_qu++) {
+                m_send[l_si][l_nQuantities * l_ce + l_qu] = l_data[l_first + l_qu][l_idx];
+            }
+        }
+
+        int l_count = int(l_nQuantities * m_nSideCells[l_si]);
+        MPI_Isend(m_send[l_si].data(), l_count, c_mpiReal, m_neighbors[l_si], l_si, m_comm, &l_requests[l_nRequests++]);
+    }
+
+    // boundary conditions of the domain while the messages are in flight
+    for (unsigned short l_si : l_sides) {
+        if (m_neighbors[l_si] != MPI_PROC_NULL) continue;
+
+        for (t_idx l_ce = 0; l_ce < m_nSideCells[l_si]; l_ce++) {
+            t_idx l_ghost[2];
+            t_idx l_inner[2];
+            l_cell(l_si, l_ce, 1, l_ghost);
+            l_cell(l_si, l_ce, 0, l_inner);
+
+            // ghost columns of rows are corners of the domain if no neighbor exists in x-direction
+            bool l_corner = false;
+            if (l_si % 2 == 1) {
+                if (l_ce == 0 && m_neighbors[2] == MPI_PROC_NULL) {
+                    l_corner = true;
+                    l_inner[0] = 1;
+                } else if (l_ce == l_nx + 1 && m_neighbors[0] == MPI_PROC_NULL) {
+                    l_corner = true;
+                    l_inner[0] = l_nx;
+                }
+            }
+
+            t_idx l_idx = io_patch.getIndex(l_inner[0], l_inner[1]);
+            if (l_corner || i_boundary[l_si] == OUTFLOW) {
+                io_patch.setCell(l_ghost[0],
+                                 l_ghost[1],
+                                 l_data[0][l_idx],
+                                 l_data[1][l_idx],
+                                 l_data[2][l_idx],
+                                 l_data[3][l_idx]);
+            } else if (i_boundary[l_si] == REFLECTING) {
+                io_patch.setCell(l_ghost[0], l_ghost[1], 0, 0, 0, 20);
+            }
+        }
+    }
+
+    MPI_Waitall(l_nRequests, l_requests, MPI_STATUSES_IGNORE);
+
+    for (unsigned short l_si : l_sides) {
+        if (m_neighbors[l_si] == MPI_PROC_NULL) continue;
+
+        for (t_idx l_ce = 0; l_ce < m_nSideCells[l_si]; l_ce++) {
+            t_idx l_xy[2];
+            l_cell(l_si, l_ce, 1, l_xy);
+            t_idx l_idx = io_patch.getIndex(l_xy[0], l_xy[1]);
+
+            // the quantities which were not received keep their values
+            t_real l_cellData[4] = {l_data[0][l_idx], l_data[1][l_idx], l_data[2][l_idx], l_data[3][l_idx]};
+            for (unsigned short l_qu = 0; l_qu < l_nQuantities; l_qu++) {
+                l_cellData[l_first + l_qu] = m_recv[l_si][l_nQuantities * l_ce + l_qu];
+            }
+            io_patch.setCell(l_xy[0], l_xy[1], l_cellData[0], l_cellData[1], l_cellData[2], l_cellData[3]);
+        }
+    }
+}
+
+void tsunami_lab::parallel::MpiGrid::exchangeBathymetry(patches::WavePropagation2d &io_patch,
+                                                        e_boundary const *i_boundary) {
+    exchangeSides(io_patch, 0, i_boundary, true);
+    exchangeSides(io_patch, 1, i_boundary, true);
+}
+
+void tsunami_lab::parallel::MpiGrid::exchangeHalos(patches::WavePropagation2d &io_patch,
+                                                   e_boundary const *i_boundary) {
+    // the rows are sent after the columns were received, which provides the diagonal neighbors
+    exchangeSides(io_patch, 0, i_boundary, false);
+    exchangeSides(io_patch, 1, i_boundary, false);
+}
+
+tsunami_lab::t_real tsunami_lab::parallel::MpiGrid::getMax(t_real i_value) {
+    t_real l_max = i_value;
+    MPI_Allreduce(&i_value, &l_max, 1, c_mpiReal, MPI_MAX, m_comm);
+
+    return l_max;
+}
+
+void tsunami_lab::parallel::MpiGrid::getNodeRank(int i_key,
+                                                 t_idx &o_rank,
+                                                 t_idx &o_nRanks) {
+    MPI_Comm l_node;
+    MPI_Comm_split_type(m_comm, MPI_COMM_TYPE_SHARED, m_rank, MPI_INFO_NULL, &l_node);
+
+    MPI_Comm l_shared;
+    MPI_Comm_split(l_node, i_key, m_rank, &l_shared);
+
+    int l_rank = 0;
+    int l_nRanks = 1;
+    MPI_Comm_rank(l_shared, &l_rank);
+    MPI_Comm_size(l_shared, &l_nRanks);
+    o_rank = l_rank;
+    o_nRanks = l_nRanks;
+
+    MPI_Comm_free(&l_shared);
+    MPI_Comm_free(&l_node);
+}
+
+void tsunami_lab::parallel::MpiGrid::gather(t_real const *i_local,
+                                            t_idx i_stride,
+                                            t_real *o_global) {
+    t_idx l_nx = m_decomp->getCellsX();
+    t_idx l_ny = m_decomp->getCellsY();
+
+    for (t_idx l_iy = 0; l_iy < l_ny; l_iy++) {
+        for (t_idx l_ix = 0; l_ix < l_nx; l_ix++) {
+            m_gatherLocal[l_iy * l_nx + l_ix] = i_local[(l_iy + 1) * i_stride + l_ix + 1];
+        }
+    }
+
+    std::vector<int> l_counts;
+    std::vector<int> l_displs;
+    if (m_rank == 0) {
+        l_counts.resize(m_nRanks);
+        l_displs.resize(m_nRanks);
+
+        int l_displ = 0;
+        for (int l_ra = 0; l_ra < m_nRanks; l_ra++) {
+            Decomposition l_decomp(m_nCells[0], m_nCells[1], m_nRanks, l_ra);
+            l_counts[l_ra] = int(l_decomp.getCellsX() * l_decomp.getCellsY());
+            l_displs[l_ra] = l_displ;
+            l_displ += l_counts[l_ra];
+        }
+    }
+
+    MPI_Gatherv(m_gatherLocal.data(),
+                int(m_gatherLocal.size()),
+                c_mpiReal,
+                m_gatherGlobal.data(),
+                l_counts.data(),
+                l_displs.data(),
+                c_mpiReal,
+                0,
+                m_comm);
+
+    if (m_rank != 0) return;
+
+    t_idx l_stride = m_nCells[0] + 2;
+    for (int l_ra = 0; l_ra < m_nRanks; l_ra++) {
+        Decomposition l_decomp(m_nCells[0], m_nCells[1], m_nRanks, l_ra);
+        t_real const *l_block = m_gatherGlobal.data() + l_displs[l_ra];
+
+        for (t_idx l_iy = 0; l_iy < l_decomp.getCellsY(); l_iy++) {
+            for (t_idx l_ix = 0; l_ix < l_decomp.getCellsX(); l_ix++) {
+                t_idx l_gx = l_decomp.getFirstX() + l_ix;
+                t_idx l_gy = l_decomp.getFirstY() + l_iy;
+                o_global[(l_gy + 1) * l_stride + l_gx + 1] = l_block[l_iy * l_decomp.getCellsX() + l_ix];
+            }
+        }
+    }
+}
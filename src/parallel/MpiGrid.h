@@ -0,0 +1,175 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Communication of the subdomains of a Cartesian decomposition through MPI.
+ **/
+#ifndef TSUNAMI_LAB_PARALLEL_MPI_GRID
+#define TSUNAMI_LAB_PARALLEL_MPI_GRID
+
+#include <mpi.h>
+
+#include <vector>
+
+#include "../constants.h"
+#include "../patches/2d/WavePropagation2d.h"
+#include "Decomposition.h"
+
+namespace tsunami_lab {
+    namespace parallel {
+        class MpiGrid;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * Every process owns the WavePropagation2d patch of its subdomain. The ghost cells at the cuts between subdomains
+ * are exchanged with the neighbors, while the ghost cells at the boundary of the domain obey the boundary conditions.
+ * The ghost layers are filled in two phases: first the columns in x-direction, then the full rows in y-direction
+ * including the ghost columns, which also delivers the diagonal neighbors. The result is identical to
+ * WavePropagation2d::setGhostCells on the entire domain.
+ **/
+class tsunami_lab::parallel::MpiGrid {
+   private:
+    //! communicator of all processes
+    MPI_Comm m_comm;
+
+    //! rank of the process
+    int m_rank = 0;
+
+    //! number of processes
+    int m_nRanks = 1;
+
+    //! number of cells of the entire domain in x- and y-direction
+    t_idx m_nCells[2] = {0, 0};
+
+    //! decomposition as seen by this process
+    Decomposition *m_decomp = nullptr;
+
+    //! ranks of the neighbors in the order east, north, west, south; MPI_PROC_NULL at the boundary of the domain
+    int m_neighbors[4] = {MPI_PROC_NULL, MPI_PROC_NULL, MPI_PROC_NULL, MPI_PROC_NULL};
+
+    //! number of cells of the four sides; columns hold the inner rows, rows hold all columns including the ghost cells
+    t_idx m_nSideCells[4] = {0, 0, 0, 0};
+
+    //! send buffers of the four sides holding the water heights and momenta, or the bathymetries of the sent cells
+    std::vector<t_real> m_send[4];
+
+    //! receive buffers of the four sides
+    std::vector<t_real> m_recv[4];
+
+    //! buffer holding the inner cells of the subdomain for gathers
+    std::vector<t_real> m_gatherLocal;
+
+    //! buffer of the root holding the inner cells of all subdomains in the order of the ranks
+    std::vector<t_real> m_gatherGlobal;
+
+    /**
+     * Exchanges the ghost cells of two opposite sides.
+     *
+     * @param io_patch patch of the subdomain.
+     * @param i_side side of the first of the two opposite sides; 0: east and west, 1: north and south.
+     * @param i_boundary boundary conditions of the domain.
+     * @param i_bathymetry true if the bathymetries are exchanged, false if the water heights and momenta are.
+     **/
+    void exchangeSides(patches::WavePropagation2d &io_patch,
+                       unsigned short i_side,
+                       e_boundary const *i_boundary,
+                       bool i_bathymetry);
+
+   public:
+    /**
+     * Constructs the communication of the subdomains.
+     *
+     * @param i_nCellsX number of cells of the entire domain in x-direction.
+     * @param i_nCellsY number of cells of the entire domain in y-direction.
+     * @param i_comm communicator of all processes.
+     **/
+    MpiGrid(t_idx i_nCellsX,
+            t_idx i_nCellsY,
+            MPI_Comm i_comm);
+
+    /**
+     * Destructor which frees all allocated memory.
+     **/
+    ~MpiGrid();
+
+    /**
+     * Gets the decomposition as seen by this process.
+     *
+     * @return decomposition.
+     **/
+    Decomposition &getDecomposition() {
+        return *m_decomp;
+    }
+
+    /**
+     * Gets the rank of the process.
+     *
+     * @return rank.
+     **/
+    int getRank() {
+        return m_rank;
+    }
+
+    /**
+     * Gets the number of processes.
+     *
+     * @return number of processes.
+     **/
+    int getNumberOfRanks() {
+        return m_nRanks;
+    }
+
+    /**
+     * Fills the bathymetries of the ghost cells once after the setup, since they do not change over time.
+     *
+     * @param io_patch patch of the subdomain.
+     * @param i_boundary boundary conditions of the domain in the order east, north, west, south.
+     **/
+    void exchangeBathymetry(patches::WavePropagation2d &io_patch,
+                            e_boundary const *i_boundary);
+
+    /**
+     * Fills the ghost cells of the patch by non-blocking exchanges with the neighbors and the boundary conditions.
+     * Only the water heights and momenta are exchanged; the bathymetries of the ghost cells at the cuts are filled by
+     * exchangeBathymetry.
+     *
+     * @param io_patch patch of the subdomain.
+     * @param i_boundary boundary conditions of the domain in the order east, north, west, south.
+     **/
+    void exchangeHalos(patches::WavePropagation2d &io_patch,
+                       e_boundary const *i_boundary);
+
+    /**
+     * Gets the maximum of a value over all processes.
+     *
+     * @param i_value value of this process.
+     * @return maximum of all processes.
+     **/
+    t_real getMax(t_real i_value);
+
+    /**
+     * Gets the rank of the process among the processes of its node with the same key; collective.
+     *
+     * @param i_key non-negative key, e.g., identifying the cores the process may run on.
+     * @param o_rank will be set to the rank among the processes of the node with the same key.
+     * @param o_nRanks will be set to the number of processes of the node with the same key.
+     **/
+    void getNodeRank(int i_key,
+                     t_idx &o_rank,
+                     t_idx &o_nRanks);
+
+    /**
+     * Gathers a quantity of all subdomains on rank 0.
+     *
+     * @param i_local quantity of the subdomain including the ghost cells.
+     * @param i_stride stride of the rows of the subdomain, e.g., the padded stride of its patch.
+     * @param o_global will be set to the quantity of the entire domain on rank 0; rows are nx + 2 apart and the ghost
+     *                 cells are not touched. Unused on the remaining ranks.
+     **/
+    void gather(t_real const *i_local,
+                t_idx i_stride,
+                t_real *o_global);
+};
+
+#endif
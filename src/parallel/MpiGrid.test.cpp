@@ -0,0 +1,178 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the communication of the subdomains; run with mpirun on any number of processes.
+ **/
+#include "MpiGrid.h"
+
+#include <catch2/catch.hpp>
+
+/**
+ * Initializes a patch with varying heights, momenta and bathymetries of the global cells starting at an offset.
+ *
+ * @param i_x0 first global cell in x-direction.
+ * @param i_y0 first global cell in y-direction.
+ * @param io_patch patch which is initialized.
+ * @param i_nx number of cells of the patch in x-direction.
+ * @param i_ny number of cells of the patch in y-direction.
+ **/
+static void initPatch(tsunami_lab::t_idx i_x0,
+                      tsunami_lab::t_idx i_y0,
+                      tsunami_lab::patches::WavePropagation2d &io_patch,
+                      tsunami_lab::t_idx i_nx,
+                      tsunami_lab::t_idx i_ny) {
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < i_ny; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < i_nx; l_cx++) {
+            tsunami_lab::t_idx l_gx = i_x0 + l_cx;
+            tsunami_lab::t_idx l_gy = i_y0 + l_cy;
+
+            io_patch.setHeight(l_cx, l_cy, 10 + ((l_gx < 15 && l_gy > 8) ? 5 : 0) + tsunami_lab::t_real(0.1) * (l_gx % 7));
+            io_patch.setMomentumX(l_cx, l_cy, tsunami_lab::t_real(0.5) * (l_gy % 4));
+            io_patch.setMomentumY(l_cx, l_cy, -tsunami_lab::t_real(0.25) * (l_gx % 3));
+            io_patch.setBathymetry(l_cx, l_cy, -20 + tsunami_lab::t_real(0.2) * (l_gx % 5));
+        }
+    }
+}
+
+TEST_CASE("Test the halo exchange of the subdomains against a single patch.", "[MpiGrid]") {
+    /*
+     * Test case:
+     *   Every process solves its subdomain of 37 x 23 cells with varying water heights, momenta and bathymetries and
+     *   redundantly the entire domain with a single patch. Outflow and reflecting boundaries alternate.
+     *
+     *   After the halo exchange all cells of the subdomain including the ghost cells match the single patch bit for
+     *   bit; this holds after every time step.
+     */
+    tsunami_lab::t_idx l_nx = 37;
+    tsunami_lab::t_idx l_ny = 23;
+
+    tsunami_lab::parallel::MpiGrid l_grid(l_nx, l_ny, MPI_COMM_WORLD);
+    tsunami_lab::parallel::Decomposition &l_decomp = l_grid.getDecomposition();
+    tsunami_lab::t_idx l_nxLocal = l_decomp.getCellsX();
+    tsunami_lab::t_idx l_nyLocal = l_decomp.getCellsY();
+    tsunami_lab::t_idx l_x0 = l_decomp.getFirstX();
+    tsunami_lab::t_idx l_y0 = l_decomp.getFirstY();
+
+    tsunami_lab::patches::WavePropagation2d l_local(l_nxLocal, l_nyLocal);
+    tsunami_lab::patches::WavePropagation2d l_single(l_nx, l_ny);
+    initPatch(l_x0, l_y0, l_local, l_nxLocal, l_nyLocal);
+    initPatch(0, 0, l_single, l_nx, l_ny);
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING};
+    l_grid.exchangeBathymetry(l_local, l_boundary);
+
+    for (int l_st = 0; l_st < 6; l_st++) {
+        l_grid.exchangeHalos(l_local, l_boundary);
+        l_single.setGhostCells(l_boundary);
+
+        for (tsunami_lab::t_idx l_iy = 0; l_iy < l_nyLocal + 2; l_iy++) {
+            for (tsunami_lab::t_idx l_ix = 0; l_ix < l_nxLocal + 2; l_ix++) {
+                tsunami_lab::t_idx l_idx = l_local.getIndex(l_ix, l_iy);
+                tsunami_lab::t_idx l_idxSingle = l_single.getIndex(l_x0 + l_ix, l_y0 + l_iy);
+
+                REQUIRE(l_local.getHeight()[l_idx] == l_single.getHeight()[l_idxSingle]);
+                REQUIRE(l_local.getMomentumX()[l_idx] == l_single.getMomentumX()[l_idxSingle]);
+                REQUIRE(l_local.getMomentumY()[l_idx] == l_single.getMomentumY()[l_idxSingle]);
+                REQUIRE(l_local.getBathymetry()[l_idx] == l_single.getBathymetry()[l_idxSingle]);
+            }
+        }
+
+        l_local.timeStep(0.02, 0.02);
+        l_single.timeStep(0.02, 0.02);
+
+        // the agreed wave speed is the one of the entire domain
+        REQUIRE(l_grid.getMax(l_local.getMaxWaveSpeed()) == l_single.getMaxWaveSpeed());
+    }
+
+    for (tsunami_lab::t_idx l_iy = 1; l_iy < l_nyLocal + 1; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 1; l_ix < l_nxLocal + 1; l_ix++) {
+            tsunami_lab::t_idx l_idx = l_local.getIndex(l_ix, l_iy);
+            tsunami_lab::t_idx l_idxSingle = l_single.getIndex(l_x0 + l_ix, l_y0 + l_iy);
+
+            REQUIRE(l_local.getHeight()[l_idx] == l_single.getHeight()[l_idxSingle]);
+            REQUIRE(l_local.getMomentumX()[l_idx] == l_single.getMomentumX()[l_idxSingle]);
+            REQUIRE(l_local.getMomentumY()[l_idx] == l_single.getMomentumY()[l_idxSingle]);
+        }
+    }
+
+    // rank 0 gathers the entire domain from the padded rows of the subdomains
+    std::vector<tsunami_lab::t_real> l_h((l_nx + 2) * (l_ny + 2), 0);
+    l_grid.gather(l_local.getHeight(), l_local.getStride(), l_h.data());
+
+    if (l_grid.getRank() == 0) {
+        for (tsunami_lab::t_idx l_iy = 1; l_iy < l_ny + 1; l_iy++) {
+            for (tsunami_lab::t_idx l_ix = 1; l_ix < l_nx + 1; l_ix++) {
+                tsunami_lab::t_idx l_idx = l_single.getIndex(l_ix, l_iy);
+                REQUIRE(l_h[l_iy * (l_nx + 2) + l_ix] == l_single.getHeight()[l_idx]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test the halo exchange overlapped with the inner edges against a single patch.", "[MpiGrid]") {
+    /*
+     * Test case:
+     *   The subdomains of 37 x 23 cells exchange their halos while the inner edges are solved.
+     *
+     *   After several time steps all inner cells match the single patch bit for bit.
+     */
+    tsunami_lab::t_idx l_nx = 37;
+    tsunami_lab::t_idx l_ny = 23;
+
+    tsunami_lab::parallel::MpiGrid l_grid(l_nx, l_ny, MPI_COMM_WORLD);
+    tsunami_lab::parallel::Decomposition &l_decomp = l_grid.getDecomposition();
+    tsunami_lab::t_idx l_nxLocal = l_decomp.getCellsX();
+    tsunami_lab::t_idx l_nyLocal = l_decomp.getCellsY();
+    tsunami_lab::t_idx l_x0 = l_decomp.getFirstX();
+    tsunami_lab::t_idx l_y0 = l_decomp.getFirstY();
+
+    tsunami_lab::patches::WavePropagation2d l_local(l_nxLocal, l_nyLocal);
+    tsunami_lab::patches::WavePropagation2d l_single(l_nx, l_ny);
+    initPatch(l_x0, l_y0, l_local, l_nxLocal, l_nyLocal);
+    initPatch(0, 0, l_single, l_nx, l_ny);
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW};
+    l_grid.exchangeBathymetry(l_local, l_boundary);
+
+    for (int l_st = 0; l_st < 6; l_st++) {
+        l_local.timeStepOverlapped(0.02, 0.02, [&]() { l_grid.exchangeHalos(l_local, l_boundary); });
+
+        l_single.setGhostCells(l_boundary);
+        l_single.timeStep(0.02, 0.02);
+
+        REQUIRE(l_grid.getMax(l_local.getMaxWaveSpeed()) == l_single.getMaxWaveSpeed());
+    }
+
+    for (tsunami_lab::t_idx l_iy = 1; l_iy < l_nyLocal + 1; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 1; l_ix < l_nxLocal + 1; l_ix++) {
+            tsunami_lab::t_idx l_idx = l_local.getIndex(l_ix, l_iy);
+            tsunami_lab::t_idx l_idxSingle = l_single.getIndex(l_x0 + l_ix, l_y0 + l_iy);
+
+            REQUIRE(l_local.getHeight()[l_idx] == l_single.getHeight()[l_idxSingle]);
+            REQUIRE(l_local.getMomentumX()[l_idx] == l_single.getMomentumX()[l_idxSingle]);
+            REQUIRE(l_local.getMomentumY()[l_idx] == l_single.getMomentumY()[l_idxSingle]);
+        }
+    }
+}
+
+TEST_CASE("Test the ranks of the processes of a node.", "[MpiGrid]") {
+    /*
+     * Test case:
+     *   All processes of the test run on a single node; they share the same key or alternate between two keys.
+     *
+     *   The ranks among the processes with the same key follow the ranks of the communicator.
+     */
+    tsunami_lab::parallel::MpiGrid l_grid(4, 4, MPI_COMM_WORLD);
+    tsunami_lab::t_idx l_rank = 0;
+    tsunami_lab::t_idx l_nRanks = 0;
+
+    l_grid.getNodeRank(3, l_rank, l_nRanks);
+    REQUIRE(l_rank == tsunami_lab::t_idx(l_grid.getRank()));
+    REQUIRE(l_nRanks == tsunami_lab::t_idx(l_grid.getNumberOfRanks()));
+
+    int l_key = l_grid.getRank() % 2;
+    l_grid.getNodeRank(l_key, l_rank, l_nRanks);
+    REQUIRE(l_rank == tsunami_lab::t_idx(l_grid.getRank() / 2));
+    REQUIRE(l_nRanks == tsunami_lab::t_idx((l_grid.getNumberOfRanks() + 1 - l_key) / 2));
+}
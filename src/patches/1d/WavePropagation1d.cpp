@@ -6,12 +6,22 @@
  **/
 #include "WavePropagation1d.h"
 
+#include <algorithm>
+
 #include "../../solvers/FWave.h"
 #include "../../solvers/Roe.h"
 
-tsunami_lab::patches::WavePropagation1d::WavePropagation1d(t_idx i_nCells, bool i_use_roe_solver) {
+constexpr tsunami_lab::t_idx tsunami_lab::patches::WavePropagation1d::c_chunkSize;
+
+tsunami_lab::patches::WavePropagation1d::WavePropagation1d(t_idx i_nCells, e_solver i_solver) {
     m_nCells = i_nCells;
-    m_use_roe_solver = i_use_roe_solver;
+
+    // the solver is chosen once, the time steps run its instantiation of the edge loop
+    if (i_solver == ROE) {
+        m_timeStep = &WavePropagation1d::timeStepSolver<solvers::Roe>;
+    } else {
+        m_timeStep = &WavePropagation1d::timeStepSolver<solvers::FWave>;
+    }
 
     // allocate memory including a single ghost cell on each side
     for (unsigned short l_st = 0; l_st < 2; l_st++) {
@@ -39,7 +49,8 @@ tsunami_lab::patches::WavePropagation1d::~WavePropagation1d() {
     delete[] m_b;
 }
 
-void tsunami_lab::patches::WavePropagation1d::timeStep(t_real i_scaling, t_real) {
+template <typename t_solver>
+void tsunami_lab::patches::WavePropagation1d::timeStepSolver(t_real i_scaling) {
     // pointers to old and new data
     t_real *l_hOld = m_h[m_step];
     t_real *l_huOld = m_hu[m_step];
@@ -54,39 +65,39 @@ void tsunami_lab::patches::WavePropagation1d::timeStep(t_real i_scaling, t_real)
         l_huNew[l_ce] = l_huOld[l_ce];
     }
 
-    // iterate over edges and update with Riemann solutions
-    for (t_idx l_ed = 0; l_ed < m_nCells + 1; l_ed++) {
-        // determine left and right cell-id
-        t_idx l_ceL = l_ed;
-        t_idx l_ceR = l_ed + 1;
-
-        // compute net-updates
-        t_real l_netUpdates[2][2];
-
-        if (m_use_roe_solver) {
-            solvers::Roe::netUpdates(l_hOld[l_ceL],
-                                     l_hOld[l_ceR],
-                                     l_huOld[l_ceL],
-                                     l_huOld[l_ceR],
-                                     l_netUpdates[0],
-                                     l_netUpdates[1]);
-        } else {
-            solvers::FWave::netUpdates(l_hOld[l_ceL],
-                                       l_hOld[l_ceR],
-                                       l_huOld[l_ceL],
-                                       l_huOld[l_ceR],
-                                       m_b[l_ceL],
-                                       m_b[l_ceR],
-                                       l_netUpdates[0],
-                                       l_netUpdates[1]);
-        }
+    // iterate over chunks of edges and update with Riemann solutions
+    t_idx l_nEdges = m_nCells + 1;
+    m_maxWaveSpeed = 0;
+    for (t_idx l_ed0 = 0; l_ed0 < l_nEdges; l_ed0 += c_chunkSize) {
+        t_idx l_nChunk = std::min(c_chunkSize, l_nEdges - l_ed0);
+
+        // compute net-updates; 0: height left, 1: momentum left, 2: height right, 3: momentum right
+        t_real l_netUpdates[4][c_chunkSize];
+
+        t_real l_waveSpeed = t_solver::netUpdatesBatch(l_nChunk,
+                                                       l_hOld + l_ed0,
+                                                       l_hOld + l_ed0 + 1,
+                                                       l_huOld + l_ed0,
+                                                       l_huOld + l_ed0 + 1,
+                                                       m_b + l_ed0,
+                                                       m_b + l_ed0 + 1,
+                                                       l_netUpdates[0],
+                                                       l_netUpdates[1],
+                                                       l_netUpdates[2],
+                                                       l_netUpdates[3]);
+        m_maxWaveSpeed = std::max(m_maxWaveSpeed, l_waveSpeed);
 
         // update the cells' quantities
-        l_hNew[l_ceL] -= i_scaling * l_netUpdates[0][0];
-        l_huNew[l_ceL] -= i_scaling * l_netUpdates[0][1];
+        for (t_idx l_ed = 0; l_ed < l_nChunk; l_ed++) {
+            t_idx l_ceL = l_ed0 + l_ed;
+            t_idx l_ceR = l_ceL + 1;
+
+            l_hNew[l_ceL] -= i_scaling * l_netUpdates[0][l_ed];
+            l_huNew[l_ceL] -= i_scaling * l_netUpdates[1][l_ed];
 
-        l_hNew[l_ceR] -= i_scaling * l_netUpdates[1][0];
-        l_huNew[l_ceR] -= i_scaling * l_netUpdates[1][1];
+            l_hNew[l_ceR] -= i_scaling * l_netUpdates[2][l_ed];
+            l_huNew[l_ceR] -= i_scaling * l_netUpdates[3][l_ed];
+        }
     }
 }
 
@@ -17,8 +17,11 @@ namespace tsunami_lab {
 
 class tsunami_lab::patches::WavePropagation1d : public WavePropagation {
    private:
-    //! boolean that decides which solver is used
-    bool m_use_roe_solver = 0;
+    //! number of edges whose net-updates are computed at once
+    static t_idx constexpr c_chunkSize = 128;
+
+    //! time step of the solver chosen at construction
+    void (WavePropagation1d::*m_timeStep)(t_real) = nullptr;
 
     //! current step which indicates the active values in the arrays below
     unsigned short m_step = 0;
@@ -35,14 +38,26 @@ class tsunami_lab::patches::WavePropagation1d : public WavePropagation {
     //! bathymetries for all cells
     t_real *m_b = nullptr;
 
+    //! maximum absolute wave speed observed in the last time step
+    t_real m_maxWaveSpeed = 0;
+
+    /**
+     * Performs a time step with the batched net-updates of the given solver, which are inlined into the edge loop.
+     *
+     * @tparam t_solver solver policy, i.e., solvers::FWave or solvers::Roe.
+     * @param i_scaling scaling of the time step (dt / dx).
+     **/
+    template <typename t_solver>
+    void timeStepSolver(t_real i_scaling);
+
    public:
     /**
      * Constructs the 1d wave propagation solver.
      *
      * @param i_nCells number of cells.
-     * @param i_use_roe_solver boolean showing if the roe solver is used (0 -> f-wave, 1 -> roe)
+     * @param i_solver Riemann solver which computes the net-updates.
      **/
-    WavePropagation1d(t_idx i_nCells, bool i_use_roe_solver);
+    WavePropagation1d(t_idx i_nCells, e_solver i_solver);
 
     /**
      * Destructor which frees all allocated memory.
@@ -55,7 +70,18 @@ class tsunami_lab::patches::WavePropagation1d : public WavePropagation {
      * @param i_scaling scaling of the time step (dt / dx).
      **/
     void timeStep(t_real i_scaling,
-                  t_real);
+                  t_real) {
+        (this->*m_timeStep)(i_scaling);
+    }
+
+    /**
+     * Gets the maximum absolute wave speed observed in the last time step.
+     *
+     * @return maximum wave speed.
+     **/
+    t_real getMaxWaveSpeed() {
+        return m_maxWaveSpeed;
+    }
 
     /**
      * Sets the values of the ghost cells according to entered boundary conditions.
@@ -7,6 +7,7 @@
 #include "WavePropagation1d.h"
 
 #include <catch2/catch.hpp>
+#include <cmath>
 
 TEST_CASE("Test the 1d wave propagation solver (Roe).", "[WaveProp1d]") {
     /*
@@ -27,7 +28,7 @@ TEST_CASE("Test the 1d wave propagation solver (Roe).", "[WaveProp1d]") {
      */
 
     // construct solver (roe) and setup a dambreak problem
-    tsunami_lab::patches::WavePropagation1d m_waveProp(100, 1);
+    tsunami_lab::patches::WavePropagation1d m_waveProp(100, tsunami_lab::ROE);
 
     for (std::size_t l_ce = 0; l_ce < 50; l_ce++) {
         m_waveProp.setHeight(l_ce,
@@ -92,7 +93,7 @@ TEST_CASE("Test the 1d wave propagation solver (FWave).", "[WaveProp1d]") {
      */
 
     // construct solver (F_Wave) and setup a dambreak problem
-    tsunami_lab::patches::WavePropagation1d m_waveProp(100, 0);
+    tsunami_lab::patches::WavePropagation1d m_waveProp(100, tsunami_lab::FWAVE);
 
     for (std::size_t l_ce = 0; l_ce < 50; l_ce++) {
         m_waveProp.setHeight(l_ce,
@@ -124,6 +125,9 @@ TEST_CASE("Test the 1d wave propagation solver (FWave).", "[WaveProp1d]") {
     // perform a time step
     m_waveProp.timeStep(0.1, 0);
 
+    // the still water on the left limits the time step
+    REQUIRE(m_waveProp.getMaxWaveSpeed() == Approx(std::sqrt(9.80665 * 10)));
+
     // steady state
     for (std::size_t l_ce = 0; l_ce < 49; l_ce++) {
         REQUIRE(m_waveProp.getHeight()[l_ce] == Approx(10));
@@ -159,7 +163,7 @@ TEST_CASE("Test Reflecting Boundary Condition.", "[ReflectingBoundaryConditions]
      */
 
     // construct solver (F_Wave) and setup a dambreak problem
-    tsunami_lab::patches::WavePropagation1d m_waveProp(100, 0);
+    tsunami_lab::patches::WavePropagation1d m_waveProp(100, tsunami_lab::FWAVE);
 
     for (std::size_t l_ce = 0; l_ce < 50; l_ce++) {
         m_waveProp.setHeight(l_ce,
@@ -201,7 +205,7 @@ TEST_CASE("Test Left Reflecting Boundary Condition.", "[LeftReflectingBoundaryCo
      */
 
     // construct solver (F_Wave) and setup a dambreak problem
-    tsunami_lab::patches::WavePropagation1d m_waveProp(100, 0);
+    tsunami_lab::patches::WavePropagation1d m_waveProp(100, tsunami_lab::FWAVE);
 
     for (std::size_t l_ce = 0; l_ce < 50; l_ce++) {
         m_waveProp.setHeight(l_ce,
@@ -243,7 +247,7 @@ TEST_CASE("Test Right Reflecting Boundary Condition.", "[RightReflectingBoundary
      */
 
     // construct solver (F_Wave) and setup a dambreak problem
-    tsunami_lab::patches::WavePropagation1d m_waveProp(100, 0);
+    tsunami_lab::patches::WavePropagation1d m_waveProp(100, tsunami_lab::FWAVE);
 
     for (std::size_t l_ce = 0; l_ce < 50; l_ce++) {
         m_waveProp.setHeight(l_ce,
@@ -0,0 +1,42 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Memory layout of the cells of the 2d patch.
+ **/
+#include "Layout2d.h"
+
+#include <cstdlib>
+#include <new>
+
+constexpr tsunami_lab::t_idx tsunami_lab::patches::Layout2d::c_alignCells;
+
+tsunami_lab::patches::Layout2d::Layout2d(t_idx i_nCellsX,
+                                         t_idx i_nCellsY) {
+    m_nCellsX = i_nCellsX;
+    m_nCellsY = i_nCellsY;
+    m_stride = getPaddedStride(i_nCellsX);
+}
+
+tsunami_lab::t_idx tsunami_lab::patches::Layout2d::getPaddedStride(t_idx i_nCellsX) {
+    t_idx l_nAlignments = (i_nCellsX + 2 + c_alignCells - 1) / c_alignCells;
+
+    // an odd number of alignments distributes the cells of a column over all sets of the caches
+    if (l_nAlignments % 2 == 0) l_nAlignments++;
+
+    return l_nAlignments * c_alignCells;
+}
+
+tsunami_lab::t_real *tsunami_lab::patches::Layout2d::allocate(t_idx i_nRows) const {
+    // the ghost cells (0, y) precede the aligned inner cells
+    void *l_data = nullptr;
+    t_idx l_bytes = (c_alignCells - 1 + i_nRows * m_stride) * sizeof(t_real);
+    if (posix_memalign(&l_data, kernels::c_alignment, l_bytes) != 0) throw std::bad_alloc();
+
+    return static_cast<t_real *>(l_data) + c_alignCells - 1;
+}
+
+void tsunami_lab::patches::Layout2d::free(t_real *io_data) {
+    if (io_data == nullptr) return;
+    std::free(io_data - (c_alignCells - 1));
+}
@@ -0,0 +1,109 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Memory layout of the cells of the 2d patch.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_LAYOUT_2D
+#define TSUNAMI_LAB_PATCHES_LAYOUT_2D
+
+#include "../../constants.h"
+#include "../../kernels/Kernels.h"
+
+namespace tsunami_lab {
+    namespace patches {
+        class Layout2d;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * The cells of an array, including a single ghost cell on each side, are stored row by row. Cell (x, y) is at index
+ * y * stride + x relative to cell (0, 0), as seen by all users of the arrays.
+ *
+ * Every row's first inner cell (1, y) starts at a multiple of kernels::c_alignment bytes, such that the blocks of
+ * columns of the y-sweep, which start at the inner cells 1, 1 + c_chunkSize, ..., are swept with aligned loads.
+ * Thus the stride is padded to a multiple of the alignment. It is further padded to an odd number of alignments:
+ * strides of a power of two map the cells of a column to a few sets of the caches, which evicts the rows of the y-sweep
+ * before they are reused. The padding cells are zero and never updated.
+ **/
+class tsunami_lab::patches::Layout2d {
+   private:
+    //! number of cells which fill an alignment
+    static t_idx constexpr c_alignCells = kernels::c_alignment / sizeof(t_real);
+
+    //! number of cells in x-direction without ghost cells
+    t_idx m_nCellsX = 0;
+
+    //! number of cells in y-direction without ghost cells
+    t_idx m_nCellsY = 0;
+
+    //! distance between two rows in cells
+    t_idx m_stride = 0;
+
+   public:
+    /**
+     * Constructs the layout of a patch.
+     *
+     * @param i_nCellsX number of cells in x-direction without ghost cells.
+     * @param i_nCellsY number of cells in y-direction without ghost cells.
+     **/
+    Layout2d(t_idx i_nCellsX,
+             t_idx i_nCellsY);
+
+    /**
+     * Gets the padded stride of rows.
+     *
+     * @param i_nCellsX number of cells in x-direction without ghost cells.
+     * @return stride in cells; a multiple of the alignment which is at least i_nCellsX + 2.
+     **/
+    static t_idx getPaddedStride(t_idx i_nCellsX);
+
+    /**
+     * Gets the stride in y-direction. x-direction is stride-1.
+     *
+     * @return stride in y-direction.
+     **/
+    t_idx getStride() const {
+        return m_stride;
+    }
+
+    /**
+     * Gets the index of a cell relative to cell (0, 0).
+     *
+     * @param i_x id of the cell in x-direction including the ghost cells.
+     * @param i_y id of the cell in y-direction including the ghost cells.
+     * @return index.
+     **/
+    t_idx getIndex(t_idx i_x,
+                   t_idx i_y) const {
+        return i_y * m_stride + i_x;
+    }
+
+    /**
+     * Gets the number of cells of an array including the ghost cells and the padding, i.e., the cells between cell
+     * (0, 0) and the end of the last row.
+     *
+     * @return number of cells.
+     **/
+    t_idx getNumberOfCells() const {
+        return (m_nCellsY + 2) * m_stride;
+    }
+
+    /**
+     * Allocates an array of rows of the layout, whose first inner cells are aligned. The cells are not initialized,
+     * such that their pages are placed when they are first touched.
+     *
+     * @param i_nRows number of rows including the ghost rows.
+     * @return cell (0, 0) of the array.
+     **/
+    t_real *allocate(t_idx i_nRows) const;
+
+    /**
+     * Frees an array allocated by allocate.
+     *
+     * @param io_data cell (0, 0) of the array; nullptr is ignored.
+     **/
+    static void free(t_real *io_data);
+};
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the memory layout of the 2d patch.
+ **/
+#include "Layout2d.h"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+TEST_CASE("Test the padded stride of the 2d layout.", "[Layout2d]") {
+    /*
+     * Test case:
+     *   The rows of 16 cells (64 bytes) hold the ghost cells and are padded to an odd number of 16 cells.
+     *
+     *   nx    | nx + 2 | stride
+     *   1     | 3      | 16
+     *   14    | 16     | 16
+     *   15    | 17     | 48
+     *   30    | 32     | 48
+     *   1000  | 1002   | 1008
+     *   1022  | 1024   | 1040
+     */
+    tsunami_lab::t_idx l_nx[6] = {1, 14, 15, 30, 1000, 1022};
+    tsunami_lab::t_idx l_stride[6] = {16, 16, 48, 48, 1008, 1040};
+
+    for (unsigned short l_te = 0; l_te < 6; l_te++) {
+        REQUIRE(tsunami_lab::patches::Layout2d::getPaddedStride(l_nx[l_te]) == l_stride[l_te]);
+
+        tsunami_lab::patches::Layout2d l_layout(l_nx[l_te], 5);
+        REQUIRE(l_layout.getStride() == l_stride[l_te]);
+        REQUIRE(l_layout.getIndex(3, 2) == 2 * l_stride[l_te] + 3);
+        REQUIRE(l_layout.getNumberOfCells() == 7 * l_stride[l_te]);
+    }
+}
+
+TEST_CASE("Test the alignment of the arrays of the 2d layout.", "[Layout2d]") {
+    /*
+     * Test case:
+     *   The first inner cell of every row of an array with 7 rows starts at 64 bytes.
+     *   All cells of the array can be written.
+     */
+    tsunami_lab::patches::Layout2d l_layout(100, 5);
+    tsunami_lab::t_real *l_data = l_layout.allocate(7);
+
+    for (tsunami_lab::t_idx l_ro = 0; l_ro < 7; l_ro++) {
+        std::uintptr_t l_address = reinterpret_cast<std::uintptr_t>(l_data + l_layout.getIndex(1, l_ro));
+        REQUIRE(l_address % tsunami_lab::kernels::c_alignment == 0);
+    }
+
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_layout.getNumberOfCells(); l_ce++) l_data[l_ce] = l_ce;
+    REQUIRE(l_data[l_layout.getNumberOfCells() - 1] == l_layout.getNumberOfCells() - 1);
+
+    tsunami_lab::patches::Layout2d::free(l_data);
+    tsunami_lab::patches::Layout2d::free(nullptr);
+}
@@ -7,218 +7,680 @@
 
 #include "WavePropagation2d.h"
 
-#include "../../solvers/FWave.h"
+#include <omp.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "../../parallel/Affinity.h"
+
+constexpr tsunami_lab::t_idx tsunami_lab::patches::WavePropagation2d::c_chunkSize;
+constexpr tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::c_stillTolerance;
 
 tsunami_lab::patches::WavePropagation2d::WavePropagation2d(t_idx i_nCellsX,
-                                                           t_idx i_mCellsY) {
+                                                           t_idx i_mCellsY,
+                                                           t_idx i_tileRows,
+                                                           bool i_trackActivity,
+                                                           e_solver i_solver,
+                                                           kernels::Kernels const *i_kernels) : m_layout(i_nCellsX, i_mCellsY) {
     m_nCellsX = i_nCellsX;
     m_nCellsY = i_mCellsY;
-    m_nCellsAll = (i_nCellsX + 2) * (i_mCellsY + 2);
-
-    // allocate memory including a single ghost cell on each side
+    m_tileRows = std::min(i_tileRows, i_mCellsY);
+    m_trackActivity = i_trackActivity && m_tileRows == 0 && i_solver == FWAVE;
+
+    // the solver and the instruction set level are chosen once, all sweeps run their build of the kernels
+    m_kernels = (i_kernels != nullptr) ? i_kernels : &kernels::getKernels();
+    m_sweepRow = m_kernels->sweepRow[i_solver];
+    m_sweepColumns = m_kernels->sweepColumns[i_solver];
+    m_nTilesX = (m_nCellsX + c_chunkSize - 1) / c_chunkSize;
+    m_nTilesY = (m_nCellsY + c_chunkSize - 1) / c_chunkSize;
+    m_nActiveTiles = m_nTilesX * m_nTilesY;
+
+    // allocate memory including a single ghost cell on each side; the pages are placed when they are first touched
     for (unsigned short l_st = 0; l_st < 2; l_st++) {
-        m_h[l_st] = new t_real[m_nCellsAll];
-        m_hu[l_st] = new t_real[m_nCellsAll];
-        m_hv[l_st] = new t_real[m_nCellsAll];
+        m_h[l_st] = m_layout.allocate(m_nCellsY + 2);
+        m_hu[l_st] = m_layout.allocate(m_nCellsY + 2);
+        m_hv[l_st] = m_layout.allocate(m_nCellsY + 2);
+    }
+    m_b = m_layout.allocate(m_nCellsY + 2);
+
+    // allocate the intermediate results of the x-sweep: full grid or one band (including halo rows) per thread
+    if (m_tileRows == 0) {
+        m_hStar = m_layout.allocate(m_nCellsY + 2);
+        m_huStar = m_layout.allocate(m_nCellsY + 2);
+    } else {
+        m_nBandBuffers = omp_get_max_threads();
+        m_hBand = m_layout.allocate(m_nBandBuffers * (m_tileRows + 2));
+        m_huBand = m_layout.allocate(m_nBandBuffers * (m_tileRows + 2));
     }
-    m_b = new t_real[m_nCellsAll];
 
-    // init to zero
-    for (t_idx l_ce = 0; l_ce < m_nCellsAll; l_ce++) {
+    // init to zero with the static partition of the rows of the x-sweep, such that the pages of a row are placed on
+    // the NUMA node of the thread which updates it
+    t_idx l_stride = getStride();
+#pragma omp parallel for schedule(static)
+    for (t_idx l_ceY = 0; l_ceY < m_nCellsY + 2; l_ceY++) {
+        t_idx l_idx = getIndex(0, l_ceY);
         for (unsigned short l_st = 0; l_st < 2; l_st++) {
-            m_h[l_st][l_ce] = 0;
-            m_hu[l_st][l_ce] = 0;
-            m_hv[l_st][l_ce] = 0;
+            std::fill(m_h[l_st] + l_idx, m_h[l_st] + l_idx + l_stride, 0);
+            std::fill(m_hu[l_st] + l_idx, m_hu[l_st] + l_idx + l_stride, 0);
+            std::fill(m_hv[l_st] + l_idx, m_hv[l_st] + l_idx + l_stride, 0);
+        }
+        std::fill(m_b + l_idx, m_b + l_idx + l_stride, 0);
+
+        if (m_tileRows == 0) {
+            std::fill(m_hStar + l_idx, m_hStar + l_idx + l_stride, 0);
+            std::fill(m_huStar + l_idx, m_huStar + l_idx + l_stride, 0);
+        }
+    }
+
+    // thread i uses band buffer i, which it touches first
+    if (m_tileRows != 0) {
+        t_idx l_nBufferCells = (m_tileRows + 2) * l_stride;
+#pragma omp parallel for schedule(static, 1) num_threads(m_nBandBuffers)
+        for (t_idx l_bu = 0; l_bu < m_nBandBuffers; l_bu++) {
+            t_idx l_offset = l_bu * l_nBufferCells;
+            std::fill(m_hBand + l_offset, m_hBand + l_offset + l_nBufferCells, 0);
+            std::fill(m_huBand + l_offset, m_huBand + l_offset + l_nBufferCells, 0);
+        }
+    }
+
+    // states of the tiles; all tiles are derived and solved in the first time step
+    if (m_trackActivity) {
+        t_idx l_nTiles = m_nTilesX * m_nTilesY;
+        m_tileActive = new unsigned char[l_nTiles];
+        m_tileStill = new unsigned char[l_nTiles];
+        m_tileLevelMin = new t_real[l_nTiles];
+        m_tileLevelMax = new t_real[l_nTiles];
+        m_tileWaveSpeed = new t_real[l_nTiles];
+        for (t_idx l_ti = 0; l_ti < l_nTiles; l_ti++) {
+            m_tileActive[l_ti] = 1;
+            m_tileStill[l_ti] = 0;
+            m_tileLevelMin[l_ti] = 0;
+            m_tileLevelMax[l_ti] = 0;
+            m_tileWaveSpeed[l_ti] = 0;
         }
-        m_b[l_ce] = 0;
     }
 }
 
 tsunami_lab::patches::WavePropagation2d::~WavePropagation2d() {
     for (unsigned short l_st = 0; l_st < 2; l_st++) {
-        delete[] m_h[l_st];
-        delete[] m_hu[l_st];
-        delete[] m_hv[l_st];
+        Layout2d::free(m_h[l_st]);
+        Layout2d::free(m_hu[l_st]);
+        Layout2d::free(m_hv[l_st]);
     }
 
-    delete[] m_b;
+    Layout2d::free(m_b);
+    Layout2d::free(m_hStar);
+    Layout2d::free(m_huStar);
+    Layout2d::free(m_hBand);
+    Layout2d::free(m_huBand);
+    delete[] m_tileActive;
+    delete[] m_tileStill;
+    delete[] m_tileLevelMin;
+    delete[] m_tileLevelMax;
+    delete[] m_tileWaveSpeed;
 }
 
 tsunami_lab::t_idx tsunami_lab::patches::WavePropagation2d::getIndex(t_idx i_x, t_idx i_y) {
-    return i_y * getStride() + i_x;
+    return m_layout.getIndex(i_x, i_y);
 }
 
 void tsunami_lab::patches::WavePropagation2d::timeStep(t_real i_scalingX,
                                                        t_real i_scalingY) {
-    // pointers to old and new data
+    if (m_tileRows == 0) {
+        t_real l_waveSpeedX = sweepX(i_scalingX);
+        t_real l_waveSpeedY = sweepY(i_scalingY);
+        m_maxWaveSpeed = std::max(l_waveSpeedX, l_waveSpeedY);
+    } else {
+        m_maxWaveSpeed = timeStepFused(i_scalingX, i_scalingY);
+    }
+}
+
+void tsunami_lab::patches::WavePropagation2d::timeStepOverlapped(t_real i_scalingX,
+                                                                 t_real i_scalingY,
+                                                                 std::function<void()> const &i_setGhostCells) {
+    if (m_tileRows != 0 || m_trackActivity) {
+        double l_start = traceNow();
+        i_setGhostCells();
+        traceRecord("ghost cells", l_start);
+
+        l_start = traceNow();
+        timeStep(i_scalingX, i_scalingY);
+        traceRecord("time step", l_start);
+        return;
+    }
+
     t_real *l_hOld = m_h[m_step];
     t_real *l_huOld = m_hu[m_step];
     t_real *l_hvOld = m_hv[m_step];
 
-    m_step = (m_step + 1) % 2;
-    t_real *l_hNew = m_h[m_step];
-    t_real *l_huNew = m_hu[m_step];
-    t_real *l_hvNew = m_hv[m_step];
+    t_real *l_hNew = m_h[(m_step + 1) % 2];
+    t_real *l_huNew = m_hu[(m_step + 1) % 2];
+    t_real *l_hvNew = m_hv[(m_step + 1) % 2];
 
-    // create arrays to save the data from the x-sweep
-    t_real *l_hStar = new t_real[m_nCellsAll];
-    t_real *l_huStar = new t_real[m_nCellsAll];
-    t_real *l_hvStar = new t_real[m_nCellsAll];
+    t_idx l_nx = m_nCellsX;
+    t_idx l_ny = m_nCellsY;
 
-    // init cell (Star) quantities
-#pragma omp parallel for collapse(2) schedule(static, 32)
-    for (t_idx l_ceY = 0; l_ceY < m_nCellsY + 2; l_ceY++) {
-        for (t_idx l_ceX = 0; l_ceX < m_nCellsX + 2; l_ceX++) {
-            t_idx l_idx = getIndex(l_ceX, l_ceY);
-            l_hStar[l_idx] = l_hOld[l_idx];
-            l_huStar[l_idx] = l_huOld[l_idx];
-            l_hvStar[l_idx] = l_hvOld[l_idx];
+    // the inner cells 2 to nx - 1 and 2 to ny - 1 do not depend on ghost cells; they are split into tiles
+    t_idx l_nInnerX = (l_nx > 2) ? l_nx - 2 : 0;
+    t_idx l_nInnerY = (l_ny > 2) ? l_ny - 2 : 0;
+    t_idx l_nTilesX = (l_nInnerX + c_chunkSize - 1) / c_chunkSize;
+    t_idx l_nTilesY = (l_nInnerY + c_chunkSize - 1) / c_chunkSize;
+
+    // the rows 1 and ny next to the ghost rows are swept in chunks of columns 2 to nx - 1
+    t_idx l_nBoundaryRows = (l_ny > 1) ? 2 : 1;
+    t_idx l_nBoundaryCols = (l_nx > 1) ? 2 : 1;
+    t_idx l_nChunks = (l_nInnerX + c_chunkSize - 1) / c_chunkSize;
+
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp parallel reduction(max : l_waveSpeedMax)
+    {
+        double l_start = 0;
+
+        // the master thread fills the ghost cells and joins the x-sweep of the inner cells afterwards
+#pragma omp master
+        {
+            l_start = traceNow();
+            i_setGhostCells();
+            traceRecord("ghost cells", l_start);
+        }
+
+        // x-sweep of the inner rows: the cells 2 to nx - 1 only depend on the inner cells; the loop runs over all rows
+        // with the static partition of the first touch, such that every thread updates the rows it placed
+        l_start = traceNow();
+#pragma omp for schedule(static) nowait
+        for (t_idx l_ceY = 0; l_ceY < l_ny + 2; l_ceY++) {
+            if (l_ceY == 0 || l_ceY == l_ny + 1) continue;
+            t_idx l_idx = getIndex(1, l_ceY);
+
+            t_real l_waveSpeed = sweepRow(l_nx,
+                                          i_scalingX,
+                                          l_hOld + l_idx,
+                                          l_huOld + l_idx,
+                                          m_b + l_idx,
+                                          m_hStar + l_idx,
+                                          m_huStar + l_idx);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+        }
+        traceRecord("interior x-sweep", l_start);
+
+#pragma omp barrier
+
+        // y-sweep of the inner cells, which only depends on the x-sweep of the inner rows; the static partition assigns
+        // consecutive tiles in row-major order, i.e., about the rows of the first touch, to every thread
+        l_start = traceNow();
+#pragma omp for collapse(2) schedule(static) nowait
+        for (t_idx l_tiY = 0; l_tiY < l_nTilesY; l_tiY++) {
+            for (t_idx l_tiX = 0; l_tiX < l_nTilesX; l_tiX++) {
+                t_idx l_rowFirst = 2 + l_tiY * c_chunkSize;
+                t_idx l_rowEnd = std::min(l_rowFirst + c_chunkSize, l_ny);
+                t_idx l_colFirst = 2 + l_tiX * c_chunkSize;
+                t_idx l_nCols = std::min(c_chunkSize, l_nx - l_colFirst);
+                t_idx l_idx = getIndex(l_colFirst, l_rowFirst - 1);
+
+                t_real l_waveSpeed = sweepColumns(l_rowEnd - l_rowFirst + 2,
+                                                  l_nCols,
+                                                  i_scalingY,
+                                                  m_hStar + l_idx,
+                                                  l_hvOld + l_idx,
+                                                  m_b + l_idx,
+                                                  l_hNew + l_idx,
+                                                  l_hvNew + l_idx);
+                l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+
+                for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+                    t_idx l_idxRow = getIndex(l_colFirst, l_ceY);
+                    for (t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                        l_huNew[l_idxRow + l_co] = m_huStar[l_idxRow + l_co];
+                    }
+                }
+            }
         }
+        traceRecord("interior y-sweep", l_start);
+
+        // x-sweep of the ghost rows and of the cells 1 and nx of the inner rows, partitioned as the first touch
+        l_start = traceNow();
+#pragma omp for schedule(static) nowait
+        for (t_idx l_ceY = 0; l_ceY < l_ny + 2; l_ceY++) {
+            t_real l_waveSpeed = 0;
+
+            if (l_ceY == 0 || l_ceY == l_ny + 1) {
+                t_idx l_idx = getIndex(0, l_ceY);
+                l_waveSpeed = sweepRow(l_nx + 2,
+                                       i_scalingX,
+                                       l_hOld + l_idx,
+                                       l_huOld + l_idx,
+                                       m_b + l_idx,
+                                       m_hStar + l_idx,
+                                       m_huStar + l_idx);
+            } else {
+                for (t_idx l_si = 0; l_si < l_nBoundaryCols; l_si++) {
+                    t_idx l_idx = getIndex((l_si == 0) ? 0 : l_nx - 1, l_ceY);
+                    t_real l_waveSpeedSide = sweepRow(3,
+                                                      i_scalingX,
+                                                      l_hOld + l_idx,
+                                                      l_huOld + l_idx,
+                                                      m_b + l_idx,
+                                                      m_hStar + l_idx,
+                                                      m_huStar + l_idx);
+                    l_waveSpeed = std::max(l_waveSpeed, l_waveSpeedSide);
+                }
+            }
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+        }
+        traceRecord("boundary x-sweep", l_start);
+
+#pragma omp barrier
+
+        // y-sweep of the columns 1 and nx and of the rows 1 and ny in between
+        l_start = traceNow();
+#pragma omp for schedule(dynamic) nowait
+        for (t_idx l_it = 0; l_it < l_nBoundaryCols + l_nBoundaryRows * l_nChunks; l_it++) {
+            t_idx l_colFirst, l_nCols, l_rowFirst, l_rowEnd;
+
+            if (l_it < l_nBoundaryCols) {
+                l_colFirst = (l_it == 0) ? 1 : l_nx;
+                l_nCols = 1;
+                l_rowFirst = 1;
+                l_rowEnd = l_ny + 1;
+            } else {
+                t_idx l_ch = (l_it - l_nBoundaryCols) / l_nBoundaryRows;
+                l_colFirst = 2 + l_ch * c_chunkSize;
+                l_nCols = std::min(c_chunkSize, l_nx - l_colFirst);
+                l_rowFirst = ((l_it - l_nBoundaryCols) % l_nBoundaryRows == 0) ? 1 : l_ny;
+                l_rowEnd = l_rowFirst + 1;
+            }
+            t_idx l_idx = getIndex(l_colFirst, l_rowFirst - 1);
+
+            t_real l_waveSpeed = sweepColumns(l_rowEnd - l_rowFirst + 2,
+                                              l_nCols,
+                                              i_scalingY,
+                                              m_hStar + l_idx,
+                                              l_hvOld + l_idx,
+                                              m_b + l_idx,
+                                              l_hNew + l_idx,
+                                              l_hvNew + l_idx);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+
+            for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+                t_idx l_idxRow = getIndex(l_colFirst, l_ceY);
+                for (t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                    l_huNew[l_idxRow + l_co] = m_huStar[l_idxRow + l_co];
+                }
+            }
+        }
+        traceRecord("boundary y-sweep", l_start);
     }
 
-    // iterate over edges in x-direction for every row and update with Riemann solutions (x-sweep)
-#pragma omp parallel for collapse(2) shared(l_hStar, l_huStar)
-    for (t_idx l_edY = 0; l_edY < m_nCellsY + 2; l_edY++) {
-        for (t_idx l_edX = 0; l_edX < m_nCellsX + 1; l_edX++) {
-            // determine left and right cell-id
-            t_idx l_ceL = getIndex(l_edX, l_edY);
-            t_idx l_ceR = getIndex(l_edX + 1, l_edY);
+    m_step = (m_step + 1) % 2;
+    m_maxWaveSpeed = l_waveSpeedMax;
+}
 
-            // compute net-updates
-            t_real l_netUpdates[2][2];
+tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::sweepX(t_real i_scalingX) {
+    // the scratch arrays of the full-grid sweeps are not allocated in the fused mode
+    assert(m_tileRows == 0);
 
-            solvers::FWave::netUpdates(l_hOld[l_ceL],
-                                       l_hOld[l_ceR],
-                                       l_huOld[l_ceL],
-                                       l_huOld[l_ceR],
-                                       m_b[l_ceL],
-                                       m_b[l_ceR],
-                                       l_netUpdates[0],
-                                       l_netUpdates[1]);
+    t_real *l_hOld = m_h[m_step];
+    t_real *l_huOld = m_hu[m_step];
+    t_real l_waveSpeedMax = 0;
+
+    if (m_trackActivity) {
+        // the water in skipped tiles still limits the time step
+        l_waveSpeedMax = updateActiveTiles();
+
+        // iterate over the tiles; the rows of active tiles are updated segment-wise, skipped tiles keep their state
+#pragma omp parallel for collapse(2) schedule(static) reduction(max : l_waveSpeedMax)
+        for (t_idx l_tiY = 0; l_tiY < m_nTilesY; l_tiY++) {
+            for (t_idx l_tiX = 0; l_tiX < m_nTilesX; l_tiX++) {
+                t_idx l_rowFirst, l_rowEnd;
+                getTileRowRange(l_tiY, l_rowFirst, l_rowEnd);
+                t_idx l_colFirst = 1 + l_tiX * c_chunkSize;
+                t_idx l_nCols = std::min(c_chunkSize, m_nCellsX + 1 - l_colFirst);
+                bool l_active = m_tileActive[l_tiY * m_nTilesX + l_tiX];
+
+                for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+                    t_idx l_idx = getIndex(l_colFirst, l_ceY);
+
+                    if (l_active) {
+                        t_real l_waveSpeed = sweepRow(l_nCols + 2,
+                                                      i_scalingX,
+                                                      l_hOld + l_idx - 1,
+                                                      l_huOld + l_idx - 1,
+                                                      m_b + l_idx - 1,
+                                                      m_hStar + l_idx - 1,
+                                                      m_huStar + l_idx - 1);
+                        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+                    } else {
+                        for (t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                            m_hStar[l_idx + l_co] = l_hOld[l_idx + l_co];
+                            m_huStar[l_idx + l_co] = l_huOld[l_idx + l_co];
+                        }
+                    }
+                }
+            }
+        }
 
-            // update the cells' quantities
-#pragma omp atomic update
-            l_hStar[l_ceL] -= i_scalingX * l_netUpdates[0][0];
-#pragma omp atomic update
-            l_huStar[l_ceL] -= i_scalingX * l_netUpdates[0][1];
+        return l_waveSpeedMax;
+    }
 
-#pragma omp atomic update
-            l_hStar[l_ceR] -= i_scalingX * l_netUpdates[1][0];
-#pragma omp atomic update
-            l_huStar[l_ceR] -= i_scalingX * l_netUpdates[1][1];
-        }
+    // iterate over the rows and update with Riemann solutions; every row is owned by a single thread
+#pragma omp parallel for schedule(static) reduction(max : l_waveSpeedMax)
+    for (t_idx l_ceY = 0; l_ceY < m_nCellsY + 2; l_ceY++) {
+        t_idx l_idx = getIndex(0, l_ceY);
+
+        t_real l_waveSpeed = sweepRow(m_nCellsX + 2,
+                                      i_scalingX,
+                                      l_hOld + l_idx,
+                                      l_huOld + l_idx,
+                                      m_b + l_idx,
+                                      m_hStar + l_idx,
+                                      m_huStar + l_idx);
+        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
     }
 
-    // init new cell quantities
-#pragma omp parallel for collapse(2) schedule(static, 32)
+    return l_waveSpeedMax;
+}
+
+tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::sweepY(t_real i_scalingY) {
+    assert(m_tileRows == 0);
+
+    // the x-sweep wrote to the patch's scratch arrays; it does not change the momenta in y-direction
+    t_real *l_hStar = m_hStar;
+    t_real *l_huStar = m_huStar;
+    t_real *l_hvOld = m_hv[m_step];
+
+    m_step = (m_step + 1) % 2;
+    t_real *l_hNew = m_h[m_step];
+    t_real *l_huNew = m_hu[m_step];
+    t_real *l_hvNew = m_hv[m_step];
+
+    // init new momenta in x-direction, which are not touched by the y-sweep
+#pragma omp parallel for schedule(static)
     for (t_idx l_ceY = 1; l_ceY < m_nCellsY + 1; l_ceY++) {
         for (t_idx l_ceX = 1; l_ceX < m_nCellsX + 1; l_ceX++) {
             t_idx l_idx = getIndex(l_ceX, l_ceY);
-            l_hNew[l_idx] = l_hStar[l_idx];
             l_huNew[l_idx] = l_huStar[l_idx];
-            l_hvNew[l_idx] = l_hvStar[l_idx];
         }
     }
 
-    // iterate over edges in y-direction for every column and update with Riemann solutions (y-sweep)
-#pragma omp parallel for collapse(2) shared(l_hNew, l_hvNew)
-    for (t_idx l_edX = 1; l_edX < m_nCellsX + 1; l_edX++) {
-        for (t_idx l_edY = 0; l_edY < m_nCellsY + 1; l_edY++) {
-            // determine upper and lower cell-id
-            t_idx l_ceU = getIndex(l_edX, l_edY);
-            t_idx l_ceD = getIndex(l_edX, l_edY + 1);
+    // iterate over tiles of columns and rows and update with Riemann solutions; every tile is owned by a
+    // single thread, the rows of edges at the tiles' lower and upper borders are solved by both neighbors
+    t_idx l_nTilesX = (m_nCellsX + c_chunkSize - 1) / c_chunkSize;
+    t_idx l_nTilesY = (m_nCellsY + c_chunkSize - 1) / c_chunkSize;
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp parallel for collapse(2) schedule(static) reduction(max : l_waveSpeedMax)
+    for (t_idx l_tiY = 0; l_tiY < l_nTilesY; l_tiY++) {
+        for (t_idx l_tiX = 0; l_tiX < l_nTilesX; l_tiX++) {
+            t_idx l_rowFirst = 1 + l_tiY * c_chunkSize;
+            t_idx l_rowEnd = std::min(l_rowFirst + c_chunkSize, m_nCellsY + 1);
+            t_idx l_colFirst = 1 + l_tiX * c_chunkSize;
+            t_idx l_nCols = std::min(c_chunkSize, m_nCellsX + 1 - l_colFirst);
+
+            t_idx l_idx = getIndex(l_colFirst, l_rowFirst - 1);
+
+            // skipped tiles keep their state
+            if (m_trackActivity && !m_tileActive[l_tiY * m_nTilesX + l_tiX]) {
+                for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+                    t_idx l_idxRow = getIndex(l_colFirst, l_ceY);
+                    for (t_idx l_co = 0; l_co < l_nCols; l_co++) {
+                        l_hNew[l_idxRow + l_co] = l_hStar[l_idxRow + l_co];
+                        l_hvNew[l_idxRow + l_co] = l_hvOld[l_idxRow + l_co];
+                    }
+                }
+                continue;
+            }
+
+            t_real l_waveSpeed = sweepColumns(l_rowEnd - l_rowFirst + 2,
+                                              l_nCols,
+                                              i_scalingY,
+                                              l_hStar + l_idx,
+                                              l_hvOld + l_idx,
+                                              m_b + l_idx,
+                                              l_hNew + l_idx,
+                                              l_hvNew + l_idx);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+        }
+    }
 
-            // compute net-updates
-            t_real l_netUpdates[2][2];
+    return l_waveSpeedMax;
+}
 
-            solvers::FWave::netUpdates(l_hStar[l_ceU],
-                                       l_hStar[l_ceD],
-                                       l_hvStar[l_ceU],
-                                       l_hvStar[l_ceD],
-                                       m_b[l_ceU],
-                                       m_b[l_ceD],
-                                       l_netUpdates[0],
-                                       l_netUpdates[1]);
+void tsunami_lab::patches::WavePropagation2d::getTileRowRange(t_idx i_tiY,
+                                                              t_idx &o_rowFirst,
+                                                              t_idx &o_rowEnd) {
+    o_rowFirst = 1 + i_tiY * c_chunkSize;
+    o_rowEnd = std::min(o_rowFirst + c_chunkSize, m_nCellsY + 1);
 
-            // update the cells' quantities
-#pragma omp atomic update
-            l_hNew[l_ceU] -= i_scalingY * l_netUpdates[0][0];
-#pragma omp atomic update
-            l_hvNew[l_ceU] -= i_scalingY * l_netUpdates[0][1];
+    if (i_tiY == 0) o_rowFirst = 0;
+    if (i_tiY == m_nTilesY - 1) o_rowEnd = m_nCellsY + 2;
+}
 
-#pragma omp atomic update
-            l_hNew[l_ceD] -= i_scalingY * l_netUpdates[1][0];
-#pragma omp atomic update
-            l_hvNew[l_ceD] -= i_scalingY * l_netUpdates[1][1];
+tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::updateActiveTiles() {
+    t_real *l_h = m_h[m_step];
+    t_real *l_hu = m_hu[m_step];
+    t_real *l_hv = m_hv[m_step];
+
+    // derive the states of the tiles which were solved in the last time step; the ghost cells of the grid's
+    // border belong to the adjacent tiles
+#pragma omp parallel for collapse(2) schedule(static)
+    for (t_idx l_tiY = 0; l_tiY < m_nTilesY; l_tiY++) {
+        for (t_idx l_tiX = 0; l_tiX < m_nTilesX; l_tiX++) {
+            t_idx l_ti = l_tiY * m_nTilesX + l_tiX;
+            if (m_tileStatesValid && !m_tileActive[l_ti]) continue;
+
+            t_idx l_rowFirst, l_rowEnd;
+            getTileRowRange(l_tiY, l_rowFirst, l_rowEnd);
+            t_idx l_colFirst = (l_tiX == 0) ? 0 : 1 + l_tiX * c_chunkSize;
+            t_idx l_colEnd = (l_tiX == m_nTilesX - 1) ? m_nCellsX + 2 : 1 + (l_tiX + 1) * c_chunkSize;
+
+            bool l_still = true;
+            t_real l_levelMin = std::numeric_limits<t_real>::max();
+            t_real l_levelMax = std::numeric_limits<t_real>::lowest();
+            t_real l_hMax = 0;
+
+            for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+                for (t_idx l_ceX = l_colFirst; l_ceX < l_colEnd; l_ceX++) {
+                    t_idx l_idx = getIndex(l_ceX, l_ceY);
+
+                    // dry cells are walls for their neighbors
+                    if (l_h[l_idx] <= 0) continue;
+
+                    l_still = l_still && std::abs(l_hu[l_idx]) <= c_stillTolerance && std::abs(l_hv[l_idx]) <= c_stillTolerance;
+                    l_levelMin = std::min(l_levelMin, l_h[l_idx] + m_b[l_idx]);
+                    l_levelMax = std::max(l_levelMax, l_h[l_idx] + m_b[l_idx]);
+                    l_hMax = std::max(l_hMax, l_h[l_idx]);
+                }
+            }
+
+            m_tileStill[l_ti] = l_still;
+            m_tileLevelMin[l_ti] = l_levelMin;
+            m_tileLevelMax[l_ti] = l_levelMax;
+            m_tileWaveSpeed[l_ti] = std::sqrt(t_real(9.80665) * l_hMax);
         }
     }
+    m_tileStatesValid = true;
+
+    // a tile is solved if any water in it or its neighbors moves or the surface elevations differ
+    t_idx l_nActiveTiles = 0;
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp parallel for collapse(2) schedule(static) reduction(+ : l_nActiveTiles) reduction(max : l_waveSpeedMax)
+    for (t_idx l_tiY = 0; l_tiY < m_nTilesY; l_tiY++) {
+        for (t_idx l_tiX = 0; l_tiX < m_nTilesX; l_tiX++) {
+            bool l_still = true;
+            t_real l_levelMin = std::numeric_limits<t_real>::max();
+            t_real l_levelMax = std::numeric_limits<t_real>::lowest();
+
+            for (t_idx l_neY = (l_tiY == 0) ? 0 : l_tiY - 1; l_neY < std::min(l_tiY + 2, m_nTilesY); l_neY++) {
+                for (t_idx l_neX = (l_tiX == 0) ? 0 : l_tiX - 1; l_neX < std::min(l_tiX + 2, m_nTilesX); l_neX++) {
+                    t_idx l_ne = l_neY * m_nTilesX + l_neX;
+                    l_still = l_still && m_tileStill[l_ne];
+                    l_levelMin = std::min(l_levelMin, m_tileLevelMin[l_ne]);
+                    l_levelMax = std::max(l_levelMax, m_tileLevelMax[l_ne]);
+                }
+            }
+
+            t_idx l_ti = l_tiY * m_nTilesX + l_tiX;
+            bool l_active = !l_still || l_levelMax - l_levelMin > c_stillTolerance;
+            m_tileActive[l_ti] = l_active;
+
+            if (l_active) {
+                l_nActiveTiles++;
+            } else {
+                l_waveSpeedMax = std::max(l_waveSpeedMax, m_tileWaveSpeed[l_ti]);
+            }
+        }
+    }
+    m_nActiveTiles = l_nActiveTiles;
 
-    delete[] l_hStar;
-    delete[] l_huStar;
-    delete[] l_hvStar;
+    return l_waveSpeedMax;
 }
 
-void tsunami_lab::patches::WavePropagation2d::copyCornerCells(t_real *o_dataArray) {
-    t_idx l_xMax = m_nCellsX + 1;
-    t_idx l_yMax = m_nCellsY + 1;
+tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::timeStepFused(t_real i_scalingX,
+                                                                           t_real i_scalingY) {
+    // pointers to old and new data
+    t_real *l_hOld = m_h[m_step];
+    t_real *l_huOld = m_hu[m_step];
+    t_real *l_hvOld = m_hv[m_step];
 
-    o_dataArray[getIndex(0, 0)] = o_dataArray[getIndex(1, 1)];
-    o_dataArray[getIndex(l_xMax, 0)] = o_dataArray[getIndex(l_xMax - 1, 1)];
-    o_dataArray[getIndex(0, l_yMax)] = o_dataArray[getIndex(1, l_yMax - 1)];
-    o_dataArray[getIndex(l_xMax, l_yMax)] = o_dataArray[getIndex(l_xMax - 1, l_yMax - 1)];
-}
+    m_step = (m_step + 1) % 2;
+    t_real *l_hNew = m_h[m_step];
+    t_real *l_huNew = m_hu[m_step];
+    t_real *l_hvNew = m_hv[m_step];
 
-void tsunami_lab::patches::WavePropagation2d::copyGhostCellsOutflow(short i_axis[2], t_real *o_dataArray) {
-    t_idx l_xMax = m_nCellsX + 1;
-    t_idx l_yMax = m_nCellsY + 1;
+    t_idx l_stride = getStride();
+    t_idx l_nBands = (m_nCellsY + m_tileRows - 1) / m_tileRows;
+    int l_nThreads = std::min(omp_get_max_threads(), (int)m_nBandBuffers);
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp parallel for schedule(static) num_threads(l_nThreads) reduction(max : l_waveSpeedMax)
+    for (t_idx l_ba = 0; l_ba < l_nBands; l_ba++) {
+        // rows [l_rowFirst, l_rowEnd) of the band; row 0 of the band buffer holds row l_rowFirst - 1
+        t_idx l_rowFirst = 1 + l_ba * m_tileRows;
+        t_idx l_rowEnd = std::min(l_rowFirst + m_tileRows, m_nCellsY + 1);
+
+        t_idx l_offset = omp_get_thread_num() * (m_tileRows + 2) * l_stride;
+        t_real *l_hStar = m_hBand + l_offset;
+        t_real *l_huStar = m_huBand + l_offset;
+
+        // x-sweep of the band and its halo rows
+        for (t_idx l_ceY = l_rowFirst - 1; l_ceY < l_rowEnd + 1; l_ceY++) {
+            t_idx l_idx = getIndex(0, l_ceY);
+            t_idx l_idxBand = (l_ceY + 1 - l_rowFirst) * l_stride;
+
+            t_real l_waveSpeed = sweepRow(m_nCellsX + 2,
+                                          i_scalingX,
+                                          l_hOld + l_idx,
+                                          l_huOld + l_idx,
+                                          m_b + l_idx,
+                                          l_hStar + l_idxBand,
+                                          l_huStar + l_idxBand);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+        }
+
+        // init new momenta in x-direction of the band
+        for (t_idx l_ceY = l_rowFirst; l_ceY < l_rowEnd; l_ceY++) {
+            t_idx l_idx = getIndex(0, l_ceY);
+            t_idx l_idxBand = (l_ceY + 1 - l_rowFirst) * l_stride;
 
-    if (i_axis[0] == 1) {
-        for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
-            o_dataArray[getIndex(l_xMax, l_iy)] = o_dataArray[getIndex(l_xMax - 1, l_iy)];
+            for (t_idx l_ceX = 1; l_ceX < m_nCellsX + 1; l_ceX++) {
+                l_huNew[l_idx + l_ceX] = l_huStar[l_idxBand + l_ceX];
+            }
         }
-    } else if (i_axis[0] == -1) {
-        for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
-            o_dataArray[getIndex(0, l_iy)] = o_dataArray[getIndex(1, l_iy)];
+
+        // y-sweep of the band in blocks of columns; the halo rows are input only
+        for (t_idx l_colFirst = 1; l_colFirst < m_nCellsX + 1; l_colFirst += c_chunkSize) {
+            t_idx l_nCols = std::min(c_chunkSize, m_nCellsX + 1 - l_colFirst);
+            t_idx l_idx = getIndex(l_colFirst, l_rowFirst - 1);
+
+            t_real l_waveSpeed = sweepColumns(l_rowEnd - l_rowFirst + 2,
+                                              l_nCols,
+                                              i_scalingY,
+                                              l_hStar + l_colFirst,
+                                              l_hvOld + l_idx,
+                                              m_b + l_idx,
+                                              l_hNew + l_idx,
+                                              l_hvNew + l_idx);
+            l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
         }
     }
 
-    if (i_axis[1] == 1) {
-        for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
-            o_dataArray[getIndex(l_ix, l_yMax)] = o_dataArray[getIndex(l_ix, l_yMax - 1)];
-        }
-    } else if (i_axis[1] == -1) {
-        for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
-            o_dataArray[getIndex(l_ix, 0)] = o_dataArray[getIndex(l_ix, 1)];
-        }
+    return l_waveSpeedMax;
+}
+
+tsunami_lab::t_real tsunami_lab::patches::WavePropagation2d::getBytesPerCellUpdate() {
+    t_real l_floats = 0;
+
+    if (m_tileRows == 0) {
+        // x-sweep: load h, hu, b; store h*, hu*
+        l_floats += 3 + 2 * 2;
+        // copy: load hu*; store hu
+        l_floats += 1 + 1 * 2;
+        // y-sweep: load h*, hv, b; store h, hv
+        l_floats += 3 + 2 * 2;
+    } else {
+        // load h, hu, hv, b once per row of the band and its two halo rows
+        l_floats += t_real(4 * (m_tileRows + 2)) / m_tileRows;
+        // store h, hu, hv
+        l_floats += 3 * 2;
     }
 
-    copyCornerCells(o_dataArray);
+    return l_floats * sizeof(t_real);
 }
 
-void tsunami_lab::patches::WavePropagation2d::copyGhostCellsReflecting(short i_axis[2], t_real i_value, t_real *o_dataArray) {
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagation2d::getL2TileRows(t_idx i_nCellsX) {
+    long l_cacheSize = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    l_cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    // assume 1 MiB if the size is unknown
+    if (l_cacheSize <= 0) l_cacheSize = 1 << 20;
+
+    // rows of h* and hu* (including the two halo rows) which fit into half of the cache
+    t_idx l_rows = (l_cacheSize / 2) / (2 * Layout2d::getPaddedStride(i_nCellsX) * sizeof(t_real));
+
+    return std::max(l_rows, t_idx(4)) - 2;
+}
+
+bool tsunami_lab::patches::WavePropagation2d::countPagesPerNode(std::vector<t_idx> &o_pages) {
+    o_pages.clear();
+
+    t_real const *l_arrays[9] = {m_h[0], m_h[1], m_hu[0], m_hu[1], m_hv[0], m_hv[1], m_b, m_hStar, m_huStar};
+    for (unsigned short l_ar = 0; l_ar < 9; l_ar++) {
+        if (l_arrays[l_ar] == nullptr) continue;
+        if (!parallel::Affinity::countPagesPerNode(l_arrays[l_ar], m_layout.getNumberOfCells() * sizeof(t_real), o_pages)) return false;
+    }
+    if (m_hBand != nullptr) {
+        t_idx l_bytes = m_nBandBuffers * (m_tileRows + 2) * getStride() * sizeof(t_real);
+        if (!parallel::Affinity::countPagesPerNode(m_hBand, l_bytes, o_pages)) return false;
+        if (!parallel::Affinity::countPagesPerNode(m_huBand, l_bytes, o_pages)) return false;
+    }
+
+    return true;
+}
+
+void tsunami_lab::patches::WavePropagation2d::copyCornerCells(t_real *o_dataArray) {
     t_idx l_xMax = m_nCellsX + 1;
     t_idx l_yMax = m_nCellsY + 1;
 
-    if (i_axis[0] == 1) {
-        for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
-            o_dataArray[getIndex(l_xMax, l_iy)] = i_value;
-        }
-    } else if (i_axis[0] == -1) {
-        for (t_idx l_iy = 1; l_iy < l_yMax; l_iy++) {
-            o_dataArray[getIndex(0, l_iy)] = i_value;
-        }
-    }
+    o_dataArray[getIndex(0, 0)] = o_dataArray[getIndex(1, 1)];
+    o_dataArray[getIndex(l_xMax, 0)] = o_dataArray[getIndex(l_xMax - 1, 1)];
+    o_dataArray[getIndex(0, l_yMax)] = o_dataArray[getIndex(1, l_yMax - 1)];
+    o_dataArray[getIndex(l_xMax, l_yMax)] = o_dataArray[getIndex(l_xMax - 1, l_yMax - 1)];
+}
 
-    if (i_axis[1] == 1) {
-        for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
-            o_dataArray[getIndex(l_ix, l_yMax)] = i_value;
-        }
-    } else if (i_axis[1] == -1) {
-        for (t_idx l_ix = 1; l_ix < l_xMax; l_ix++) {
-            o_dataArray[getIndex(l_ix, 0)] = i_value;
-        }
-    }
+void tsunami_lab::patches::WavePropagation2d::copyGhostCellsOutflow(short i_axis[2], t_real *o_dataArray) {
+    m_kernels->copyGhostCellsOutflow(m_nCellsX, m_nCellsY, getStride(), i_axis, o_dataArray);
+    copyCornerCells(o_dataArray);
+}
 
+void tsunami_lab::patches::WavePropagation2d::copyGhostCellsReflecting(short i_axis[2], t_real i_value, t_real *o_dataArray) {
+    m_kernels->copyGhostCellsReflecting(m_nCellsX, m_nCellsY, getStride(), i_axis, i_value, o_dataArray);
     copyCornerCells(o_dataArray);
 }
 
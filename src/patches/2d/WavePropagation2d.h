@@ -7,7 +7,15 @@
 #ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D
 #define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_2D
 
+#include <omp.h>
+
+#include <functional>
+#include <vector>
+
+#include "../../io/Trace/Trace.h"
+#include "../../kernels/Kernels.h"
 #include "../WavePropagation.h"
+#include "Layout2d.h"
 
 namespace tsunami_lab {
     namespace patches {
@@ -17,6 +25,9 @@ namespace tsunami_lab {
 
 class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
    private:
+    //! number of edges which are solved before their net-updates are gathered into the cells; also the width and height of the y-sweep's tiles
+    static t_idx constexpr c_chunkSize = kernels::c_chunkSize;
+
     //! current step which indicates the active values in the arrays below
     unsigned short m_step = 0;
 
@@ -26,8 +37,8 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
     //! number of cells in y-direction discretizing the computational domain
     t_idx m_nCellsY = 0;
 
-    //! number of overall cells discretizing the computational domain including ghost cells
-    t_idx m_nCellsAll = 0;
+    //! layout of the arrays below, whose rows are padded and aligned
+    Layout2d m_layout;
 
     //! water heights for the current and next time step for all cells
     t_real *m_h[2] = {nullptr, nullptr};
@@ -41,14 +52,197 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
     //! bathymetries for all cells
     t_real *m_b = nullptr;
 
+    //! water heights after the x-sweep; persistent scratch space reused in every time step
+    t_real *m_hStar = nullptr;
+
+    //! momenta in x-direction after the x-sweep; persistent scratch space reused in every time step
+    t_real *m_huStar = nullptr;
+
+    //! maximum absolute wave speed observed in the last time step
+    t_real m_maxWaveSpeed = 0;
+
+    //! number of rows per band in the fused mode; 0 selects separate full-grid sweeps
+    t_idx m_tileRows = 0;
+
+    //! number of per-thread band buffers in the fused mode
+    t_idx m_nBandBuffers = 0;
+
+    //! per-thread water heights after the x-sweep of a band and its two halo rows
+    t_real *m_hBand = nullptr;
+
+    //! per-thread momenta in x-direction after the x-sweep of a band and its two halo rows
+    t_real *m_huBand = nullptr;
+
+    //! tolerance of the surface elevation (m) and momenta (m^2/s) below which water is considered to be at rest
+    static t_real constexpr c_stillTolerance = 1E-3;
+
+    //! true if tiles of still or dry water are skipped
+    bool m_trackActivity = false;
+
+    //! number of tiles in x-direction
+    t_idx m_nTilesX = 0;
+
+    //! number of tiles in y-direction
+    t_idx m_nTilesY = 0;
+
+    //! number of tiles which were solved in the last time step
+    t_idx m_nActiveTiles = 0;
+
+    //! false if cells were set since the tile states were derived
+    bool m_tileStatesValid = false;
+
+    //! 1 if the tile is solved in the current time step
+    unsigned char *m_tileActive = nullptr;
+
+    //! 1 if all water in the tile is at rest
+    unsigned char *m_tileStill = nullptr;
+
+    //! lowest surface elevation of the tile's wet cells
+    t_real *m_tileLevelMin = nullptr;
+
+    //! highest surface elevation of the tile's wet cells
+    t_real *m_tileLevelMax = nullptr;
+
+    //! largest gravity wave speed of the tile's cells
+    t_real *m_tileWaveSpeed = nullptr;
+
+    //! timeline to which the phases of overlapped time steps are recorded; nullptr disables the recording
+    io::Trace *m_trace = nullptr;
+
+    /**
+     * Gets the current time of the trace.
+     *
+     * @return seconds since the construction of the trace; 0 if no trace is set.
+     **/
+    double traceNow() {
+        return (m_trace != nullptr) ? m_trace->now() : 0;
+    }
+
+    /**
+     * Records a phase of the calling thread, which ends now, to the trace, if set.
+     *
+     * @param i_name name of the phase.
+     * @param i_start start of the phase as returned by traceNow().
+     **/
+    void traceRecord(char const *i_name,
+                     double i_start) {
+        if (m_trace != nullptr) m_trace->record(omp_get_thread_num(), i_name, i_start, m_trace->now());
+    }
+
+    //! x-sweep of a row with the solver and instruction set level chosen at construction
+    kernels::t_sweepRow m_sweepRow = nullptr;
+
+    //! y-sweep of a block of columns with the solver and instruction set level chosen at construction
+    kernels::t_sweepColumns m_sweepColumns = nullptr;
+
+    //! ghost-cell copies of the instruction set level chosen at construction
+    kernels::Kernels const *m_kernels = nullptr;
+
+    /**
+     * Updates one row of cells in the x-sweep.
+     * The edges of the row are solved chunk-wise by the batched net-updates of the solver into per-edge net-update
+     * buffers, which are gathered per cell afterwards. Thus every cell is written exactly once and rows can be
+     * processed by different threads without atomics.
+     * Only the inner cells of the row are written; the first and the last cell are input only.
+     *
+     * @param i_nCells number of cells in the row including both ghost cells.
+     * @param i_scaling scaling of the time step (dt / dx).
+     * @param i_h water heights of the row before the sweep.
+     * @param i_hu momenta in x-direction of the row before the sweep.
+     * @param i_b bathymetries of the row.
+     * @param o_h will be set to the water heights of the inner cells after the sweep.
+     * @param o_hu will be set to the momenta in x-direction of the inner cells after the sweep.
+     * @return maximum absolute wave speed of the row's edges.
+     **/
+    t_real sweepRow(t_idx i_nCells,
+                    t_real i_scaling,
+                    t_real const *i_h,
+                    t_real const *i_hu,
+                    t_real const *i_b,
+                    t_real *o_h,
+                    t_real *o_hu) {
+        return m_sweepRow(i_nCells, i_scaling, i_h, i_hu, i_b, o_h, o_hu);
+    }
+
+    /**
+     * Updates a block of up to c_chunkSize neighboring columns in the y-sweep.
+     * The block is traversed row by row: the horizontal edges between two rows of the block are contiguous in
+     * memory and solved by one batch. A cell is updated as soon as the edges below and above it are known,
+     * receiving the update of the lower edge first.
+     * Only the inner rows of the block are written; the first and the last row are input only.
+     *
+     * @param i_nRows number of rows of the block including the two input-only rows.
+     * @param i_nCols number of columns of the block.
+     * @param i_scaling scaling of the time step (dt / dy).
+     * @param i_h water heights of the block before the sweep; rows are getStride() apart.
+     * @param i_hv momenta in y-direction of the block before the sweep.
+     * @param i_b bathymetries of the block.
+     * @param o_h will be set to the water heights of the inner rows after the sweep.
+     * @param o_hv will be set to the momenta in y-direction of the inner rows after the sweep.
+     * @return maximum absolute wave speed of the block's edges.
+     **/
+    t_real sweepColumns(t_idx i_nRows,
+                        t_idx i_nCols,
+                        t_real i_scaling,
+                        t_real const *i_h,
+                        t_real const *i_hv,
+                        t_real const *i_b,
+                        t_real *o_h,
+                        t_real *o_hv) {
+        return m_sweepColumns(i_nRows, i_nCols, getStride(), i_scaling, i_h, i_hv, i_b, o_h, o_hv);
+    }
+
+    /**
+     * Performs a time step band by band. For every band of rows the x-sweep (including one halo row
+     * on either side), the copy of the x-momenta and the y-sweep are done while the band is in cache.
+     *
+     * @param i_scalingX scaling of the time step (dt / dx).
+     * @param i_scalingY scaling of the time step (dt / dy).
+     * @return maximum absolute wave speed of all edges.
+     **/
+    t_real timeStepFused(t_real i_scalingX,
+                       t_real i_scalingY);
+
+    /**
+     * Gets the rows of a tile which are updated by the x-sweep. The tiles of the first and the last row of tiles
+     * also hold the adjacent ghost row.
+     *
+     * @param i_tiY id of the tile in y-direction.
+     * @param o_rowFirst will be set to the first row of the tile.
+     * @param o_rowEnd will be set to the row after the last row of the tile.
+     **/
+    void getTileRowRange(t_idx i_tiY,
+                         t_idx &o_rowFirst,
+                         t_idx &o_rowEnd);
+
+    /**
+     * Derives which tiles are solved in the next time step. A tile is skipped if the water of the tile and its
+     * eight neighbors is at rest on a common surface elevation or dry; the edges of its cells are in equilibrium then.
+     * The states of tiles which were skipped in the last time step are unchanged and reused.
+     *
+     * @return largest gravity wave speed of the skipped tiles.
+     **/
+    t_real updateActiveTiles();
+
    public:
     /**
      * Constructs the 2d wave propagation solver.
      *
      * @param i_nCellsX number of cells in x-direction.
      * @param i_nCellsY number of cells in y-direction.
+     * @param i_tileRows number of rows per band of the fused mode; 0 uses separate full-grid sweeps.
+     * @param i_trackActivity true if tiles of still or dry water are skipped; only used without bands and with the
+     *                        F-wave solver, whose net-updates vanish for water at rest above any bathymetry.
+     * @param i_solver Riemann solver which computes the net-updates; the Roe solver requires wet cells, i.e., outflow
+     *                 boundaries, since reflecting boundaries are dry walls.
+     * @param i_kernels kernels of an instruction set level; nullptr uses the ones selected by kernels::selectIsa.
      **/
-    WavePropagation2d(t_idx i_nCellsX, t_idx i_nCellsY);
+    WavePropagation2d(t_idx i_nCellsX,
+                      t_idx i_nCellsY,
+                      t_idx i_tileRows = 0,
+                      bool i_trackActivity = false,
+                      e_solver i_solver = FWAVE,
+                      kernels::Kernels const *i_kernels = nullptr);
 
     /**
      * Destructor which frees all allocated memory.
@@ -72,6 +266,113 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
     void timeStep(t_real i_scalingX,
                   t_real i_scalingY);
 
+    /**
+     * Performs a time step while the ghost cells are filled. Edges which do not depend on ghost cells are solved
+     * first: the master thread fills the ghost cells, e.g., by a halo exchange, while the remaining threads start
+     * the x-sweep of the inner cells. The y-sweep of the inner cells then runs concurrently with the x-sweep of the
+     * cells next to the ghost cells, which is followed by their y-sweep.
+     * The result is identical to filling the ghost cells before timeStep. Bands and skipped tiles need all ghost
+     * cells up front and fill them first.
+     *
+     * @param i_scalingX scaling of the time step (dt / dx).
+     * @param i_scalingY scaling of the time step (dt / dy).
+     * @param i_setGhostCells fills the ghost cells of the patch; called by the master thread of the team.
+     **/
+    void timeStepOverlapped(t_real i_scalingX,
+                            t_real i_scalingY,
+                            std::function<void()> const &i_setGhostCells);
+
+    /**
+     * Sets the timeline to which the phases of overlapped time steps are recorded.
+     *
+     * @param i_trace trace; nullptr disables the recording.
+     **/
+    void setTrace(io::Trace *i_trace) {
+        m_trace = i_trace;
+    }
+
+    /**
+     * Performs the x-sweep of a time step over the entire grid into the patch's scratch arrays.
+     * Together with sweepY this is identical to timeStep without bands; the split allows to time the sweeps separately.
+     * Only available if the patch uses no bands.
+     *
+     * @param i_scalingX scaling of the time step (dt / dx).
+     * @return maximum absolute wave speed of the x-sweep's edges.
+     **/
+    t_real sweepX(t_real i_scalingX);
+
+    /**
+     * Performs the y-sweep of a time step over the entire grid, which completes the time step started by sweepX.
+     * The y-sweep works on tiles of c_chunkSize columns and rows, which are traversed row by row.
+     * Only available if the patch uses no bands.
+     *
+     * @param i_scalingY scaling of the time step (dt / dy).
+     * @return maximum absolute wave speed of the y-sweep's edges.
+     **/
+    t_real sweepY(t_real i_scalingY);
+
+    /**
+     * Gets the maximum absolute wave speed observed in the sweeps of the last time step.
+     *
+     * @return maximum wave speed.
+     **/
+    t_real getMaxWaveSpeed() {
+        return m_maxWaveSpeed;
+    }
+
+    /**
+     * Gets the number of tiles which were solved in the last time step.
+     *
+     * @return active tiles; all tiles if the activity is not tracked.
+     **/
+    t_idx getActiveTiles() {
+        return m_nActiveTiles;
+    }
+
+    /**
+     * Gets the number of tiles the grid is divided into.
+     *
+     * @return number of tiles.
+     **/
+    t_idx getNumberOfTiles() {
+        return m_nTilesX * m_nTilesY;
+    }
+
+    /**
+     * Gets the number of rows per band of the fused mode.
+     *
+     * @return rows per band; 0 if separate full-grid sweeps are used.
+     **/
+    t_idx getTileRows() {
+        return m_tileRows;
+    }
+
+    /**
+     * Gets the modeled main memory traffic of a time step per cell update. This is not measured: the model counts the
+     * compulsory loads and stores of the arrays, assumes that a band of the fused mode stays in cache and counts a
+     * write-allocate for every store. Capacity and conflict misses, the ghost cells and the padding are ignored, such
+     * that the traffic of a run is at least the modeled one.
+     *
+     * @return modeled lower bound of the bytes moved per cell update.
+     **/
+    t_real getBytesPerCellUpdate();
+
+    /**
+     * Counts the pages of the patch's arrays per NUMA node.
+     *
+     * @param o_pages will be set to the number of pages per node.
+     * @return true if the nodes could be queried from the kernel.
+     **/
+    bool countPagesPerNode(std::vector<t_idx> &o_pages);
+
+    /**
+     * Derives the number of rows per band such that the band's intermediate results fit into half of the L2 cache.
+     *
+     * @param i_nCellsX number of cells in x-direction.
+     * @return rows per band.
+     **/
+    static t_idx getL2TileRows(t_idx i_nCellsX);
+
     /**
      * @brief copies the 4 corner cells of the water grid into the ghost corner cells.
      *
@@ -104,12 +405,12 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
     void setGhostCells(e_boundary *i_boundary);
 
     /**
-     * Gets the stride in y-direction. x-direction is stride-1.
+     * Gets the stride in y-direction, which is padded beyond the ghost cells; see Layout2d. x-direction is stride-1.
      *
      * @return stride in y-direction.
      **/
     t_idx getStride() {
-        return m_nCellsX + 2;
+        return m_layout.getStride();
     }
 
     /**
@@ -139,6 +440,24 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
         return m_hv[m_step];
     }
 
+    /**
+     * Gets the water heights after the x-sweep; only valid between sweepX and sweepY of the full-grid sweeps.
+     *
+     * @return water heights after the x-sweep.
+     **/
+    t_real const *getHeightStar() {
+        return m_hStar;
+    }
+
+    /**
+     * Gets the momenta in x-direction after the x-sweep; only valid between sweepX and sweepY of the full-grid sweeps.
+     *
+     * @return momenta in x-direction after the x-sweep.
+     **/
+    t_real const *getMomentumXStar() {
+        return m_huStar;
+    }
+
     /**
      * Gets the cells bathymetries;
      *
@@ -148,6 +467,30 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
         return m_b;
     }
 
+    /**
+     * Gets writable views of the cells' quantities, which start at the first inner cell.
+     *
+     * @param o_h will be set to the view of the water heights.
+     * @param o_hu will be set to the view of the momenta in x-direction.
+     * @param o_hv will be set to the view of the momenta in y-direction.
+     * @param o_b will be set to the view of the bathymetry.
+     * @return true.
+     **/
+    bool getStateViews(t_real **o_h,
+                       t_real **o_hu,
+                       t_real **o_hv,
+                       t_real **o_b) {
+        t_idx l_first = getIndex(1, 1);
+        *o_h = m_h[m_step] + l_first;
+        *o_hu = m_hu[m_step] + l_first;
+        *o_hv = m_hv[m_step] + l_first;
+        *o_b = m_b + l_first;
+
+        // the cells are written through the views
+        if (m_trackActivity) m_tileStatesValid = false;
+        return true;
+    }
+
     /**
      * Sets the height of the cell to the given value.
      *
@@ -160,6 +503,7 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
                    t_real i_h) {
         t_idx l_idx = getIndex(i_ix + 1, i_iy + 1);
         m_h[m_step][l_idx] = i_h;
+        if (m_trackActivity) m_tileStatesValid = false;
     }
 
     /**
@@ -174,6 +518,7 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
                       t_real i_hu) {
         t_idx l_idx = getIndex(i_ix + 1, i_iy + 1);
         m_hu[m_step][l_idx] = i_hu;
+        if (m_trackActivity) m_tileStatesValid = false;
     }
 
     /**
@@ -188,8 +533,34 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
                       t_real i_hv) {
         t_idx l_idx = getIndex(i_ix + 1, i_iy + 1);
         m_hv[m_step][l_idx] = i_hv;
+        if (m_trackActivity) m_tileStatesValid = false;
     };
 
+    /**
+     * Sets all quantities of a cell. Other than the remaining setters, the ids include the ghost cells,
+     * which allows to fill the ghost cells from outside the patch.
+     *
+     * @param i_x id of the cell in x-direction including the ghost cells.
+     * @param i_y id of the cell in y-direction including the ghost cells.
+     * @param i_h water height.
+     * @param i_hu momentum in x-direction.
+     * @param i_hv momentum in y-direction.
+     * @param i_b bathymetry.
+     **/
+    void setCell(t_idx i_x,
+                 t_idx i_y,
+                 t_real i_h,
+                 t_real i_hu,
+                 t_real i_hv,
+                 t_real i_b) {
+        t_idx l_idx = getIndex(i_x, i_y);
+        m_h[m_step][l_idx] = i_h;
+        m_hu[m_step][l_idx] = i_hu;
+        m_hv[m_step][l_idx] = i_hv;
+        m_b[l_idx] = i_b;
+        if (m_trackActivity) m_tileStatesValid = false;
+    }
+
     /**
      * Sets the bathymetry to the given value.
      *
@@ -202,6 +573,7 @@ class tsunami_lab::patches::WavePropagation2d : public WavePropagation {
                        t_real i_b) {
         t_idx l_idx = getIndex(i_ix + 1, i_iy + 1);
         m_b[l_idx] = i_b;
+        if (m_trackActivity) m_tileStatesValid = false;
     }
 };
 
@@ -7,8 +7,38 @@
 
 #include "WavePropagation2d.h"
 
+#include <unistd.h>
+
 #include <catch2/catch.hpp>
+#include <cmath>
 #include <iostream>
+#include <vector>
+
+#include "../../solvers/FWave.h"
+#include "../1d/WavePropagation1d.h"
+
+/**
+ * Initializes a patch with smoothly varying heights, momenta and bathymetries including some dry cells.
+ *
+ * @param i_nx number of cells in x-direction.
+ * @param i_ny number of cells in y-direction.
+ * @param io_waveProp patch which is initialized.
+ **/
+static void setVaryingState(tsunami_lab::t_idx i_nx,
+                            tsunami_lab::t_idx i_ny,
+                            tsunami_lab::patches::WavePropagation2d &io_waveProp) {
+    for (tsunami_lab::t_idx l_ceY = 0; l_ceY < i_ny; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 0; l_ceX < i_nx; l_ceX++) {
+            tsunami_lab::t_real l_h = 5 + std::sin(0.1 * l_ceX) + 0.3 * l_ceY;
+            if ((l_ceX + 3 * l_ceY) % 37 == 0) l_h = 0;
+
+            io_waveProp.setHeight(l_ceX, l_ceY, l_h);
+            io_waveProp.setMomentumX(l_ceX, l_ceY, l_h * std::cos(0.05 * l_ceX));
+            io_waveProp.setMomentumY(l_ceX, l_ceY, l_h * std::sin(0.7 * l_ceY + 0.01 * l_ceX));
+            io_waveProp.setBathymetry(l_ceX, l_ceY, -5 - 0.01 * l_ceX);
+        }
+    }
+}
 
 TEST_CASE("Test the 2d wave propagation solver.", "[WaveProp2d]") {
     /*
@@ -30,8 +60,9 @@ TEST_CASE("Test the 2d wave propagation solver.", "[WaveProp2d]") {
      *    -88.25991835     | -88.25991835
      */
 
-    // construct solver (F_Wave) and setup a dambreak problem
+    // construct solver (F_Wave) and setup a dambreak problem; the rows are padded beyond the 12 cells
     tsunami_lab::patches::WavePropagation2d l_waveProp(10, 10);
+    tsunami_lab::t_idx l_stride = l_waveProp.getStride();
 
     for (std::size_t l_ceY = 0; l_ceY < 10; l_ceY++) {
         for (std::size_t l_ceX = 0; l_ceX < 5; l_ceX++) {
@@ -66,28 +97,384 @@ TEST_CASE("Test the 2d wave propagation solver.", "[WaveProp2d]") {
     // perform a time step
     l_waveProp.timeStep(0.1, 0.1);
 
+    // the still water on the left limits the time step
+    REQUIRE(l_waveProp.getMaxWaveSpeed() == Approx(std::sqrt(9.80665 * 10)));
+
     for (std::size_t l_ceY = 1; l_ceY < 11; l_ceY++) {
         // steady state
         for (std::size_t l_ceX = 1; l_ceX < 5; l_ceX++) {
-            REQUIRE(l_waveProp.getHeight()[l_ceY * 12 + l_ceX] == Approx(10));
-            REQUIRE(l_waveProp.getMomentumX()[l_ceY * 12 + l_ceX] == Approx(0));
-            REQUIRE(l_waveProp.getMomentumY()[l_ceY * 12 + l_ceX] == Approx(0));
+            REQUIRE(l_waveProp.getHeight()[l_ceY * l_stride + l_ceX] == Approx(10));
+            REQUIRE(l_waveProp.getMomentumX()[l_ceY * l_stride + l_ceX] == Approx(0));
+            REQUIRE(l_waveProp.getMomentumY()[l_ceY * l_stride + l_ceX] == Approx(0));
         }
 
         // dam-break
-        REQUIRE(l_waveProp.getHeight()[l_ceY * 12 + 5] == Approx(10 - 0.1 * 9.394671362));
-        REQUIRE(l_waveProp.getMomentumX()[l_ceY * 12 + 5] == Approx(0 + 0.1 * 88.25985));
-        REQUIRE(l_waveProp.getMomentumY()[l_ceY * 12 + 5] == Approx(0));
+        REQUIRE(l_waveProp.getHeight()[l_ceY * l_stride + 5] == Approx(10 - 0.1 * 9.394671362));
+        REQUIRE(l_waveProp.getMomentumX()[l_ceY * l_stride + 5] == Approx(0 + 0.1 * 88.25985));
+        REQUIRE(l_waveProp.getMomentumY()[l_ceY * l_stride + 5] == Approx(0));
 
-        REQUIRE(l_waveProp.getHeight()[l_ceY * 12 + 6] == Approx(8 + 0.1 * 9.394671362));
-        REQUIRE(l_waveProp.getMomentumX()[l_ceY * 12 + 6] == Approx(0 + 0.1 * 88.25985));
-        REQUIRE(l_waveProp.getMomentumY()[l_ceY * 12 + 6] == Approx(0));
+        REQUIRE(l_waveProp.getHeight()[l_ceY * l_stride + 6] == Approx(8 + 0.1 * 9.394671362));
+        REQUIRE(l_waveProp.getMomentumX()[l_ceY * l_stride + 6] == Approx(0 + 0.1 * 88.25985));
+        REQUIRE(l_waveProp.getMomentumY()[l_ceY * l_stride + 6] == Approx(0));
 
         // steady state
         for (std::size_t l_ceX = 7; l_ceX < 11; l_ceX++) {
-            REQUIRE(l_waveProp.getHeight()[l_ceY * 12 + l_ceX] == Approx(8));
-            REQUIRE(l_waveProp.getMomentumX()[l_ceY * 12 + l_ceX] == Approx(0));
-            REQUIRE(l_waveProp.getMomentumY()[l_ceY * 12 + l_ceX] == Approx(0));
+            REQUIRE(l_waveProp.getHeight()[l_ceY * l_stride + l_ceX] == Approx(8));
+            REQUIRE(l_waveProp.getMomentumX()[l_ceY * l_stride + l_ceX] == Approx(0));
+            REQUIRE(l_waveProp.getMomentumY()[l_ceY * l_stride + l_ceX] == Approx(0));
+        }
+    }
+}
+
+TEST_CASE("Test the 2d wave propagation solver against the serial edge-wise reference sweep.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 300 x 150 cells with varying heights, momenta and bathymetries
+     *   including dry cells; the rows are longer than a single chunk of edges and the columns
+     *   are longer than a single tile of the y-sweep.
+     *
+     *   The result of a time step has to match bit for bit the one obtained by solving
+     *   every edge in order and applying its net-updates directly to both adjacent cells.
+     */
+    tsunami_lab::t_idx l_nx = 300;
+    tsunami_lab::t_idx l_ny = 150;
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny);
+    tsunami_lab::t_idx l_stride = l_waveProp.getStride();
+    tsunami_lab::t_idx l_nAll = l_stride * (l_ny + 2);
+
+    setVaryingState(l_nx, l_ny, l_waveProp);
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    l_waveProp.setGhostCells(l_boundary);
+
+    // copy the initial state
+    std::vector<tsunami_lab::t_real> l_h(l_waveProp.getHeight(), l_waveProp.getHeight() + l_nAll);
+    std::vector<tsunami_lab::t_real> l_hu(l_waveProp.getMomentumX(), l_waveProp.getMomentumX() + l_nAll);
+    std::vector<tsunami_lab::t_real> l_hv(l_waveProp.getMomentumY(), l_waveProp.getMomentumY() + l_nAll);
+    tsunami_lab::t_real const *l_b = l_waveProp.getBathymetry();
+
+    tsunami_lab::t_real l_scalingX = 0.01;
+    tsunami_lab::t_real l_scalingY = 0.02;
+
+    // reference x-sweep
+    std::vector<tsunami_lab::t_real> l_hStar(l_h), l_huStar(l_hu);
+    for (tsunami_lab::t_idx l_edY = 0; l_edY < l_ny + 2; l_edY++) {
+        for (tsunami_lab::t_idx l_edX = 0; l_edX < l_nx + 1; l_edX++) {
+            tsunami_lab::t_idx l_ceL = l_edY * l_stride + l_edX;
+            tsunami_lab::t_idx l_ceR = l_ceL + 1;
+            tsunami_lab::t_real l_netUpdates[2][2];
+            tsunami_lab::solvers::FWave::netUpdates(l_h[l_ceL], l_h[l_ceR], l_hu[l_ceL], l_hu[l_ceR], l_b[l_ceL], l_b[l_ceR], l_netUpdates[0], l_netUpdates[1]);
+            l_hStar[l_ceL] -= l_scalingX * l_netUpdates[0][0];
+            l_huStar[l_ceL] -= l_scalingX * l_netUpdates[0][1];
+            l_hStar[l_ceR] -= l_scalingX * l_netUpdates[1][0];
+            l_huStar[l_ceR] -= l_scalingX * l_netUpdates[1][1];
+        }
+    }
+
+    // reference y-sweep
+    std::vector<tsunami_lab::t_real> l_hNew(l_hStar), l_hvNew(l_hv);
+    for (tsunami_lab::t_idx l_edX = 1; l_edX < l_nx + 1; l_edX++) {
+        for (tsunami_lab::t_idx l_edY = 0; l_edY < l_ny + 1; l_edY++) {
+            tsunami_lab::t_idx l_ceU = l_edY * l_stride + l_edX;
+            tsunami_lab::t_idx l_ceD = l_ceU + l_stride;
+            tsunami_lab::t_real l_netUpdates[2][2];
+            tsunami_lab::solvers::FWave::netUpdates(l_hStar[l_ceU], l_hStar[l_ceD], l_hv[l_ceU], l_hv[l_ceD], l_b[l_ceU], l_b[l_ceD], l_netUpdates[0], l_netUpdates[1]);
+            l_hNew[l_ceU] -= l_scalingY * l_netUpdates[0][0];
+            l_hvNew[l_ceU] -= l_scalingY * l_netUpdates[0][1];
+            l_hNew[l_ceD] -= l_scalingY * l_netUpdates[1][0];
+            l_hvNew[l_ceD] -= l_scalingY * l_netUpdates[1][1];
+        }
+    }
+
+    l_waveProp.timeStep(l_scalingX, l_scalingY);
+
+    for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+            tsunami_lab::t_idx l_idx = l_ceY * l_stride + l_ceX;
+            REQUIRE(l_waveProp.getHeight()[l_idx] == l_hNew[l_idx]);
+            REQUIRE(l_waveProp.getMomentumX()[l_idx] == l_huStar[l_idx]);
+            REQUIRE(l_waveProp.getMomentumY()[l_idx] == l_hvNew[l_idx]);
         }
     }
-}
\ No newline at end of file
+}
+
+
+TEST_CASE("Test the fused band mode of the 2d wave propagation solver against the full-grid sweeps.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 50 x 7 cells with varying heights, momenta and bathymetries.
+     *   The fused mode uses bands of three rows, i.e., the last band has a single row.
+     *
+     *   After several time steps both modes have to give bit for bit the same results.
+     */
+    tsunami_lab::t_idx l_nx = 50;
+    tsunami_lab::t_idx l_ny = 7;
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny);
+    tsunami_lab::patches::WavePropagation2d l_wavePropFused(l_nx, l_ny, 3);
+
+    REQUIRE(l_waveProp.getTileRows() == 0);
+    REQUIRE(l_wavePropFused.getTileRows() == 3);
+    REQUIRE(l_waveProp.getBytesPerCellUpdate() == Approx(68));
+    REQUIRE(l_wavePropFused.getBytesPerCellUpdate() == Approx(4 * (4 * 5.0 / 3 + 6)));
+
+    setVaryingState(l_nx, l_ny, l_waveProp);
+    setVaryingState(l_nx, l_ny, l_wavePropFused);
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING};
+
+    for (int l_st = 0; l_st < 5; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.01, 0.02);
+
+        l_wavePropFused.setGhostCells(l_boundary);
+        l_wavePropFused.timeStep(0.01, 0.02);
+
+        REQUIRE(l_waveProp.getMaxWaveSpeed() > 0);
+        REQUIRE(l_waveProp.getMaxWaveSpeed() == l_wavePropFused.getMaxWaveSpeed());
+    }
+
+    for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+            tsunami_lab::t_idx l_idx = l_waveProp.getIndex(l_ceX, l_ceY);
+            REQUIRE(l_waveProp.getHeight()[l_idx] == l_wavePropFused.getHeight()[l_idx]);
+            REQUIRE(l_waveProp.getMomentumX()[l_idx] == l_wavePropFused.getMomentumX()[l_idx]);
+            REQUIRE(l_waveProp.getMomentumY()[l_idx] == l_wavePropFused.getMomentumY()[l_idx]);
+        }
+    }
+}
+TEST_CASE("Test the overlapped time step of the 2d wave propagation solver against the full-grid sweeps.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given 2d fields with varying heights, momenta and bathymetries, from a single cell up to several tiles of
+     *   inner cells in both directions.
+     *   The overlapped time step fills the ghost cells while it solves the inner edges.
+     *
+     *   After several time steps both variants have to give bit for bit the same results.
+     */
+    tsunami_lab::t_idx l_sizes[5][2] = {{1, 1}, {2, 3}, {3, 2}, {4, 5}, {300, 270}};
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW};
+
+    for (tsunami_lab::t_idx l_si = 0; l_si < 5; l_si++) {
+        tsunami_lab::t_idx l_nx = l_sizes[l_si][0];
+        tsunami_lab::t_idx l_ny = l_sizes[l_si][1];
+        tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny);
+        tsunami_lab::patches::WavePropagation2d l_wavePropOverlapped(l_nx, l_ny);
+
+        tsunami_lab::io::Trace l_trace(omp_get_max_threads());
+        l_wavePropOverlapped.setTrace(&l_trace);
+
+        setVaryingState(l_nx, l_ny, l_waveProp);
+        setVaryingState(l_nx, l_ny, l_wavePropOverlapped);
+
+        for (int l_st = 0; l_st < 4; l_st++) {
+            l_waveProp.setGhostCells(l_boundary);
+            l_waveProp.timeStep(0.01, 0.02);
+
+            l_wavePropOverlapped.timeStepOverlapped(0.01, 0.02, [&]() { l_wavePropOverlapped.setGhostCells(l_boundary); });
+
+            REQUIRE(l_waveProp.getMaxWaveSpeed() == l_wavePropOverlapped.getMaxWaveSpeed());
+        }
+
+        // every thread records its phases in every time step
+        REQUIRE(l_trace.getNumberOfEvents() == 4 * (1 + 4 * tsunami_lab::t_idx(omp_get_max_threads())));
+
+        for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+            for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+                tsunami_lab::t_idx l_idx = l_waveProp.getIndex(l_ceX, l_ceY);
+                REQUIRE(l_waveProp.getHeight()[l_idx] == l_wavePropOverlapped.getHeight()[l_idx]);
+                REQUIRE(l_waveProp.getMomentumX()[l_idx] == l_wavePropOverlapped.getMomentumX()[l_idx]);
+                REQUIRE(l_waveProp.getMomentumY()[l_idx] == l_wavePropOverlapped.getMomentumY()[l_idx]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test the skipping of still and dry tiles of the 2d wave propagation solver against the full-grid sweeps.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 300 x 300 cells, i.e., 3 x 3 tiles, with a lake at rest over a sloped bathymetry.
+     *   The cells with x >= 250 are dry land. The water in the lower left 10 x 10 cells is raised by 1.
+     *
+     *   Only the lower left tile and its three neighbors are solved; the results have to match the full-grid
+     *   sweeps within the tolerance of still water.
+     */
+    tsunami_lab::t_idx l_nx = 300;
+    tsunami_lab::t_idx l_ny = 300;
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny);
+    tsunami_lab::patches::WavePropagation2d l_wavePropActive(l_nx, l_ny, 0, true);
+
+    for (tsunami_lab::t_idx l_ceY = 0; l_ceY < l_ny; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 0; l_ceX < l_nx; l_ceX++) {
+            tsunami_lab::t_real l_b = (l_ceX < 250) ? -10 - 0.01 * l_ceX : 5;
+            tsunami_lab::t_real l_h = (l_ceX < 250) ? -l_b : 0;
+            if (l_ceX < 10 && l_ceY < 10) l_h += 1;
+
+            l_waveProp.setHeight(l_ceX, l_ceY, l_h);
+            l_waveProp.setBathymetry(l_ceX, l_ceY, l_b);
+            l_wavePropActive.setHeight(l_ceX, l_ceY, l_h);
+            l_wavePropActive.setBathymetry(l_ceX, l_ceY, l_b);
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+
+    for (int l_st = 0; l_st < 20; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.05, 0.05);
+
+        l_wavePropActive.setGhostCells(l_boundary);
+        l_wavePropActive.timeStep(0.05, 0.05);
+
+        REQUIRE(l_waveProp.getActiveTiles() == 9);
+        REQUIRE(l_wavePropActive.getActiveTiles() == 4);
+        REQUIRE(l_wavePropActive.getNumberOfTiles() == 9);
+
+        // the still water of the skipped tiles limits the time step as well
+        REQUIRE(l_wavePropActive.getMaxWaveSpeed() == Approx(l_waveProp.getMaxWaveSpeed()));
+    }
+
+    for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+            tsunami_lab::t_idx l_idx = l_waveProp.getIndex(l_ceX, l_ceY);
+            REQUIRE(l_wavePropActive.getHeight()[l_idx] == Approx(l_waveProp.getHeight()[l_idx]).margin(1E-3));
+            REQUIRE(l_wavePropActive.getMomentumX()[l_idx] == Approx(l_waveProp.getMomentumX()[l_idx]).margin(1E-3));
+            REQUIRE(l_wavePropActive.getMomentumY()[l_idx] == Approx(l_waveProp.getMomentumY()[l_idx]).margin(1E-3));
+        }
+    }
+
+    // setting cells invalidates the tile states: a disturbance in the upper left tile activates its neighborhood
+    l_wavePropActive.setHeight(20, 280, 15);
+    l_wavePropActive.setGhostCells(l_boundary);
+    l_wavePropActive.timeStep(0.05, 0.05);
+    REQUIRE(l_wavePropActive.getActiveTiles() == 6);
+}
+
+TEST_CASE("Test the 2d wave propagation solver with the Roe solver against the 1d one.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 200 x 6 cells, whose rows hold the same wet state with varying heights and momenta in
+     *   x-direction; the momenta in y-direction are zero.
+     *
+     *   The y-sweep leaves the cells unchanged, such that every row matches the 1d patch with the Roe solver.
+     *   The skipping of tiles, which assumes the well-balanced F-wave solver, is not used.
+     */
+    tsunami_lab::t_idx l_nx = 200;
+    tsunami_lab::t_idx l_ny = 6;
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny, 0, true, tsunami_lab::ROE);
+    tsunami_lab::patches::WavePropagation1d l_waveProp1d(l_nx, tsunami_lab::ROE);
+
+    for (tsunami_lab::t_idx l_ceX = 0; l_ceX < l_nx; l_ceX++) {
+        tsunami_lab::t_real l_h = (l_ceX < 90) ? 10 : 6 + std::sin(0.1 * l_ceX);
+        tsunami_lab::t_real l_hu = l_h * std::cos(0.05 * l_ceX);
+
+        l_waveProp1d.setHeight(l_ceX, 0, l_h);
+        l_waveProp1d.setMomentumX(l_ceX, 0, l_hu);
+        l_waveProp1d.setBathymetry(l_ceX, 0, -10);
+        for (tsunami_lab::t_idx l_ceY = 0; l_ceY < l_ny; l_ceY++) {
+            l_waveProp.setHeight(l_ceX, l_ceY, l_h);
+            l_waveProp.setMomentumX(l_ceX, l_ceY, l_hu);
+            l_waveProp.setBathymetry(l_ceX, l_ceY, -10);
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    for (int l_st = 0; l_st < 5; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.02, 0.02);
+        l_waveProp1d.setGhostCells(l_boundary);
+        l_waveProp1d.timeStep(0.02, 0);
+
+        REQUIRE(l_waveProp.getActiveTiles() == l_waveProp.getNumberOfTiles());
+        REQUIRE(l_waveProp.getMaxWaveSpeed() == Approx(l_waveProp1d.getMaxWaveSpeed()));
+    }
+
+    for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+            tsunami_lab::t_idx l_idx = l_waveProp.getIndex(l_ceX, l_ceY);
+            REQUIRE(l_waveProp.getHeight()[l_idx] == l_waveProp1d.getHeight()[l_ceX - 1]);
+            REQUIRE(l_waveProp.getMomentumX()[l_idx] == l_waveProp1d.getMomentumX()[l_ceX - 1]);
+            REQUIRE(l_waveProp.getMomentumY()[l_idx] == 0);
+        }
+    }
+}
+
+TEST_CASE("Test the 2d wave propagation solver with the Roe solver at walls and dry cells.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Given a 2d field of 60 x 40 cells with reflecting boundaries, whose ghost cells are dry.
+     *   A dam break of heights 10 and 5 surrounds a dry island of 5 x 5 cells at x, y in [30, 35).
+     *
+     *   Dry cells act as walls: all results are finite, the island stays dry and the mass is conserved.
+     */
+    tsunami_lab::t_idx l_nx = 60;
+    tsunami_lab::t_idx l_ny = 40;
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny, 0, false, tsunami_lab::ROE);
+
+    tsunami_lab::t_real l_mass = 0;
+    for (tsunami_lab::t_idx l_ceY = 0; l_ceY < l_ny; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 0; l_ceX < l_nx; l_ceX++) {
+            bool l_isIsland = l_ceX >= 30 && l_ceX < 35 && l_ceY >= 30 && l_ceY < 35;
+            tsunami_lab::t_real l_h = l_isIsland ? 0 : ((l_ceX < 20) ? 10 : 5);
+
+            l_waveProp.setHeight(l_ceX, l_ceY, l_h);
+            l_waveProp.setBathymetry(l_ceX, l_ceY, l_isIsland ? 5 : -10);
+            l_mass += l_h;
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING};
+    for (int l_st = 0; l_st < 40; l_st++) {
+        l_waveProp.timeStepOverlapped(0.02, 0.02, [&]() { l_waveProp.setGhostCells(l_boundary); });
+
+        REQUIRE(std::isfinite(l_waveProp.getMaxWaveSpeed()));
+        REQUIRE(l_waveProp.getMaxWaveSpeed() > 0);
+    }
+
+    tsunami_lab::t_real l_massEnd = 0;
+    for (tsunami_lab::t_idx l_ceY = 1; l_ceY < l_ny + 1; l_ceY++) {
+        for (tsunami_lab::t_idx l_ceX = 1; l_ceX < l_nx + 1; l_ceX++) {
+            tsunami_lab::t_idx l_idx = l_waveProp.getIndex(l_ceX, l_ceY);
+            REQUIRE(std::isfinite(l_waveProp.getHeight()[l_idx]));
+            REQUIRE(std::isfinite(l_waveProp.getMomentumX()[l_idx]));
+            REQUIRE(std::isfinite(l_waveProp.getMomentumY()[l_idx]));
+
+            bool l_isIsland = l_ceX > 30 && l_ceX < 36 && l_ceY > 30 && l_ceY < 36;
+            if (l_isIsland) REQUIRE(l_waveProp.getHeight()[l_idx] == 0);
+            l_massEnd += l_waveProp.getHeight()[l_idx];
+        }
+    }
+
+    REQUIRE(l_massEnd == Approx(l_mass));
+}
+
+TEST_CASE("Test the first touch of the 2d wave propagation solver's arrays.", "[WaveProp2d]") {
+    /*
+     * Test case:
+     *   Patches of 300 x 200 cells with full-grid sweeps and with bands are constructed.
+     *
+     *   If the kernel reports the nodes of pages, every page of the arrays is placed, i.e., touched by the construction.
+     */
+    tsunami_lab::t_idx l_nx = 300;
+    tsunami_lab::t_idx l_ny = 200;
+    tsunami_lab::t_idx l_pageSize = sysconf(_SC_PAGESIZE);
+
+    tsunami_lab::patches::WavePropagation2d l_waveProp(l_nx, l_ny);
+    tsunami_lab::t_idx l_bytes = l_waveProp.getStride() * (l_ny + 2) * sizeof(tsunami_lab::t_real);
+    tsunami_lab::patches::WavePropagation2d l_wavePropFused(l_nx, l_ny, 16);
+    tsunami_lab::patches::WavePropagation2d *l_waveProps[2] = {&l_waveProp, &l_wavePropFused};
+
+    // seven arrays of the state and two for the results of the x-sweep or the band buffers
+    tsunami_lab::t_idx l_minPages[2] = {9 * (l_bytes / l_pageSize), 7 * (l_bytes / l_pageSize)};
+
+    for (unsigned short l_pa = 0; l_pa < 2; l_pa++) {
+        std::vector<tsunami_lab::t_idx> l_pages;
+        if (!l_waveProps[l_pa]->countPagesPerNode(l_pages)) {
+            WARN("the NUMA nodes of pages can't be queried");
+            return;
+        }
+
+        tsunami_lab::t_idx l_nPages = 0;
+        for (tsunami_lab::t_idx l_no = 0; l_no < l_pages.size(); l_no++) l_nPages += l_pages[l_no];
+        REQUIRE(l_nPages >= l_minPages[l_pa]);
+    }
+}
@@ -33,6 +33,13 @@ class tsunami_lab::patches::WavePropagation {
     virtual void timeStep(t_real i_scalingX,
                           t_real i_scalingY) = 0;
 
+    /**
+     * Gets the maximum absolute wave speed observed in the last time step.
+     *
+     * @return maximum wave speed.
+     **/
+    virtual t_real getMaxWaveSpeed() = 0;
+
     /**
      * Sets the values of the ghost cells according to entered outflow boundary conditions.
      *
@@ -75,6 +82,24 @@ class tsunami_lab::patches::WavePropagation {
      */
     virtual t_real const *getBathymetry() = 0;
 
+    /**
+     * Gets writable views of the cells' quantities, which allow to set all cells at once. The views point to the
+     * first inner cell and their rows are getStride() apart. Patches which can't expose their cells this way return
+     * false and are set cell by cell.
+     *
+     * @param o_h will be set to the view of the water heights.
+     * @param o_hu will be set to the view of the momenta in x-direction.
+     * @param o_hv will be set to the view of the momenta in y-direction.
+     * @param o_b will be set to the view of the bathymetry.
+     * @return true if the views were set.
+     **/
+    virtual bool getStateViews(t_real **,
+                               t_real **,
+                               t_real **,
+                               t_real **) {
+        return false;
+    }
+
     /**
      * Sets the height of the cell to the given value.
      *
@@ -0,0 +1,510 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch with block-structured adaptive mesh refinement.
+ **/
+
+#include "WavePropagationAmr.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../../solvers/FWave.h"
+
+tsunami_lab::patches::WavePropagationAmr::WavePropagationAmr(t_idx i_nCellsX,
+                                                             t_idx i_nCellsY,
+                                                             t_real i_dx,
+                                                             t_real i_dy,
+                                                             t_idx i_ratio,
+                                                             t_idx i_blockSize,
+                                                             t_real i_depthThreshold,
+                                                             t_real i_gradientThreshold,
+                                                             t_idx i_regridInterval) {
+    m_nCellsX = i_nCellsX;
+    m_nCellsY = i_nCellsY;
+    m_dx = i_dx;
+    m_dy = i_dy;
+    m_ratio = std::max(i_ratio, t_idx(1));
+    m_blockSize = std::max(i_blockSize, t_idx(1));
+    m_depthThreshold = i_depthThreshold;
+    m_gradientThreshold = i_gradientThreshold;
+    m_regridInterval = std::max(i_regridInterval, t_idx(1));
+
+    m_nBlocksX = (m_nCellsX + m_blockSize - 1) / m_blockSize;
+    m_nBlocksY = (m_nCellsY + m_blockSize - 1) / m_blockSize;
+    t_idx l_nBlocks = m_nBlocksX * m_nBlocksY;
+
+    m_coarse = new WavePropagation2d(m_nCellsX, m_nCellsY);
+    m_blocks.assign(l_nBlocks, nullptr);
+    m_blockShallow.assign(l_nBlocks, 0);
+    m_blockSteep.assign(l_nBlocks, 0);
+
+    // every side of every block may border coarse cells
+    m_corrections.reserve(4 * l_nBlocks * m_blockSize);
+}
+
+tsunami_lab::patches::WavePropagationAmr::~WavePropagationAmr() {
+    for (t_idx l_bl = 0; l_bl < m_blocks.size(); l_bl++) {
+        delete m_blocks[l_bl];
+    }
+    delete m_coarse;
+}
+
+void tsunami_lab::patches::WavePropagationAmr::getBlockRange(t_idx i_bl,
+                                                             t_idx o_first[2],
+                                                             t_idx o_end[2]) {
+    o_first[0] = (i_bl % m_nBlocksX) * m_blockSize;
+    o_first[1] = (i_bl / m_nBlocksX) * m_blockSize;
+    o_end[0] = std::min(o_first[0] + m_blockSize, m_nCellsX);
+    o_end[1] = std::min(o_first[1] + m_blockSize, m_nCellsY);
+}
+
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagationAmr::getRefinedBlocks() {
+    t_idx l_nRefined = 0;
+    for (t_idx l_bl = 0; l_bl < m_blocks.size(); l_bl++) {
+        if (m_blocks[l_bl] != nullptr) l_nRefined++;
+    }
+    return l_nRefined;
+}
+
+tsunami_lab::t_idx tsunami_lab::patches::WavePropagationAmr::getNumberOfCells() {
+    t_idx l_nCells = m_nCellsX * m_nCellsY;
+    for (t_idx l_bl = 0; l_bl < m_blocks.size(); l_bl++) {
+        if (m_blocks[l_bl] == nullptr) continue;
+
+        t_idx l_first[2], l_end[2];
+        getBlockRange(l_bl, l_first, l_end);
+        l_nCells += (l_end[0] - l_first[0]) * (l_end[1] - l_first[1]) * m_ratio * m_ratio;
+    }
+    return l_nCells;
+}
+
+void tsunami_lab::patches::WavePropagationAmr::getFineState(long i_fx,
+                                                            long i_fy,
+                                                            t_real o_state[4]) {
+    long l_nFx = m_nCellsX * m_ratio;
+    long l_nFy = m_nCellsY * m_ratio;
+
+    // positions outside the domain: order of the boundaries is east, north, west, south;
+    // like the ghost cells of a single patch, the corners copy the closest cell of the domain
+    bool l_outsideX = (i_fx < 0 || i_fx >= l_nFx);
+    bool l_outsideY = (i_fy < 0 || i_fy >= l_nFy);
+    if (l_outsideX != l_outsideY &&
+        ((i_fx >= l_nFx && m_boundary[0] == REFLECTING) ||
+         (i_fy >= l_nFy && m_boundary[1] == REFLECTING) ||
+         (i_fx < 0 && m_boundary[2] == REFLECTING) ||
+         (i_fy < 0 && m_boundary[3] == REFLECTING))) {
+        o_state[0] = 0;
+        o_state[1] = 0;
+        o_state[2] = 0;
+        o_state[3] = 20;
+        return;
+    }
+    t_idx l_fx = std::min(std::max(i_fx, 0L), l_nFx - 1);
+    t_idx l_fy = std::min(std::max(i_fy, 0L), l_nFy - 1);
+
+    t_idx l_cx = l_fx / m_ratio;
+    t_idx l_cy = l_fy / m_ratio;
+    WavePropagation2d *l_block = m_blocks[(l_cy / m_blockSize) * m_nBlocksX + l_cx / m_blockSize];
+
+    WavePropagation2d *l_patch = m_coarse;
+    t_idx l_idx = m_coarse->getIndex(l_cx + 1, l_cy + 1);
+    if (l_block != nullptr) {
+        l_patch = l_block;
+        l_idx = l_block->getIndex(l_fx - (l_cx / m_blockSize) * m_blockSize * m_ratio + 1,
+                                  l_fy - (l_cy / m_blockSize) * m_blockSize * m_ratio + 1);
+    }
+
+    o_state[0] = l_patch->getHeight()[l_idx];
+    o_state[1] = l_patch->getMomentumX()[l_idx];
+    o_state[2] = l_patch->getMomentumY()[l_idx];
+    o_state[3] = l_patch->getBathymetry()[l_idx];
+}
+
+void tsunami_lab::patches::WavePropagationAmr::regrid() {
+    t_real const *l_h = m_coarse->getHeight();
+    t_real const *l_b = m_coarse->getBathymetry();
+    t_idx l_nBlocks = m_blocks.size();
+
+    // flags of the blocks
+#pragma omp parallel for schedule(static)
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        t_idx l_first[2], l_end[2];
+        getBlockRange(l_bl, l_first, l_end);
+
+        bool l_shallow = false;
+        bool l_steep = (m_gradientThreshold <= 0);
+
+        for (t_idx l_cy = l_first[1]; l_cy < l_end[1]; l_cy++) {
+            for (t_idx l_cx = l_first[0]; l_cx < l_end[0]; l_cx++) {
+                t_idx l_idx = m_coarse->getIndex(l_cx + 1, l_cy + 1);
+                if (l_h[l_idx] <= 0) continue;
+
+                l_shallow = l_shallow || l_h[l_idx] < m_depthThreshold;
+                if (l_steep) continue;
+
+                // central differences of the surface elevation; dry neighbors and the ghost cells are replaced by the cell itself
+                t_real l_eta = l_h[l_idx] + l_b[l_idx];
+                t_idx l_stride = m_coarse->getStride();
+                t_idx l_neighbors[4] = {l_idx - 1, l_idx + 1, l_idx - l_stride, l_idx + l_stride};
+                bool l_inside[4] = {l_cx > 0, l_cx + 1 < m_nCellsX, l_cy > 0, l_cy + 1 < m_nCellsY};
+                t_real l_etaNeighbors[4];
+                for (unsigned short l_ne = 0; l_ne < 4; l_ne++) {
+                    t_idx l_idxNe = l_neighbors[l_ne];
+                    bool l_wet = l_inside[l_ne] && l_h[l_idxNe] > 0;
+                    l_etaNeighbors[l_ne] = l_wet ? l_h[l_idxNe] + l_b[l_idxNe] : l_eta;
+                }
+
+                t_real l_gradX = std::abs(l_etaNeighbors[1] - l_etaNeighbors[0]) / (2 * m_dx);
+                t_real l_gradY = std::abs(l_etaNeighbors[3] - l_etaNeighbors[2]) / (2 * m_dy);
+                l_steep = std::max(l_gradX, l_gradY) >= m_gradientThreshold;
+            }
+        }
+
+        m_blockShallow[l_bl] = l_shallow;
+        m_blockSteep[l_bl] = l_steep;
+    }
+
+    // refine shallow blocks with a wave in their neighborhood; coarsened blocks keep the restricted values
+    for (t_idx l_by = 0; l_by < m_nBlocksY; l_by++) {
+        for (t_idx l_bx = 0; l_bx < m_nBlocksX; l_bx++) {
+            t_idx l_bl = l_by * m_nBlocksX + l_bx;
+
+            bool l_steep = false;
+            for (t_idx l_ny = (l_by == 0) ? 0 : l_by - 1; l_ny < std::min(l_by + 2, m_nBlocksY); l_ny++) {
+                for (t_idx l_nx = (l_bx == 0) ? 0 : l_bx - 1; l_nx < std::min(l_bx + 2, m_nBlocksX); l_nx++) {
+                    l_steep = l_steep || m_blockSteep[l_ny * m_nBlocksX + l_nx];
+                }
+            }
+            bool l_refine = m_blockShallow[l_bl] && l_steep;
+
+            if (l_refine && m_blocks[l_bl] == nullptr) {
+                refineBlock(l_bl);
+            } else if (!l_refine && m_blocks[l_bl] != nullptr) {
+                delete m_blocks[l_bl];
+                m_blocks[l_bl] = nullptr;
+            }
+        }
+    }
+}
+
+void tsunami_lab::patches::WavePropagationAmr::refineBlock(t_idx i_bl) {
+    t_idx l_first[2], l_end[2];
+    getBlockRange(i_bl, l_first, l_end);
+
+    WavePropagation2d *l_block = new WavePropagation2d((l_end[0] - l_first[0]) * m_ratio,
+                                                       (l_end[1] - l_first[1]) * m_ratio);
+
+    t_real const *l_hCoarse = m_coarse->getHeight();
+    t_real const *l_huCoarse = m_coarse->getMomentumX();
+    t_real const *l_hvCoarse = m_coarse->getMomentumY();
+    t_real const *l_bCoarse = m_coarse->getBathymetry();
+    t_real const *l_hFine = l_block->getHeight();
+    t_real const *l_bFine = l_block->getBathymetry();
+
+    t_real l_dxFine = m_dx / m_ratio;
+    t_real l_dyFine = m_dy / m_ratio;
+    bool l_fromSetup = (m_setup != nullptr && m_nSteps == 0);
+
+#pragma omp parallel for collapse(2) schedule(static)
+    for (t_idx l_cy = l_first[1]; l_cy < l_end[1]; l_cy++) {
+        for (t_idx l_cx = l_first[0]; l_cx < l_end[0]; l_cx++) {
+            t_idx l_idx = m_coarse->getIndex(l_cx + 1, l_cy + 1);
+            t_real l_h = l_hCoarse[l_idx];
+            t_real l_eta = l_h + l_bCoarse[l_idx];
+            t_real l_hSum = 0;
+
+            // fine bathymetry and, depending on the time step, water of the setup or the coarse surface elevation
+            for (t_idx l_ky = 0; l_ky < m_ratio; l_ky++) {
+                for (t_idx l_kx = 0; l_kx < m_ratio; l_kx++) {
+                    t_idx l_fx = (l_cx - l_first[0]) * m_ratio + l_kx;
+                    t_idx l_fy = (l_cy - l_first[1]) * m_ratio + l_ky;
+                    t_real l_x = (l_cx * m_ratio + l_kx) * l_dxFine;
+                    t_real l_y = (l_cy * m_ratio + l_ky) * l_dyFine;
+
+                    t_real l_bFineCell = (m_setup != nullptr) ? m_setup->getBathymetry(l_x, l_y) : l_bCoarse[l_idx];
+
+                    if (l_fromSetup) {
+                        l_block->setCell(l_fx + 1,
+                                         l_fy + 1,
+                                         m_setup->getHeight(l_x, l_y),
+                                         m_setup->getMomentumX(l_x, l_y),
+                                         m_setup->getMomentumY(l_x, l_y),
+                                         l_bFineCell);
+                    } else {
+                        t_real l_hFineCell = (l_h > 0) ? std::max(l_eta - l_bFineCell, t_real(0)) : 0;
+                        l_hSum += l_hFineCell;
+                        l_block->setCell(l_fx + 1, l_fy + 1, l_hFineCell, 0, 0, l_bFineCell);
+                    }
+                }
+            }
+            if (l_fromSetup) continue;
+
+            // keep the mass and the velocities of the coarse cell
+            for (t_idx l_ky = 0; l_ky < m_ratio; l_ky++) {
+                for (t_idx l_kx = 0; l_kx < m_ratio; l_kx++) {
+                    t_idx l_fx = (l_cx - l_first[0]) * m_ratio + l_kx + 1;
+                    t_idx l_fy = (l_cy - l_first[1]) * m_ratio + l_ky + 1;
+                    t_idx l_idxFine = l_block->getIndex(l_fx, l_fy);
+
+                    t_real l_hFineCell = l_h;
+                    if (l_hSum > 0) l_hFineCell = l_hFine[l_idxFine] * (l_h * m_ratio * m_ratio / l_hSum);
+                    t_real l_velocityScaling = (l_h > 0) ? l_hFineCell / l_h : 1;
+
+                    l_block->setCell(l_fx,
+                                     l_fy,
+                                     l_hFineCell,
+                                     l_huCoarse[l_idx] * l_velocityScaling,
+                                     l_hvCoarse[l_idx] * l_velocityScaling,
+                                     l_bFine[l_idxFine]);
+                }
+            }
+        }
+    }
+
+    m_blocks[i_bl] = l_block;
+    restrictBlock(i_bl, true);
+}
+
+void tsunami_lab::patches::WavePropagationAmr::restrictBlock(t_idx i_bl,
+                                                             bool i_bathymetry) {
+    t_idx l_first[2], l_end[2];
+    getBlockRange(i_bl, l_first, l_end);
+
+    WavePropagation2d *l_block = m_blocks[i_bl];
+    t_real const *l_h = l_block->getHeight();
+    t_real const *l_hu = l_block->getMomentumX();
+    t_real const *l_hv = l_block->getMomentumY();
+    t_real const *l_b = l_block->getBathymetry();
+    t_real l_scaling = t_real(1) / (m_ratio * m_ratio);
+
+    for (t_idx l_cy = l_first[1]; l_cy < l_end[1]; l_cy++) {
+        for (t_idx l_cx = l_first[0]; l_cx < l_end[0]; l_cx++) {
+            t_real l_sums[4] = {0, 0, 0, 0};
+
+            for (t_idx l_ky = 0; l_ky < m_ratio; l_ky++) {
+                t_idx l_fy = (l_cy - l_first[1]) * m_ratio + l_ky + 1;
+                for (t_idx l_kx = 0; l_kx < m_ratio; l_kx++) {
+                    t_idx l_idx = l_block->getIndex((l_cx - l_first[0]) * m_ratio + l_kx + 1, l_fy);
+                    l_sums[0] += l_h[l_idx];
+                    l_sums[1] += l_hu[l_idx];
+                    l_sums[2] += l_hv[l_idx];
+                    l_sums[3] += l_b[l_idx];
+                }
+            }
+
+            m_coarse->setHeight(l_cx, l_cy, l_sums[0] * l_scaling);
+            m_coarse->setMomentumX(l_cx, l_cy, l_sums[1] * l_scaling);
+            m_coarse->setMomentumY(l_cx, l_cy, l_sums[2] * l_scaling);
+            if (i_bathymetry) m_coarse->setBathymetry(l_cx, l_cy, l_sums[3] * l_scaling);
+        }
+    }
+}
+
+void tsunami_lab::patches::WavePropagationAmr::setGhostCells(e_boundary *i_boundary) {
+    for (unsigned short l_si = 0; l_si < 4; l_si++) {
+        m_boundary[l_si] = i_boundary[l_si];
+    }
+    m_coarse->setGhostCells(i_boundary);
+}
+
+void tsunami_lab::patches::WavePropagationAmr::setFineGhostCells() {
+    t_idx l_nBlocks = m_blocks.size();
+
+#pragma omp parallel for schedule(dynamic)
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        WavePropagation2d *l_block = m_blocks[l_bl];
+        if (l_block == nullptr) continue;
+
+        t_idx l_first[2], l_end[2];
+        getBlockRange(l_bl, l_first, l_end);
+        t_idx l_nFx = (l_end[0] - l_first[0]) * m_ratio;
+        t_idx l_nFy = (l_end[1] - l_first[1]) * m_ratio;
+
+        // position of the ghost cell in the lower left corner in fine cells of the domain
+        long l_fx0 = long(l_first[0] * m_ratio) - 1;
+        long l_fy0 = long(l_first[1] * m_ratio) - 1;
+        t_real l_state[4];
+
+        // lower and upper ghost rows including the corners
+        for (t_idx l_fx = 0; l_fx < l_nFx + 2; l_fx++) {
+            for (t_idx l_fy : {t_idx(0), l_nFy + 1}) {
+                getFineState(l_fx0 + l_fx, l_fy0 + l_fy, l_state);
+                l_block->setCell(l_fx, l_fy, l_state[0], l_state[1], l_state[2], l_state[3]);
+            }
+        }
+
+        // left and right ghost columns
+        for (t_idx l_fy = 1; l_fy < l_nFy + 1; l_fy++) {
+            for (t_idx l_fx : {t_idx(0), l_nFx + 1}) {
+                getFineState(l_fx0 + l_fx, l_fy0 + l_fy, l_state);
+                l_block->setCell(l_fx, l_fy, l_state[0], l_state[1], l_state[2], l_state[3]);
+            }
+        }
+    }
+}
+
+void tsunami_lab::patches::WavePropagationAmr::addCorrections(t_idx i_bl,
+                                                              unsigned short i_side,
+                                                              t_real i_scaling) {
+    t_idx l_first[2], l_end[2];
+    getBlockRange(i_bl, l_first, l_end);
+
+    // the neighboring block has to be coarse; order of the sides is east, north, west, south
+    bool l_atBoundary[4] = {l_end[0] == m_nCellsX, l_end[1] == m_nCellsY, l_first[0] == 0, l_first[1] == 0};
+    if (l_atBoundary[i_side]) return;
+
+    long l_offsets[4] = {1, long(m_nBlocksX), -1, -long(m_nBlocksX)};
+    if (m_blocks[i_bl + l_offsets[i_side]] != nullptr) return;
+
+    WavePropagation2d *l_block = m_blocks[i_bl];
+    bool l_isX = (i_side % 2 == 0);
+    // for the east and north side, the coarse cell is on the right side of the edges
+    bool l_isRight = (i_side < 2);
+
+    // states seen by the sweep: the x-sweep works on the old states, the y-sweep on the ones after the x-sweep
+    t_real const *l_hC = l_isX ? m_coarse->getHeight() : m_coarse->getHeightStar();
+    t_real const *l_huC = l_isX ? m_coarse->getMomentumX() : m_coarse->getMomentumY();
+    t_real const *l_bC = m_coarse->getBathymetry();
+    t_real const *l_hF = l_isX ? l_block->getHeight() : l_block->getHeightStar();
+    t_real const *l_huF = l_isX ? l_block->getMomentumX() : l_block->getMomentumY();
+    t_real const *l_bF = l_block->getBathymetry();
+
+    t_idx l_nFx = (l_end[0] - l_first[0]) * m_ratio;
+    t_idx l_nFy = (l_end[1] - l_first[1]) * m_ratio;
+    t_idx l_nCells = l_isX ? l_end[1] - l_first[1] : l_end[0] - l_first[0];
+
+    for (t_idx l_ce = 0; l_ce < l_nCells; l_ce++) {
+        // coarse cell outside (l_out) and inside (l_in) of the block
+        t_idx l_out[2], l_in[2];
+        if (l_isX) {
+            l_in[0] = l_isRight ? l_end[0] - 1 : l_first[0];
+            l_out[0] = l_isRight ? l_end[0] : l_first[0] - 1;
+            l_in[1] = l_out[1] = l_first[1] + l_ce;
+        } else {
+            l_in[1] = l_isRight ? l_end[1] - 1 : l_first[1];
+            l_out[1] = l_isRight ? l_end[1] : l_first[1] - 1;
+            l_in[0] = l_out[0] = l_first[0] + l_ce;
+        }
+        t_idx l_idxOut = m_coarse->getIndex(l_out[0] + 1, l_out[1] + 1);
+        t_idx l_idxIn = m_coarse->getIndex(l_in[0] + 1, l_in[1] + 1);
+
+        // dry cells receive no updates
+        if (l_hC[l_idxOut] <= 0) continue;
+
+        // flux through the edge on the coarse level: f(q_out) + A^-dQ (left side) or f(q_out) - A^+dQ (right side)
+        t_real l_sign = l_isRight ? -1 : 1;
+        t_real l_netUpdates[2][2];
+        t_real l_flux[2];
+        t_real l_fluxCoarse[2];
+
+        if (l_isRight) {
+            solvers::FWave::netUpdates(l_hC[l_idxIn], l_hC[l_idxOut], l_huC[l_idxIn], l_huC[l_idxOut], l_bC[l_idxIn], l_bC[l_idxOut], l_netUpdates[0], l_netUpdates[1]);
+        } else {
+            solvers::FWave::netUpdates(l_hC[l_idxOut], l_hC[l_idxIn], l_huC[l_idxOut], l_huC[l_idxIn], l_bC[l_idxOut], l_bC[l_idxIn], l_netUpdates[0], l_netUpdates[1]);
+        }
+        solvers::FWave::flux(l_hC[l_idxOut], l_huC[l_idxOut], l_flux);
+        for (unsigned short l_qu = 0; l_qu < 2; l_qu++) {
+            l_fluxCoarse[l_qu] = l_flux[l_qu] + l_sign * l_netUpdates[l_isRight][l_qu];
+        }
+
+        // average flux through the fine edges, whose outer cells are the ghost cells of the block
+        t_real l_fluxFine[2] = {0, 0};
+        for (t_idx l_k = 0; l_k < m_ratio; l_k++) {
+            t_idx l_along = l_ce * m_ratio + l_k + 1;
+            t_idx l_idxFOut, l_idxFIn;
+            if (l_isX) {
+                l_idxFOut = l_block->getIndex(l_isRight ? l_nFx + 1 : 0, l_along);
+                l_idxFIn = l_block->getIndex(l_isRight ? l_nFx : 1, l_along);
+            } else {
+                l_idxFOut = l_block->getIndex(l_along, l_isRight ? l_nFy + 1 : 0);
+                l_idxFIn = l_block->getIndex(l_along, l_isRight ? l_nFy : 1);
+            }
+
+            if (l_isRight) {
+                solvers::FWave::netUpdates(l_hF[l_idxFIn], l_hF[l_idxFOut], l_huF[l_idxFIn], l_huF[l_idxFOut], l_bF[l_idxFIn], l_bF[l_idxFOut], l_netUpdates[0], l_netUpdates[1]);
+            } else {
+                solvers::FWave::netUpdates(l_hF[l_idxFOut], l_hF[l_idxFIn], l_huF[l_idxFOut], l_huF[l_idxFIn], l_bF[l_idxFOut], l_bF[l_idxFIn], l_netUpdates[0], l_netUpdates[1]);
+            }
+            l_flux[0] = l_flux[1] = 0;
+            if (l_hF[l_idxFOut] > 0) solvers::FWave::flux(l_hF[l_idxFOut], l_huF[l_idxFOut], l_flux);
+
+            for (unsigned short l_qu = 0; l_qu < 2; l_qu++) {
+                l_fluxFine[l_qu] += l_flux[l_qu] + l_sign * l_netUpdates[l_isRight][l_qu];
+            }
+        }
+
+        // the coarse cell lost (left side) or gained (right side) the coarse flux; replace it by the fine one
+        t_real l_corrections[2];
+        for (unsigned short l_qu = 0; l_qu < 2; l_qu++) {
+            l_corrections[l_qu] = -l_sign * i_scaling * (l_fluxFine[l_qu] / m_ratio - l_fluxCoarse[l_qu]);
+        }
+
+        m_corrections.push_back({l_out[0] + 1,
+                                 l_out[1] + 1,
+                                 l_corrections[0],
+                                 l_isX ? l_corrections[1] : 0,
+                                 l_isX ? 0 : l_corrections[1]});
+    }
+}
+
+void tsunami_lab::patches::WavePropagationAmr::timeStep(t_real i_scalingX,
+                                                        t_real i_scalingY) {
+    if (m_nSteps % m_regridInterval == 0) regrid();
+    setFineGhostCells();
+
+    t_idx l_nBlocks = m_blocks.size();
+    t_real l_waveSpeedMax = m_coarse->sweepX(i_scalingX);
+    t_real l_waveSpeedFine = 0;
+
+    // the blocks are distributed among the threads; their sweeps run serially within a thread
+#pragma omp parallel for schedule(dynamic) reduction(max : l_waveSpeedFine)
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        if (m_blocks[l_bl] == nullptr) continue;
+        l_waveSpeedFine = std::max(l_waveSpeedFine, m_blocks[l_bl]->sweepX(i_scalingX * m_ratio));
+    }
+
+    // both sweeps' corrections, while the old states and the ones after the x-sweep are available
+    m_corrections.clear();
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        if (m_blocks[l_bl] == nullptr) continue;
+        for (unsigned short l_si = 0; l_si < 4; l_si++) {
+            addCorrections(l_bl, l_si, (l_si % 2 == 0) ? i_scalingX : i_scalingY);
+        }
+    }
+
+    l_waveSpeedMax = std::max(l_waveSpeedMax, m_coarse->sweepY(i_scalingY));
+
+#pragma omp parallel for schedule(dynamic) reduction(max : l_waveSpeedFine)
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        if (m_blocks[l_bl] == nullptr) continue;
+        l_waveSpeedFine = std::max(l_waveSpeedFine, m_blocks[l_bl]->sweepY(i_scalingY * m_ratio));
+    }
+
+    // flux correction of the coarse cells next to refined blocks
+    t_real const *l_h = m_coarse->getHeight();
+    t_real const *l_hu = m_coarse->getMomentumX();
+    t_real const *l_hv = m_coarse->getMomentumY();
+    t_real const *l_b = m_coarse->getBathymetry();
+    for (t_idx l_co = 0; l_co < m_corrections.size(); l_co++) {
+        Correction const &l_correction = m_corrections[l_co];
+        t_idx l_idx = m_coarse->getIndex(l_correction.x, l_correction.y);
+
+        m_coarse->setCell(l_correction.x,
+                          l_correction.y,
+                          l_h[l_idx] + l_correction.h,
+                          l_hu[l_idx] + l_correction.hu,
+                          l_hv[l_idx] + l_correction.hv,
+                          l_b[l_idx]);
+    }
+
+    // coarse cells of refined blocks
+#pragma omp parallel for schedule(dynamic)
+    for (t_idx l_bl = 0; l_bl < l_nBlocks; l_bl++) {
+        if (m_blocks[l_bl] != nullptr) restrictBlock(l_bl, false);
+    }
+
+    m_maxWaveSpeed = std::max(l_waveSpeedMax, l_waveSpeedFine * m_ratio);
+    m_nSteps++;
+}
@@ -0,0 +1,386 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Two-dimensional wave propagation patch with block-structured adaptive mesh refinement.
+ **/
+#ifndef TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_AMR
+#define TSUNAMI_LAB_PATCHES_WAVE_PROPAGATION_AMR
+
+#include <vector>
+
+#include "../../setups/Setup.h"
+#include "../2d/WavePropagation2d.h"
+#include "../WavePropagation.h"
+
+namespace tsunami_lab {
+    namespace patches {
+        class WavePropagationAmr;
+    }
+}  // namespace tsunami_lab
+
+/**
+ * The coarse grid covers the entire domain and is divided into blocks of coarse cells. Blocks which meet the
+ * refinement criteria are additionally solved by a WavePropagation2d patch whose cells are finer by the refinement
+ * ratio. After every time step the coarse cells of refined blocks are set to the averages of their fine cells and the
+ * coarse cells next to refined blocks are corrected by the difference between the coarse and the fine net-updates of
+ * the shared edges, such that mass is conserved across coarse/fine boundaries.
+ *
+ * All levels use the time step of the fine level.
+ **/
+class tsunami_lab::patches::WavePropagationAmr : public WavePropagation {
+   private:
+    //! correction of a coarse cell next to a refined block
+    struct Correction {
+        //! id of the coarse cell in x-direction including the ghost cells
+        t_idx x;
+        //! id of the coarse cell in y-direction including the ghost cells
+        t_idx y;
+        //! correction of the water height
+        t_real h;
+        //! correction of the momentum in x-direction
+        t_real hu;
+        //! correction of the momentum in y-direction
+        t_real hv;
+    };
+
+    //! number of coarse cells in x-direction
+    t_idx m_nCellsX = 0;
+
+    //! number of coarse cells in y-direction
+    t_idx m_nCellsY = 0;
+
+    //! size of a coarse cell in x-direction
+    t_real m_dx = 1;
+
+    //! size of a coarse cell in y-direction
+    t_real m_dy = 1;
+
+    //! number of fine cells per coarse cell in each direction
+    t_idx m_ratio = 1;
+
+    //! number of coarse cells per block in each direction
+    t_idx m_blockSize = 1;
+
+    //! number of blocks in x-direction
+    t_idx m_nBlocksX = 0;
+
+    //! number of blocks in y-direction
+    t_idx m_nBlocksY = 0;
+
+    //! water depth below which wet cells are considered coastal
+    t_real m_depthThreshold = 0;
+
+    //! gradient of the surface elevation from which on a wave is considered to be present
+    t_real m_gradientThreshold = 0;
+
+    //! number of time steps between two regrids
+    t_idx m_regridInterval = 1;
+
+    //! number of performed time steps
+    t_idx m_nSteps = 0;
+
+    //! maximum wave speed of the last time step scaled to the coarse cell size
+    t_real m_maxWaveSpeed = 0;
+
+    //! boundary conditions of the domain
+    e_boundary m_boundary[4] = {OUTFLOW, OUTFLOW, OUTFLOW, OUTFLOW};
+
+    //! setup which provides the bathymetry of the fine cells; nullptr uses the coarse bathymetry
+    setups::Setup *m_setup = nullptr;
+
+    //! coarse grid of the entire domain
+    WavePropagation2d *m_coarse = nullptr;
+
+    //! fine patches of the blocks; nullptr for blocks which are not refined
+    std::vector<WavePropagation2d *> m_blocks;
+
+    //! corrections of the coarse cells next to refined blocks in the current time step
+    std::vector<Correction> m_corrections;
+
+    //! 1 if the block holds wet cells shallower than the depth threshold
+    std::vector<unsigned char> m_blockShallow;
+
+    //! 1 if the surface gradient in the block reaches the gradient threshold
+    std::vector<unsigned char> m_blockSteep;
+
+    /**
+     * Gets the range of coarse cells covered by a block.
+     *
+     * @param i_bl id of the block.
+     * @param o_first will be set to the first coarse cell in x- and y-direction.
+     * @param o_end will be set to the coarse cell after the last one in x- and y-direction.
+     **/
+    void getBlockRange(t_idx i_bl,
+                       t_idx o_first[2],
+                       t_idx o_end[2]);
+
+    /**
+     * Gets the state of the finest cell at a position given in fine cells. Positions outside the domain obey the
+     * boundary conditions.
+     *
+     * @param i_fx position in x-direction in fine cells.
+     * @param i_fy position in y-direction in fine cells.
+     * @param o_state will be set to the water height, momenta in x- and y-direction and bathymetry.
+     **/
+    void getFineState(long i_fx,
+                      long i_fy,
+                      t_real o_state[4]);
+
+    /**
+     * Derives the refinement flags of all blocks from the coarse grid and creates or removes the fine patches.
+     * A block is refined if it holds wet cells shallower than the depth threshold and the surface gradient in the
+     * block or one of its neighbors reaches the gradient threshold.
+     **/
+    void regrid();
+
+    /**
+     * Creates the fine patch of a block. The fine bathymetry is taken from the setup, if available.
+     * In the first time step the water is also taken from the setup; afterwards the surface elevation of the coarse
+     * cells is prolonged and scaled such that the mass of every coarse cell is kept.
+     *
+     * @param i_bl id of the block.
+     **/
+    void refineBlock(t_idx i_bl);
+
+    /**
+     * Sets the ghost cells of all fine patches to the states of the neighboring fine or coarse cells.
+     **/
+    void setFineGhostCells();
+
+    /**
+     * Adds the corrections of the coarse cells along one side of a refined block for one sweep.
+     * The correction replaces the coarse net-update of every shared edge by the average of the fine ones.
+     *
+     * @param i_bl id of the block.
+     * @param i_side side of the block; 0: east, 1: north, 2: west, 3: south.
+     * @param i_scaling scaling of the time step on the coarse grid (dt / dx or dt / dy).
+     **/
+    void addCorrections(t_idx i_bl,
+                        unsigned short i_side,
+                        t_real i_scaling);
+
+    /**
+     * Sets the coarse cells of a refined block to the averages of the fine cells.
+     *
+     * @param i_bl id of the block.
+     * @param i_bathymetry true if the bathymetry is averaged as well.
+     **/
+    void restrictBlock(t_idx i_bl,
+                       bool i_bathymetry);
+
+   public:
+    /**
+     * Constructs the adaptive wave propagation solver.
+     *
+     * @param i_nCellsX number of coarse cells in x-direction.
+     * @param i_nCellsY number of coarse cells in y-direction.
+     * @param i_dx size of a coarse cell in x-direction.
+     * @param i_dy size of a coarse cell in y-direction.
+     * @param i_ratio number of fine cells per coarse cell in each direction.
+     * @param i_blockSize number of coarse cells per block in each direction.
+     * @param i_depthThreshold water depth below which wet cells are refined.
+     * @param i_gradientThreshold gradient of the surface elevation which triggers the refinement; 0 refines all shallow blocks.
+     * @param i_regridInterval number of time steps between two regrids.
+     **/
+    WavePropagationAmr(t_idx i_nCellsX,
+                       t_idx i_nCellsY,
+                       t_real i_dx,
+                       t_real i_dy,
+                       t_idx i_ratio,
+                       t_idx i_blockSize,
+                       t_real i_depthThreshold,
+                       t_real i_gradientThreshold,
+                       t_idx i_regridInterval);
+
+    /**
+     * Destructor which frees all allocated memory.
+     **/
+    ~WavePropagationAmr();
+
+    /**
+     * Sets the setup which provides the bathymetry and the initial water of the fine cells.
+     *
+     * @param i_setup setup, which is queried at the lower left corners of the cells like the coarse grid.
+     **/
+    void setSetup(setups::Setup *i_setup) {
+        m_setup = i_setup;
+    }
+
+    /**
+     * Performs a time step. The blocks are regridded before every regridInterval-th time step.
+     *
+     * @param i_scalingX scaling of the time step on the coarse grid (dt / dx).
+     * @param i_scalingY scaling of the time step on the coarse grid (dt / dy).
+     **/
+    void timeStep(t_real i_scalingX,
+                  t_real i_scalingY);
+
+    /**
+     * Gets the maximum wave speed of the last time step. The wave speeds of the fine level are multiplied by the
+     * refinement ratio, such that a time step derived from the coarse cell size is stable on the fine level.
+     *
+     * @return maximum wave speed.
+     **/
+    t_real getMaxWaveSpeed() {
+        return m_maxWaveSpeed;
+    }
+
+    /**
+     * Gets the number of refined blocks.
+     *
+     * @return refined blocks.
+     **/
+    t_idx getRefinedBlocks();
+
+    /**
+     * Gets the number of blocks the domain is divided into.
+     *
+     * @return number of blocks.
+     **/
+    t_idx getNumberOfBlocks() {
+        return m_nBlocksX * m_nBlocksY;
+    }
+
+    /**
+     * Gets the number of cells which are solved in a time step.
+     *
+     * @return coarse cells and fine cells of all refined blocks.
+     **/
+    t_idx getNumberOfCells();
+
+    /**
+     * Gets the fine patch of a block.
+     *
+     * @param i_bx id of the block in x-direction.
+     * @param i_by id of the block in y-direction.
+     * @return fine patch; nullptr if the block is not refined.
+     **/
+    WavePropagation2d *getBlock(t_idx i_bx,
+                                t_idx i_by) {
+        return m_blocks[i_by * m_nBlocksX + i_bx];
+    }
+
+    /**
+     * Sets the boundary conditions and the ghost cells of the coarse grid. The ghost cells of the fine patches are
+     * set in the time step after the regrid.
+     *
+     * @param i_boundary defines the boundary condition.
+     **/
+    void setGhostCells(e_boundary *i_boundary);
+
+    /**
+     * Gets the stride in y-direction of the coarse grid. x-direction is stride-1.
+     *
+     * @return stride in y-direction.
+     **/
+    t_idx getStride() {
+        return m_coarse->getStride();
+    }
+
+    /**
+     * Gets the coarse cells' water heights; refined blocks hold the averages of their fine cells.
+     *
+     * @return water heights.
+     */
+    t_real const *getHeight() {
+        return m_coarse->getHeight();
+    }
+
+    /**
+     * Gets the coarse cells' momenta in x-direction.
+     *
+     * @return momenta in x-direction.
+     **/
+    t_real const *getMomentumX() {
+        return m_coarse->getMomentumX();
+    }
+
+    /**
+     * Gets the coarse cells' momenta in y-direction.
+     *
+     * @return momenta in y-direction.
+     **/
+    t_real const *getMomentumY() {
+        return m_coarse->getMomentumY();
+    }
+
+    /**
+     * Gets the coarse cells' bathymetries.
+     *
+     * @return bathymetries.
+     */
+    t_real const *getBathymetry() {
+        return m_coarse->getBathymetry();
+    }
+
+    /**
+     * Gets writable views of the coarse cells' quantities, which start at the first inner cell.
+     *
+     * @param o_h will be set to the view of the water heights.
+     * @param o_hu will be set to the view of the momenta in x-direction.
+     * @param o_hv will be set to the view of the momenta in y-direction.
+     * @param o_b will be set to the view of the bathymetry.
+     * @return true.
+     **/
+    bool getStateViews(t_real **o_h,
+                       t_real **o_hu,
+                       t_real **o_hv,
+                       t_real **o_b) {
+        return m_coarse->getStateViews(o_h, o_hu, o_hv, o_b);
+    }
+
+    /**
+     * Sets the height of the coarse cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_h water height.
+     **/
+    void setHeight(t_idx i_ix,
+                   t_idx i_iy,
+                   t_real i_h) {
+        m_coarse->setHeight(i_ix, i_iy, i_h);
+    }
+
+    /**
+     * Sets the momentum in x-direction of the coarse cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_hu momentum in x-direction.
+     **/
+    void setMomentumX(t_idx i_ix,
+                      t_idx i_iy,
+                      t_real i_hu) {
+        m_coarse->setMomentumX(i_ix, i_iy, i_hu);
+    }
+
+    /**
+     * Sets the momentum in y-direction of the coarse cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_hv momentum in y-direction.
+     **/
+    void setMomentumY(t_idx i_ix,
+                      t_idx i_iy,
+                      t_real i_hv) {
+        m_coarse->setMomentumY(i_ix, i_iy, i_hv);
+    }
+
+    /**
+     * Sets the bathymetry of the coarse cell to the given value.
+     *
+     * @param i_ix id of the cell in x-direction.
+     * @param i_iy id of the cell in y-direction.
+     * @param i_b bathymetry.
+     **/
+    void setBathymetry(t_idx i_ix,
+                       t_idx i_iy,
+                       t_real i_b) {
+        m_coarse->setBathymetry(i_ix, i_iy, i_b);
+    }
+};
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Unit tests of the two-dimensional wave propagation patch with adaptive mesh refinement.
+ **/
+#include "WavePropagationAmr.h"
+
+#include <catch2/catch.hpp>
+
+/**
+ * Lake at rest over a slope in x-direction.
+ **/
+class SlopeSetup : public tsunami_lab::setups::Setup {
+   public:
+    tsunami_lab::t_real getHeight(tsunami_lab::t_real i_x,
+                                  tsunami_lab::t_real) const {
+        return -getBathymetry(i_x, 0);
+    }
+
+    tsunami_lab::t_real getMomentumX(tsunami_lab::t_real,
+                                     tsunami_lab::t_real) const {
+        return 0;
+    }
+
+    tsunami_lab::t_real getMomentumY(tsunami_lab::t_real,
+                                     tsunami_lab::t_real) const {
+        return 0;
+    }
+
+    tsunami_lab::t_real getBathymetry(tsunami_lab::t_real i_x,
+                                      tsunami_lab::t_real) const {
+        return -5 - tsunami_lab::t_real(0.2) * i_x;
+    }
+};
+
+TEST_CASE("Test the adaptive wave propagation solver on a lake at rest.", "[WavePropAmr]") {
+    /*
+     * Test case:
+     *   Given 64 x 64 coarse cells of size 1 with a lake at rest over the bathymetry -5 - 0.2 * x.
+     *   The blocks of 16 x 16 coarse cells with depths below 10 (x < 25) are refined by a ratio of 2 and get the
+     *   bathymetry of the setup at the fine cells.
+     *
+     *   The lake stays at rest.
+     */
+    SlopeSetup l_setup;
+    tsunami_lab::patches::WavePropagationAmr l_waveProp(64, 64, 1, 1, 2, 16, 10, 0, 5);
+    l_waveProp.setSetup(&l_setup);
+
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < 64; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < 64; l_cx++) {
+            l_waveProp.setHeight(l_cx, l_cy, l_setup.getHeight(l_cx, l_cy));
+            l_waveProp.setMomentumX(l_cx, l_cy, 0);
+            l_waveProp.setMomentumY(l_cx, l_cy, 0);
+            l_waveProp.setBathymetry(l_cx, l_cy, l_setup.getBathymetry(l_cx, l_cy));
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW};
+
+    for (int l_st = 0; l_st < 10; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.05, 0.05);
+    }
+
+    REQUIRE(l_waveProp.getNumberOfBlocks() == 16);
+    REQUIRE(l_waveProp.getRefinedBlocks() == 8);
+    REQUIRE(l_waveProp.getBlock(1, 3) != nullptr);
+    REQUIRE(l_waveProp.getBlock(2, 0) == nullptr);
+    REQUIRE(l_waveProp.getNumberOfCells() == 64 * 64 + 8 * 32 * 32);
+
+    // the speed of the shallowest fine cells in units of coarse cells
+    REQUIRE(l_waveProp.getMaxWaveSpeed() > 2 * std::sqrt(9.80665 * 5));
+
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < 64; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < 64; l_cx++) {
+            tsunami_lab::t_idx l_idx = (l_cy + 1) * l_waveProp.getStride() + l_cx + 1;
+            tsunami_lab::t_real l_eta = l_waveProp.getHeight()[l_idx] + l_waveProp.getBathymetry()[l_idx];
+
+            REQUIRE(l_eta == Approx(0).margin(1E-4));
+            REQUIRE(l_waveProp.getMomentumX()[l_idx] == Approx(0).margin(1E-4));
+            REQUIRE(l_waveProp.getMomentumY()[l_idx] == Approx(0).margin(1E-4));
+        }
+    }
+}
+
+TEST_CASE("Test the adaptive wave propagation solver with all blocks refined against a uniform fine grid.", "[WavePropAmr]") {
+    /*
+     * Test case:
+     *   Given 32 x 24 coarse cells with varying heights and momenta over a flat bathymetry, refined by a ratio of 2
+     *   in blocks of 8 x 8 coarse cells, i.e., the blocks exchange all their ghost cells among each other.
+     *
+     *   The fine cells have to match those of a single patch with 64 x 48 cells bit for bit.
+     */
+    tsunami_lab::t_idx l_nx = 32;
+    tsunami_lab::t_idx l_ny = 24;
+    tsunami_lab::patches::WavePropagationAmr l_waveProp(l_nx, l_ny, 2, 2, 2, 8, 1000, 0, 100);
+    tsunami_lab::patches::WavePropagation2d l_waveProp2d(2 * l_nx, 2 * l_ny);
+
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < l_ny; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++) {
+            tsunami_lab::t_real l_h = 10 + ((l_cx < 12) ? 3 : 0) + tsunami_lab::t_real(0.1) * l_cy;
+            tsunami_lab::t_real l_hu = tsunami_lab::t_real(0.5) * (l_cx % 5);
+            tsunami_lab::t_real l_hv = -tsunami_lab::t_real(0.25) * (l_cy % 3);
+
+            l_waveProp.setHeight(l_cx, l_cy, l_h);
+            l_waveProp.setMomentumX(l_cx, l_cy, l_hu);
+            l_waveProp.setMomentumY(l_cx, l_cy, l_hv);
+            l_waveProp.setBathymetry(l_cx, l_cy, -20);
+
+            for (tsunami_lab::t_idx l_ky = 0; l_ky < 2; l_ky++) {
+                for (tsunami_lab::t_idx l_kx = 0; l_kx < 2; l_kx++) {
+                    l_waveProp2d.setHeight(2 * l_cx + l_kx, 2 * l_cy + l_ky, l_h);
+                    l_waveProp2d.setMomentumX(2 * l_cx + l_kx, 2 * l_cy + l_ky, l_hu);
+                    l_waveProp2d.setMomentumY(2 * l_cx + l_kx, 2 * l_cy + l_ky, l_hv);
+                    l_waveProp2d.setBathymetry(2 * l_cx + l_kx, 2 * l_cy + l_ky, -20);
+                }
+            }
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::REFLECTING, tsunami_lab::OUTFLOW};
+
+    for (int l_st = 0; l_st < 8; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.02, 0.02);
+
+        l_waveProp2d.setGhostCells(l_boundary);
+        l_waveProp2d.timeStep(0.04, 0.04);
+    }
+
+    REQUIRE(l_waveProp.getRefinedBlocks() == 12);
+    REQUIRE(l_waveProp.getMaxWaveSpeed() == 2 * l_waveProp2d.getMaxWaveSpeed());
+
+    for (tsunami_lab::t_idx l_by = 0; l_by < 3; l_by++) {
+        for (tsunami_lab::t_idx l_bx = 0; l_bx < 4; l_bx++) {
+            tsunami_lab::patches::WavePropagation2d *l_block = l_waveProp.getBlock(l_bx, l_by);
+
+            for (tsunami_lab::t_idx l_fy = 1; l_fy < 17; l_fy++) {
+                for (tsunami_lab::t_idx l_fx = 1; l_fx < 17; l_fx++) {
+                    tsunami_lab::t_idx l_idx = l_block->getIndex(l_fx, l_fy);
+                    tsunami_lab::t_idx l_idx2d = l_waveProp2d.getIndex(16 * l_bx + l_fx, 16 * l_by + l_fy);
+
+                    REQUIRE(l_block->getHeight()[l_idx] == l_waveProp2d.getHeight()[l_idx2d]);
+                    REQUIRE(l_block->getMomentumX()[l_idx] == l_waveProp2d.getMomentumX()[l_idx2d]);
+                    REQUIRE(l_block->getMomentumY()[l_idx] == l_waveProp2d.getMomentumY()[l_idx2d]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test the mass conservation of the adaptive wave propagation solver.", "[WavePropAmr]") {
+    /*
+     * Test case:
+     *   Given 48 x 48 coarse cells enclosed by reflecting boundaries. The water is 8 deep for x < 16 and 20 deep
+     *   otherwise; a hump of height 1 is placed at the cells 20 to 27 in both directions.
+     *   Shallow blocks of 8 x 8 coarse cells are refined by a ratio of 4 once the wave reaches them.
+     *
+     *   The total mass stays the same while waves pass the coarse/fine boundaries and blocks are refined.
+     */
+    tsunami_lab::t_idx l_nx = 48;
+    tsunami_lab::patches::WavePropagationAmr l_waveProp(l_nx, l_nx, 10, 10, 4, 8, 10, 1E-3, 4);
+
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < l_nx; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++) {
+            tsunami_lab::t_real l_b = (l_cx < 16) ? -8 : -20;
+            tsunami_lab::t_real l_h = -l_b;
+            if (l_cx >= 20 && l_cx < 28 && l_cy >= 20 && l_cy < 28) l_h += 1;
+
+            l_waveProp.setHeight(l_cx, l_cy, l_h);
+            l_waveProp.setMomentumX(l_cx, l_cy, 0);
+            l_waveProp.setMomentumY(l_cx, l_cy, 0);
+            l_waveProp.setBathymetry(l_cx, l_cy, l_b);
+        }
+    }
+
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING, tsunami_lab::REFLECTING};
+
+    double l_massInitial = 0;
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < l_nx; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++) {
+            l_massInitial += l_waveProp.getHeight()[(l_cy + 1) * l_waveProp.getStride() + l_cx + 1];
+        }
+    }
+
+    tsunami_lab::t_idx l_refinedMax = 0;
+    for (int l_st = 0; l_st < 160; l_st++) {
+        l_waveProp.setGhostCells(l_boundary);
+        l_waveProp.timeStep(0.025, 0.025);
+        l_refinedMax = std::max(l_refinedMax, l_waveProp.getRefinedBlocks());
+    }
+
+    // only the shallow blocks are refined
+    REQUIRE(l_refinedMax > 0);
+    REQUIRE(l_refinedMax <= 12);
+
+    double l_mass = 0;
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < l_nx; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++) {
+            l_mass += l_waveProp.getHeight()[(l_cy + 1) * l_waveProp.getStride() + l_cx + 1];
+        }
+    }
+    REQUIRE(l_mass == Approx(l_massInitial).epsilon(1E-6));
+}
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 tsunami_lab::setups::ArtificialTsunami2d::ArtificialTsunami2d(t_real i_simLenX,
                                                               t_real i_simLenY) {
@@ -63,4 +64,51 @@ tsunami_lab::t_real tsunami_lab::setups::ArtificialTsunami2d::getBathymetry(t_re
     } else {
         return std::max(m_bIn, m_delta) + l_dxy;
     }
-}
\ No newline at end of file
+}
+void tsunami_lab::setups::ArtificialTsunami2d::fill(t_idx i_ix0,
+                                                    t_idx i_iy0,
+                                                    t_real i_dx,
+                                                    t_real i_dy,
+                                                    t_idx i_nx,
+                                                    t_idx i_ny,
+                                                    t_idx i_stride,
+                                                    t_real *o_h,
+                                                    t_real *o_hu,
+                                                    t_real *o_hv,
+                                                    t_real *o_b) const {
+    t_real l_offsetX = -(m_simLenX / 2);
+    t_real l_offsetY = -(m_simLenY / 2);
+
+    t_real l_dispDomainStart = -((m_simLenX * 0.1) / 2);
+    t_real l_dispDomainEnd = ((m_simLenX * 0.1) / 2);
+
+    t_real l_height = getHeight(0, 0);
+    t_real l_bIn = (m_bIn < 0) ? std::min(m_bIn, -m_delta) : std::max(m_bIn, m_delta);
+
+    // displacement factor of every column, zero outside of the displaced domain
+    std::vector<t_real> l_fx(i_nx);
+    for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+        t_real l_x = (i_ix0 + l_ix) * i_dx + l_offsetX;
+        bool l_isInDomainX = l_x > l_dispDomainStart && l_x < l_dispDomainEnd;
+        l_fx[l_ix] = l_isInDomainX ? std::sin(((l_x / 500) + 1) * C_PI) : 0;
+    }
+
+    for (t_idx l_iy = 0; l_iy < i_ny; l_iy++) {
+        t_real l_y = (i_iy0 + l_iy) * i_dy + l_offsetY;
+        bool l_isInDomainY = l_y > l_dispDomainStart && l_y < l_dispDomainEnd;
+        t_real l_gy = l_isInDomainY ? (-std::pow((l_y / 500), 2)) + 1 : 0;
+
+        t_real *l_h = o_h + l_iy * i_stride;
+        t_real *l_hu = o_hu + l_iy * i_stride;
+        t_real *l_hv = o_hv + l_iy * i_stride;
+        t_real *l_b = o_b + l_iy * i_stride;
+
+#pragma omp simd
+        for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+            l_h[l_ix] = l_height;
+            l_hu[l_ix] = 0;
+            l_hv[l_ix] = 0;
+            l_b[l_ix] = l_bIn + 5 * l_fx[l_ix] * l_gy;
+        }
+    }
+}
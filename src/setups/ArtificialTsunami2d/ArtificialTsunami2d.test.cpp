@@ -9,6 +9,7 @@
 #include "ArtificialTsunami2d.h"
 
 #include <catch2/catch.hpp>
+#include <vector>
 
 TEST_CASE("Test the two-dimensional artificial tsunami setup.", "[ArtificialTsunami2d]") {
     tsunami_lab::setups::ArtificialTsunami2d l_artificialTsunami(10000, 10000);
@@ -21,4 +22,31 @@ TEST_CASE("Test the two-dimensional artificial tsunami setup.", "[ArtificialTsun
             REQUIRE(l_artificialTsunami.getBathymetry(l_x, l_y) == -100);
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Test filling a block of the two-dimensional artificial tsunami setup at once.", "[ArtificialTsunami2d]") {
+    /*
+     * Test case:
+     *   A block of 40 x 20 cells of 50 m, which covers the displacement, starts at cell (80, 90); its rows are 41
+     *   values apart.
+     *
+     *   Every cell matches the point-wise getters.
+     */
+    tsunami_lab::setups::ArtificialTsunami2d l_artificialTsunami(10000, 10000);
+
+    std::vector<tsunami_lab::t_real> l_h(20 * 41), l_hu(20 * 41), l_hv(20 * 41), l_b(20 * 41);
+    l_artificialTsunami.fill(80, 90, 50, 50, 40, 20, 41, l_h.data(), l_hu.data(), l_hv.data(), l_b.data());
+
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 20; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 40; l_ix++) {
+            tsunami_lab::t_idx l_ce = l_iy * 41 + l_ix;
+            tsunami_lab::t_real l_x = (80 + l_ix) * tsunami_lab::t_real(50);
+            tsunami_lab::t_real l_y = (90 + l_iy) * tsunami_lab::t_real(50);
+
+            REQUIRE(l_h[l_ce] == l_artificialTsunami.getHeight(l_x, l_y));
+            REQUIRE(l_hu[l_ce] == 0);
+            REQUIRE(l_hv[l_ce] == 0);
+            REQUIRE(l_b[l_ce] == Approx(l_artificialTsunami.getBathymetry(l_x, l_y)));
+        }
+    }
+    REQUIRE(l_b[10 * 41 + 25] == Approx(-105));
+}
@@ -8,34 +8,22 @@
 #include "CheckPoint.h"
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 tsunami_lab::setups::CheckPoint::CheckPoint(t_real i_dimX,
                                             t_real i_dimY,
-                                            t_idx i_nx,
-                                            t_idx i_ny,
-                                            t_idx i_frame,
-                                            t_real *i_height,
-                                            t_real *i_momentumX,
-                                            t_real *i_momentumY,
-                                            t_real *i_bathymetry,
-                                            t_real *i_time) {
-    m_nx = i_nx;
-    m_ny = i_ny;
-    m_frameOffset = (i_frame - 1) * i_nx * i_ny;
-    m_height = i_height;
-    m_momentumX = i_momentumX;
-    m_momentumY = i_momentumY;
-    m_bathymetry = i_bathymetry;
-    m_time = i_time;
-    m_currentFrame = i_frame;
-
-    m_cellWidthX = m_nx / i_dimX;
-    m_cellWidthY = m_ny / i_dimY;
-
-    m_heightData = new t_real[(m_nx + 2) * (m_ny + 2)];
-    m_momentumXData = new t_real[(m_nx + 2) * (m_ny + 2)];
-    m_momentumYData = new t_real[(m_nx + 2) * (m_ny + 2)];
+                                            io::BinaryCheckPoint *i_checkPoint) {
+    m_checkPoint = i_checkPoint;
+    m_stride = m_checkPoint->getStride();
+    m_height = m_checkPoint->getHeight();
+    m_momentumX = m_checkPoint->getMomentumX();
+    m_momentumY = m_checkPoint->getMomentumY();
+    m_bathymetry = m_checkPoint->getBathymetry();
+
+    m_cellWidthX = m_checkPoint->getNx() / i_dimX;
+    m_cellWidthY = m_checkPoint->getNy() / i_dimY;
 }
 
 tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getHeight(t_real i_x,
@@ -43,7 +31,7 @@ tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getHeight(t_real i_x,
     t_idx l_ix = round(i_x * m_cellWidthX);
     t_idx l_iy = round(i_y * m_cellWidthY);
 
-    return m_height[l_ix + l_iy * m_nx + m_frameOffset];
+    return m_height[(l_iy + 1) * m_stride + l_ix + 1];
 }
 
 tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getMomentumX(t_real i_x,
@@ -51,7 +39,7 @@ tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getMomentumX(t_real i_x,
     t_idx l_ix = round(i_x * m_cellWidthX);
     t_idx l_iy = round(i_y * m_cellWidthY);
 
-    return m_momentumX[l_ix + l_iy * m_nx + m_frameOffset];
+    return m_momentumX[(l_iy + 1) * m_stride + l_ix + 1];
 }
 
 tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getMomentumY(t_real i_x,
@@ -59,7 +47,7 @@ tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getMomentumY(t_real i_x,
     t_idx l_ix = round(i_x * m_cellWidthX);
     t_idx l_iy = round(i_y * m_cellWidthY);
 
-    return m_momentumY[l_ix + l_iy * m_nx + m_frameOffset];
+    return m_momentumY[(l_iy + 1) * m_stride + l_ix + 1];
 }
 
 tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getBathymetry(t_real i_x,
@@ -67,17 +55,54 @@ tsunami_lab::t_real tsunami_lab::setups::CheckPoint::getBathymetry(t_real i_x,
     t_idx l_ix = round(i_x * m_cellWidthX);
     t_idx l_iy = round(i_y * m_cellWidthY);
 
-    return m_bathymetry[l_ix + l_iy * m_nx];
+    return m_bathymetry[(l_iy + 1) * m_stride + l_ix + 1];
 }
 
 tsunami_lab::setups::CheckPoint::~CheckPoint() {
-    delete[] m_heightData;
-    delete[] m_momentumXData;
-    delete[] m_momentumYData;
-
-    delete[] m_height;
-    delete[] m_momentumX;
-    delete[] m_momentumY;
-    delete[] m_bathymetry;
-    delete[] m_time;
-}
\ No newline at end of file
+    delete m_checkPoint;
+}
+
+void tsunami_lab::setups::CheckPoint::fill(t_idx i_ix0,
+                                           t_idx i_iy0,
+                                           t_real i_dx,
+                                           t_real i_dy,
+                                           t_idx i_nx,
+                                           t_idx i_ny,
+                                           t_idx i_stride,
+                                           t_real *o_h,
+                                           t_real *o_hu,
+                                           t_real *o_hv,
+                                           t_real *o_b) const {
+    if (i_nx == 0) return;
+
+    // cells of the checkpoint in every column, which are contiguous if the grids match
+    std::vector<t_idx> l_ids(i_nx);
+    bool l_contiguous = true;
+    for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+        t_real l_x = (i_ix0 + l_ix) * i_dx;
+        l_ids[l_ix] = round(l_x * m_cellWidthX);
+        l_contiguous = l_contiguous && l_ids[l_ix] == l_ids[0] + l_ix;
+    }
+
+    for (t_idx l_iy = 0; l_iy < i_ny; l_iy++) {
+        t_real l_y = (i_iy0 + l_iy) * i_dy;
+        t_idx l_row = (t_idx(round(l_y * m_cellWidthY)) + 1) * m_stride + 1;
+        t_idx l_ce = l_iy * i_stride;
+
+        if (l_contiguous) {
+            t_idx l_bytes = i_nx * sizeof(t_real);
+            std::memcpy(o_h + l_ce, m_height + l_row + l_ids[0], l_bytes);
+            std::memcpy(o_hu + l_ce, m_momentumX + l_row + l_ids[0], l_bytes);
+            std::memcpy(o_hv + l_ce, m_momentumY + l_row + l_ids[0], l_bytes);
+            std::memcpy(o_b + l_ce, m_bathymetry + l_row + l_ids[0], l_bytes);
+            continue;
+        }
+
+        for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+            o_h[l_ce + l_ix] = m_height[l_row + l_ids[l_ix]];
+            o_hu[l_ce + l_ix] = m_momentumX[l_row + l_ids[l_ix]];
+            o_hv[l_ce + l_ix] = m_momentumY[l_row + l_ids[l_ix]];
+            o_b[l_ce + l_ix] = m_bathymetry[l_row + l_ids[l_ix]];
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #ifndef TSUNAMI_LAB_SETUPS_CHECK_POINT_H
 #define TSUNAMI_LAB_SETUPS_CHECK_POINT_H
 
+#include "../../io/BinaryCheckPoint/BinaryCheckPoint.h"
 #include "../Setup.h"
 
 namespace tsunami_lab {
@@ -17,44 +18,38 @@ namespace tsunami_lab {
 
 class tsunami_lab::setups::CheckPoint : public Setup {
    private:
-    t_idx m_nx;
-    t_idx m_ny;
-    t_idx m_frameOffset;
-    t_idx m_currentFrame;
+    t_idx m_stride;
     t_real m_cellWidthX;
     t_real m_cellWidthY;
-    t_real *m_height;
-    t_real *m_momentumX;
-    t_real *m_momentumY;
-    t_real *m_bathymetry;
-    t_real *m_time;
-    t_real *m_heightData;
-    t_real *m_momentumXData;
-    t_real *m_momentumYData;
+    io::BinaryCheckPoint *m_checkPoint;
+    t_real const *m_height;
+    t_real const *m_momentumX;
+    t_real const *m_momentumY;
+    t_real const *m_bathymetry;
 
    public:
     /**
-     * Constructor.
+     * Constructor which takes over a mapped checkpoint.
      *
-     * @param i_innerHeight water height in the dam.
-     * @param i_outerHeight water height outside of the dam.
-     * @param i_simLenX length of simulation in x direction.
-     * @param i_simLenY length of simulation in y direction.
-     * @param i_damLimit limit of the dam.
+     * @param i_dimX length of simulation in x direction.
+     * @param i_dimY length of simulation in y direction.
+     * @param i_checkPoint mapped checkpoint; it is deleted with the setup.
      **/
     CheckPoint(t_real i_dimX,
                t_real i_dimY,
-               t_idx i_nx,
-               t_idx i_ny,
-               t_idx i_frame,
-               t_real *i_height,
-               t_real *i_momentumX,
-               t_real *i_momentumY,
-               t_real *i_bathymetry,
-               t_real *i_time);
+               io::BinaryCheckPoint *i_checkPoint);
 
     ~CheckPoint();
 
+    /**
+     * Gets the mapped checkpoint.
+     *
+     * @return mapped checkpoint.
+     **/
+    io::BinaryCheckPoint const *getCheckPoint() const {
+        return m_checkPoint;
+    }
+
     /**
      * Gets the water height at a given point.
      *
@@ -91,42 +86,32 @@ class tsunami_lab::setups::CheckPoint : public Setup {
     t_real getBathymetry(t_real,
                          t_real) const;
 
-    t_real *getHeightData(t_idx i_frame) {
-        for (t_idx l_iy = 0; l_iy < m_ny; l_iy++) {
-            for (t_idx l_ix = 0; l_ix < m_nx; l_ix++) {
-                m_heightData[(l_ix + 1) + (l_iy + 1) * (m_nx + 2)] = m_height[l_ix + l_iy * m_nx + i_frame * m_nx * m_ny];
-            }
-        }
-
-        return m_heightData;
-    }
-
-    t_real *getMomentumXData(t_idx i_frame) {
-        for (t_idx l_iy = 0; l_iy < m_ny; l_iy++) {
-            for (t_idx l_ix = 0; l_ix < m_nx; l_ix++) {
-                m_momentumXData[(l_ix + 1) + (l_iy + 1) * (m_nx + 2)] = m_momentumX[l_ix + l_iy * m_nx + i_frame * m_nx * m_ny];
-            }
-        }
-
-        return m_momentumXData;
-    }
-
-    t_real *getMomentumYData(t_idx i_frame) {
-        for (t_idx l_iy = 0; l_iy < m_ny; l_iy++) {
-            for (t_idx l_ix = 0; l_ix < m_nx; l_ix++) {
-                m_momentumYData[(l_ix + 1) + (l_iy + 1) * (m_nx + 2)] = m_momentumY[l_ix + l_iy * m_nx + i_frame * m_nx * m_ny];
-            }
-        }
-        return m_momentumYData;
-    }
-
-    t_real getSimTimeData(t_idx i_frame) {
-        return m_time[i_frame];
-    }
-
-    t_real getCurrentFrame() {
-        return m_currentFrame;
-    }
+    /**
+     * Fills a block of cells at once; rows of the checkpoint which match the rows of the block are copied as a whole.
+     *
+     * @param i_ix0 id of the first cell of the block in x-direction.
+     * @param i_iy0 id of the first cell of the block in y-direction.
+     * @param i_dx cell width in x-direction.
+     * @param i_dy cell width in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the rows of the arrays.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     * @param o_hv will be set to the momenta in y-direction.
+     * @param o_b will be set to the bathymetry.
+     **/
+    void fill(t_idx i_ix0,
+              t_idx i_iy0,
+              t_real i_dx,
+              t_real i_dy,
+              t_idx i_nx,
+              t_idx i_ny,
+              t_idx i_stride,
+              t_real *o_h,
+              t_real *o_hu,
+              t_real *o_hv,
+              t_real *o_b) const;
 };
 
 #endif
\ No newline at end of file
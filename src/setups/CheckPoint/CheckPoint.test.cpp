@@ -8,62 +8,45 @@
 #include "CheckPoint.h"
 
 #include <catch2/catch.hpp>
+#include <cstdio>
+#include <vector>
 
 TEST_CASE("Test the two-dimensional checkpoint setup data.", "[Checkpoint]") {
     tsunami_lab::t_idx l_nx = 3;
     tsunami_lab::t_idx l_ny = 2;
-    tsunami_lab::t_idx l_dimX = 3.0;
-    tsunami_lab::t_idx l_dimY = 2.0;
-    tsunami_lab::t_idx l_frame = 2;
-    tsunami_lab::t_real *l_height_ptr = new tsunami_lab::t_real[12];
-    tsunami_lab::t_real *l_momentumX_ptr = new tsunami_lab::t_real[12];
-    tsunami_lab::t_real *l_momentumY_ptr = new tsunami_lab::t_real[12];
-    tsunami_lab::t_real *l_bathymetry_ptr = new tsunami_lab::t_real[12];
-    tsunami_lab::t_real l_bathymetry[12] = {1.5, 2.5,
-                                            3.5, 4.5,
-                                            5.5, 6.5,
-                                            1.5, 2.5,
-                                            3.5, 4.5,
-                                            5.5, 6.5};
-    tsunami_lab::t_real l_height[12] = {0, 0,
-                                        2, 1,
-                                        0, 0,
-                                        0, 0,
-                                        0, 0,
-                                        0, 0};
-    tsunami_lab::t_real l_momentumX[12] = {0, 1,
-                                           2, 3,
-                                           4, 5,
-                                           6, 7,
-                                           8, 9,
-                                           10, 11};
-    tsunami_lab::t_real l_momentumY[12] = {0.1, 0.2,
-                                           0.3, 0.4,
-                                           0.5, 0.6,
-                                           0.2, 0.4,
-                                           0.8, 1.6,
-                                           3.2, 6.4};
+    tsunami_lab::t_real l_dimX = 3.0;
+    tsunami_lab::t_real l_dimY = 2.0;
+    tsunami_lab::t_real l_bathymetry[6] = {1.5, 2.5,
+                                           3.5, 4.5,
+                                           5.5, 6.5};
+    tsunami_lab::t_real l_height[6] = {0, 0,
+                                       0, 0,
+                                       0, 0};
+    tsunami_lab::t_real l_momentumX[6] = {6, 7,
+                                          8, 9,
+                                          10, 11};
+    tsunami_lab::t_real l_momentumY[6] = {0.2, 0.4,
+                                          0.8, 1.6,
+                                          3.2, 6.4};
 
-    tsunami_lab::t_real *l_time = new tsunami_lab::t_real[2];
-    for (tsunami_lab::t_idx l_i = 0; l_i < 12; l_i++) {
-        l_bathymetry_ptr[l_i] = l_bathymetry[l_i];
-        l_height_ptr[l_i] = l_height[l_i];
-        l_momentumX_ptr[l_i] = l_momentumX[l_i];
-        l_momentumY_ptr[l_i] = l_momentumY[l_i];
+    // the checkpoint holds the cells with a ghost cell on each side in rows of 5 values
+    std::vector<tsunami_lab::t_real> l_b(20, -1), l_h(20, -1), l_hu(20, -1), l_hv(20, -1);
+    for (tsunami_lab::t_idx l_i = 0; l_i < 6; l_i++) {
+        tsunami_lab::t_idx l_ce = (l_i / l_nx + 1) * 5 + l_i % l_nx + 1;
+        l_b[l_ce] = l_bathymetry[l_i];
+        l_h[l_ce] = l_height[l_i];
+        l_hu[l_ce] = l_momentumX[l_i];
+        l_hv[l_ce] = l_momentumY[l_i];
     }
-    for (tsunami_lab::t_idx l_i = 0; l_i < 2; l_i++) {
-        l_time[l_i] = tsunami_lab::t_real(l_i);
-    }
-    tsunami_lab::setups::CheckPoint l_setup = tsunami_lab::setups::CheckPoint(l_dimX,
-                                                                              l_dimY,
-                                                                              l_nx,
-                                                                              l_ny,
-                                                                              l_frame,
-                                                                              l_height_ptr,
-                                                                              l_momentumX_ptr,
-                                                                              l_momentumY_ptr,
-                                                                              l_bathymetry_ptr,
-                                                                              l_time);
+    REQUIRE(tsunami_lab::io::BinaryCheckPoint::write("checkpoint_setup_test.bin", l_nx, l_ny, 5, 0, 0, 1, l_h.data(), l_hu.data(), l_hv.data(), l_b.data()) == 0);
+
+    tsunami_lab::io::BinaryCheckPoint *l_checkPoint = new tsunami_lab::io::BinaryCheckPoint();
+    REQUIRE(l_checkPoint->map("checkpoint_setup_test.bin", l_nx, l_ny) == 0);
+    tsunami_lab::setups::CheckPoint l_setup(l_dimX,
+                                            l_dimY,
+                                            l_checkPoint);
+    REQUIRE(l_setup.getCheckPoint() == l_checkPoint);
+
     tsunami_lab::t_real l_momentumYTest = 0.1;
     tsunami_lab::t_real l_momentumXTest = 5;
     tsunami_lab::t_real l_bathymetryTest = 0.5;
@@ -78,4 +61,45 @@ TEST_CASE("Test the two-dimensional checkpoint setup data.", "[Checkpoint]") {
             REQUIRE(l_setup.getBathymetry(l_ceX, l_ceY) == l_bathymetryTest);
         }
     }
-}
\ No newline at end of file
+
+    std::remove("checkpoint_setup_test.bin");
+}
+
+TEST_CASE("Test filling a block of the two-dimensional checkpoint setup at once.", "[Checkpoint]") {
+    /*
+     * Test case:
+     *   A checkpoint of 4 x 3 cells is filled into blocks of the same grid and of a grid with half the cell width
+     *   in x-direction; the rows of the blocks are 9 values apart.
+     *
+     *   Every cell matches the point-wise getters.
+     */
+    std::vector<tsunami_lab::t_real> l_data(6 * 5);
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_data.size(); l_ce++) l_data[l_ce] = l_ce;
+    REQUIRE(tsunami_lab::io::BinaryCheckPoint::write("checkpoint_fill_test.bin", 4, 3, 6, 0, 0, 1, l_data.data(), l_data.data(), l_data.data(), l_data.data()) == 0);
+
+    tsunami_lab::io::BinaryCheckPoint *l_checkPoint = new tsunami_lab::io::BinaryCheckPoint();
+    REQUIRE(l_checkPoint->map("checkpoint_fill_test.bin", 4, 3) == 0);
+    tsunami_lab::setups::CheckPoint l_setup(4, 3, l_checkPoint);
+
+    tsunami_lab::t_real l_dxs[2] = {1, 0.5};
+    tsunami_lab::t_idx l_nxs[2] = {4, 7};
+    for (tsunami_lab::t_idx l_grid = 0; l_grid < 2; l_grid++) {
+        std::vector<tsunami_lab::t_real> l_h(2 * 9), l_hu(2 * 9), l_hv(2 * 9), l_b(2 * 9);
+        l_setup.fill(0, 1, l_dxs[l_grid], 1, l_nxs[l_grid], 2, 9, l_h.data(), l_hu.data(), l_hv.data(), l_b.data());
+
+        for (tsunami_lab::t_idx l_iy = 0; l_iy < 2; l_iy++) {
+            for (tsunami_lab::t_idx l_ix = 0; l_ix < l_nxs[l_grid]; l_ix++) {
+                tsunami_lab::t_idx l_ce = l_iy * 9 + l_ix;
+                tsunami_lab::t_real l_x = l_ix * l_dxs[l_grid];
+                tsunami_lab::t_real l_y = 1 + l_iy;
+
+                REQUIRE(l_h[l_ce] == l_setup.getHeight(l_x, l_y));
+                REQUIRE(l_hu[l_ce] == l_setup.getMomentumX(l_x, l_y));
+                REQUIRE(l_hv[l_ce] == l_setup.getMomentumY(l_x, l_y));
+                REQUIRE(l_b[l_ce] == l_setup.getBathymetry(l_x, l_y));
+            }
+        }
+    }
+
+    std::remove("checkpoint_fill_test.bin");
+}
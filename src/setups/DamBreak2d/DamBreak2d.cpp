@@ -53,3 +53,42 @@ tsunami_lab::t_real tsunami_lab::setups::DamBreak2d::getBathymetry(t_real i_x,
         return -10;
     }
 }
+
+void tsunami_lab::setups::DamBreak2d::fill(t_idx i_ix0,
+                                           t_idx i_iy0,
+                                           t_real i_dx,
+                                           t_real i_dy,
+                                           t_idx i_nx,
+                                           t_idx i_ny,
+                                           t_idx i_stride,
+                                           t_real *o_h,
+                                           t_real *o_hu,
+                                           t_real *o_hv,
+                                           t_real *o_b) const {
+    for (t_idx l_iy = 0; l_iy < i_ny; l_iy++) {
+        t_real l_y = (i_iy0 + l_iy) * i_dy;
+        t_real l_yCenter = l_y - (m_simLenY / 2);
+        bool l_inRangeY = 0.3 * m_simLenY < l_y && 0.4 * m_simLenY > l_y;
+
+        t_real *l_h = o_h + l_iy * i_stride;
+        t_real *l_hu = o_hu + l_iy * i_stride;
+        t_real *l_hv = o_hv + l_iy * i_stride;
+        t_real *l_b = o_b + l_iy * i_stride;
+
+        // same expressions as the point-wise getters
+#pragma omp simd
+        for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+            t_real l_x = (i_ix0 + l_ix) * i_dx;
+            t_real l_xCenter = l_x - (m_simLenX / 2);
+            bool l_inRangeX = 0.3 * m_simLenX < l_x && 0.4 * m_simLenX > l_x;
+
+            t_real l_bCell = (l_inRangeX && l_inRangeY) ? -2 : -10;
+            bool l_inDam = sqrt(pow(l_xCenter, 2) + pow(l_yCenter, 2)) < m_damLimit;
+
+            l_h[l_ix] = (l_inDam ? 10 : 5) + fabs(l_bCell);
+            l_hu[l_ix] = 0;
+            l_hv[l_ix] = 0;
+            l_b[l_ix] = l_bCell;
+        }
+    }
+}
@@ -86,6 +86,33 @@ class tsunami_lab::setups::DamBreak2d : public Setup {
      */
     t_real getBathymetry(t_real,
                          t_real) const;
+
+    /**
+     * Fills a block of cells at once; the rows are set by loops over the columns without calls.
+     *
+     * @param i_ix0 id of the first cell of the block in x-direction.
+     * @param i_iy0 id of the first cell of the block in y-direction.
+     * @param i_dx cell width in x-direction.
+     * @param i_dy cell width in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the rows of the arrays.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     * @param o_hv will be set to the momenta in y-direction.
+     * @param o_b will be set to the bathymetry.
+     **/
+    void fill(t_idx i_ix0,
+              t_idx i_iy0,
+              t_real i_dx,
+              t_real i_dy,
+              t_idx i_nx,
+              t_idx i_ny,
+              t_idx i_stride,
+              t_real *o_h,
+              t_real *o_hu,
+              t_real *o_hv,
+              t_real *o_b) const;
 };
 
 #endif
\ No newline at end of file
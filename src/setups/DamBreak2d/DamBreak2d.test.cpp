@@ -7,6 +7,7 @@
 #include "DamBreak2d.h"
 
 #include <catch2/catch.hpp>
+#include <vector>
 
 TEST_CASE("Test the two-dimensional dam break setup.", "[DamBreak2d]") {
     tsunami_lab::setups::DamBreak2d l_damBreak(10,
@@ -36,4 +37,39 @@ TEST_CASE("Test the two-dimensional dam break setup.", "[DamBreak2d]") {
     REQUIRE(l_damBreak.getMomentumX(-8, -8) == 0);
     REQUIRE(l_damBreak.getMomentumY(-8, -8) == 0);
     REQUIRE(l_damBreak.getBathymetry(-8, -8) == -10);
-}
\ No newline at end of file
+}
+TEST_CASE("Test filling a block of the two-dimensional dam break setup at once.", "[DamBreak2d]") {
+    /*
+     * Test case:
+     *   A block of 30 x 20 cells, which covers the dam and the raised bathymetry, starts at cell (10, 10) of a grid of
+     *   2 x 2 cells; its rows are 32 values apart.
+     *
+     *   Every cell matches the point-wise getters, the remaining values of the rows are untouched.
+     */
+    tsunami_lab::setups::DamBreak2d l_damBreak(10,
+                                               5,
+                                               100,
+                                               100,
+                                               20);
+
+    std::vector<tsunami_lab::t_real> l_h(20 * 32, -1), l_hu(20 * 32, -1), l_hv(20 * 32, -1), l_b(20 * 32, -1);
+    l_damBreak.fill(10, 10, 2, 2, 30, 20, 32, l_h.data(), l_hu.data(), l_hv.data(), l_b.data());
+
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 20; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 32; l_ix++) {
+            tsunami_lab::t_idx l_ce = l_iy * 32 + l_ix;
+            if (l_ix >= 30) {
+                REQUIRE(l_h[l_ce] == -1);
+                REQUIRE(l_b[l_ce] == -1);
+                continue;
+            }
+
+            tsunami_lab::t_real l_x = (10 + l_ix) * tsunami_lab::t_real(2);
+            tsunami_lab::t_real l_y = (10 + l_iy) * tsunami_lab::t_real(2);
+            REQUIRE(l_h[l_ce] == l_damBreak.getHeight(l_x, l_y));
+            REQUIRE(l_hu[l_ce] == 0);
+            REQUIRE(l_hv[l_ce] == 0);
+            REQUIRE(l_b[l_ce] == l_damBreak.getBathymetry(l_x, l_y));
+        }
+    }
+}
@@ -64,6 +64,48 @@ class tsunami_lab::setups::Setup {
     */
     virtual t_real getBathymetry( t_real i_x,
                                   t_real i_y ) const = 0;
+
+    /**
+     * Fills a block of cells at once. Cell (ix, iy) of the block is queried at ((i_ix0 + ix) * i_dx, (i_iy0 + iy) * i_dy)
+     * and stored at iy * i_stride + ix of the arrays. The default queries the point-wise getters; setups override it
+     * with loops free of virtual calls.
+     *
+     * @param i_ix0 id of the first cell of the block in x-direction.
+     * @param i_iy0 id of the first cell of the block in y-direction.
+     * @param i_dx cell width in x-direction.
+     * @param i_dy cell width in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the rows of the arrays.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     * @param o_hv will be set to the momenta in y-direction.
+     * @param o_b will be set to the bathymetry.
+     **/
+    virtual void fill( t_idx    i_ix0,
+                       t_idx    i_iy0,
+                       t_real   i_dx,
+                       t_real   i_dy,
+                       t_idx    i_nx,
+                       t_idx    i_ny,
+                       t_idx    i_stride,
+                       t_real * o_h,
+                       t_real * o_hu,
+                       t_real * o_hv,
+                       t_real * o_b ) const {
+      for( t_idx l_iy = 0; l_iy < i_ny; l_iy++ ) {
+        t_real l_y = (i_iy0 + l_iy) * i_dy;
+        for( t_idx l_ix = 0; l_ix < i_nx; l_ix++ ) {
+          t_real l_x = (i_ix0 + l_ix) * i_dx;
+          t_idx l_ce = l_iy * i_stride + l_ix;
+
+          o_h[l_ce]  = getHeight( l_x, l_y );
+          o_hu[l_ce] = getMomentumX( l_x, l_y );
+          o_hv[l_ce] = getMomentumY( l_x, l_y );
+          o_b[l_ce]  = getBathymetry( l_x, l_y );
+        }
+      }
+    }
       
 };
 
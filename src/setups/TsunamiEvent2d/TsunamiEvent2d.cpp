@@ -10,7 +10,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <vector>
 
 tsunami_lab::setups::TsunamiEvent2d::TsunamiEvent2d(t_real i_simLenX,
                                                     t_real i_simLenY,
@@ -40,6 +42,11 @@ tsunami_lab::setups::TsunamiEvent2d::TsunamiEvent2d(t_real i_simLenX,
     m_displacement = i_displacements;
     m_epicenterOffsetX = i_epicenterOffsetX;
     m_epicenterOffsetY = i_epicenterOffsetY;
+
+    m_bathymetryAxisX = initAxis(m_bathymetryPosX, m_bathymetryDimX);
+    m_bathymetryAxisY = initAxis(m_bathymetryPosY, m_bathymetryDimY);
+    m_displacementsAxisX = initAxis(m_displacementsPosX, m_displacementsDimX);
+    m_displacementsAxisY = initAxis(m_displacementsPosY, m_displacementsDimY);
 }
 
 tsunami_lab::setups::TsunamiEvent2d::~TsunamiEvent2d() {
@@ -51,6 +58,72 @@ tsunami_lab::setups::TsunamiEvent2d::~TsunamiEvent2d() {
     delete[] m_displacement;
 }
 
+tsunami_lab::setups::TsunamiEvent2d::Axis tsunami_lab::setups::TsunamiEvent2d::initAxis(t_real const *i_pos,
+                                                                                       t_idx i_n) {
+    Axis l_axis;
+    l_axis.pos = i_pos;
+    l_axis.n = i_n;
+    if (i_n > 0) {
+        l_axis.min = *std::min_element(i_pos, i_pos + i_n);
+        l_axis.max = *std::max_element(i_pos, i_pos + i_n);
+    }
+    if (i_n < 2) return l_axis;
+
+    t_real l_spacing = (i_pos[i_n - 1] - i_pos[0]) / (i_n - 1);
+    l_axis.sorted = l_spacing != 0;
+    l_axis.uniform = l_axis.sorted;
+    for (t_idx l_i = 1; l_i < i_n && l_axis.sorted; l_i++) {
+        t_real l_step = i_pos[l_i] - i_pos[l_i - 1];
+        l_axis.sorted = (l_spacing > 0) ? l_step > 0 : l_step < 0;
+
+        // the coordinates are stored with single precision, the remaining deviation is corrected by the lookup
+        if (std::fabs(l_step - l_spacing) > t_real(0.01) * std::fabs(l_spacing)) l_axis.uniform = false;
+    }
+    l_axis.uniform = l_axis.uniform && l_axis.sorted;
+    if (l_axis.uniform) l_axis.invSpacing = 1 / l_spacing;
+
+    return l_axis;
+}
+
+tsunami_lab::t_idx tsunami_lab::setups::TsunamiEvent2d::nearest(Axis const &i_axis,
+                                                                t_real i_coord) {
+    t_real const *l_pos = i_axis.pos;
+    t_idx l_n = i_axis.n;
+    if (l_n < 2) return 0;
+
+    t_idx l_idx = 0;
+    if (i_axis.uniform) {
+        t_real l_t = (i_coord - l_pos[0]) * i_axis.invSpacing;
+        if (l_t >= l_n - 1) {
+            l_idx = l_n - 1;
+        } else if (l_t > 0) {
+            l_idx = std::ceil(l_t - t_real(0.5));
+        }
+    } else if (i_axis.sorted) {
+        // first sample at or behind the coordinate in the direction of the axis
+        bool l_ascending = l_pos[l_n - 1] > l_pos[0];
+        t_real const *l_it = l_ascending ? std::lower_bound(l_pos, l_pos + l_n, i_coord)
+                                         : std::lower_bound(l_pos, l_pos + l_n, i_coord, std::greater<t_real>());
+        l_idx = std::min(t_idx(l_it - l_pos), l_n - 1);
+    } else {
+        for (t_idx l_i = 1; l_i < l_n; l_i++) {
+            if (std::fabs(i_coord - l_pos[l_idx]) > std::fabs(i_coord - l_pos[l_i])) l_idx = l_i;
+        }
+        return l_idx;
+    }
+
+    // the estimate is at most a sample off, a tie goes to the lower id
+    while (l_idx > 0 && std::fabs(i_coord - l_pos[l_idx - 1]) <= std::fabs(i_coord - l_pos[l_idx])) l_idx--;
+    while (l_idx + 1 < l_n && std::fabs(i_coord - l_pos[l_idx + 1]) < std::fabs(i_coord - l_pos[l_idx])) l_idx++;
+
+    return l_idx;
+}
+
+bool tsunami_lab::setups::TsunamiEvent2d::covers(Axis const &i_axis,
+                                                 t_real i_coord) {
+    return i_axis.n > 0 && i_coord >= i_axis.min && i_coord <= i_axis.max;
+}
+
 tsunami_lab::t_real tsunami_lab::setups::TsunamiEvent2d::getHeight(t_real i_x,
                                                                    t_real i_y) const {
     t_real l_offsetX = m_epicenterOffsetX;
@@ -59,24 +132,8 @@ tsunami_lab::t_real tsunami_lab::setups::TsunamiEvent2d::getHeight(t_real i_x,
     i_x += l_offsetX;
     i_y += l_offsetY;
 
-    t_idx l_gridIdxX = 0;
-    t_idx l_gridIdxY = 0;
-    t_real l_gridX = m_bathymetryPosX[0];
-    t_real l_gridY = m_bathymetryPosY[0];
-
-    for (t_idx l_i = 1; l_i < m_bathymetryDimX; l_i++) {
-        if (fabs(i_x - l_gridX) > fabs(i_x - m_bathymetryPosX[l_i])) {
-            l_gridX = m_bathymetryPosX[l_i];
-            l_gridIdxX = l_i;
-        }
-    }
-
-    for (t_idx l_i = 1; l_i < m_bathymetryDimY; l_i++) {
-        if (fabs(i_y - l_gridY) > fabs(i_y - m_bathymetryPosY[l_i])) {
-            l_gridY = m_bathymetryPosY[l_i];
-            l_gridIdxY = l_i;
-        }
-    }
+    t_idx l_gridIdxX = nearest(m_bathymetryAxisX, i_x);
+    t_idx l_gridIdxY = nearest(m_bathymetryAxisY, i_y);
 
     t_idx l_mappedGridIdx = l_gridIdxY * m_bathymetryDimX + l_gridIdxX;
     if (m_bathymetry[l_mappedGridIdx] < 0) {
@@ -103,35 +160,65 @@ tsunami_lab::t_real tsunami_lab::setups::TsunamiEvent2d::getBathymetry(t_real i_
     i_x += l_offsetX;
     i_y += l_offsetY;
 
-    t_idx l_gridIdxX = 0;
-    t_idx l_gridIdxY = 0;
-    t_real l_gridX = m_bathymetryPosX[0];
-    t_real l_gridY = m_bathymetryPosY[0];
-
-    for (t_idx l_i = 1; l_i < m_bathymetryDimX; l_i++) {
-        if (fabs(i_x - l_gridX) > fabs(i_x - m_bathymetryPosX[l_i])) {
-            l_gridX = m_bathymetryPosX[l_i];
-            l_gridIdxX = l_i;
-        }
-    }
-
-    for (t_idx l_i = 1; l_i < m_bathymetryDimY; l_i++) {
-        if (fabs(i_y - l_gridY) > fabs(i_y - m_bathymetryPosY[l_i])) {
-            l_gridY = m_bathymetryPosY[l_i];
-            l_gridIdxY = l_i;
-        }
-    }
+    t_idx l_gridIdxX = nearest(m_bathymetryAxisX, i_x);
+    t_idx l_gridIdxY = nearest(m_bathymetryAxisY, i_y);
 
     t_idx l_mappedGridIdx = l_gridIdxY * m_bathymetryDimX + l_gridIdxX;
 
-    t_idx l_mappedDispGridIdx = l_gridIdxY * m_displacementsDimX + l_gridIdxX;
-
-    // get possible displacement
-    t_real l_displacement = m_displacement[l_mappedDispGridIdx];
+    // the displacement vanishes outside of its grid
+    t_real l_displacement = 0;
+    if (covers(m_displacementsAxisX, i_x) && covers(m_displacementsAxisY, i_y)) {
+        l_displacement = m_displacement[nearest(m_displacementsAxisY, i_y) * m_displacementsDimX + nearest(m_displacementsAxisX, i_x)];
+    }
 
     if (m_bathymetry[l_mappedGridIdx] < 0) {
         return std::min(m_bathymetry[l_mappedGridIdx], -m_delta) + l_displacement;
     } else {
         return std::max(m_bathymetry[l_mappedGridIdx], m_delta) + l_displacement;
     }
-}
\ No newline at end of file
+}
+
+void tsunami_lab::setups::TsunamiEvent2d::fill(t_idx i_ix0,
+                                               t_idx i_iy0,
+                                               t_real i_dx,
+                                               t_real i_dy,
+                                               t_idx i_nx,
+                                               t_idx i_ny,
+                                               t_idx i_stride,
+                                               t_real *o_h,
+                                               t_real *o_hu,
+                                               t_real *o_hv,
+                                               t_real *o_b) const {
+    // nearest samples of every column in both grids; columns outside of the displacement grid are not displaced
+    std::vector<t_idx> l_bathymetryIdsX(i_nx);
+    std::vector<t_idx> l_displacementsIdsX(i_nx);
+    std::vector<unsigned char> l_displacedX(i_nx);
+    for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+        t_real l_x = (i_ix0 + l_ix) * i_dx + m_epicenterOffsetX;
+        l_bathymetryIdsX[l_ix] = nearest(m_bathymetryAxisX, l_x);
+        l_displacementsIdsX[l_ix] = nearest(m_displacementsAxisX, l_x);
+        l_displacedX[l_ix] = covers(m_displacementsAxisX, l_x);
+    }
+
+    for (t_idx l_iy = 0; l_iy < i_ny; l_iy++) {
+        t_real l_y = (i_iy0 + l_iy) * i_dy + m_epicenterOffsetY;
+        t_real const *l_bathymetryRow = m_bathymetry + nearest(m_bathymetryAxisY, l_y) * m_bathymetryDimX;
+        t_real const *l_displacementsRow = m_displacement + nearest(m_displacementsAxisY, l_y) * m_displacementsDimX;
+        bool l_displacedY = covers(m_displacementsAxisY, l_y);
+
+        t_real *l_h = o_h + l_iy * i_stride;
+        t_real *l_hu = o_hu + l_iy * i_stride;
+        t_real *l_hv = o_hv + l_iy * i_stride;
+        t_real *l_b = o_b + l_iy * i_stride;
+
+        for (t_idx l_ix = 0; l_ix < i_nx; l_ix++) {
+            t_real l_bIn = l_bathymetryRow[l_bathymetryIdsX[l_ix]];
+            t_real l_displacement = (l_displacedY && l_displacedX[l_ix]) ? l_displacementsRow[l_displacementsIdsX[l_ix]] : 0;
+
+            l_h[l_ix] = (l_bIn < 0) ? std::max(-l_bIn, m_delta) : 0;
+            l_hu[l_ix] = 0;
+            l_hv[l_ix] = 0;
+            l_b[l_ix] = ((l_bIn < 0) ? std::min(l_bIn, -m_delta) : std::max(l_bIn, m_delta)) + l_displacement;
+        }
+    }
+}
@@ -24,6 +24,22 @@ namespace tsunami_lab {
  **/
 class tsunami_lab::setups::TsunamiEvent2d : public Setup {
    private:
+    //! lookup of the nearest sample along one axis of the bathymetry or displacement grid
+    struct Axis {
+        //! coordinates of the samples
+        t_real const *pos = nullptr;
+        //! number of samples
+        t_idx n = 0;
+        //! true if the coordinates are strictly ascending or descending, such that they can be bisected
+        bool sorted = false;
+        //! true if the samples are evenly spaced, such that the nearest one follows from the coordinate directly
+        bool uniform = false;
+        //! inverse of the signed spacing of evenly spaced samples
+        t_real invSpacing = 0;
+        //! smallest and largest coordinate of the samples
+        t_real min = 0, max = 0;
+    };
+
     //! length of the simulation in x-direction.
     t_real m_simLenX = 0;
 
@@ -69,6 +85,43 @@ class tsunami_lab::setups::TsunamiEvent2d : public Setup {
     //! delta
     t_real m_delta = 20;
 
+    //! lookups of the bathymetry grid in x- and y-direction
+    Axis m_bathymetryAxisX, m_bathymetryAxisY;
+
+    //! lookups of the displacement grid in x- and y-direction, which is independent of the bathymetry grid
+    Axis m_displacementsAxisX, m_displacementsAxisY;
+
+    /**
+     * Classifies the samples along one axis once, such that every lookup takes O(1) for evenly spaced samples and
+     * O(log n) for other sorted ones.
+     *
+     * @param i_pos coordinates of the samples.
+     * @param i_n number of samples.
+     * @return lookup of the axis.
+     **/
+    static Axis initAxis(t_real const *i_pos,
+                         t_idx i_n);
+
+    /**
+     * Gets the sample nearest to a coordinate; of two equally near samples, the one with the lower id is taken.
+     *
+     * @param i_axis lookup of the axis.
+     * @param i_coord queried coordinate.
+     * @return id of the nearest sample.
+     **/
+    static t_idx nearest(Axis const &i_axis,
+                         t_real i_coord);
+
+    /**
+     * Checks if a coordinate lies between the first and the last sample of an axis.
+     *
+     * @param i_axis lookup of the axis.
+     * @param i_coord queried coordinate.
+     * @return true if the coordinate is covered by the samples.
+     **/
+    static bool covers(Axis const &i_axis,
+                       t_real i_coord);
+
    public:
     /**
      * Construct.
@@ -144,6 +197,33 @@ class tsunami_lab::setups::TsunamiEvent2d : public Setup {
      **/
     t_real getBathymetry(t_real i_x,
                          t_real i_y) const;
+
+    /**
+     * Fills a block of cells at once; the nearest samples are looked up once per column and row of the block.
+     *
+     * @param i_ix0 id of the first cell of the block in x-direction.
+     * @param i_iy0 id of the first cell of the block in y-direction.
+     * @param i_dx cell width in x-direction.
+     * @param i_dy cell width in y-direction.
+     * @param i_nx number of cells of the block in x-direction.
+     * @param i_ny number of cells of the block in y-direction.
+     * @param i_stride stride of the rows of the arrays.
+     * @param o_h will be set to the water heights.
+     * @param o_hu will be set to the momenta in x-direction.
+     * @param o_hv will be set to the momenta in y-direction.
+     * @param o_b will be set to the bathymetry.
+     **/
+    void fill(t_idx i_ix0,
+              t_idx i_iy0,
+              t_real i_dx,
+              t_real i_dy,
+              t_idx i_nx,
+              t_idx i_ny,
+              t_idx i_stride,
+              t_real *o_h,
+              t_real *o_hu,
+              t_real *o_hv,
+              t_real *o_b) const;
 };
 
 #endif
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include <catch2/catch.hpp>
 #include <iostream>
+#include <vector>
 
 TEST_CASE("Test the two-dimensional tsunami setup data.", "[TsunamiSetup2d]") {
     tsunami_lab::t_real l_simLenX = 3.5;
@@ -91,4 +92,110 @@ TEST_CASE("Test the two-dimensional tsunami setup data.", "[TsunamiSetup2d]") {
     REQUIRE(l_setup.getBathymetry(4.0, 4.0) == Approx(50));
     REQUIRE(l_setup.getBathymetry(2.0, 2.0) == Approx(-3134.43481));
     REQUIRE(l_setup.getBathymetry(1.4, 1.4) == Approx(-6959.52197));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test the lookup of evenly spaced and independent grids of the two-dimensional tsunami setup.", "[TsunamiSetup2d]") {
+    /*
+     * Test case:
+     *   The bathymetry is given on an evenly spaced grid of 5 x 3 samples with descending y-coordinates, the
+     *   displacements on a coarser grid of 2 x 2 samples which covers only the center of the bathymetry.
+     *
+     *   Every lookup takes the nearest sample of its own grid and ties go to the lower id. Coordinates outside of the
+     *   bathymetry grid take its nearest border sample, coordinates outside of [15, 25] x [5, 15] are not displaced.
+     */
+    tsunami_lab::t_real *l_bathymetryPosX = new tsunami_lab::t_real[5]{0, 10, 20, 30, 40};
+    tsunami_lab::t_real *l_bathymetryPosY = new tsunami_lab::t_real[3]{20, 10, 0};
+    tsunami_lab::t_real *l_bathymetry = new tsunami_lab::t_real[15];
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 3; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 5; l_ix++) {
+            l_bathymetry[l_iy * 5 + l_ix] = -tsunami_lab::t_real(100 + 10 * l_iy + l_ix);
+        }
+    }
+    tsunami_lab::t_real *l_displacementsPosX = new tsunami_lab::t_real[2]{15, 25};
+    tsunami_lab::t_real *l_displacementsPosY = new tsunami_lab::t_real[2]{5, 15};
+    tsunami_lab::t_real *l_displacements = new tsunami_lab::t_real[4]{1, 2, 3, 4};
+
+    tsunami_lab::setups::TsunamiEvent2d l_setup(40,
+                                                20,
+                                                5,
+                                                3,
+                                                l_bathymetryPosX,
+                                                l_bathymetryPosY,
+                                                l_bathymetry,
+                                                2,
+                                                2,
+                                                l_displacementsPosX,
+                                                l_displacementsPosY,
+                                                l_displacements,
+                                                0,
+                                                0);
+
+    // outside of the displacements
+    REQUIRE(l_setup.getHeight(10, 10) == Approx(111));
+    REQUIRE(l_setup.getBathymetry(10, 10) == Approx(-111));
+    REQUIRE(l_setup.getBathymetry(24, 0) == Approx(-122));
+
+    // the displacement ids differ from the bathymetry ids
+    REQUIRE(l_setup.getHeight(24, 6) == Approx(112));
+    REQUIRE(l_setup.getBathymetry(24, 6) == Approx(-110));
+
+    // ties between two samples
+    REQUIRE(l_setup.getHeight(15, 15) == Approx(101));
+    REQUIRE(l_setup.getBathymetry(15, 15) == Approx(-98));
+    REQUIRE(l_setup.getBathymetry(20, 10) == Approx(-111));
+
+    // outside of both grids
+    REQUIRE(l_setup.getHeight(-7, 33) == Approx(100));
+    REQUIRE(l_setup.getBathymetry(-7, 33) == Approx(-100));
+    REQUIRE(l_setup.getBathymetry(55, -5) == Approx(-124));
+}
+
+TEST_CASE("Test filling a block of the two-dimensional tsunami setup at once.", "[TsunamiSetup2d]") {
+    /*
+     * Test case:
+     *   The grids of the previous test case with dry and wet samples are filled into a block of 12 x 6 cells of 5 m.
+     *   The epicenter offset of -5 m moves the block beyond both grids.
+     *
+     *   Every cell matches the point-wise getters.
+     */
+    tsunami_lab::t_real *l_bathymetryPosX = new tsunami_lab::t_real[5]{0, 10, 20, 30, 40};
+    tsunami_lab::t_real *l_bathymetryPosY = new tsunami_lab::t_real[3]{20, 10, 0};
+    tsunami_lab::t_real *l_bathymetry = new tsunami_lab::t_real[15];
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < 15; l_ce++) {
+        l_bathymetry[l_ce] = (l_ce % 4 == 0) ? tsunami_lab::t_real(l_ce) : -tsunami_lab::t_real(100 + l_ce);
+    }
+    tsunami_lab::t_real *l_displacementsPosX = new tsunami_lab::t_real[2]{15, 25};
+    tsunami_lab::t_real *l_displacementsPosY = new tsunami_lab::t_real[2]{5, 15};
+    tsunami_lab::t_real *l_displacements = new tsunami_lab::t_real[4]{1, 2, 3, 4};
+
+    tsunami_lab::setups::TsunamiEvent2d l_setup(40,
+                                                20,
+                                                5,
+                                                3,
+                                                l_bathymetryPosX,
+                                                l_bathymetryPosY,
+                                                l_bathymetry,
+                                                2,
+                                                2,
+                                                l_displacementsPosX,
+                                                l_displacementsPosY,
+                                                l_displacements,
+                                                -5,
+                                                -5);
+
+    std::vector<tsunami_lab::t_real> l_h(6 * 12), l_hu(6 * 12), l_hv(6 * 12), l_b(6 * 12);
+    l_setup.fill(0, 0, 5, 5, 12, 6, 12, l_h.data(), l_hu.data(), l_hv.data(), l_b.data());
+
+    for (tsunami_lab::t_idx l_iy = 0; l_iy < 6; l_iy++) {
+        for (tsunami_lab::t_idx l_ix = 0; l_ix < 12; l_ix++) {
+            tsunami_lab::t_idx l_ce = l_iy * 12 + l_ix;
+            tsunami_lab::t_real l_x = l_ix * tsunami_lab::t_real(5);
+            tsunami_lab::t_real l_y = l_iy * tsunami_lab::t_real(5);
+
+            REQUIRE(l_h[l_ce] == l_setup.getHeight(l_x, l_y));
+            REQUIRE(l_hu[l_ce] == 0);
+            REQUIRE(l_hv[l_ce] == 0);
+            REQUIRE(l_b[l_ce] == l_setup.getBathymetry(l_x, l_y));
+        }
+    }
+}
@@ -9,21 +9,163 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <vector>
 
+#include "../io/AsyncWriter/AsyncWriter.h"
 #include "../io/Csv/Csv.h"
 #include "../io/NetCDF/NetCDF.h"
+#include "../io/SnapshotWriter/SnapshotWriter.h"
+#include "../io/Trace/Trace.h"
+#include "../kernels/Kernels.h"
 #include "../patches/1d/WavePropagation1d.h"
 #include "../patches/2d/WavePropagation2d.h"
-#include "../setups/CheckPoint/CheckPoint.h"
+#include "../patches/amr/WavePropagationAmr.h"
 #include "../timer.h"
 
-template <typename Base, typename T>
-inline bool instanceof (const T *ptr) {
-    return dynamic_cast<const Base *>(ptr) != nullptr;
+constexpr tsunami_lab::t_real tsunami_lab::simulator::c_frameTolerance;
+
+tsunami_lab::t_real tsunami_lab::simulator::getTimeStep(t_real i_waveSpeedMax,
+                                                        t_real i_dxy,
+                                                        t_real i_cflNumber,
+                                                        t_real i_dtMax) {
+    // a resting or dry domain does not limit the time step; the previous one might have been shortened by a frame
+    if (!(i_waveSpeedMax > 0)) return i_dtMax;
+
+    return i_cflNumber * i_dxy / i_waveSpeedMax;
+}
+
+void tsunami_lab::simulator::initPatch(tsunami_lab::setups::Setup *i_setup,
+                                       tsunami_lab::patches::WavePropagation *io_waveProp,
+                                       tsunami_lab::t_idx i_nx,
+                                       tsunami_lab::t_idx i_ny,
+                                       tsunami_lab::t_idx i_ix0,
+                                       tsunami_lab::t_idx i_iy0,
+                                       tsunami_lab::t_real i_dx,
+                                       tsunami_lab::t_real i_dy,
+                                       tsunami_lab::t_real &o_hMax,
+                                       tsunami_lab::t_real &o_speedMax) {
+    tsunami_lab::t_real l_hMax = std::numeric_limits<tsunami_lab::t_real>::lowest();
+    tsunami_lab::t_real l_speedMax = 0;
+
+    // speed of the fastest gravity wave relative to the flow
+    auto l_waveSpeed = [](tsunami_lab::t_real i_h,
+                          tsunami_lab::t_real i_hu,
+                          tsunami_lab::t_real i_hv) {
+        return std::max(std::fabs(i_hu), std::fabs(i_hv)) / i_h + std::sqrt(tsunami_lab::t_real(9.80665) * i_h);
+    };
+
+    tsunami_lab::t_real *l_h, *l_hu, *l_hv, *l_b;
+    if (io_waveProp->getStateViews(&l_h, &l_hu, &l_hv, &l_b)) {
+        tsunami_lab::t_idx l_stride = io_waveProp->getStride();
+
+        // every thread fills a contiguous block of rows with a single call of the setup
+#pragma omp parallel reduction(max : l_hMax, l_speedMax)
+        {
+            tsunami_lab::t_idx l_nThreads = omp_get_num_threads();
+            tsunami_lab::t_idx l_thread = omp_get_thread_num();
+            tsunami_lab::t_idx l_first = i_ny * l_thread / l_nThreads;
+            tsunami_lab::t_idx l_end = i_ny * (l_thread + 1) / l_nThreads;
+
+            if (l_first < l_end) {
+                tsunami_lab::t_idx l_offset = l_first * l_stride;
+                i_setup->fill(i_ix0,
+                              i_iy0 + l_first,
+                              i_dx,
+                              i_dy,
+                              i_nx,
+                              l_end - l_first,
+                              l_stride,
+                              l_h + l_offset,
+                              l_hu + l_offset,
+                              l_hv + l_offset,
+                              l_b + l_offset);
+            }
+
+            for (tsunami_lab::t_idx l_cy = l_first; l_cy < l_end; l_cy++) {
+                for (tsunami_lab::t_idx l_cx = 0; l_cx < i_nx; l_cx++) {
+                    tsunami_lab::t_idx l_ce = l_cy * l_stride + l_cx;
+                    l_hMax = l_hMax < l_h[l_ce] ? l_h[l_ce] : l_hMax;
+                    if (l_h[l_ce] > 0) {
+                        tsunami_lab::t_real l_speed = l_waveSpeed(l_h[l_ce], l_hu[l_ce], l_hv[l_ce]);
+                        l_speedMax = l_speedMax < l_speed ? l_speed : l_speedMax;
+                    }
+                }
+            }
+        }
+    } else {
+#pragma omp parallel for collapse(2) schedule(static, 8) reduction(max : l_hMax, l_speedMax)
+        for (tsunami_lab::t_idx l_cy = 0; l_cy < i_ny; l_cy++) {
+            for (tsunami_lab::t_idx l_cx = 0; l_cx < i_nx; l_cx++) {
+                tsunami_lab::t_real l_y = (i_iy0 + l_cy) * i_dy;
+                tsunami_lab::t_real l_x = (i_ix0 + l_cx) * i_dx;
+
+                // get initial values of the setup
+                tsunami_lab::t_real l_hCell = i_setup->getHeight(l_x, l_y);
+                tsunami_lab::t_real l_huCell = i_setup->getMomentumX(l_x, l_y);
+                tsunami_lab::t_real l_hvCell = i_setup->getMomentumY(l_x, l_y);
+                tsunami_lab::t_real l_bCell = i_setup->getBathymetry(l_x, l_y);
+
+                l_hMax = l_hMax < l_hCell ? l_hCell : l_hMax;
+                if (l_hCell > 0) {
+                    tsunami_lab::t_real l_speed = l_waveSpeed(l_hCell, l_huCell, l_hvCell);
+                    l_speedMax = l_speedMax < l_speed ? l_speed : l_speedMax;
+                }
+
+                // set initial values in wave propagation solver
+                io_waveProp->setHeight(l_cx, l_cy, l_hCell);
+                io_waveProp->setMomentumX(l_cx, l_cy, l_huCell);
+                io_waveProp->setMomentumY(l_cx, l_cy, l_hvCell);
+                io_waveProp->setBathymetry(l_cx, l_cy, l_bCell);
+            }
+        }
+    }
+
+    o_hMax = l_hMax;
+    o_speedMax = l_speedMax;
+}
+
+std::string tsunami_lab::simulator::pinThreads(tsunami_lab::parallel::e_affinity i_affinity,
+                                               tsunami_lab::t_idx i_partition,
+                                               tsunami_lab::t_idx i_nPartitions) {
+    if (tsunami_lab::parallel::Affinity::isSetByEnvironment()) return "OMP_PROC_BIND / OMP_PLACES";
+
+    tsunami_lab::t_idx l_nPinned = tsunami_lab::parallel::Affinity::pinThreads(i_affinity, i_partition, i_nPartitions);
+    std::string l_description = tsunami_lab::parallel::Affinity::getName(i_affinity);
+    if (i_affinity != tsunami_lab::parallel::AFFINITY_NONE) {
+        tsunami_lab::t_idx l_first = 0;
+        tsunami_lab::t_idx l_nCores = 0;
+        tsunami_lab::parallel::Affinity::getPartition(i_partition,
+                                                      i_nPartitions,
+                                                      tsunami_lab::parallel::Affinity::getCores().size(),
+                                                      l_first,
+                                                      l_nCores);
+        l_description += " (" + std::to_string(l_nPinned) + " threads on " + std::to_string(l_nCores) + " cores";
+        if (i_nPartitions > 1) {
+            l_description += ", partition " + std::to_string(i_partition) + " of " + std::to_string(i_nPartitions);
+        }
+        l_description += ")";
+    }
+
+    return l_description;
+}
+
+std::string tsunami_lab::simulator::describePages(tsunami_lab::patches::WavePropagation2d *i_waveProp) {
+    std::vector<tsunami_lab::t_idx> l_pages;
+    if (!i_waveProp->countPagesPerNode(l_pages)) return "unknown";
+
+    std::string l_description;
+    for (tsunami_lab::t_idx l_no = 0; l_no < l_pages.size(); l_no++) {
+        if (l_pages[l_no] == 0) continue;
+        if (!l_description.empty()) l_description += ", ";
+        l_description += std::to_string(l_no) + ": " + std::to_string(l_pages[l_no]);
+    }
+
+    return l_description;
 }
 
 void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
@@ -39,71 +181,65 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
     tsunami_lab::t_real l_dx = i_simConfig.getXLength() / l_nx;
     tsunami_lab::t_real l_dy = i_simConfig.getYLength() / l_ny;
 
+    std::string l_affinity = pinThreads(i_simConfig.getThreadAffinity());
+
     // construct solver
     if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
     tsunami_lab::patches::WavePropagation *l_waveProp;
+    tsunami_lab::patches::WavePropagation2d *l_waveProp2d = nullptr;
+    tsunami_lab::patches::WavePropagationAmr *l_wavePropAmr = nullptr;
+    tsunami_lab::configs::AmrConfig l_amrConfig = i_simConfig.getAmrConfig();
+    tsunami_lab::e_solver l_solver = i_simConfig.isRoeSolver() ? tsunami_lab::ROE : tsunami_lab::FWAVE;
 
     if (i_simConfig.getDimension() == 1) {
-        l_waveProp = new tsunami_lab::patches::WavePropagation1d(l_nx, i_simConfig.isRoeSolver());
+        l_waveProp = new tsunami_lab::patches::WavePropagation1d(l_nx, l_solver);
+    } else if (l_amrConfig.useRefinement()) {
+        if (l_solver != tsunami_lab::FWAVE) {
+            std::cerr << "adaptive mesh refinement supports the F-wave solver only, using it instead" << std::endl;
+            l_solver = tsunami_lab::FWAVE;
+        }
+        l_wavePropAmr = new tsunami_lab::patches::WavePropagationAmr(l_nx,
+                                                                     l_ny,
+                                                                     l_dx,
+                                                                     l_dy,
+                                                                     l_amrConfig.getRatio(),
+                                                                     l_amrConfig.getBlockSize(),
+                                                                     l_amrConfig.getDepthThreshold(),
+                                                                     l_amrConfig.getGradientThreshold(),
+                                                                     l_amrConfig.getRegridInterval());
+        l_wavePropAmr->setSetup(i_setup);
+        l_waveProp = l_wavePropAmr;
     } else {
-        l_waveProp = new tsunami_lab::patches::WavePropagation2d(l_nx, l_ny);
+        l_waveProp2d = new tsunami_lab::patches::WavePropagation2d(l_nx,
+                                                                   l_ny,
+                                                                   i_simConfig.getTileRows(),
+                                                                   i_simConfig.useActiveTiles(),
+                                                                   l_solver);
+        l_waveProp = l_waveProp2d;
     }
     if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Create WaveProp Object");
 
-    // maximum observed height in the setup
-    tsunami_lab::t_real l_hMax = std::numeric_limits<tsunami_lab::t_real>::lowest();
-
-    // set up solver
-#pragma omp parallel for collapse(2) schedule(static, 8) reduction(max : l_hMax)
-    for (tsunami_lab::t_idx l_cy = 0; l_cy < l_ny; l_cy++) {
-        for (tsunami_lab::t_idx l_cx = 0; l_cx < l_nx; l_cx++) {
-            tsunami_lab::t_real l_y = l_cy * l_dy;
-            tsunami_lab::t_real l_x = l_cx * l_dx;
-
-            // get initial values of the setup
-            tsunami_lab::t_real l_h = i_setup->getHeight(l_x,
-                                                         l_y);
-
-            l_hMax = l_hMax < l_h ? l_h : l_hMax;
-
-            tsunami_lab::t_real l_hu = i_setup->getMomentumX(l_x,
-                                                             l_y);
-            tsunami_lab::t_real l_hv = i_setup->getMomentumY(l_x,
-                                                             l_y);
-            tsunami_lab::t_real l_b = i_setup->getBathymetry(l_x,
-                                                             l_y);
-
-            // set initial values in wave propagation solver
-            l_waveProp->setHeight(l_cx,
-                                  l_cy,
-                                  l_h);
-
-            l_waveProp->setMomentumX(l_cx,
-                                     l_cy,
-                                     l_hu);
-
-            l_waveProp->setMomentumY(l_cx,
-                                     l_cy,
-                                     l_hv);
-
-            l_waveProp->setBathymetry(l_cx,
-                                      l_cy,
-                                      l_b);
-        }
-    }
+    // set up solver and get the maximum observed height and wave speed in the setup
+    tsunami_lab::t_real l_hMax = 0;
+    tsunami_lab::t_real l_speedMax = 0;
+    initPatch(i_setup, l_waveProp, l_nx, l_ny, 0, 0, l_dx, l_dy, l_hMax, l_speedMax);
     if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Caculate hMax and Init WaveProp");
 
-    // derive maximum wave speed in setup; the momentum is ignored
-    tsunami_lab::t_real l_speedMax = std::sqrt(9.81 * l_hMax);
-
     // check if delta x is smaller than delta y
     bool l_isXStepSmaller = (l_dx <= l_dy);
 
     // choose l_dxy as l_dx if it is smaller or l_dy if it is smaller
     tsunami_lab::t_real l_dxy = l_dx * l_isXStepSmaller + l_dy * !l_isXStepSmaller;
 
-    // derive constant time step; changes at simulation time are ignored
-    tsunami_lab::t_real l_dt = 0.5 * l_dxy / l_speedMax;
+    // derive the initial time step; afterwards every time step is derived from the wave speeds of the previous one
+    // and refined blocks are solved with the time step of the fine cells
+    if (l_wavePropAmr != nullptr) l_speedMax *= l_amrConfig.getRatio();
+    tsunami_lab::t_real l_cflNumber = i_simConfig.getCflNumber();
+    tsunami_lab::t_real l_dt = getTimeStep(l_speedMax, l_dxy, l_cflNumber, i_simConfig.getEndSimTime());
+
+    // output frames are placed by simulation time
+    tsunami_lab::t_real l_frameTime = i_simConfig.getFrameTime();
+    if (l_frameTime <= 0) l_frameTime = 25 * l_dt;
 
     std::cout << l_hMax << " | " << l_speedMax << std::endl;
 
@@ -112,13 +248,24 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
     std::cout << "  number of cells in x-direction: " << l_nx << std::endl;
     std::cout << "  number of cells in y-direction: " << l_ny << std::endl;
     std::cout << "  cell size:                      " << l_dxy << std::endl;
-    std::cout << "  time step:                      " << l_dt << std::endl;
+    std::cout << "  CFL number:                     " << l_cflNumber << std::endl;
+    std::cout << "  initial time step:              " << l_dt << std::endl;
+    std::cout << "  time between frames:            " << l_frameTime << std::endl;
+    std::cout << "  Riemann solver:                 " << (l_solver == tsunami_lab::ROE ? "Roe" : "F-Wave") << std::endl;
+    std::cout << "  kernel ISA:                     " << tsunami_lab::kernels::getIsaName(tsunami_lab::kernels::getActiveIsa()) << std::endl;
+    std::cout << "  thread affinity:                " << l_affinity << std::endl;
+    if (l_waveProp2d != nullptr) {
+        std::cout << "  pages per NUMA node:            " << describePages(l_waveProp2d) << std::endl;
+        std::cout << "  rows per band (0: full grid):   " << l_waveProp2d->getTileRows() << std::endl;
+        std::cout << "  modeled bytes per cell update:  " << l_waveProp2d->getBytesPerCellUpdate() << " (lower bound)" << std::endl;
+        std::cout << "  skip still or dry tiles:        " << (i_simConfig.useActiveTiles() && l_solver == tsunami_lab::FWAVE) << std::endl;
+    }
+    if (l_wavePropAmr != nullptr) {
+        std::cout << "  refinement ratio:               " << l_amrConfig.getRatio() << std::endl;
+        std::cout << "  coarse cells per block:         " << l_amrConfig.getBlockSize() << std::endl;
+    }
     std::cout << std::endl;
 
-    // derive scaling for a time step
-    tsunami_lab::t_real l_scalingX = l_dt / l_dx;
-    tsunami_lab::t_real l_scalingY = l_dt / l_dy;
-
     // set up time and print control
     tsunami_lab::t_idx l_frame = 0;
     tsunami_lab::t_real l_endTime = i_simConfig.getEndSimTime();
@@ -132,7 +279,7 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
             tsunami_lab::t_idx l_timeStep = 0;
             // iterate over time
             while (l_simTime < l_endTime) {
-                if (l_timeStep % 25 == 0) {
+                if (l_simTime >= l_frame * l_frameTime - l_frameTime * c_frameTolerance) {
                     std::cout << "  simulation time / #time steps: "
                               << l_simTime << " / " << l_timeStep << std::endl;
 
@@ -155,11 +302,15 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
                     l_frame++;
                 }
 
+                // do not step over the next frame
+                l_dt = std::min(l_dt, l_frame * l_frameTime - l_simTime);
+
                 l_waveProp->setGhostCells(i_simConfig.getBoundaryCondition());
-                l_waveProp->timeStep(l_scalingX, 0);
+                l_waveProp->timeStep(l_dt / l_dx, 0);
 
                 l_timeStep++;
                 l_simTime += l_dt;
+                l_dt = getTimeStep(l_waveProp->getMaxWaveSpeed(), l_dxy, l_cflNumber, l_endTime);
             }
         } else {
             tsunami_lab::t_idx l_number_of_time_steps = 100;
@@ -167,7 +318,7 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
             for (tsunami_lab::t_idx l_timeStep = 0; l_timeStep < l_number_of_time_steps; l_timeStep++) {
                 e_boundary l_boundary[4] = {OUTFLOW, OUTFLOW, OUTFLOW, OUTFLOW};
                 l_waveProp->setGhostCells(l_boundary);
-                l_waveProp->timeStep(l_scalingX, 0);
+                l_waveProp->timeStep(l_dt / l_dx, 0);
 
                 tsunami_lab::t_real l_middle_state = l_waveProp->getHeight()[tsunami_lab::t_idx(5.0)];
                 if (abs(l_middle_state - i_hStar) < 4.20) {
@@ -182,33 +333,52 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
         }
     } else {
         std::string l_path = "./out/" + i_simConfig.getConfigName() + ".nc";
-        std::cout << "  writing wave field to " << l_path << std::endl;
-        t_idx l_timestepsPerFrame = 25;
-        t_idx l_timeStep = l_timestepsPerFrame * l_frame;
-        std::cout << l_timeStep << " > " << l_frame << std::endl;
-        if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
-        io::NetCDF *l_writer = new tsunami_lab::io::NetCDF(l_endTime,
-                                                           l_dt,
-                                                           l_timestepsPerFrame,
-                                                           l_dxy,
-                                                           l_nx,
-                                                           l_ny,
-                                                           l_waveProp->getStride(),
-                                                           i_simConfig.getCoarseFactor(),
-                                                           l_waveProp->getBathymetry(),
-                                                           l_path);
-        if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Create Writer Object");
-
-        if (i_simConfig.getFlagConfig().useCheckPoint() && instanceof <tsunami_lab::setups::CheckPoint>(i_setup)) {
-            tsunami_lab::setups::CheckPoint *l_checkpoint = (tsunami_lab::setups::CheckPoint *)i_setup;
-            for (t_idx l_i = 0; l_i < l_frame; l_i++) {
-                l_writer->store(l_checkpoint->getSimTimeData(l_i),
-                                l_i,
-                                l_checkpoint->getHeightData(l_i),
-                                l_checkpoint->getMomentumXData(l_i),
-                                l_checkpoint->getMomentumYData(l_i));
-            }
-            if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Load Checkpoint");
+        t_idx l_timeStep = 0;
+
+        // the writer appends every frame to the output file; a restarted run continues the file of the earlier one
+        io::NetCDF *l_writer = nullptr;
+        if (i_simConfig.getFlagConfig().useIO() || i_simConfig.getFlagConfig().useCheckPoint()) {
+            std::cout << "  writing wave field to " << l_path << std::endl;
+            if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
+            l_writer = new tsunami_lab::io::NetCDF(l_dxy,
+                                                   l_nx,
+                                                   l_ny,
+                                                   l_waveProp->getStride(),
+                                                   i_simConfig.getCoarseFactor(),
+                                                   l_waveProp->getBathymetry(),
+                                                   l_path,
+                                                   l_simTime,
+                                                   i_simConfig.getOutputConfig());
+            if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Create Writer Object");
+        }
+
+        // the output thread coarsens and writes the frames while the time loop continues
+        tsunami_lab::configs::OutputConfig l_outputConfig = i_simConfig.getOutputConfig();
+        tsunami_lab::io::AsyncWriter *l_output = nullptr;
+        if (l_writer != nullptr) {
+            l_output = new tsunami_lab::io::AsyncWriter(l_writer,
+                                                        l_nx,
+                                                        l_ny,
+                                                        l_waveProp->getStride(),
+                                                        l_waveProp->getBathymetry(),
+                                                        l_outputConfig.getBufferCount(),
+                                                        l_outputConfig.dropFrames());
+        }
+
+        // forked processes write the checkpoints from a copy-on-write snapshot of the patch
+        tsunami_lab::io::SnapshotWriter *l_snapshots = nullptr;
+        if (i_simConfig.getFlagConfig().useCheckPoint() && l_outputConfig.getSnapshotWriters() > 0) {
+            l_snapshots = new tsunami_lab::io::SnapshotWriter(l_nx,
+                                                              l_ny,
+                                                              l_waveProp->getStride(),
+                                                              l_outputConfig.getSnapshotWriters());
+        }
+
+        // timeline of the overlapped time steps
+        tsunami_lab::io::Trace *l_trace = nullptr;
+        if (i_simConfig.getFlagConfig().useTrace() && l_waveProp2d != nullptr) {
+            l_trace = new tsunami_lab::io::Trace(omp_get_max_threads());
+            l_waveProp2d->setTrace(l_trace);
         }
 
         // iterate over time
@@ -217,12 +387,21 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
         t_idx l_checkPoints = l_simTime / l_checkPointTime;
         if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
         while (l_simTime < l_endTime) {
-            if (l_timeStep % 25 == 0) {
+            if (l_simTime >= l_frame * l_frameTime - l_frameTime * c_frameTolerance) {
                 std::cout << "  simulation time / #time steps / #step: "
                           << l_simTime << " / " << l_timeStep << " / " << l_frame << std::endl;
+                if (l_wavePropAmr != nullptr) {
+                    std::cout << "  refined blocks / blocks / solved cells: "
+                              << l_wavePropAmr->getRefinedBlocks() << " / " << l_wavePropAmr->getNumberOfBlocks() << " / "
+                              << l_wavePropAmr->getNumberOfCells() << std::endl;
+                }
+                if (i_simConfig.useActiveTiles()) {
+                    std::cout << "  active tiles in the last time step: "
+                              << l_waveProp2d->getActiveTiles() << " / " << l_waveProp2d->getNumberOfTiles() << std::endl;
+                }
 
                 if (i_simConfig.getFlagConfig().useIO()) {
-                    l_writer->store(l_simTime,
+                    l_output->store(l_simTime,
                                     l_frame,
                                     l_waveProp->getHeight(),
                                     l_waveProp->getMomentumX(),
@@ -230,23 +409,81 @@ void tsunami_lab::simulator::runSimulation(tsunami_lab::setups::Setup *i_setup,
                 }
 
                 if (i_simConfig.getFlagConfig().useCheckPoint() && l_simTime > l_checkPointTime * l_checkPoints) {
-                    std::string l_checkpointPath = "./out/" + i_simConfig.getConfigName() + "_checkpoint.nc";
-                    l_writer->write(l_frame, l_checkpointPath, l_simTime, l_endTime);
+                    std::string l_checkpointPath = "./out/" + i_simConfig.getConfigName() + "_checkpoint.bin";
+                    if (l_snapshots != nullptr) {
+                        l_snapshots->checkPoint(l_checkpointPath,
+                                                l_frame + 1,
+                                                l_simTime,
+                                                l_endTime,
+                                                l_waveProp->getHeight(),
+                                                l_waveProp->getMomentumX(),
+                                                l_waveProp->getMomentumY(),
+                                                l_waveProp->getBathymetry());
+                    } else {
+                        l_output->checkPoint(l_frame + 1,
+                                             l_checkpointPath,
+                                             l_simTime,
+                                             l_endTime,
+                                             l_waveProp->getHeight(),
+                                             l_waveProp->getMomentumX(),
+                                             l_waveProp->getMomentumY());
+                    }
                     l_checkPoints++;
                 }
                 l_frame++;
             }
-            l_waveProp->setGhostCells(i_simConfig.getBoundaryCondition());
-            l_waveProp->timeStep(l_scalingX, l_scalingY);
+            // do not step over the next frame
+            l_dt = std::min(l_dt, l_frame * l_frameTime - l_simTime);
+
+            if (l_waveProp2d != nullptr) {
+                // the ghost cells are filled while the inner edges are solved
+                l_waveProp2d->timeStepOverlapped(l_dt / l_dx,
+                                                 l_dt / l_dy,
+                                                 [&]() { l_waveProp2d->setGhostCells(i_simConfig.getBoundaryCondition()); });
+            } else {
+                l_waveProp->setGhostCells(i_simConfig.getBoundaryCondition());
+                l_waveProp->timeStep(l_dt / l_dx, l_dt / l_dy);
+            }
 
             l_timeStep++;
             l_simTime += l_dt;
+            l_dt = getTimeStep(l_waveProp->getMaxWaveSpeed(), l_dxy, l_cflNumber, l_endTime);
         }
         if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Simulation");
         if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
-        if (i_simConfig.getFlagConfig().useIO())
+        if (l_snapshots != nullptr) {
+            if (l_snapshots->finish() != 0) std::cerr << "writing a checkpoint failed" << std::endl;
+            std::cout << "  checkpoint snapshots:           " << l_snapshots->getNumberOfSnapshots() << std::endl;
+            std::cout << "  time loop forking snapshots:    " << l_snapshots->getStallTime() << "s" << std::endl;
+            delete l_snapshots;
+        }
+        if (l_output != nullptr) {
+            if (l_output->finish() != 0) std::cerr << "writing the output failed" << std::endl;
+            std::cout << "  frames written / dropped:       " << l_output->getNumberOfStoredFrames() << " / "
+                      << l_output->getNumberOfDroppedFrames() << std::endl;
+            std::cout << "  time loop waiting on output:    " << l_output->getStallTime() << "s" << std::endl;
+            std::cout << "  time loop copying frames:       " << l_output->getCopyTime() << "s" << std::endl;
+            std::cout << "  output thread writing:          " << l_output->getWriteTime() << "s" << std::endl;
+            delete l_output;
             l_writer->write();
-        if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Write NC File");
+            if (l_writer->getFramesWritten() > 0 && l_writer->getFileSize() > 0) {
+                double l_rawMb = l_writer->getRawBytes() / 1e6;
+                double l_fileMb = l_writer->getFileSize() / 1e6;
+                std::cout << "  output file size / raw:         " << l_fileMb << "MB / " << l_rawMb << "MB" << std::endl;
+                std::cout << "  compression ratio:              " << l_rawMb / l_fileMb << std::endl;
+                std::cout << "  write throughput:               " << l_rawMb / l_writer->getWriteTime() << "MB/s" << std::endl;
+                std::cout << "  time per frame / slowest frame: " << l_writer->getWriteTime() / l_writer->getFramesWritten()
+                          << "s / " << l_writer->getMaxFrameWriteTime() << "s" << std::endl;
+            }
+        }
+        if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Close NC File");
+        if (l_trace != nullptr) {
+            std::string l_tracePath = "./out/" + i_simConfig.getConfigName() + "_trace.json";
+            std::cout << "  writing timeline to " << l_tracePath << std::endl;
+            std::ofstream l_traceFile(l_tracePath);
+            l_trace->write(l_traceFile);
+            delete l_trace;
+        }
         // free memory
         std::cout << "finished time loop" << std::endl;
         std::cout << "freeing memory" << std::endl;
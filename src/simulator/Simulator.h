@@ -12,6 +12,9 @@
 
 #include "../configs/SimConfig.h"
 #include "../constants.h"
+#include "../parallel/Affinity.h"
+#include "../patches/2d/WavePropagation2d.h"
+#include "../patches/WavePropagation.h"
 #include "../setups/Setup.h"
 
 namespace tsunami_lab {
@@ -20,9 +23,85 @@ namespace tsunami_lab {
 
 class tsunami_lab::simulator {
    public:
+    //! relative tolerance of the simulation time, at which a frame is written early instead of taking a tiny extra step
+    static constexpr t_real c_frameTolerance = 1E-4;
+
+    /**
+     * Derives a time step from the maximum wave speed of the previous time step.
+     *
+     * @param i_waveSpeedMax maximum absolute wave speed observed in the previous time step.
+     * @param i_dxy smallest cell size.
+     * @param i_cflNumber CFL number.
+     * @param i_dtMax time step if no wave was observed, e.g., the simulated time; the frames still limit the step.
+     * @return time step.
+     **/
+    static t_real getTimeStep(t_real i_waveSpeedMax,
+                              t_real i_dxy,
+                              t_real i_cflNumber,
+                              t_real i_dtMax);
+
+    /**
+     * Sets the initial state of a patch from a setup. Patches which expose views of their cells are filled by a single
+     * call of the setup per thread, all others cell by cell.
+     *
+     * @param i_setup setup.
+     * @param io_waveProp patch, whose inner cells are set.
+     * @param i_nx number of inner cells of the patch in x-direction.
+     * @param i_ny number of inner cells of the patch in y-direction.
+     * @param i_ix0 global id of the first cell of the patch in x-direction.
+     * @param i_iy0 global id of the first cell of the patch in y-direction.
+     * @param i_dx cell width in x-direction.
+     * @param i_dy cell width in y-direction.
+     * @param o_hMax will be set to the maximum water height of the patch.
+     * @param o_speedMax will be set to the maximum wave speed of the wet cells of the patch.
+     **/
+    static void initPatch(tsunami_lab::setups::Setup *i_setup,
+                          tsunami_lab::patches::WavePropagation *io_waveProp,
+                          tsunami_lab::t_idx i_nx,
+                          tsunami_lab::t_idx i_ny,
+                          tsunami_lab::t_idx i_ix0,
+                          tsunami_lab::t_idx i_iy0,
+                          tsunami_lab::t_real i_dx,
+                          tsunami_lab::t_real i_dy,
+                          tsunami_lab::t_real &o_hMax,
+                          tsunami_lab::t_real &o_speedMax);
+
+    /**
+     * Pins the threads to the cores of a preset; has to be called before the patches are allocated, such that their
+     * pages are placed on the NUMA nodes of the threads which update them.
+     *
+     * @param i_affinity preset.
+     * @param i_partition id of the partition of the cores of this process, e.g., its rank among the processes of a node.
+     * @param i_nPartitions number of processes which share the cores.
+     * @return description of the affinity for the runtime configuration.
+     **/
+    static std::string pinThreads(tsunami_lab::parallel::e_affinity i_affinity,
+                                  tsunami_lab::t_idx i_partition = 0,
+                                  tsunami_lab::t_idx i_nPartitions = 1);
+
+    /**
+     * Describes the placement of the pages of a 2d patch on the NUMA nodes.
+     *
+     * @param i_waveProp patch.
+     * @return pages per node, e.g., "0: 2048, 1: 2040"; "unknown" if the nodes can't be queried.
+     **/
+    static std::string describePages(tsunami_lab::patches::WavePropagation2d *i_waveProp);
+
     static void runSimulation(tsunami_lab::setups::Setup *i_setup,
                               tsunami_lab::t_real i_hStar,
                               tsunami_lab::configs::SimConfig i_simConfig);
+
+#ifdef USE_MPI
+    /**
+     * Runs a 2d simulation distributed over all processes of MPI_COMM_WORLD. Every process solves one subdomain of
+     * a Cartesian decomposition; rank 0 gathers the frames and writes the output.
+     *
+     * @param i_setup setup, which is queried by every process for the cells of its subdomain.
+     * @param i_simConfig configuration of the simulation.
+     **/
+    static void runSimulationMpi(tsunami_lab::setups::Setup *i_setup,
+                                 tsunami_lab::configs::SimConfig i_simConfig);
+#endif
 };
 
 #endif
\ No newline at end of file
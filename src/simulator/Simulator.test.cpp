@@ -4,18 +4,120 @@
  * @section DESCRIPTION
  * Unit-tests for Simulator.
  **/
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch.hpp>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
 
 #include "../constants.h"
+#include "../patches/1d/WavePropagation1d.h"
+#include "../patches/2d/WavePropagation2d.h"
 #include "../setups/DamBreak1d/DamBreak1d.h"
+#include "../setups/DamBreak2d/DamBreak2d.h"
 #define private public
 #include "Simulator.h"
 #undef public
 
+//! true while heap allocations are counted
+static std::atomic<bool> s_countAllocations(false);
+
+//! number of heap allocations since counting was enabled
+static std::atomic<std::size_t> s_allocations(0);
+
+/**
+ * Allocates heap memory and counts the allocation if counting is enabled.
+ *
+ * @param i_size number of bytes.
+ * @return pointer to the memory or nullptr if the allocation failed.
+ **/
+static void *countedAllocation(std::size_t i_size) {
+    if (s_countAllocations) s_allocations++;
+    return std::malloc(i_size == 0 ? 1 : i_size);
+}
+
+// replace all global allocation functions of the test binary to observe the simulator's time loop;
+// not inlined, such that the compiler does not pair the new-expressions with malloc/free
+__attribute__((noinline)) void *operator new(std::size_t i_size) {
+    void *l_ptr = countedAllocation(i_size);
+    if (l_ptr == nullptr) throw std::bad_alloc();
+    return l_ptr;
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t i_size) {
+    void *l_ptr = countedAllocation(i_size);
+    if (l_ptr == nullptr) throw std::bad_alloc();
+    return l_ptr;
+}
+
+__attribute__((noinline)) void *operator new(std::size_t i_size, std::nothrow_t const &) noexcept {
+    return countedAllocation(i_size);
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t i_size, std::nothrow_t const &) noexcept {
+    return countedAllocation(i_size);
+}
+
+__attribute__((noinline)) void operator delete(void *i_ptr) noexcept {
+    std::free(i_ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void *i_ptr) noexcept {
+    std::free(i_ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *i_ptr, std::nothrow_t const &) noexcept {
+    std::free(i_ptr);
+}
+
+__attribute__((noinline)) void operator delete[](void *i_ptr, std::nothrow_t const &) noexcept {
+    std::free(i_ptr);
+}
+
+/**
+ * Runs a 2d dam break without output and counts the heap allocations of the whole run.
+ *
+ * @param i_endTime simulated time in seconds.
+ * @return number of heap allocations.
+ **/
+static std::size_t countAllocations2d(tsunami_lab::t_real i_endTime) {
+    tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
+    tsunami_lab::configs::FlagConfig l_flagConfig = tsunami_lab::configs::FlagConfig();
+    l_flagConfig.setUseIO(false);
+    // a single frame, such that the runs only differ in the number of time steps
+    tsunami_lab::configs::SimConfig l_config = tsunami_lab::configs::SimConfig(2,
+                                                                               "simulator_2d",
+                                                                               l_flagConfig,
+                                                                               0,
+                                                                               40,
+                                                                               30,
+                                                                               10,
+                                                                               10,
+                                                                               i_endTime,
+                                                                               0,
+                                                                               0,
+                                                                               1.0,
+                                                                               l_boundary,
+                                                                               false,
+                                                                               0,
+                                                                               0.5,
+                                                                               100);
+    tsunami_lab::setups::Setup *l_setup = new tsunami_lab::setups::DamBreak2d(10, 5, 10, 10, 2);
+
+    s_allocations = 0;
+    s_countAllocations = true;
+    tsunami_lab::simulator::runSimulation(l_setup, -1, l_config);
+    s_countAllocations = false;
+
+    delete l_setup;
+    return s_allocations;
+}
+
 TEST_CASE("Test the simulation running method.", "[Simulator]") {
     tsunami_lab::e_boundary l_boundary[4] = {tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW, tsunami_lab::OUTFLOW};
 	 tsunami_lab::configs::FlagConfig l_flagConfig = tsunami_lab::configs::FlagConfig();
@@ -79,9 +181,75 @@ TEST_CASE("Test the simulation running method.", "[Simulator]") {
         }
         REQUIRE(l_deletedAll);
 
-        // check middle state
-        REQUIRE(l_height == Approx(7.2627));
+        // check middle state; the adaptive time steps place the cell slightly off the exact middle state
+        REQUIRE(l_height == Approx(7.2627).epsilon(0.001));
     }
     l_file.close();
     delete l_setup;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test the derivation of the adaptive time step.", "[Simulator]") {
+    /*
+     * Test case:
+     *   cell size 100, CFL number 0.5
+     *
+     *   maximum wave speed 10: dt = 0.5 * 100 / 10 = 5
+     *   no waves:              the maximum time step 3
+     */
+    REQUIRE(tsunami_lab::simulator::getTimeStep(10, 100, 0.5, 3) == Approx(5));
+    REQUIRE(tsunami_lab::simulator::getTimeStep(0, 100, 0.5, 3) == Approx(3));
+}
+
+TEST_CASE("Test that the 2d time loop of the simulator does not allocate heap memory.", "[Simulator]") {
+    /*
+     * Test case:
+     *   The same simulation runs for 1s and 3s; the second run takes about three times the time steps.
+     *   The setup and the teardown allocate the same memory in both runs, thus an allocating time loop would add
+     *   allocations to the longer run. The first run warms up the lazily allocated state of the runtimes.
+     */
+    countAllocations2d(1);
+    std::size_t l_allocationsShort = countAllocations2d(1);
+    std::size_t l_allocationsLong = countAllocations2d(3);
+
+    REQUIRE(l_allocationsShort > 0);
+    REQUIRE(l_allocationsLong == l_allocationsShort);
+}
+
+TEST_CASE("Test setting the initial state of a patch from a setup.", "[Simulator]") {
+    /*
+     * Test case:
+     *   The 2d patch of 7 x 5 cells holding cells 3 to 9 in x- and 2 to 6 in y-direction of a dam break is filled at
+     *   once, the 1d patch of 7 cells cell by cell.
+     *
+     *   Both patches hold the values of the point-wise getters; the maxima are taken over the inner cells.
+     */
+    tsunami_lab::setups::DamBreak2d l_setup(10, 5, 10, 10, 2);
+
+    tsunami_lab::patches::WavePropagation2d l_waveProp2d(7, 5);
+    tsunami_lab::t_real l_hMax = 0;
+    tsunami_lab::t_real l_speedMax = 0;
+    tsunami_lab::simulator::initPatch(&l_setup, &l_waveProp2d, 7, 5, 3, 2, 1, 1, l_hMax, l_speedMax);
+
+    tsunami_lab::t_real l_hExpected = 0;
+    for (tsunami_lab::t_idx l_cy = 0; l_cy < 5; l_cy++) {
+        for (tsunami_lab::t_idx l_cx = 0; l_cx < 7; l_cx++) {
+            tsunami_lab::t_idx l_ce = (l_cy + 1) * l_waveProp2d.getStride() + l_cx + 1;
+            tsunami_lab::t_real l_x = 3 + l_cx;
+            tsunami_lab::t_real l_y = 2 + l_cy;
+            REQUIRE(l_waveProp2d.getHeight()[l_ce] == l_setup.getHeight(l_x, l_y));
+            REQUIRE(l_waveProp2d.getMomentumX()[l_ce] == 0);
+            REQUIRE(l_waveProp2d.getMomentumY()[l_ce] == 0);
+            REQUIRE(l_waveProp2d.getBathymetry()[l_ce] == l_setup.getBathymetry(l_x, l_y));
+            l_hExpected = std::max(l_hExpected, l_setup.getHeight(l_x, l_y));
+        }
+    }
+    REQUIRE(l_hMax == l_hExpected);
+    REQUIRE(l_speedMax == Approx(std::sqrt(tsunami_lab::t_real(9.80665) * l_hExpected)));
+
+    tsunami_lab::patches::WavePropagation1d l_waveProp1d(7, tsunami_lab::FWAVE);
+    tsunami_lab::simulator::initPatch(&l_setup, &l_waveProp1d, 7, 1, 3, 2, 1, 1, l_hMax, l_speedMax);
+    for (tsunami_lab::t_idx l_cx = 0; l_cx < 7; l_cx++) {
+        REQUIRE(l_waveProp1d.getHeight()[l_cx] == l_setup.getHeight(3 + l_cx, 2));
+        REQUIRE(l_waveProp1d.getBathymetry()[l_cx] == l_setup.getBathymetry(3 + l_cx, 2));
+    }
+}
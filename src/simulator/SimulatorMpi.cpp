@@ -0,0 +1,232 @@
+/**
+ * @author Bohdan Babii, Phillip Rothenbeck
+ *
+ * @section DESCRIPTION
+ * Distributed-memory simulations of the simulator class.
+ **/
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "../io/AsyncWriter/AsyncWriter.h"
+#include "../io/NetCDF/NetCDF.h"
+#include "../io/Trace/Trace.h"
+#include "../kernels/Kernels.h"
+#include "../parallel/MpiGrid.h"
+#include "../patches/2d/WavePropagation2d.h"
+#include "../timer.h"
+#include "Simulator.h"
+
+void tsunami_lab::simulator::runSimulationMpi(tsunami_lab::setups::Setup *i_setup,
+                                              tsunami_lab::configs::SimConfig i_simConfig) {
+    Timer *l_timer = new Timer();
+
+    // define number of cells of the entire domain
+    tsunami_lab::t_idx l_nx = i_simConfig.getXCells();
+    tsunami_lab::t_idx l_ny = i_simConfig.getYCells();
+
+    // define length of one cell
+    tsunami_lab::t_real l_dx = i_simConfig.getXLength() / l_nx;
+    tsunami_lab::t_real l_dy = i_simConfig.getYLength() / l_ny;
+
+    tsunami_lab::parallel::MpiGrid l_grid(l_nx, l_ny, MPI_COMM_WORLD);
+    tsunami_lab::parallel::Decomposition &l_decomp = l_grid.getDecomposition();
+    bool l_isRoot = (l_grid.getRank() == 0);
+
+    if (i_simConfig.getAmrConfig().useRefinement()) {
+        std::cerr << "adaptive mesh refinement is not supported by distributed runs, solving the uniform grid" << std::endl;
+    }
+    if (i_simConfig.getFlagConfig().useCheckPoint()) {
+        std::cerr << "checkpoints are not supported by distributed runs, ignoring them" << std::endl;
+    }
+
+    // subdomain of this process
+    tsunami_lab::t_idx l_nxLocal = l_decomp.getCellsX();
+    tsunami_lab::t_idx l_nyLocal = l_decomp.getCellsY();
+    tsunami_lab::t_idx l_x0 = l_decomp.getFirstX();
+    tsunami_lab::t_idx l_y0 = l_decomp.getFirstY();
+
+    // the processes of a node which inherited the same cores, i.e., were not bound by the launcher, split them
+    std::vector<std::vector<int> > l_cores = tsunami_lab::parallel::Affinity::getCores();
+    tsunami_lab::t_idx l_nodeRank = 0;
+    tsunami_lab::t_idx l_nNodeRanks = 1;
+    l_grid.getNodeRank(l_cores.empty() ? 0 : l_cores.front().front(), l_nodeRank, l_nNodeRanks);
+
+    std::string l_affinity = pinThreads(i_simConfig.getThreadAffinity(), l_nodeRank, l_nNodeRanks);
+
+    // construct solver
+    if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
+    tsunami_lab::e_solver l_solver = i_simConfig.isRoeSolver() ? tsunami_lab::ROE : tsunami_lab::FWAVE;
+    tsunami_lab::patches::WavePropagation2d *l_waveProp = new tsunami_lab::patches::WavePropagation2d(l_nxLocal,
+                                                                                                     l_nyLocal,
+                                                                                                     i_simConfig.getTileRows(),
+                                                                                                     i_simConfig.useActiveTiles(),
+                                                                                                     l_solver);
+    if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Create WaveProp Object");
+
+    // set up solver at the global positions of the cells
+    tsunami_lab::t_real l_hMax = 0;
+    tsunami_lab::t_real l_speedMax = 0;
+    initPatch(i_setup, l_waveProp, l_nxLocal, l_nyLocal, l_x0, l_y0, l_dx, l_dy, l_hMax, l_speedMax);
+    l_speedMax = l_grid.getMax(l_speedMax);
+
+    // the bathymetries of the ghost cells are exchanged once, the time steps only exchange heights and momenta
+    l_grid.exchangeBathymetry(*l_waveProp, i_simConfig.getBoundaryCondition());
+    if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Caculate hMax and Init WaveProp");
+
+    // choose the smaller cell size for the time step
+    tsunami_lab::t_real l_dxy = std::min(l_dx, l_dy);
+
+    // every process derives the same time step from the global maximum of the wave speeds
+    tsunami_lab::t_real l_cflNumber = i_simConfig.getCflNumber();
+    tsunami_lab::t_real l_dt = getTimeStep(l_speedMax, l_dxy, l_cflNumber, i_simConfig.getEndSimTime());
+
+    // output frames are placed by simulation time
+    tsunami_lab::t_real l_frameTime = i_simConfig.getFrameTime();
+    if (l_frameTime <= 0) l_frameTime = 25 * l_dt;
+
+    std::cout << std::endl;
+    std::cout << "runtime configuration" << std::endl;
+    std::cout << "  number of cells in x-direction: " << l_nx << std::endl;
+    std::cout << "  number of cells in y-direction: " << l_ny << std::endl;
+    std::cout << "  cell size:                      " << l_dxy << std::endl;
+    std::cout << "  CFL number:                     " << l_cflNumber << std::endl;
+    std::cout << "  initial time step:              " << l_dt << std::endl;
+    std::cout << "  time between frames:            " << l_frameTime << std::endl;
+    std::cout << "  number of processes:            " << l_grid.getNumberOfRanks() << std::endl;
+    std::cout << "  processes in x- / y-direction:  " << l_decomp.getProcsX() << " / " << l_decomp.getProcsY() << std::endl;
+    std::cout << "  Riemann solver:                 " << (l_solver == tsunami_lab::ROE ? "Roe" : "F-Wave") << std::endl;
+    std::cout << "  kernel ISA:                     " << tsunami_lab::kernels::getIsaName(tsunami_lab::kernels::getActiveIsa()) << std::endl;
+    std::cout << "  thread affinity:                " << l_affinity << std::endl;
+    std::cout << "  pages per NUMA node (rank 0):   " << describePages(l_waveProp) << std::endl;
+    std::cout << "  rows per band (0: full grid):   " << l_waveProp->getTileRows() << std::endl;
+    std::cout << "  skip still or dry tiles:        " << (i_simConfig.useActiveTiles() && l_solver == tsunami_lab::FWAVE) << std::endl;
+    std::cout << std::endl;
+
+    // rank 0 holds the entire domain for the output
+    bool l_useIO = i_simConfig.getFlagConfig().useIO();
+    tsunami_lab::t_idx l_stride = l_nx + 2;
+    std::vector<tsunami_lab::t_real> l_h;
+    std::vector<tsunami_lab::t_real> l_hu;
+    std::vector<tsunami_lab::t_real> l_hv;
+    std::vector<tsunami_lab::t_real> l_b;
+    if (l_isRoot) {
+        l_h.resize(l_stride * (l_ny + 2), 0);
+        l_hu.resize(l_stride * (l_ny + 2), 0);
+        l_hv.resize(l_stride * (l_ny + 2), 0);
+        l_b.resize(l_stride * (l_ny + 2), 0);
+    }
+    l_grid.gather(l_waveProp->getBathymetry(), l_waveProp->getStride(), l_b.data());
+
+    std::string l_path = "./out/" + i_simConfig.getConfigName() + ".nc";
+    tsunami_lab::io::NetCDF *l_writer = nullptr;
+    if (l_isRoot && l_useIO) {
+        std::cout << "  writing wave field to " << l_path << std::endl;
+        l_writer = new tsunami_lab::io::NetCDF(l_dxy,
+                                               l_nx,
+                                               l_ny,
+                                               l_stride,
+                                               i_simConfig.getCoarseFactor(),
+                                               l_b.data(),
+                                               l_path,
+                                               0,
+                                               i_simConfig.getOutputConfig());
+    }
+
+    // the output thread of rank 0 coarsens and writes the frames while the time loop continues
+    tsunami_lab::configs::OutputConfig l_outputConfig = i_simConfig.getOutputConfig();
+    tsunami_lab::io::AsyncWriter *l_output = nullptr;
+    if (l_writer != nullptr) {
+        l_output = new tsunami_lab::io::AsyncWriter(l_writer,
+                                                    l_nx,
+                                                    l_ny,
+                                                    l_stride,
+                                                    l_b.data(),
+                                                    l_outputConfig.getBufferCount(),
+                                                    l_outputConfig.dropFrames());
+    }
+
+    // timeline of the overlapped time steps; every process writes its own
+    tsunami_lab::io::Trace *l_trace = nullptr;
+    if (i_simConfig.getFlagConfig().useTrace()) {
+        l_trace = new tsunami_lab::io::Trace(omp_get_max_threads(), l_grid.getRank());
+        l_waveProp->setTrace(l_trace);
+    }
+
+    // set up time and print control
+    tsunami_lab::t_idx l_frame = 0;
+    tsunami_lab::t_idx l_timeStep = 0;
+    tsunami_lab::t_real l_endTime = i_simConfig.getEndSimTime();
+    tsunami_lab::t_real l_simTime = 0;
+
+    if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
+    while (l_simTime < l_endTime) {
+        if (l_simTime >= l_frame * l_frameTime - l_frameTime * c_frameTolerance) {
+            std::cout << "  simulation time / #time steps / #step: "
+                      << l_simTime << " / " << l_timeStep << " / " << l_frame << std::endl;
+
+            if (l_useIO) {
+                l_grid.gather(l_waveProp->getHeight(), l_waveProp->getStride(), l_h.data());
+                l_grid.gather(l_waveProp->getMomentumX(), l_waveProp->getStride(), l_hu.data());
+                l_grid.gather(l_waveProp->getMomentumY(), l_waveProp->getStride(), l_hv.data());
+
+                if (l_isRoot) l_output->store(l_simTime, l_frame, l_h.data(), l_hu.data(), l_hv.data());
+            }
+            l_frame++;
+        }
+        // do not step over the next frame
+        l_dt = std::min(l_dt, l_frame * l_frameTime - l_simTime);
+
+        // the halos are exchanged while the inner edges are solved
+        l_waveProp->timeStepOverlapped(l_dt / l_dx,
+                                       l_dt / l_dy,
+                                       [&]() { l_grid.exchangeHalos(*l_waveProp, i_simConfig.getBoundaryCondition()); });
+
+        l_timeStep++;
+        l_simTime += l_dt;
+        l_dt = getTimeStep(l_grid.getMax(l_waveProp->getMaxWaveSpeed()), l_dxy, l_cflNumber, l_endTime);
+    }
+    if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Simulation");
+
+    if (l_writer != nullptr) {
+        if (i_simConfig.getFlagConfig().useTiming()) l_timer->start();
+        if (l_output->finish() != 0) std::cerr << "writing the output failed" << std::endl;
+        std::cout << "  frames written / dropped:       " << l_output->getNumberOfStoredFrames() << " / "
+                  << l_output->getNumberOfDroppedFrames() << std::endl;
+        std::cout << "  time loop waiting on output:    " << l_output->getStallTime() << "s" << std::endl;
+        std::cout << "  time loop copying frames:       " << l_output->getCopyTime() << "s" << std::endl;
+        std::cout << "  output thread writing:          " << l_output->getWriteTime() << "s" << std::endl;
+        delete l_output;
+        l_writer->write();
+        if (l_writer->getFramesWritten() > 0 && l_writer->getFileSize() > 0) {
+            double l_rawMb = l_writer->getRawBytes() / 1e6;
+            double l_fileMb = l_writer->getFileSize() / 1e6;
+            std::cout << "  output file size / raw:         " << l_fileMb << "MB / " << l_rawMb << "MB" << std::endl;
+            std::cout << "  compression ratio:              " << l_rawMb / l_fileMb << std::endl;
+            std::cout << "  write throughput:               " << l_rawMb / l_writer->getWriteTime() << "MB/s" << std::endl;
+            std::cout << "  time per frame / slowest frame: " << l_writer->getWriteTime() / l_writer->getFramesWritten()
+                      << "s / " << l_writer->getMaxFrameWriteTime() << "s" << std::endl;
+        }
+        if (i_simConfig.getFlagConfig().useTiming()) l_timer->printTime("Close NC File");
+        delete l_writer;
+    }
+
+    if (l_trace != nullptr) {
+        std::string l_tracePath = "./out/" + i_simConfig.getConfigName() + "_trace_" + std::to_string(l_grid.getRank()) + ".json";
+        std::cout << "  writing timeline to " << l_tracePath << std::endl;
+        std::ofstream l_traceFile(l_tracePath);
+        l_trace->write(l_traceFile);
+        delete l_trace;
+    }
+
+    std::cout << "finished time loop" << std::endl;
+    std::cout << "freeing memory" << std::endl;
+    delete l_waveProp;
+    delete l_timer;
+}
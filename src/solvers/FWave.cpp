@@ -7,6 +7,7 @@
 
 #include "FWave.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -8,6 +8,9 @@
 #ifndef TSUNAMI_LAB_SOLVERS_F_WAVE
 #define TSUNAMI_LAB_SOLVERS_F_WAVE
 
+#include <algorithm>
+#include <cmath>
+
 #include "../constants.h"
 
 namespace tsunami_lab {
@@ -69,17 +72,6 @@ class tsunami_lab::solvers::FWave {
                            t_real &o_waveSpeedL,
                            t_real &o_waveSpeedR);
 
-    /**
-     * Computes the flux function for one cell.
-     *
-     * @param i_h height of the cell
-     * @param i_hu momentum of the cell
-     * @param o_flux will be set to the flux function value
-     **/
-    static void flux(t_real i_h,
-                     t_real i_hu,
-                     t_real o_flux[2]);
-
     /**
      * Computes the wave strengths
      *
@@ -107,6 +99,17 @@ class tsunami_lab::solvers::FWave {
                               t_real &o_strengthR);
 
    public:
+    /**
+     * Computes the flux function for one cell.
+     *
+     * @param i_h height of the cell
+     * @param i_hu momentum of the cell
+     * @param o_flux will be set to the flux function value
+     **/
+    static void flux(t_real i_h,
+                     t_real i_hu,
+                     t_real o_flux[2]);
+
     /**
      * Computes the net-updates.
      *
@@ -127,5 +130,351 @@ class tsunami_lab::solvers::FWave {
                            t_real i_bR,
                            t_real o_netUpdateL[2],
                            t_real o_netUpdateR[2]);
+
+    /**
+     * Computes the net-updates of a batch of edges.
+     * All branches of the scalar solver are replaced by lane-wise selects, which allows the compiler to process several edges with a single SIMD instruction.
+     * The results match those of netUpdates.
+     *
+     * @param i_nEdges number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL bathymetries of the left sides.
+     * @param i_bR bathymetries of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the heights for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momenta for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the heights for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momenta for the right sides.
+     * @return maximum absolute wave speed of all edges; edges with two dry sides are ignored.
+     **/
+    static t_real netUpdatesBatch(t_idx i_nEdges,
+                                t_real const *i_hL,
+                                t_real const *i_hR,
+                                t_real const *i_huL,
+                                t_real const *i_huR,
+                                t_real const *i_bL,
+                                t_real const *i_bR,
+                                t_real *o_netUpdateLH,
+                                t_real *o_netUpdateLHu,
+                                t_real *o_netUpdateRH,
+                                t_real *o_netUpdateRHu);
+
+    /**
+     * Computes the terms of the net-updates which depend on a single cell: the particle velocity, the square root of
+     * the height and the momentum flux. A sweep computes them once per cell instead of once per side of every edge.
+     * Dry cells get the terms of height 1 as dummies; their edges reflect the terms of the wet side.
+     *
+     * @param i_nCells number of cells.
+     * @param i_h heights of the cells.
+     * @param i_hu momenta of the cells.
+     * @param o_u will be set to the particle velocities.
+     * @param o_sqrtH will be set to the square roots of the heights.
+     * @param o_flux will be set to the momentum fluxes hu^2 / h + g h^2 / 2.
+     **/
+    static void cellTerms(t_idx i_nCells,
+                          t_real const *i_h,
+                          t_real const *i_hu,
+                          t_real *o_u,
+                          t_real *o_sqrtH,
+                          t_real *o_flux);
+
+    /**
+     * Computes the net-updates of a batch of edges from the terms of their sides, which were computed by cellTerms.
+     * The results match those of netUpdatesBatch exactly, while every edge evaluates a single square root and two
+     * divisions instead of three square roots and four divisions.
+     *
+     * @param i_nEdges number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL bathymetries of the left sides.
+     * @param i_bR bathymetries of the right sides.
+     * @param i_uL particle velocities of the left sides.
+     * @param i_uR particle velocities of the right sides.
+     * @param i_sqrtHL square roots of the heights of the left sides.
+     * @param i_sqrtHR square roots of the heights of the right sides.
+     * @param i_fluxL momentum fluxes of the left sides.
+     * @param i_fluxR momentum fluxes of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the heights for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momenta for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the heights for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momenta for the right sides.
+     * @return maximum absolute wave speed of all edges; edges with two dry sides are ignored.
+     **/
+    static t_real netUpdatesBatch(t_idx i_nEdges,
+                                t_real const *i_hL,
+                                t_real const *i_hR,
+                                t_real const *i_huL,
+                                t_real const *i_huR,
+                                t_real const *i_bL,
+                                t_real const *i_bR,
+                                t_real const *i_uL,
+                                t_real const *i_uR,
+                                t_real const *i_sqrtHL,
+                                t_real const *i_sqrtHR,
+                                t_real const *i_fluxL,
+                                t_real const *i_fluxR,
+                                t_real *o_netUpdateLH,
+                                t_real *o_netUpdateLHu,
+                                t_real *o_netUpdateRH,
+                                t_real *o_netUpdateRHu);
 };
+
+// the batched kernels are defined in the header, such that they are inlined into the sweeps of the patches
+
+inline tsunami_lab::t_real tsunami_lab::solvers::FWave::netUpdatesBatch(t_idx i_nEdges,
+                                                                        t_real const *i_hL,
+                                                                        t_real const *i_hR,
+                                                                        t_real const *i_huL,
+                                                                        t_real const *i_huR,
+                                                                        t_real const *i_bL,
+                                                                        t_real const *i_bR,
+                                                                        t_real *o_netUpdateLH,
+                                                                        t_real *o_netUpdateLHu,
+                                                                        t_real *o_netUpdateRH,
+                                                                        t_real *o_netUpdateRHu) {
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp simd reduction(max : l_waveSpeedMax)
+    for (t_idx l_ed = 0; l_ed < i_nEdges; l_ed++) {
+        // load all inputs unconditionally, which allows the compiler to replace the branches by selects
+        t_real l_hInL = i_hL[l_ed];
+        t_real l_hInR = i_hR[l_ed];
+        t_real l_huInL = i_huL[l_ed];
+        t_real l_huInR = i_huR[l_ed];
+        t_real l_bInL = i_bL[l_ed];
+        t_real l_bInR = i_bR[l_ed];
+
+        bool l_isLeftDry = (l_hInL <= 0);
+        bool l_isRightDry = (l_hInR <= 0);
+        bool l_isBothDry = l_isLeftDry & l_isRightDry;
+
+        // if one cell is dry set it to reflecting; lanes with two dry cells compute a dummy state and are zeroed below
+        t_real l_hL = l_isLeftDry ? l_hInR : l_hInL;
+        t_real l_hR = l_isRightDry ? l_hInL : l_hInR;
+        t_real l_huL = l_isLeftDry ? -l_huInR : l_huInL;
+        t_real l_huR = l_isRightDry ? -l_huInL : l_huInR;
+        t_real l_bL = l_isLeftDry ? l_bInR : l_bInL;
+        t_real l_bR = l_isRightDry ? l_bInL : l_bInR;
+
+        l_hL = l_isBothDry ? 1 : l_hL;
+        l_hR = l_isBothDry ? 1 : l_hR;
+
+        // calculate particle velocities
+        t_real l_uL = l_huL / l_hL;
+        t_real l_uR = l_huR / l_hR;
+
+        // calculate wave speeds from the Roe averages
+        t_real l_heightAvg = t_real(0.5) * (l_hL + l_hR);
+        t_real l_sqrtHL = std::sqrt(l_hL);
+        t_real l_sqrtHR = std::sqrt(l_hR);
+        t_real l_velocityAvg = l_uL * l_sqrtHL + l_uR * l_sqrtHR;
+        l_velocityAvg = l_velocityAvg / (l_sqrtHL + l_sqrtHR);
+
+        // the scalar solver evaluates the speed terms and the fluxes in double precision, which is kept here
+        double l_speedTerm = c_sqrt_g * std::sqrt(double(l_heightAvg));
+        t_real l_waveSpeedL = l_velocityAvg - l_speedTerm;
+        t_real l_waveSpeedR = l_velocityAvg + l_speedTerm;
+
+        // calculate the decomposed flux difference including the bathymetry source term
+        double l_uLDouble = l_uL;
+        double l_uRDouble = l_uR;
+        double l_hLDouble = l_hL;
+        double l_hRDouble = l_hR;
+        t_real l_fluxL = l_hLDouble * (l_uLDouble * l_uLDouble) + t_real(0.5) * c_g * (l_hLDouble * l_hLDouble);
+        t_real l_fluxR = l_hRDouble * (l_uRDouble * l_uRDouble) + t_real(0.5) * c_g * (l_hRDouble * l_hRDouble);
+
+        t_real l_deltaPsi = (-c_g) * (l_bR - l_bL) * ((l_hL + l_hR) / 2);
+        t_real l_decomposition0 = l_huR - l_huL;
+        t_real l_decomposition1 = (l_fluxR - l_fluxL) - l_deltaPsi;
+
+        // calculate wave strengths with the inverse of the matrix of eigenvectors
+        t_real l_revDet = 1 / (l_waveSpeedR - l_waveSpeedL);
+
+        t_real l_waveStrengthL = (l_revDet * l_waveSpeedR) * l_decomposition0;
+        l_waveStrengthL += (-l_revDet) * l_decomposition1;
+        t_real l_waveStrengthR = (-l_revDet * l_waveSpeedL) * l_decomposition0;
+        l_waveStrengthR += l_revDet * l_decomposition1;
+
+        // calculate waves
+        t_real l_waveL[2] = {l_waveStrengthL, l_waveStrengthL * l_waveSpeedL};
+        t_real l_waveR[2] = {l_waveStrengthR, l_waveStrengthR * l_waveSpeedR};
+
+        // masks of the wave directions; dry cells do not receive updates
+        bool l_isLToL = (l_waveSpeedL < 0) & !l_isLeftDry;
+        bool l_isLToR = (l_waveSpeedL >= 0) & !l_isRightDry;
+        bool l_isRToR = (l_waveSpeedR > 0) & !l_isRightDry;
+        bool l_isRToL = (l_waveSpeedR <= 0) & !l_isLeftDry;
+
+        t_real l_netUpdateL[2] = {0, 0};
+        t_real l_netUpdateR[2] = {0, 0};
+
+        l_netUpdateL[0] += l_isLToL ? l_waveL[0] : 0;
+        l_netUpdateL[1] += l_isLToL ? l_waveL[1] : 0;
+        l_netUpdateR[0] += l_isLToR ? l_waveL[0] : 0;
+        l_netUpdateR[1] += l_isLToR ? l_waveL[1] : 0;
+
+        l_netUpdateR[0] += l_isRToR ? l_waveR[0] : 0;
+        l_netUpdateR[1] += l_isRToR ? l_waveR[1] : 0;
+        l_netUpdateL[0] += l_isRToL ? l_waveR[0] : 0;
+        l_netUpdateL[1] += l_isRToL ? l_waveR[1] : 0;
+
+        o_netUpdateLH[l_ed] = l_netUpdateL[0];
+        o_netUpdateLHu[l_ed] = l_netUpdateL[1];
+        o_netUpdateRH[l_ed] = l_netUpdateR[0];
+        o_netUpdateRHu[l_ed] = l_netUpdateR[1];
+
+        // the speed of the faster wave limits the time step
+        t_real l_waveSpeed = std::max(std::fabs(l_waveSpeedL), std::fabs(l_waveSpeedR));
+        l_waveSpeed = l_isBothDry ? 0 : l_waveSpeed;
+        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+    }
+
+    return l_waveSpeedMax;
+}
+
+inline void tsunami_lab::solvers::FWave::cellTerms(t_idx i_nCells,
+                                                   t_real const *i_h,
+                                                   t_real const *i_hu,
+                                                   t_real *o_u,
+                                                   t_real *o_sqrtH,
+                                                   t_real *o_flux) {
+#pragma omp simd
+    for (t_idx l_ce = 0; l_ce < i_nCells; l_ce++) {
+        t_real l_hIn = i_h[l_ce];
+        t_real l_huIn = i_hu[l_ce];
+
+        // dry cells get the terms of height 1, which only enter the dummy state of edges between two dry cells
+        t_real l_h = (l_hIn <= 0) ? 1 : l_hIn;
+        t_real l_u = l_huIn / l_h;
+
+        // same precision as the fluxes of netUpdatesBatch
+        double l_uDouble = l_u;
+        double l_hDouble = l_h;
+
+        o_u[l_ce] = l_u;
+        o_sqrtH[l_ce] = std::sqrt(l_h);
+        o_flux[l_ce] = l_hDouble * (l_uDouble * l_uDouble) + t_real(0.5) * c_g * (l_hDouble * l_hDouble);
+    }
+}
+
+inline tsunami_lab::t_real tsunami_lab::solvers::FWave::netUpdatesBatch(t_idx i_nEdges,
+                                                                        t_real const *i_hL,
+                                                                        t_real const *i_hR,
+                                                                        t_real const *i_huL,
+                                                                        t_real const *i_huR,
+                                                                        t_real const *i_bL,
+                                                                        t_real const *i_bR,
+                                                                        t_real const *i_uL,
+                                                                        t_real const *i_uR,
+                                                                        t_real const *i_sqrtHL,
+                                                                        t_real const *i_sqrtHR,
+                                                                        t_real const *i_fluxL,
+                                                                        t_real const *i_fluxR,
+                                                                        t_real *o_netUpdateLH,
+                                                                        t_real *o_netUpdateLHu,
+                                                                        t_real *o_netUpdateRH,
+                                                                        t_real *o_netUpdateRHu) {
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp simd reduction(max : l_waveSpeedMax)
+    for (t_idx l_ed = 0; l_ed < i_nEdges; l_ed++) {
+        // load all inputs unconditionally, which allows the compiler to replace the branches by selects
+        t_real l_hInL = i_hL[l_ed];
+        t_real l_hInR = i_hR[l_ed];
+        t_real l_huInL = i_huL[l_ed];
+        t_real l_huInR = i_huR[l_ed];
+        t_real l_bInL = i_bL[l_ed];
+        t_real l_bInR = i_bR[l_ed];
+        t_real l_uInL = i_uL[l_ed];
+        t_real l_uInR = i_uR[l_ed];
+        t_real l_sqrtHInL = i_sqrtHL[l_ed];
+        t_real l_sqrtHInR = i_sqrtHR[l_ed];
+        t_real l_fluxInL = i_fluxL[l_ed];
+        t_real l_fluxInR = i_fluxR[l_ed];
+
+        bool l_isLeftDry = (l_hInL <= 0);
+        bool l_isRightDry = (l_hInR <= 0);
+        bool l_isBothDry = l_isLeftDry & l_isRightDry;
+
+        // a dry side reflects the wet one: same height, root and flux, negated momentum and velocity
+        t_real l_hL = l_isLeftDry ? l_hInR : l_hInL;
+        t_real l_hR = l_isRightDry ? l_hInL : l_hInR;
+        t_real l_huL = l_isLeftDry ? -l_huInR : l_huInL;
+        t_real l_huR = l_isRightDry ? -l_huInL : l_huInR;
+        t_real l_bL = l_isLeftDry ? l_bInR : l_bInL;
+        t_real l_bR = l_isRightDry ? l_bInL : l_bInR;
+        t_real l_uL = l_isLeftDry ? -l_uInR : l_uInL;
+        t_real l_uR = l_isRightDry ? -l_uInL : l_uInR;
+        t_real l_sqrtHL = l_isLeftDry ? l_sqrtHInR : l_sqrtHInL;
+        t_real l_sqrtHR = l_isRightDry ? l_sqrtHInL : l_sqrtHInR;
+        t_real l_fluxL = l_isLeftDry ? l_fluxInR : l_fluxInL;
+        t_real l_fluxR = l_isRightDry ? l_fluxInL : l_fluxInR;
+
+        // lanes with two dry cells compute a dummy state from the dummy terms of height 1 and are zeroed below
+        l_hL = l_isBothDry ? 1 : l_hL;
+        l_hR = l_isBothDry ? 1 : l_hR;
+
+        // calculate wave speeds from the Roe averages
+        t_real l_heightAvg = t_real(0.5) * (l_hL + l_hR);
+        t_real l_velocityAvg = l_uL * l_sqrtHL + l_uR * l_sqrtHR;
+        l_velocityAvg = l_velocityAvg / (l_sqrtHL + l_sqrtHR);
+
+        double l_speedTerm = c_sqrt_g * std::sqrt(double(l_heightAvg));
+        t_real l_waveSpeedL = l_velocityAvg - l_speedTerm;
+        t_real l_waveSpeedR = l_velocityAvg + l_speedTerm;
+
+        // calculate the decomposed flux difference including the bathymetry source term
+        t_real l_deltaPsi = (-c_g) * (l_bR - l_bL) * ((l_hL + l_hR) / 2);
+        t_real l_decomposition0 = l_huR - l_huL;
+        t_real l_decomposition1 = (l_fluxR - l_fluxL) - l_deltaPsi;
+
+        // calculate wave strengths with the inverse of the matrix of eigenvectors
+        t_real l_revDet = 1 / (l_waveSpeedR - l_waveSpeedL);
+
+        t_real l_waveStrengthL = (l_revDet * l_waveSpeedR) * l_decomposition0;
+        l_waveStrengthL += (-l_revDet) * l_decomposition1;
+        t_real l_waveStrengthR = (-l_revDet * l_waveSpeedL) * l_decomposition0;
+        l_waveStrengthR += l_revDet * l_decomposition1;
+
+        // calculate waves
+        t_real l_waveL[2] = {l_waveStrengthL, l_waveStrengthL * l_waveSpeedL};
+        t_real l_waveR[2] = {l_waveStrengthR, l_waveStrengthR * l_waveSpeedR};
+
+        // masks of the wave directions; dry cells do not receive updates
+        bool l_isLToL = (l_waveSpeedL < 0) & !l_isLeftDry;
+        bool l_isLToR = (l_waveSpeedL >= 0) & !l_isRightDry;
+        bool l_isRToR = (l_waveSpeedR > 0) & !l_isRightDry;
+        bool l_isRToL = (l_waveSpeedR <= 0) & !l_isLeftDry;
+
+        t_real l_netUpdateL[2] = {0, 0};
+        t_real l_netUpdateR[2] = {0, 0};
+
+        l_netUpdateL[0] += l_isLToL ? l_waveL[0] : 0;
+        l_netUpdateL[1] += l_isLToL ? l_waveL[1] : 0;
+        l_netUpdateR[0] += l_isLToR ? l_waveL[0] : 0;
+        l_netUpdateR[1] += l_isLToR ? l_waveL[1] : 0;
+
+        l_netUpdateR[0] += l_isRToR ? l_waveR[0] : 0;
+        l_netUpdateR[1] += l_isRToR ? l_waveR[1] : 0;
+        l_netUpdateL[0] += l_isRToL ? l_waveR[0] : 0;
+        l_netUpdateL[1] += l_isRToL ? l_waveR[1] : 0;
+
+        o_netUpdateLH[l_ed] = l_netUpdateL[0];
+        o_netUpdateLHu[l_ed] = l_netUpdateL[1];
+        o_netUpdateRH[l_ed] = l_netUpdateR[0];
+        o_netUpdateRHu[l_ed] = l_netUpdateR[1];
+
+        // the speed of the faster wave limits the time step
+        t_real l_waveSpeed = std::max(std::fabs(l_waveSpeedL), std::fabs(l_waveSpeedR));
+        l_waveSpeed = l_isBothDry ? 0 : l_waveSpeed;
+        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+    }
+
+    return l_waveSpeedMax;
+}
+
 #endif
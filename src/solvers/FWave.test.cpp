@@ -4,7 +4,10 @@
  * @section DESCRIPTION
  * Unit tests of the F wave solver.
  **/
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
 #define private public
 #include "FWave.h"
 #undef public
@@ -689,4 +692,174 @@ TEST_CASE("Test net-updates for dam break with bathymetry.", "[FWaveUpdates]") {
     REQUIRE(l_netUpdatesL[1] == Approx(-308.90947936));
     REQUIRE(l_netUpdatesR[0] == Approx(-32.8816));
     REQUIRE(l_netUpdatesR[1] == Approx(-308.90947936));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test the batched net-updates against the scalar F-wave solver.", "[FWaveBatch]") {
+    /*
+     * Test case:
+     *  1000 edges with varying heights, momenta and bathymetries.
+     *  Every seventh left and every eleventh right cell is dry, which covers edges with a dry left side,
+     *  a dry right side and two dry sides. Wet cells have sub-, super- and transcritical flows.
+     *
+     *  The batched net-updates have to match the scalar ones up to a few ulps.
+     */
+    tsunami_lab::t_idx const l_nEdges = 1000;
+
+    float l_hL[l_nEdges];
+    float l_hR[l_nEdges];
+    float l_huL[l_nEdges];
+    float l_huR[l_nEdges];
+    float l_bL[l_nEdges];
+    float l_bR[l_nEdges];
+
+    for (tsunami_lab::t_idx l_ed = 0; l_ed < l_nEdges; l_ed++) {
+        l_hL[l_ed] = (l_ed % 7 == 0) ? 0 : 1 + 50 * std::fabs(std::sin(0.3f * l_ed));
+        l_hR[l_ed] = (l_ed % 11 == 0) ? 0 : 1 + 50 * std::fabs(std::cos(0.7f * l_ed));
+        l_huL[l_ed] = 40 * std::sin(0.11f * l_ed) * l_hL[l_ed];
+        l_huR[l_ed] = -30 * std::cos(0.13f * l_ed) * l_hR[l_ed];
+        l_bL[l_ed] = -100 + 20 * std::sin(0.05f * l_ed);
+        l_bR[l_ed] = -100 + 20 * std::cos(0.03f * l_ed);
+    }
+
+    float l_netUpdatesLH[l_nEdges];
+    float l_netUpdatesLHu[l_nEdges];
+    float l_netUpdatesRH[l_nEdges];
+    float l_netUpdatesRHu[l_nEdges];
+
+    float l_waveSpeedMax = tsunami_lab::solvers::FWave::netUpdatesBatch(l_nEdges,
+                                                                        l_hL,
+                                                                        l_hR,
+                                                                        l_huL,
+                                                                        l_huR,
+                                                                        l_bL,
+                                                                        l_bR,
+                                                                        l_netUpdatesLH,
+                                                                        l_netUpdatesLHu,
+                                                                        l_netUpdatesRH,
+                                                                        l_netUpdatesRHu);
+
+    float l_epsilon = 4 * std::numeric_limits<float>::epsilon();
+    float l_waveSpeedMaxRef = 0;
+
+    for (tsunami_lab::t_idx l_ed = 0; l_ed < l_nEdges; l_ed++) {
+        float l_netUpdatesL[2] = {0, 0};
+        float l_netUpdatesR[2] = {0, 0};
+
+        tsunami_lab::solvers::FWave::netUpdates(l_hL[l_ed],
+                                                l_hR[l_ed],
+                                                l_huL[l_ed],
+                                                l_huR[l_ed],
+                                                l_bL[l_ed],
+                                                l_bR[l_ed],
+                                                l_netUpdatesL,
+                                                l_netUpdatesR);
+
+        REQUIRE(l_netUpdatesLH[l_ed] == Approx(l_netUpdatesL[0]).epsilon(l_epsilon));
+        REQUIRE(l_netUpdatesLHu[l_ed] == Approx(l_netUpdatesL[1]).epsilon(l_epsilon));
+        REQUIRE(l_netUpdatesRH[l_ed] == Approx(l_netUpdatesR[0]).epsilon(l_epsilon));
+        REQUIRE(l_netUpdatesRHu[l_ed] == Approx(l_netUpdatesR[1]).epsilon(l_epsilon));
+
+        // wave speeds of the edge; a dry side reflects the wet one
+        if (l_hL[l_ed] > 0 || l_hR[l_ed] > 0) {
+            float l_h[2] = {l_hL[l_ed], l_hR[l_ed]};
+            float l_hu[2] = {l_huL[l_ed], l_huR[l_ed]};
+            if (l_h[0] <= 0) {
+                l_h[0] = l_h[1];
+                l_hu[0] = -l_hu[1];
+            }
+            if (l_h[1] <= 0) {
+                l_h[1] = l_h[0];
+                l_hu[1] = -l_hu[0];
+            }
+
+            float l_waveSpeeds[2];
+            tsunami_lab::solvers::FWave::waveSpeeds(l_h[0], l_h[1], l_hu[0] / l_h[0], l_hu[1] / l_h[1], l_waveSpeeds[0], l_waveSpeeds[1]);
+            l_waveSpeedMaxRef = std::max(l_waveSpeedMaxRef, std::max(std::fabs(l_waveSpeeds[0]), std::fabs(l_waveSpeeds[1])));
+        }
+    }
+
+    REQUIRE(l_waveSpeedMax == Approx(l_waveSpeedMaxRef).epsilon(l_epsilon));
+
+    // both sides dry
+    REQUIRE(l_netUpdatesLH[0] == 0);
+    REQUIRE(l_netUpdatesLHu[0] == 0);
+    REQUIRE(l_netUpdatesRH[0] == 0);
+    REQUIRE(l_netUpdatesRHu[0] == 0);
+
+    // left side dry
+    REQUIRE(l_netUpdatesLH[7] == 0);
+    REQUIRE(l_netUpdatesLHu[7] == 0);
+
+    // right side dry
+    REQUIRE(l_netUpdatesRH[11] == 0);
+    REQUIRE(l_netUpdatesRHu[11] == 0);
+}
+TEST_CASE("Test the batched net-updates from precomputed cell terms against the batched ones.", "[FWaveBatch]") {
+    /*
+     * Test case:
+     *  A row of 1001 cells with varying heights, momenta and bathymetries, in which every seventh cell is dry and
+     *  every 97th cell has a negative height; cells 600 and 601 are both dry. The cell terms of the row are computed once and reused by both edges
+     *  of every cell.
+     *
+     *  The net-updates and the maximum wave speed match those of the batched solver exactly.
+     */
+    tsunami_lab::t_idx const l_nCells = 1001;
+    tsunami_lab::t_idx const l_nEdges = l_nCells - 1;
+
+    float l_h[l_nCells];
+    float l_hu[l_nCells];
+    float l_b[l_nCells];
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++) {
+        l_h[l_ce] = (l_ce % 7 == 3) ? 0 : 1 + 50 * std::fabs(std::sin(0.3f * l_ce));
+        if (l_ce % 97 == 5) l_h[l_ce] = -1;
+        if (l_ce == 600 || l_ce == 601) l_h[l_ce] = 0;
+        l_hu[l_ce] = 40 * std::sin(0.11f * l_ce) * l_h[l_ce];
+        l_b[l_ce] = -100 + 20 * std::sin(0.05f * l_ce);
+    }
+
+    float l_u[l_nCells];
+    float l_sqrtH[l_nCells];
+    float l_flux[l_nCells];
+    tsunami_lab::solvers::FWave::cellTerms(l_nCells, l_h, l_hu, l_u, l_sqrtH, l_flux);
+
+    float l_netUpdates[2][4][l_nEdges];
+    float l_waveSpeedMax = tsunami_lab::solvers::FWave::netUpdatesBatch(l_nEdges,
+                                                                        l_h,
+                                                                        l_h + 1,
+                                                                        l_hu,
+                                                                        l_hu + 1,
+                                                                        l_b,
+                                                                        l_b + 1,
+                                                                        l_netUpdates[0][0],
+                                                                        l_netUpdates[0][1],
+                                                                        l_netUpdates[0][2],
+                                                                        l_netUpdates[0][3]);
+    float l_waveSpeedMaxTerms = tsunami_lab::solvers::FWave::netUpdatesBatch(l_nEdges,
+                                                                             l_h,
+                                                                             l_h + 1,
+                                                                             l_hu,
+                                                                             l_hu + 1,
+                                                                             l_b,
+                                                                             l_b + 1,
+                                                                             l_u,
+                                                                             l_u + 1,
+                                                                             l_sqrtH,
+                                                                             l_sqrtH + 1,
+                                                                             l_flux,
+                                                                             l_flux + 1,
+                                                                             l_netUpdates[1][0],
+                                                                             l_netUpdates[1][1],
+                                                                             l_netUpdates[1][2],
+                                                                             l_netUpdates[1][3]);
+
+    REQUIRE(l_waveSpeedMaxTerms == l_waveSpeedMax);
+    for (tsunami_lab::t_idx l_ed = 0; l_ed < l_nEdges; l_ed++) {
+        for (unsigned short l_qu = 0; l_qu < 4; l_qu++) {
+            REQUIRE(l_netUpdates[1][l_qu][l_ed] == l_netUpdates[0][l_qu][l_ed]);
+        }
+    }
+
+    // edges between dry cells have no updates
+    REQUIRE(l_netUpdates[1][0][600] == 0);
+    REQUIRE(l_netUpdates[1][2][600] == 0);
+}
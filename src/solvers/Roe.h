@@ -7,6 +7,9 @@
 #ifndef TSUNAMI_LAB_SOLVERS_ROE
 #define TSUNAMI_LAB_SOLVERS_ROE
 
+#include <algorithm>
+#include <cmath>
+
 #include "../constants.h"
 
 namespace tsunami_lab {
@@ -20,23 +23,6 @@ class tsunami_lab::solvers::Roe {
     //! square root of gravity
     static t_real constexpr m_gSqrt = 3.131557121;
 
-    /**
-     * Computes the wave speeds.
-     *
-     * @param i_hL height of the left side.
-     * @param i_hR height of the right side.
-     * @param i_uL particle velocity of the leftside.
-     * @param i_uR particles velocity of the right side.
-     * @param o_waveSpeedL will be set to the speed of the wave propagating to the left.
-     * @param o_waveSpeedR will be set to the speed of the wave propagating to the right.
-     **/
-    static void waveSpeeds(t_real i_hL,
-                           t_real i_hR,
-                           t_real i_uL,
-                           t_real i_uR,
-                           t_real& o_waveSpeedL,
-                           t_real& o_waveSpeedR);
-
     /**
      * Computes the wave strengths.
      *
@@ -59,6 +45,23 @@ class tsunami_lab::solvers::Roe {
                               t_real& o_strengthR);
 
    public:
+    /**
+     * Computes the wave speeds.
+     *
+     * @param i_hL height of the left side.
+     * @param i_hR height of the right side.
+     * @param i_uL particle velocity of the leftside.
+     * @param i_uR particles velocity of the right side.
+     * @param o_waveSpeedL will be set to the speed of the wave propagating to the left.
+     * @param o_waveSpeedR will be set to the speed of the wave propagating to the right.
+     **/
+    static void waveSpeeds(t_real i_hL,
+                           t_real i_hR,
+                           t_real i_uL,
+                           t_real i_uR,
+                           t_real& o_waveSpeedL,
+                           t_real& o_waveSpeedR);
+
     /**
      * Computes the net-updates.
      *
@@ -75,6 +78,296 @@ class tsunami_lab::solvers::Roe {
                            t_real i_huR,
                            t_real o_netUpdateL[2],
                            t_real o_netUpdateR[2]);
+
+    /**
+     * Computes the net-updates of a batch of edges. For two wet sides the results match those of netUpdates and
+     * waveSpeeds, which ignore the bathymetry. As in the batch of the F-wave solver, a dry side (h <= 0), e.g., a
+     * reflecting ghost cell, reflects the wet side like a wall and receives no updates; edges with two dry sides have
+     * no waves.
+     *
+     * @param i_nEdges number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL unused bathymetries of the left sides.
+     * @param i_bR unused bathymetries of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the heights for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momenta for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the heights for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momenta for the right sides.
+     * @return maximum absolute wave speed of all edges; edges with two dry sides are ignored.
+     **/
+    static t_real netUpdatesBatch(t_idx i_nEdges,
+                                  t_real const *i_hL,
+                                  t_real const *i_hR,
+                                  t_real const *i_huL,
+                                  t_real const *i_huR,
+                                  t_real const *i_bL,
+                                  t_real const *i_bR,
+                                  t_real *o_netUpdateLH,
+                                  t_real *o_netUpdateLHu,
+                                  t_real *o_netUpdateRH,
+                                  t_real *o_netUpdateRHu);
+
+    /**
+     * Computes the particle velocity and the square root of the height of every cell, which the Roe averages of both
+     * adjacent edges share. Dry cells get the terms of height 1 as dummies; their edges reflect the terms of the wet
+     * side.
+     *
+     * @param i_nCells number of cells.
+     * @param i_h heights of the cells.
+     * @param i_hu momenta of the cells.
+     * @param o_u will be set to the particle velocities.
+     * @param o_sqrtH will be set to the square roots of the heights.
+     * @param o_flux will be set to the fluxes of the heights, i.e., the momenta; the Roe solver decomposes the jumps of
+     *               the quantities instead of the fluxes and does not use them.
+     **/
+    static void cellTerms(t_idx i_nCells,
+                          t_real const *i_h,
+                          t_real const *i_hu,
+                          t_real *o_u,
+                          t_real *o_sqrtH,
+                          t_real *o_flux);
+
+    /**
+     * Computes the net-updates of a batch of edges from the terms of their sides, which were computed by cellTerms.
+     * The results match those of netUpdatesBatch, including the handling of dry sides.
+     *
+     * @param i_nEdges number of edges.
+     * @param i_hL heights of the left sides.
+     * @param i_hR heights of the right sides.
+     * @param i_huL momenta of the left sides.
+     * @param i_huR momenta of the right sides.
+     * @param i_bL unused bathymetries of the left sides.
+     * @param i_bR unused bathymetries of the right sides.
+     * @param i_uL particle velocities of the left sides.
+     * @param i_uR particle velocities of the right sides.
+     * @param i_sqrtHL square roots of the heights of the left sides.
+     * @param i_sqrtHR square roots of the heights of the right sides.
+     * @param i_fluxL unused fluxes of the left sides.
+     * @param i_fluxR unused fluxes of the right sides.
+     * @param o_netUpdateLH will be set to the net-updates of the heights for the left sides.
+     * @param o_netUpdateLHu will be set to the net-updates of the momenta for the left sides.
+     * @param o_netUpdateRH will be set to the net-updates of the heights for the right sides.
+     * @param o_netUpdateRHu will be set to the net-updates of the momenta for the right sides.
+     * @return maximum absolute wave speed of all edges; edges with two dry sides are ignored.
+     **/
+    static t_real netUpdatesBatch(t_idx i_nEdges,
+                                  t_real const *i_hL,
+                                  t_real const *i_hR,
+                                  t_real const *i_huL,
+                                  t_real const *i_huR,
+                                  t_real const *i_bL,
+                                  t_real const *i_bR,
+                                  t_real const *i_uL,
+                                  t_real const *i_uR,
+                                  t_real const *i_sqrtHL,
+                                  t_real const *i_sqrtHR,
+                                  t_real const *i_fluxL,
+                                  t_real const *i_fluxR,
+                                  t_real *o_netUpdateLH,
+                                  t_real *o_netUpdateLHu,
+                                  t_real *o_netUpdateRH,
+                                  t_real *o_netUpdateRHu);
 };
 
+// the batched kernels are defined in the header, such that they are inlined into the sweeps of the patches
+
+inline tsunami_lab::t_real tsunami_lab::solvers::Roe::netUpdatesBatch(t_idx i_nEdges,
+                                                                      t_real const *i_hL,
+                                                                      t_real const *i_hR,
+                                                                      t_real const *i_huL,
+                                                                      t_real const *i_huR,
+                                                                      t_real const *,
+                                                                      t_real const *,
+                                                                      t_real *o_netUpdateLH,
+                                                                      t_real *o_netUpdateLHu,
+                                                                      t_real *o_netUpdateRH,
+                                                                      t_real *o_netUpdateRHu) {
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp simd reduction(max : l_waveSpeedMax)
+    for (t_idx l_ed = 0; l_ed < i_nEdges; l_ed++) {
+        // load all inputs unconditionally, which allows the compiler to replace the branches by selects
+        t_real l_hInL = i_hL[l_ed];
+        t_real l_hInR = i_hR[l_ed];
+        t_real l_huInL = i_huL[l_ed];
+        t_real l_huInR = i_huR[l_ed];
+
+        bool l_isLeftDry = (l_hInL <= 0);
+        bool l_isRightDry = (l_hInR <= 0);
+        bool l_isBothDry = l_isLeftDry & l_isRightDry;
+
+        // a dry side reflects the wet one; lanes with two dry cells compute a dummy state and are zeroed below
+        t_real l_hL = l_isLeftDry ? l_hInR : l_hInL;
+        t_real l_hR = l_isRightDry ? l_hInL : l_hInR;
+        t_real l_huL = l_isLeftDry ? -l_huInR : l_huInL;
+        t_real l_huR = l_isRightDry ? -l_huInL : l_huInR;
+
+        l_hL = l_isBothDry ? 1 : l_hL;
+        l_hR = l_isBothDry ? 1 : l_hR;
+
+        // compute wave speeds from the Roe averages
+        t_real l_uL = l_huL / l_hL;
+        t_real l_uR = l_huR / l_hR;
+        t_real l_hSqrtL = std::sqrt(l_hL);
+        t_real l_hSqrtR = std::sqrt(l_hR);
+
+        t_real l_hRoe = 0.5f * (l_hL + l_hR);
+        t_real l_uRoe = l_hSqrtL * l_uL + l_hSqrtR * l_uR;
+        l_uRoe /= l_hSqrtL + l_hSqrtR;
+
+        t_real l_ghSqrtRoe = m_gSqrt * std::sqrt(l_hRoe);
+        t_real l_sL = l_uRoe - l_ghSqrtRoe;
+        t_real l_sR = l_uRoe + l_ghSqrtRoe;
+
+        // compute wave strengths with the inverse of the matrix of eigenvectors
+        t_real l_detInv = 1 / (l_sR - l_sL);
+        t_real l_hJump = l_hR - l_hL;
+        t_real l_huJump = l_huR - l_huL;
+
+        t_real l_aL = (l_detInv * l_sR) * l_hJump;
+        l_aL += (-l_detInv) * l_huJump;
+        t_real l_aR = (-l_detInv * l_sL) * l_hJump;
+        l_aR += l_detInv * l_huJump;
+
+        // compute scaled waves
+        t_real l_waveL[2] = {l_sL * l_aL, l_sL * l_aL * l_sL};
+        t_real l_waveR[2] = {l_sR * l_aR, l_sR * l_aR * l_sR};
+
+        // a right-going second wave replaces the update of the first wave on the right side, as in netUpdates
+        bool l_isLToL = (l_sL < 0);
+        bool l_isRToR = (l_sR > 0);
+
+        t_real l_netUpdateL[2] = {l_isRToR ? (l_isLToL ? l_waveL[0] : 0) : l_waveR[0],
+                                  l_isRToR ? (l_isLToL ? l_waveL[1] : 0) : l_waveR[1]};
+        t_real l_netUpdateR[2] = {l_isRToR ? l_waveR[0] : (l_isLToL ? 0 : l_waveL[0]),
+                                  l_isRToR ? l_waveR[1] : (l_isLToL ? 0 : l_waveL[1])};
+
+        // dry cells do not receive updates
+        o_netUpdateLH[l_ed] = l_isLeftDry ? 0 : l_netUpdateL[0];
+        o_netUpdateLHu[l_ed] = l_isLeftDry ? 0 : l_netUpdateL[1];
+        o_netUpdateRH[l_ed] = l_isRightDry ? 0 : l_netUpdateR[0];
+        o_netUpdateRHu[l_ed] = l_isRightDry ? 0 : l_netUpdateR[1];
+
+        t_real l_waveSpeed = std::max(std::fabs(l_sL), std::fabs(l_sR));
+        l_waveSpeed = l_isBothDry ? 0 : l_waveSpeed;
+        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+    }
+
+    return l_waveSpeedMax;
+}
+
+inline void tsunami_lab::solvers::Roe::cellTerms(t_idx i_nCells,
+                                                 t_real const *i_h,
+                                                 t_real const *i_hu,
+                                                 t_real *o_u,
+                                                 t_real *o_sqrtH,
+                                                 t_real *o_flux) {
+#pragma omp simd
+    for (t_idx l_ce = 0; l_ce < i_nCells; l_ce++) {
+        // dry cells get the terms of height 1, which only enter the dummy state of edges between two dry cells
+        t_real l_h = (i_h[l_ce] <= 0) ? 1 : i_h[l_ce];
+
+        o_u[l_ce] = i_hu[l_ce] / l_h;
+        o_sqrtH[l_ce] = std::sqrt(l_h);
+        o_flux[l_ce] = i_hu[l_ce];
+    }
+}
+
+inline tsunami_lab::t_real tsunami_lab::solvers::Roe::netUpdatesBatch(t_idx i_nEdges,
+                                                                      t_real const *i_hL,
+                                                                      t_real const *i_hR,
+                                                                      t_real const *i_huL,
+                                                                      t_real const *i_huR,
+                                                                      t_real const *,
+                                                                      t_real const *,
+                                                                      t_real const *i_uL,
+                                                                      t_real const *i_uR,
+                                                                      t_real const *i_sqrtHL,
+                                                                      t_real const *i_sqrtHR,
+                                                                      t_real const *,
+                                                                      t_real const *,
+                                                                      t_real *o_netUpdateLH,
+                                                                      t_real *o_netUpdateLHu,
+                                                                      t_real *o_netUpdateRH,
+                                                                      t_real *o_netUpdateRHu) {
+    t_real l_waveSpeedMax = 0;
+
+#pragma omp simd reduction(max : l_waveSpeedMax)
+    for (t_idx l_ed = 0; l_ed < i_nEdges; l_ed++) {
+        // load all inputs unconditionally, which allows the compiler to replace the branches by selects
+        t_real l_hInL = i_hL[l_ed];
+        t_real l_hInR = i_hR[l_ed];
+        t_real l_huInL = i_huL[l_ed];
+        t_real l_huInR = i_huR[l_ed];
+        t_real l_uInL = i_uL[l_ed];
+        t_real l_uInR = i_uR[l_ed];
+        t_real l_hSqrtInL = i_sqrtHL[l_ed];
+        t_real l_hSqrtInR = i_sqrtHR[l_ed];
+
+        bool l_isLeftDry = (l_hInL <= 0);
+        bool l_isRightDry = (l_hInR <= 0);
+        bool l_isBothDry = l_isLeftDry & l_isRightDry;
+
+        // a dry side reflects the wet one: same height and root, negated momentum and velocity
+        t_real l_hL = l_isLeftDry ? l_hInR : l_hInL;
+        t_real l_hR = l_isRightDry ? l_hInL : l_hInR;
+        t_real l_huL = l_isLeftDry ? -l_huInR : l_huInL;
+        t_real l_huR = l_isRightDry ? -l_huInL : l_huInR;
+        t_real l_uL = l_isLeftDry ? -l_uInR : l_uInL;
+        t_real l_uR = l_isRightDry ? -l_uInL : l_uInR;
+        t_real l_hSqrtL = l_isLeftDry ? l_hSqrtInR : l_hSqrtInL;
+        t_real l_hSqrtR = l_isRightDry ? l_hSqrtInL : l_hSqrtInR;
+
+        // lanes with two dry cells compute a dummy state from the dummy terms of height 1 and are zeroed below
+        l_hL = l_isBothDry ? 1 : l_hL;
+        l_hR = l_isBothDry ? 1 : l_hR;
+
+        // compute wave speeds from the Roe averages
+        t_real l_hRoe = 0.5f * (l_hL + l_hR);
+        t_real l_uRoe = l_hSqrtL * l_uL + l_hSqrtR * l_uR;
+        l_uRoe /= l_hSqrtL + l_hSqrtR;
+
+        t_real l_ghSqrtRoe = m_gSqrt * std::sqrt(l_hRoe);
+        t_real l_sL = l_uRoe - l_ghSqrtRoe;
+        t_real l_sR = l_uRoe + l_ghSqrtRoe;
+
+        // compute wave strengths with the inverse of the matrix of eigenvectors
+        t_real l_detInv = 1 / (l_sR - l_sL);
+        t_real l_hJump = l_hR - l_hL;
+        t_real l_huJump = l_huR - l_huL;
+
+        t_real l_aL = (l_detInv * l_sR) * l_hJump;
+        l_aL += (-l_detInv) * l_huJump;
+        t_real l_aR = (-l_detInv * l_sL) * l_hJump;
+        l_aR += l_detInv * l_huJump;
+
+        // compute scaled waves
+        t_real l_waveL[2] = {l_sL * l_aL, l_sL * l_aL * l_sL};
+        t_real l_waveR[2] = {l_sR * l_aR, l_sR * l_aR * l_sR};
+
+        bool l_isLToL = (l_sL < 0);
+        bool l_isRToR = (l_sR > 0);
+
+        t_real l_netUpdateL[2] = {l_isRToR ? (l_isLToL ? l_waveL[0] : 0) : l_waveR[0],
+                                  l_isRToR ? (l_isLToL ? l_waveL[1] : 0) : l_waveR[1]};
+        t_real l_netUpdateR[2] = {l_isRToR ? l_waveR[0] : (l_isLToL ? 0 : l_waveL[0]),
+                                  l_isRToR ? l_waveR[1] : (l_isLToL ? 0 : l_waveL[1])};
+
+        // dry cells do not receive updates
+        o_netUpdateLH[l_ed] = l_isLeftDry ? 0 : l_netUpdateL[0];
+        o_netUpdateLHu[l_ed] = l_isLeftDry ? 0 : l_netUpdateL[1];
+        o_netUpdateRH[l_ed] = l_isRightDry ? 0 : l_netUpdateR[0];
+        o_netUpdateRHu[l_ed] = l_isRightDry ? 0 : l_netUpdateR[1];
+
+        t_real l_waveSpeed = std::max(std::fabs(l_sL), std::fabs(l_sR));
+        l_waveSpeed = l_isBothDry ? 0 : l_waveSpeed;
+        l_waveSpeedMax = std::max(l_waveSpeedMax, l_waveSpeed);
+    }
+
+    return l_waveSpeedMax;
+}
+
 #endif
@@ -5,6 +5,8 @@
  * Unit tests of the Roe Riemann solver.
  **/
 #include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
 #define private public
 #include "Roe.h"
 #undef public
@@ -187,4 +189,87 @@ TEST_CASE("Test the derivation of the Roe net-updates.", "[RoeUpdates]") {
 
     REQUIRE(l_netUpdatesR[0] == Approx(0));
     REQUIRE(l_netUpdatesR[1] == Approx(0));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test the batched Roe net-updates against the scalar ones.", "[RoeBatch]") {
+    /*
+     * Test case:
+     *  A row of 1001 wet cells with varying heights and momenta, whose edges have sub- and supersonic flows in both
+     *  directions.
+     *
+     *  The batched net-updates, with and without precomputed cell terms, have to match the scalar ones up to a few ulps.
+     */
+    tsunami_lab::t_idx const l_nEdges = 1000;
+    tsunami_lab::t_idx const l_nCells = l_nEdges + 1;
+
+    float l_h[l_nCells];
+    float l_hu[l_nCells];
+    float l_b[l_nCells];
+    for (tsunami_lab::t_idx l_ce = 0; l_ce < l_nCells; l_ce++) {
+        l_h[l_ce] = 1 + 20 * std::fabs(std::sin(0.3f * l_ce));
+        l_hu[l_ce] = 30 * std::sin(0.11f * l_ce) * l_h[l_ce];
+        l_b[l_ce] = -10;
+    }
+
+    float l_netUpdates[2][4][l_nEdges];
+    float l_waveSpeedMax[2];
+    l_waveSpeedMax[0] = tsunami_lab::solvers::Roe::netUpdatesBatch(l_nEdges,
+                                                                   l_h,
+                                                                   l_h + 1,
+                                                                   l_hu,
+                                                                   l_hu + 1,
+                                                                   l_b,
+                                                                   l_b + 1,
+                                                                   l_netUpdates[0][0],
+                                                                   l_netUpdates[0][1],
+                                                                   l_netUpdates[0][2],
+                                                                   l_netUpdates[0][3]);
+
+    float l_u[l_nCells];
+    float l_sqrtH[l_nCells];
+    float l_flux[l_nCells];
+    tsunami_lab::solvers::Roe::cellTerms(l_nCells, l_h, l_hu, l_u, l_sqrtH, l_flux);
+    l_waveSpeedMax[1] = tsunami_lab::solvers::Roe::netUpdatesBatch(l_nEdges,
+                                                                   l_h,
+                                                                   l_h + 1,
+                                                                   l_hu,
+                                                                   l_hu + 1,
+                                                                   l_b,
+                                                                   l_b + 1,
+                                                                   l_u,
+                                                                   l_u + 1,
+                                                                   l_sqrtH,
+                                                                   l_sqrtH + 1,
+                                                                   l_flux,
+                                                                   l_flux + 1,
+                                                                   l_netUpdates[1][0],
+                                                                   l_netUpdates[1][1],
+                                                                   l_netUpdates[1][2],
+                                                                   l_netUpdates[1][3]);
+
+    float l_epsilon = 4 * std::numeric_limits<float>::epsilon();
+    float l_waveSpeedMaxRef = 0;
+    tsunami_lab::t_idx l_nSupersonic = 0;
+
+    for (tsunami_lab::t_idx l_ed = 0; l_ed < l_nEdges; l_ed++) {
+        float l_netUpdatesL[2];
+        float l_netUpdatesR[2];
+        tsunami_lab::solvers::Roe::netUpdates(l_h[l_ed], l_h[l_ed + 1], l_hu[l_ed], l_hu[l_ed + 1], l_netUpdatesL, l_netUpdatesR);
+
+        float l_waveSpeeds[2];
+        tsunami_lab::solvers::Roe::waveSpeeds(l_h[l_ed], l_h[l_ed + 1], l_hu[l_ed] / l_h[l_ed], l_hu[l_ed + 1] / l_h[l_ed + 1], l_waveSpeeds[0], l_waveSpeeds[1]);
+        l_waveSpeedMaxRef = std::max(l_waveSpeedMaxRef, std::max(std::fabs(l_waveSpeeds[0]), std::fabs(l_waveSpeeds[1])));
+        if (l_waveSpeeds[0] > 0 || l_waveSpeeds[1] < 0) l_nSupersonic++;
+
+        for (unsigned short l_ke = 0; l_ke < 2; l_ke++) {
+            REQUIRE(l_netUpdates[l_ke][0][l_ed] == Approx(l_netUpdatesL[0]).epsilon(l_epsilon));
+            REQUIRE(l_netUpdates[l_ke][1][l_ed] == Approx(l_netUpdatesL[1]).epsilon(l_epsilon));
+            REQUIRE(l_netUpdates[l_ke][2][l_ed] == Approx(l_netUpdatesR[0]).epsilon(l_epsilon));
+            REQUIRE(l_netUpdates[l_ke][3][l_ed] == Approx(l_netUpdatesR[1]).epsilon(l_epsilon));
+        }
+    }
+
+    REQUIRE(l_nSupersonic > 0);
+    REQUIRE(l_waveSpeedMax[0] == Approx(l_waveSpeedMaxRef).epsilon(l_epsilon));
+    REQUIRE(l_waveSpeedMax[1] == Approx(l_waveSpeedMaxRef).epsilon(l_epsilon));
+}
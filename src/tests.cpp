@@ -10,10 +10,22 @@
 
 #include <iostream>
 
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
 int main(int i_argc,
          char* i_argv[]) {
+#ifdef USE_MPI
+    // the master thread of the OpenMP team exchanges the halos
+    int l_threadSupport = 0;
+    MPI_Init_thread(&i_argc, &i_argv, MPI_THREAD_FUNNELED, &l_threadSupport);
+#endif
     std::cout.setstate(std::ios_base::failbit);
     int l_result = Catch::Session().run(i_argc, i_argv);
     std::cout.clear();
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
     return (l_result < 0xff ? l_result : 0xff);
 }
\ No newline at end of file